@@ -0,0 +1,93 @@
+#include "Core/TerraDyneChunkGrid.h"
+
+void FTerraDyneChunkGrid::Add(FIntPoint Coord, ATerraDyneChunk* Chunk)
+{
+	if (!Chunk) return;
+
+	TUniquePtr<FPage>& Page = FindOrAddPageSlot(ToPageCoord(Coord));
+	if (!Page.IsValid())
+	{
+		Page = MakeUnique<FPage>();
+	}
+
+	ATerraDyneChunk*& Slot = Page->Slots[ToSlotIndex(Coord)];
+	if (!Slot)
+	{
+		Page->Count++;
+		NumChunks++;
+	}
+	Slot = Chunk;
+}
+
+bool FTerraDyneChunkGrid::Remove(FIntPoint Coord, const ATerraDyneChunk* Expected)
+{
+	const FIntPoint PageCoord = ToPageCoord(Coord);
+	if (!FindPage(PageCoord)) return false;
+
+	TUniquePtr<FPage>& Page = Directory[(PageCoord.Y - DirectoryMin.Y) * DirectorySize.X + (PageCoord.X - DirectoryMin.X)];
+
+	ATerraDyneChunk*& Slot = Page->Slots[ToSlotIndex(Coord)];
+	if (!Slot || (Expected && Slot != Expected))
+	{
+		return false;
+	}
+
+	Slot = nullptr;
+	NumChunks--;
+
+	// Free empty pages so sparse worlds don't accumulate 8KB blocks
+	if (--Page->Count == 0)
+	{
+		Page.Reset();
+	}
+	return true;
+}
+
+void FTerraDyneChunkGrid::Reset()
+{
+	Directory.Reset();
+	DirectoryMin = FIntPoint::ZeroValue;
+	DirectorySize = FIntPoint::ZeroValue;
+	NumChunks = 0;
+}
+
+TUniquePtr<FTerraDyneChunkGrid::FPage>& FTerraDyneChunkGrid::FindOrAddPageSlot(FIntPoint PageCoord)
+{
+	if (DirectorySize.X == 0 || DirectorySize.Y == 0)
+	{
+		DirectoryMin = PageCoord;
+		DirectorySize = FIntPoint(1, 1);
+		Directory.SetNum(1);
+		return Directory[0];
+	}
+
+	const FIntPoint OldMin = DirectoryMin;
+	const FIntPoint OldMax = DirectoryMin + DirectorySize; // exclusive
+
+	const FIntPoint NewMin(FMath::Min(OldMin.X, PageCoord.X), FMath::Min(OldMin.Y, PageCoord.Y));
+	const FIntPoint NewMax(FMath::Max(OldMax.X, PageCoord.X + 1), FMath::Max(OldMax.Y, PageCoord.Y + 1));
+
+	if (NewMin != OldMin || NewMax != OldMax)
+	{
+		// Re-layout the directory only; pages themselves never move
+		const FIntPoint NewSize = NewMax - NewMin;
+		TArray<TUniquePtr<FPage>> NewDirectory;
+		NewDirectory.SetNum(NewSize.X * NewSize.Y);
+
+		for (int32 Y = 0; Y < DirectorySize.Y; Y++)
+		{
+			for (int32 X = 0; X < DirectorySize.X; X++)
+			{
+				const int32 NX = X + (OldMin.X - NewMin.X);
+				const int32 NY = Y + (OldMin.Y - NewMin.Y);
+				NewDirectory[NY * NewSize.X + NX] = MoveTemp(Directory[Y * DirectorySize.X + X]);
+			}
+		}
+
+		Directory = MoveTemp(NewDirectory);
+		DirectoryMin = NewMin;
+		DirectorySize = NewSize;
+	}
+
+	return Directory[(PageCoord.Y - DirectoryMin.Y) * DirectorySize.X + (PageCoord.X - DirectoryMin.X)];
+}
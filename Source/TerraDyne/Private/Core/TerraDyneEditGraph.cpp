@@ -0,0 +1,129 @@
+#include "Core/TerraDyneEditGraph.h"
+
+// Engine Includes
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+struct FTerraDyneEditGraph::FRun : public TSharedFromThis<FRun, ESPMode::ThreadSafe>
+{
+	/**
+	 * Owned by a node's pool job. The pool destroys the job after running, skipping (cancelled) or
+	 * abandoning it, so the node counts as finished in every case and its dependents never hang.
+	 */
+	struct FCompletion
+	{
+		FCompletion(TSharedRef<FRun, ESPMode::ThreadSafe> InRun, int32 InIndex) : Run(MoveTemp(InRun)), Index(InIndex) {}
+		~FCompletion() { Run->OnNodeFinished(Index); }
+
+		TSharedRef<FRun, ESPMode::ThreadSafe> Run;
+		int32 Index;
+	};
+
+	ETerraDyneJobPriority Priority = ETerraDyneJobPriority::Interactive;
+	TArray<FNode> Nodes;
+	TArray<TArray<int32>> Dependents;
+	TUniqueFunction<void()> Join;
+
+	FCriticalSection Mutex;    // Guards the counts below
+	TArray<int32> NumWaiting;  // Unfinished prerequisites per node
+	int32 NumUnfinished = 0;
+
+	void LaunchNode(int32 Index)
+	{
+		FNode& Node = Nodes[Index];
+		TUniquePtr<FCompletion> Completion = MakeUnique<FCompletion>(AsShared(), Index);
+
+		// Dependents are launched from the finishing job, before the pool counts it as done, so WaitForAll() never sees a gap
+		FTerraDyneWorkerPool::Get().Launch(Priority,
+			[Work = MoveTemp(Node.Work), DebugName = Node.DebugName, Completion = MoveTemp(Completion)](const FTerraDyneCancellationToken&) mutable
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(DebugName);
+				Work();
+			}, MoveTemp(Node.Token));
+	}
+
+	void OnNodeFinished(int32 Index)
+	{
+		TArray<int32, TInlineAllocator<4>> Ready;
+		bool bAllFinished;
+		{
+			FScopeLock Lock(&Mutex);
+			for (int32 Dependent : Dependents[Index])
+			{
+				if (--NumWaiting[Dependent] == 0)
+				{
+					Ready.Add(Dependent);
+				}
+			}
+			bAllFinished = --NumUnfinished == 0;
+		}
+
+		for (int32 Next : Ready)
+		{
+			LaunchNode(Next);
+		}
+		if (bAllFinished)
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(Join));
+		}
+	}
+};
+
+void FTerraDyneEditGraph::AddNode(const TCHAR* DebugName, ETerraDyneEditResource Reads, ETerraDyneEditResource Writes, TUniqueFunction<void()>&& Work,
+	FTerraDyneCancellationTokenPtr Token)
+{
+	FNode& Node = Nodes.AddDefaulted_GetRef();
+	Node.DebugName = DebugName;
+	Node.Reads = Reads;
+	Node.Writes = Writes;
+	Node.Work = MoveTemp(Work);
+	Node.Token = MoveTemp(Token);
+}
+
+void FTerraDyneEditGraph::Launch(ETerraDyneJobPriority Priority, TUniqueFunction<void()>&& Join)
+{
+	if (Nodes.Num() == 0)
+	{
+		Join();
+		return;
+	}
+
+	TSharedRef<FRun, ESPMode::ThreadSafe> Run = MakeShared<FRun, ESPMode::ThreadSafe>();
+	Run->Priority = Priority;
+	Run->Join = MoveTemp(Join);
+	Run->Dependents.SetNum(Nodes.Num());
+	Run->NumWaiting.SetNumZeroed(Nodes.Num());
+	Run->NumUnfinished = Nodes.Num();
+
+	TArray<int32, TInlineAllocator<4>> Roots;
+	for (int32 i = 0; i < Nodes.Num(); i++)
+	{
+		const FNode& Node = Nodes[i];
+		for (int32 j = 0; j < i; j++)
+		{
+			const FNode& Earlier = Nodes[j];
+			const bool bConflicts =
+				EnumHasAnyFlags(Earlier.Writes, Node.Reads | Node.Writes) ||
+				EnumHasAnyFlags(Earlier.Reads, Node.Writes);
+			if (bConflicts)
+			{
+				Run->Dependents[j].Add(i);
+				Run->NumWaiting[i]++;
+			}
+		}
+
+		if (Run->NumWaiting[i] == 0)
+		{
+			Roots.Add(i);
+		}
+	}
+	Run->Nodes = MoveTemp(Nodes);
+	Nodes.Reset();
+
+	// Roots are collected first: a root may finish (and launch its dependents) before the loop ends
+	for (int32 Root : Roots)
+	{
+		Run->LaunchNode(Root);
+	}
+}
@@ -0,0 +1,317 @@
+#include "Core/TerraDyneEditJournal.h"
+#include "Core/TerraDyneManager.h"
+#include "Core/TerraDyneSubsystem.h"
+
+// Engine Includes
+#include "HAL/IConsoleManager.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// TerraDyneCore
+#include "TerraDyneJournalCodec.h"
+
+using TerraDyneCore::FJournalCodec;
+
+FTerraDyneEditJournal::FTerraDyneEditJournal(float InTickRate)
+	: TickRate(InTickRate)
+{
+}
+
+FTerraDyneJournalEdit FTerraDyneEditJournal::Quantize(const FTerraDyneJournalEdit& Edit)
+{
+	FTerraDyneJournalEdit Out = Edit;
+	Out.Position.X = (double)FMath::RoundToInt32(Edit.Position.X);
+	Out.Position.Y = (double)FMath::RoundToInt32(Edit.Position.Y);
+	Out.Radius = (float)FMath::Clamp(FMath::RoundToInt(Edit.Radius), 0, 65535);
+	Out.Strength = FJournalCodec::HalfToFloat(FJournalCodec::FloatToHalf(Edit.Strength));
+	Out.PaintLayer = (Edit.PaintLayer >= 0 && Edit.PaintLayer <= 3) ? Edit.PaintLayer : -1;
+	return Out;
+}
+
+void FTerraDyneEditJournal::Append(const FTerraDyneJournalEdit& Edit)
+{
+	using namespace TerraDyneCore;
+
+	const uint32 Tick = FMath::Max(Edit.Tick, Tail.Tick);
+	const int32 X = FMath::RoundToInt32(Edit.Position.X);
+	const int32 Y = FMath::RoundToInt32(Edit.Position.Y);
+
+	FJournalRecord Record;
+	Record.TickDelta = Tick - Tail.Tick;
+	Record.Op = Edit.PaintLayer >= 0 ? JournalOpPaint : Edit.bIsHole ? JournalOpHole : JournalOpHeight;
+	if (Record.Op == JournalOpPaint)
+	{
+		Record.Op |= (uint8)(Edit.PaintLayer & 3) << 2;
+	}
+	Record.DX = X - Tail.X;
+	Record.DY = Y - Tail.Y;
+	Record.Radius = (uint16)FMath::Clamp(FMath::RoundToInt(Edit.Radius), 0, 65535);
+	Record.Strength = FJournalCodec::FloatToHalf(Edit.Strength);
+
+	uint8 Bytes[FJournalCodec::MaxRecordSize];
+	Stream.Append(Bytes, (int32)FJournalCodec::WriteRecord(Record, Bytes));
+
+	Tail.Offset = Stream.Num();
+	Tail.EditIndex++;
+	Tail.Tick = Tick;
+	Tail.X = X;
+	Tail.Y = Y;
+}
+
+bool FTerraDyneEditJournal::ReadNext(FCursor& Cursor, FTerraDyneJournalEdit& OutEdit) const
+{
+	using namespace TerraDyneCore;
+	if (Cursor.Offset < 0 || Cursor.Offset >= Stream.Num()) return false;
+
+	size_t Offset = (size_t)Cursor.Offset;
+	FJournalRecord Record;
+	if (!FJournalCodec::ReadRecord(Stream.GetData(), (size_t)Stream.Num(), Offset, Record)) return false;
+
+	Cursor.Offset = (int32)Offset;
+	Cursor.EditIndex++;
+	Cursor.Tick += Record.TickDelta;
+	Cursor.X += Record.DX;
+	Cursor.Y += Record.DY;
+
+	OutEdit.Tick = Cursor.Tick;
+	OutEdit.Position = FVector2D(Cursor.X, Cursor.Y);
+	OutEdit.Radius = (float)Record.Radius;
+	OutEdit.Strength = FJournalCodec::HalfToFloat(Record.Strength);
+	OutEdit.bIsHole = (Record.Op & 3) == JournalOpHole;
+	OutEdit.PaintLayer = (Record.Op & 3) == JournalOpPaint ? (Record.Op >> 2) & 3 : -1;
+	return true;
+}
+
+FTerraDyneEditJournal::FKeyframe& FTerraDyneEditJournal::AddKeyframe(uint32 Tick)
+{
+	FKeyframe& Keyframe = Keyframes.AddDefaulted_GetRef();
+	Keyframe.Tick = FMath::Max(Tick, Tail.Tick);
+	Keyframe.Cursor = Tail;
+	return Keyframe;
+}
+
+const FTerraDyneEditJournal::FKeyframe* FTerraDyneEditJournal::FindKeyframe(uint32 Tick) const
+{
+	// Keyframes are appended in tick order
+	const int32 Index = Algo::UpperBoundBy(Keyframes, Tick, [](const FKeyframe& Keyframe) { return Keyframe.Tick; }) - 1;
+	return Keyframes.IsValidIndex(Index) ? &Keyframes[Index] : nullptr;
+}
+
+const FTerraDyneEditJournal::FChunkState* FTerraDyneEditJournal::FindLatestState(FIntPoint Coord) const
+{
+	// Every keyframe holds every chunk touched before it, so the latest one is enough
+	if (Keyframes.Num() > 0)
+	{
+		if (const FChunkState* State = Keyframes.Last().Chunks.Find(Coord))
+		{
+			return State;
+		}
+	}
+	return BaseStates.Find(Coord);
+}
+
+void FTerraDyneEditJournal::ThinKeyframes()
+{
+	// Keep the latest and every second one before it
+	TArray<FKeyframe> Kept;
+	Kept.Reserve(Keyframes.Num() / 2 + 1);
+	for (int32 Index = Keyframes.Num() - 1; Index >= 0; Index -= 2)
+	{
+		Kept.Add(MoveTemp(Keyframes[Index]));
+	}
+	Algo::Reverse(Kept);
+	Keyframes = MoveTemp(Kept);
+}
+
+int64 FTerraDyneEditJournal::GetAllocatedSize() const
+{
+	int64 Bytes = Stream.GetAllocatedSize() + BaseStates.GetAllocatedSize() + Keyframes.GetAllocatedSize();
+
+	TSet<const TArray<uint8>*> Counted;
+	auto AddStates = [&Bytes, &Counted](const TMap<FIntPoint, FChunkState>& States)
+		{
+			Bytes += States.GetAllocatedSize();
+			for (const TPair<FIntPoint, FChunkState>& Pair : States)
+			{
+				bool bAlreadyCounted = false;
+				Counted.Add(&Pair.Value.Get(), &bAlreadyCounted);
+				Bytes += bAlreadyCounted ? 0 : Pair.Value->GetAllocatedSize();
+			}
+		};
+
+	AddStates(BaseStates);
+	for (const FKeyframe& Keyframe : Keyframes)
+	{
+		AddStates(Keyframe.Chunks);
+	}
+	return Bytes;
+}
+
+//--- Files ---//
+
+void FTerraDyneEditJournal::Serialize(FArchive& Ar)
+{
+	// Magic and version are checked by LoadFromFile() before this runs
+	Ar << TickRate;
+	Ar << Stream;
+	Ar << Tail.Offset << Tail.EditIndex << Tail.Tick << Tail.X << Tail.Y;
+	SerializeStates(Ar, BaseStates, nullptr);
+
+	int32 NumKeyframes = Keyframes.Num();
+	Ar << NumKeyframes;
+	if (Ar.IsLoading())
+	{
+		if (NumKeyframes < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+		Keyframes.Reset();
+		Keyframes.SetNum(NumKeyframes);
+	}
+
+	for (int32 Index = 0; Index < Keyframes.Num() && !Ar.IsError(); Index++)
+	{
+		FKeyframe& Keyframe = Keyframes[Index];
+		Ar << Keyframe.Tick;
+		Ar << Keyframe.Cursor.Offset << Keyframe.Cursor.EditIndex << Keyframe.Cursor.Tick << Keyframe.Cursor.X << Keyframe.Cursor.Y;
+		SerializeStates(Ar, Keyframe.Chunks, Index > 0 ? &Keyframes[Index - 1].Chunks : &BaseStates);
+	}
+}
+
+void FTerraDyneEditJournal::SerializeStates(FArchive& Ar, TMap<FIntPoint, FChunkState>& States, const TMap<FIntPoint, FChunkState>* Previous)
+{
+	int32 Num = States.Num();
+	Ar << Num;
+
+	if (!Ar.IsLoading())
+	{
+		for (TPair<FIntPoint, FChunkState>& Pair : States)
+		{
+			Ar << Pair.Key << Pair.Value.Get();
+		}
+		return;
+	}
+
+	if (Num < 0)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	States.Reset();
+	States.Reserve(Num);
+	for (int32 Index = 0; Index < Num && !Ar.IsError(); Index++)
+	{
+		FIntPoint Coord;
+		FChunkState State = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+		Ar << Coord << State.Get();
+
+		// Files hold every keyframe in full: unchanged chunks share the previous copy again
+		const FChunkState* Same = Previous ? Previous->Find(Coord) : nullptr;
+		States.Add(Coord, (Same && Same->Get() == State.Get()) ? *Same : State);
+	}
+}
+
+bool FTerraDyneEditJournal::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = FileMagic;
+	int32 Version = FileVersion;
+	Writer << Magic << Version;
+	const_cast<FTerraDyneEditJournal*>(this)->Serialize(Writer); // Only reads members while saving
+
+	if (!FFileHelper::SaveArrayToFile(Bytes, *Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneJournal: Failed to write %s"), *Path);
+		return false;
+	}
+	return true;
+}
+
+bool FTerraDyneEditJournal::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path)) return false;
+
+	FMemoryReader Reader(Bytes);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic << Version;
+	if (Magic != FileMagic || Version != FileVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneJournal: %s is not a version %d journal"), *Path, FileVersion);
+		return false;
+	}
+
+	Serialize(Reader);
+	if (Reader.IsError() || Tail.Offset != Stream.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneJournal: %s is truncated or corrupt"), *Path);
+		*this = FTerraDyneEditJournal();
+		return false;
+	}
+	return true;
+}
+
+FString FTerraDyneEditJournal::GetJournalPath(const FString& Name)
+{
+	return FPaths::ProjectSavedDir() / TEXT("TerraDyne") / TEXT("Journals") / (Name + TEXT(".tdj"));
+}
+
+//--- Console ---//
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTerraDyneJournal(
+	TEXT("terradyne.Journal"),
+	TEXT("Edit journal. Usage: terradyne.Journal record | stop [Name] | play <Name|Path> [Speed, 0 = full speed] | seek <Seconds> | pause | resume"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UTerraDyneSubsystem* Subsystem = World ? World->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+			ATerraDyneManager* Manager = Subsystem ? Subsystem->GetTerrainManager() : nullptr;
+			if (!Manager || Args.Num() == 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("TerraDyneJournal: Needs a TerraDyne manager and a subcommand (record, stop, play, seek, pause, resume)."));
+				return;
+			}
+
+			const FString& Command = Args[0];
+			if (Command.Equals(TEXT("record"), ESearchCase::IgnoreCase))
+			{
+				Manager->StartJournalRecording();
+			}
+			else if (Command.Equals(TEXT("stop"), ESearchCase::IgnoreCase))
+			{
+				Manager->StopJournalRecording(Args.Num() > 1 ? Args[1] : FString());
+			}
+			else if (Command.Equals(TEXT("play"), ESearchCase::IgnoreCase) && Args.Num() > 1)
+			{
+				// Bare names resolve to Saved/TerraDyne/Journals
+				const FString Path = FPaths::FileExists(Args[1]) ? Args[1] : FTerraDyneEditJournal::GetJournalPath(Args[1]);
+				Manager->StartJournalReplay(Path, Args.Num() > 2 ? FCString::Atof(*Args[2]) : 0.0f);
+			}
+			else if (Command.Equals(TEXT("seek"), ESearchCase::IgnoreCase) && Args.Num() > 1)
+			{
+				Manager->SeekJournalReplay(FCString::Atof(*Args[1]));
+			}
+			else if (Command.Equals(TEXT("pause"), ESearchCase::IgnoreCase))
+			{
+				Manager->StopJournalReplay();
+			}
+			else if (Command.Equals(TEXT("resume"), ESearchCase::IgnoreCase))
+			{
+				if (!Manager->ResumeJournalReplay())
+				{
+					UE_LOG(LogTemp, Warning, TEXT("TerraDyneJournal: Nothing to resume (no journal loaded, or its replay finished)."));
+				}
+			}
+			else
+			{
+				UE_LOG(LogTemp, Warning, TEXT("TerraDyneJournal: Unknown subcommand '%s'."), *Command);
+			}
+		}));
@@ -0,0 +1,317 @@
+#include "Core/TerraDyneEditLatency.h"
+
+// Engine Includes
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<bool> CVarTerraDyneEditLatency(
+	TEXT("terradyne.EditLatency.Enable"),
+	true,
+	TEXT("Trace every ApplyGlobalBrush() through CPU, GPU, collision, grass and save stages."),
+	ECVF_Default);
+
+namespace TerraDyneEditLatency
+{
+	constexpr int32 NumStages = (int32)ETerraDyneEditStage::Num;
+	constexpr int32 NumBuckets = 20;        // < 1 ms ... >= 2^18 ms
+	constexpr int32 MaxSamples = 8192;      // Ring buffer per stage feeding the percentiles
+	constexpr int32 MaxOpenEdits = 16384;   // Oldest edits are dropped beyond this (e.g. never saved)
+
+	struct FRecord
+	{
+		double StartTime = 0.0;
+		int32 Pending[NumStages] = {};
+		bool bParticipated[NumStages] = {};
+		int32 OpenStages = NumStages;
+	};
+
+	struct FStageHistogram
+	{
+		TArray<float> Samples;
+		int32 NextSample = 0;
+		int64 Count = 0;
+		float MaxMs = 0.0f;
+		int64 Buckets[NumBuckets] = {};
+
+		void Add(float Ms)
+		{
+			if (Samples.Num() < MaxSamples)
+			{
+				Samples.Add(Ms);
+			}
+			else
+			{
+				Samples[NextSample] = Ms;
+				NextSample = (NextSample + 1) % MaxSamples;
+			}
+
+			Count++;
+			MaxMs = FMath::Max(MaxMs, Ms);
+
+			int32 Bucket = 0;
+			while (Bucket < NumBuckets - 1 && Ms >= (float)(1 << Bucket))
+			{
+				Bucket++;
+			}
+			Buckets[Bucket]++;
+		}
+	};
+
+	struct FState
+	{
+		FCriticalSection Mutex;
+		TMap<uint32, FRecord> Open;
+		uint32 NextEditId = 1;
+		uint32 OldestOpenId = 1;
+		FStageHistogram Stages[NumStages];
+
+		/** Resolves one hold on a stage; returns true once the record is finished. */
+		bool Release(FRecord& Record, int32 Stage, bool bReached)
+		{
+			if (Record.Pending[Stage] <= 0) return false;
+
+			Record.bParticipated[Stage] |= bReached;
+			if (--Record.Pending[Stage] > 0) return false;
+
+			if (Record.bParticipated[Stage])
+			{
+				Stages[Stage].Add((float)((FPlatformTime::Seconds() - Record.StartTime) * 1000.0));
+			}
+			return --Record.OpenStages == 0;
+		}
+	};
+
+	static FState& Get()
+	{
+		static FState State;
+		return State;
+	}
+}
+
+uint32 FTerraDyneEditLatency::CurrentEditId = 0;
+
+bool FTerraDyneEditLatency::IsEnabled()
+{
+	return CVarTerraDyneEditLatency.GetValueOnAnyThread();
+}
+
+uint32 FTerraDyneEditLatency::BeginEdit()
+{
+	using namespace TerraDyneEditLatency;
+	if (!IsEnabled()) return 0;
+
+	FState& State = Get();
+	FScopeLock Lock(&State.Mutex);
+
+	const uint32 EditId = State.NextEditId++;
+
+	// The scope holds every stage open, so chunks that finish instantly can't close it early
+	FRecord& Record = State.Open.Add(EditId);
+	Record.StartTime = FPlatformTime::Seconds();
+	for (int32 Stage = 0; Stage < NumStages; Stage++)
+	{
+		Record.Pending[Stage] = 1;
+	}
+
+	while (State.Open.Num() > MaxOpenEdits)
+	{
+		State.Open.Remove(State.OldestOpenId++);
+	}
+
+	CurrentEditId = EditId;
+	return EditId;
+}
+
+void FTerraDyneEditLatency::EndEdit(uint32 EditId)
+{
+	using namespace TerraDyneEditLatency;
+	CurrentEditId = 0;
+	if (EditId == 0) return;
+
+	FState& State = Get();
+	FScopeLock Lock(&State.Mutex);
+
+	FRecord* Record = State.Open.Find(EditId);
+	if (!Record) return;
+
+	bool bFinished = false;
+	for (int32 Stage = 0; Stage < NumStages; Stage++)
+	{
+		bFinished |= State.Release(*Record, Stage, Stage == (int32)ETerraDyneEditStage::CPUApplied);
+	}
+	if (bFinished)
+	{
+		State.Open.Remove(EditId);
+	}
+}
+
+void FTerraDyneEditLatency::AddPending(uint32 EditId, ETerraDyneEditStage Stage)
+{
+	using namespace TerraDyneEditLatency;
+	if (EditId == 0) return;
+
+	FState& State = Get();
+	FScopeLock Lock(&State.Mutex);
+
+	if (FRecord* Record = State.Open.Find(EditId))
+	{
+		// A stage that already resolved stays resolved
+		if (Record->Pending[(int32)Stage] > 0)
+		{
+			Record->Pending[(int32)Stage]++;
+		}
+	}
+}
+
+static void ReleaseEdits(TConstArrayView<uint32> EditIds, ETerraDyneEditStage Stage, bool bReached)
+{
+	using namespace TerraDyneEditLatency;
+	if (EditIds.Num() == 0) return;
+
+	FState& State = Get();
+	FScopeLock Lock(&State.Mutex);
+
+	for (uint32 EditId : EditIds)
+	{
+		FRecord* Record = State.Open.Find(EditId);
+		if (Record && State.Release(*Record, (int32)Stage, bReached))
+		{
+			State.Open.Remove(EditId);
+		}
+	}
+}
+
+void FTerraDyneEditLatency::Complete(TConstArrayView<uint32> EditIds, ETerraDyneEditStage Stage)
+{
+	ReleaseEdits(EditIds, Stage, true);
+}
+
+void FTerraDyneEditLatency::Abandon(TConstArrayView<uint32> EditIds, ETerraDyneEditStage Stage)
+{
+	ReleaseEdits(EditIds, Stage, false);
+}
+
+FTerraDyneEditLatency::FStageSummary FTerraDyneEditLatency::GetSummary(ETerraDyneEditStage Stage)
+{
+	using namespace TerraDyneEditLatency;
+
+	FState& State = Get();
+	FScopeLock Lock(&State.Mutex);
+	const FStageHistogram& Histogram = State.Stages[(int32)Stage];
+
+	FStageSummary Summary;
+	Summary.Count = Histogram.Count;
+	Summary.MaxMs = Histogram.MaxMs;
+	Summary.Buckets.Append(Histogram.Buckets, NumBuckets);
+
+	if (Histogram.Samples.Num() > 0)
+	{
+		TArray<float> Sorted = Histogram.Samples;
+		Sorted.Sort();
+
+		auto Percentile = [&Sorted](float P)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+			return Sorted[Index];
+		};
+		Summary.P50Ms = Percentile(0.50f);
+		Summary.P95Ms = Percentile(0.95f);
+		Summary.P99Ms = Percentile(0.99f);
+	}
+	return Summary;
+}
+
+void FTerraDyneEditLatency::Reset()
+{
+	using namespace TerraDyneEditLatency;
+
+	FState& State = Get();
+	FScopeLock Lock(&State.Mutex);
+	for (FStageHistogram& Histogram : State.Stages)
+	{
+		Histogram = FStageHistogram();
+	}
+}
+
+FString FTerraDyneEditLatency::ToJson()
+{
+	using namespace TerraDyneEditLatency;
+
+	FString Json = TEXT("{\n\t\"unit\": \"ms\",\n\t\"stages\": [\n");
+	for (int32 Stage = 0; Stage < NumStages; Stage++)
+	{
+		const FStageSummary Summary = GetSummary((ETerraDyneEditStage)Stage);
+
+		FString Buckets;
+		for (int32 i = 0; i < Summary.Buckets.Num(); i++)
+		{
+			Buckets += FString::Printf(TEXT("%s%lld"), i > 0 ? TEXT(", ") : TEXT(""), Summary.Buckets[i]);
+		}
+
+		Json += FString::Printf(
+			TEXT("\t\t{ \"stage\": \"%s\", \"count\": %lld, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"buckets_pow2_ms\": [%s] }%s\n"),
+			GetStageName((ETerraDyneEditStage)Stage), Summary.Count, Summary.P50Ms, Summary.P95Ms, Summary.P99Ms, Summary.MaxMs,
+			*Buckets, Stage < NumStages - 1 ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t]\n}\n");
+	return Json;
+}
+
+bool FTerraDyneEditLatency::ExportJson(const FString& Path)
+{
+	const FString FilePath = Path.IsEmpty() ? FPaths::ProfilingDir() / TEXT("TerraDyneEditLatency.json") : Path;
+	if (!FFileHelper::SaveStringToFile(ToJson(), *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneEditLatency: Failed to write %s"), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneEditLatency: Wrote %s"), *FilePath);
+	return true;
+}
+
+const TCHAR* FTerraDyneEditLatency::GetStageName(ETerraDyneEditStage Stage)
+{
+	switch (Stage)
+	{
+	case ETerraDyneEditStage::CPUApplied:    return TEXT("CPUApplied");
+	case ETerraDyneEditStage::GPUUploaded:   return TEXT("GPUUploaded");
+	case ETerraDyneEditStage::CollisionLive: return TEXT("CollisionLive");
+	case ETerraDyneEditStage::GrassUpdated:  return TEXT("GrassUpdated");
+	case ETerraDyneEditStage::Persisted:     return TEXT("Persisted");
+	default:                                 return TEXT("Unknown");
+	}
+}
+
+//--- Console ---//
+
+static FAutoConsoleCommand CmdTerraDyneEditLatency(
+	TEXT("terradyne.EditLatency"),
+	TEXT("Prints p50/p95/p99 edit latency per pipeline stage. 'terradyne.EditLatency reset' clears the histograms."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() > 0 && Args[0].Equals(TEXT("reset"), ESearchCase::IgnoreCase))
+			{
+				FTerraDyneEditLatency::Reset();
+				UE_LOG(LogTemp, Log, TEXT("TerraDyneEditLatency: Histograms reset."));
+				return;
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("TerraDyneEditLatency: %-14s %8s %10s %10s %10s %10s"), TEXT("Stage"), TEXT("Count"), TEXT("p50 ms"), TEXT("p95 ms"), TEXT("p99 ms"), TEXT("max ms"));
+			for (int32 Stage = 0; Stage < (int32)ETerraDyneEditStage::Num; Stage++)
+			{
+				const FTerraDyneEditLatency::FStageSummary Summary = FTerraDyneEditLatency::GetSummary((ETerraDyneEditStage)Stage);
+				UE_LOG(LogTemp, Log, TEXT("TerraDyneEditLatency: %-14s %8lld %10.2f %10.2f %10.2f %10.2f"),
+					FTerraDyneEditLatency::GetStageName((ETerraDyneEditStage)Stage), Summary.Count, Summary.P50Ms, Summary.P95Ms, Summary.P99Ms, Summary.MaxMs);
+			}
+		}));
+
+static FAutoConsoleCommand CmdTerraDyneEditLatencyExport(
+	TEXT("terradyne.EditLatency.Export"),
+	TEXT("Writes the edit latency histograms as JSON. Optional argument: file path (default Saved/Profiling/TerraDyneEditLatency.json)."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			FTerraDyneEditLatency::ExportJson(Args.Num() > 0 ? Args[0] : FString());
+		}));
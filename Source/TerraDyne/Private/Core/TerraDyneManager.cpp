@@ -1,230 +1,1729 @@
 #include "Core/TerraDyneManager.h" // MUST BE FIRST
 #include "Core/TerraDyneSubsystem.h"
+#include "Core/TerraDyneResampler.h"
+#include "IO/TerraDyneSerializer.h"
+#include "IO/TerraDyneRegionFile.h"
 #include "World/TerraDyneChunk.h"
 
 // Engine Includes
 #include "Landscape.h"
 #include "LandscapeComponent.h"
+#include "LandscapeDataAccess.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
-#include "UObject/UnrealType.h" 
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
 #include "Async/ParallelFor.h"
+#include "TimerManager.h"
+#include "Async/Async.h"
+#include "Engine/StreamableManager.h"
 
 ATerraDyneManager::ATerraDyneManager()
 {
-	PrimaryActorTick.bCanEverTick = false;
+	// Ticks only while the startup init queue has work
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 	GlobalChunkSize = 0.f;
 	ChunkClass = ATerraDyneChunk::StaticClass();
 	bAutoImportAtRuntime = true;
 }
 
+void ATerraDyneManager::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Runs for every level actor before any BeginPlay, so chunks see the mode before allocating
+	if (UWorld* World = GetWorld())
+	{
+		if (UTerraDyneSubsystem* Subsystem = World->GetSubsystem<UTerraDyneSubsystem>())
+		{
+			Subsystem->SetRenderModeOverride(RenderMode);
+		}
+	}
+}
+
 void ATerraDyneManager::BeginPlay()
 {
-	Super::BeginPlay();
+	Super::BeginPlay();
+
+	StartupBeginTime = FPlatformTime::Seconds();
+	StartupStats = FTerraDyneStartupStats();
+	StreamingStats = FTerraDyneStreamingStats();
+	MemoryStats = FTerraDyneMemoryStats();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UTerraDyneSubsystem* Subsystem = World->GetSubsystem<UTerraDyneSubsystem>())
+		{
+			Subsystem->RegisterManager(this);
+		}
+	}
+
+	// Index (and queue) chunks that began play before us; later ones register themselves
+	RebuildChunkMap();
+
+	if (ChunkPoolPrewarmCount > 0)
+	{
+		PrewarmChunkPool(ChunkPoolPrewarmCount);
+	}
+
+	if (TileStreamingInterval > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_ChunkStreaming, this, &ATerraDyneManager::UpdateChunkStreaming, TileStreamingInterval, true);
+	}
+
+	if (CollisionUpdateInterval > 0.0f && (bLazyCollision || CollisionLODDistances.Num() > 0))
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_CollisionStreaming, this, &ATerraDyneManager::UpdateCollisionStreaming, CollisionUpdateInterval, true);
+	}
+
+	if (bEnableMemoryBudget || HasMemoryAlarms())
+	{
+		GetWorldTimerManager().SetTimer(TimerHandle_MemoryBudget, this, &ATerraDyneManager::UpdateMemoryBudget, MemoryBudgetInterval, true);
+	}
+
+	// Auto-Import Check (only scans for a Landscape when there is no terrain at all)
+	if (bAutoImportAtRuntime && ChunkGrid.Num() == 0)
+	{
+		if (ALandscapeProxy* LandProxy = Cast<ALandscapeProxy>(UGameplayStatics::GetActorOfClass(GetWorld(), ALandscapeProxy::StaticClass())))
+		{
+#if WITH_EDITOR
+			ImportFromLandscape(LandProxy, true);
+#endif
+		}
+		else
+		{
+			SpawnDefaultSandboxChunk();
+		}
+	}
+}
+
+void ATerraDyneManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(TimerHandle_CollisionStreaming);
+	GetWorldTimerManager().ClearTimer(TimerHandle_ChunkStreaming);
+	GetWorldTimerManager().ClearTimer(TimerHandle_GPUFlush);
+	GetWorldTimerManager().ClearTimer(TimerHandle_MemoryBudget);
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UTerraDyneSubsystem* Subsystem = World->GetSubsystem<UTerraDyneSubsystem>())
+		{
+			Subsystem->UnregisterManager(this);
+		}
+	}
+
+	for (ATerraDyneChunk* Pooled : ChunkPool)
+	{
+		if (IsValid(Pooled))
+		{
+			Pooled->Destroy();
+		}
+	}
+	ChunkPool.Reset();
+	ChunkGrid.Reset();
+	InitQueue.Reset();
+	StreamingSources.Reset();
+	PendingSaveLoads.Reset();
+	ProbedSaveCells.Reset();
+	GPUDirtyChunks.Reset();
+	PendingJournalRestores.Reset();
+
+	// Queued save loads are skipped; the ones already reading find us gone
+	if (SaveLoadToken.IsValid())
+	{
+		SaveLoadToken->Cancel();
+		SaveLoadToken.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ATerraDyneManager::SpawnDefaultSandboxChunk()
+{
+	GlobalChunkSize = 10000.0f;
+
+	if (AcquireChunk(FIntPoint(0, 0)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyne Automation: Sandbox Chunk Spawned."));
+	}
+}
+
+//--- Pooling ---//
+
+void ATerraDyneManager::InjectMaterials(ATerraDyneChunk* Chunk, bool bOverride) const
+{
+	if (!Chunk) return;
+
+	const bool bHasVisualMaterial = Chunk->VisualMesh && Chunk->VisualMesh->GetMaterial(0);
+	if (MasterMaterial && (bOverride || !bHasVisualMaterial)) Chunk->SetMaterial(MasterMaterial);
+	if (HeightBrushMaterial && (bOverride || !Chunk->BrushMaterialBase)) Chunk->BrushMaterialBase = HeightBrushMaterial;
+	if (WeightBrushMaterial && (bOverride || !Chunk->PaintMaterialBase)) Chunk->PaintMaterialBase = WeightBrushMaterial;
+}
+
+ATerraDyneChunk* ATerraDyneManager::SpawnPooledChunk()
+{
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters Params;
+	Params.bDeferConstruction = true;
+	Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ATerraDyneChunk* Chunk = World->SpawnActor<ATerraDyneChunk>(ChunkClass, FTransform::Identity, Params);
+	if (!Chunk) return nullptr;
+
+	// Build RTs, height buffer and collision topology once, up front
+	const float Size = GlobalChunkSize > 0.0f ? GlobalChunkSize : Chunk->ChunkSizeWorldUnits;
+	Chunk->InitializeChunk(FIntPoint(0, 0), Size, PooledChunkResolution, nullptr);
+	InjectMaterials(Chunk);
+	if (!UsesLazyCollision())
+	{
+		Chunk->RebuildPhysicsMesh();
+	}
+
+	// Park before BeginPlay so the registration skips the spatial index
+	Chunk->ReturnToPool();
+	Chunk->FinishSpawning(FTransform::Identity);
+
+	return Chunk;
+}
+
+void ATerraDyneManager::PrewarmChunkPool(int32 Count)
+{
+	Count = FMath::Min(Count, ChunkPoolMaxSize);
+	while (ChunkPool.Num() < Count)
+	{
+		ATerraDyneChunk* Chunk = SpawnPooledChunk();
+		if (!Chunk) break;
+		ChunkPool.Add(Chunk);
+	}
+}
+
+ATerraDyneChunk* ATerraDyneManager::AcquireChunk(FIntPoint GridCoord)
+{
+	if (GlobalChunkSize <= 0.0f) return nullptr;
+
+	// One chunk per cell: a second one would shadow the first in the grid
+	if (ATerraDyneChunk* Existing = ChunkGrid.Find(GridCoord))
+	{
+		return Existing;
+	}
+
+	ATerraDyneChunk* Chunk = nullptr;
+	while (!Chunk && ChunkPool.Num() > 0)
+	{
+		Chunk = ChunkPool.Pop(EAllowShrinking::No);
+		if (!IsValid(Chunk)) Chunk = nullptr;
+	}
+
+	if (!Chunk)
+	{
+		Chunk = SpawnPooledChunk();
+		if (!Chunk) return nullptr;
+	}
+
+	// Chunk meshes are centered on the actor; grid cell X covers [X, X+1) * GlobalChunkSize
+	const FVector Location((GridCoord.X + 0.5) * GlobalChunkSize, (GridCoord.Y + 0.5) * GlobalChunkSize, 0.0);
+	Chunk->ActivateFromPool(GridCoord, Location, GlobalChunkSize, PooledChunkResolution, !UsesLazyCollision());
+	InjectMaterials(Chunk);
+
+	RegisterChunk(Chunk);
+	return Chunk;
+}
+
+void ATerraDyneManager::ReleaseChunk(ATerraDyneChunk* Chunk)
+{
+	if (!IsValid(Chunk) || Chunk->IsPooled()) return;
+
+	UnregisterChunk(Chunk);
+
+	if (ChunkPool.Num() >= ChunkPoolMaxSize)
+	{
+		Chunk->Destroy();
+		return;
+	}
+
+	Chunk->ReturnToPool();
+	ChunkPool.Add(Chunk);
+}
+
+void ATerraDyneManager::ApplyGlobalBrush(FVector WorldLocation, float Radius, float Strength, bool bIsHole, int32 PaintLayer)
+{
+	if (GlobalChunkSize <= 0.0f)
+	{
+		RebuildChunkMap();
+		if (GlobalChunkSize <= 0) return;
+	}
+
+	// Recording: apply the quantized edit, so the live terrain matches its replay exactly
+	const bool bRecord = RecordingJournal.IsValid() && !bApplyingJournalEdit;
+	FTerraDyneJournalEdit JournalEdit;
+	if (bRecord)
+	{
+		const double JournalSeconds = GetWorld()->GetTimeSeconds() - JournalRecordStartTime;
+		JournalEdit.Tick = (uint32)FMath::Max(0, FMath::RoundToInt32(JournalSeconds * RecordingJournal->GetTickRate()));
+		JournalEdit.Position = FVector2D(WorldLocation.X, WorldLocation.Y);
+		JournalEdit.Radius = Radius;
+		JournalEdit.Strength = Strength;
+		JournalEdit.bIsHole = bIsHole;
+		JournalEdit.PaintLayer = PaintLayer;
+		JournalEdit = FTerraDyneEditJournal::Quantize(JournalEdit);
+
+		WorldLocation.X = JournalEdit.Position.X;
+		WorldLocation.Y = JournalEdit.Position.Y;
+		Radius = JournalEdit.Radius;
+		Strength = JournalEdit.Strength;
+		PaintLayer = JournalEdit.PaintLayer;
+	}
+
+	FBox2D BrushBounds(
+		FVector2D(WorldLocation.X - Radius, WorldLocation.Y - Radius),
+		FVector2D(WorldLocation.X + Radius, WorldLocation.Y + Radius)
+	);
+
+	const FIntPoint Min(FMath::FloorToInt(BrushBounds.Min.X / GlobalChunkSize), FMath::FloorToInt(BrushBounds.Min.Y / GlobalChunkSize));
+	const FIntPoint Max(FMath::FloorToInt(BrushBounds.Max.X / GlobalChunkSize), FMath::FloorToInt(BrushBounds.Max.Y / GlobalChunkSize));
+
+	if (bRecord)
+	{
+		RecordJournalEdit(JournalEdit, Min, Max);
+	}
+
+	// Every chunk touched below tags its derived products with this edit's ID
+	FTerraDyneEditLatency::FScope LatencyScope;
+
+	ChunkGrid.ForEachInRect(Min, Max, [&](FIntPoint, ATerraDyneChunk* Chunk)
+		{
+			// Edits can't wait for the startup queue or the tile stream
+			Chunk->RunStartupInit();
+			Chunk->FlushTileData();
+
+			FVector LocalPos = WorldLocation - Chunk->GetActorLocation();
+			Chunk->ApplyLocalIdempotentEdit(LocalPos, Radius, Strength, bIsHole, PaintLayer);
+		});
+}
+
+//--- Edit Journal ---//
+
+void ATerraDyneManager::StartJournalRecording()
+{
+	RecordingJournal = MakeUnique<FTerraDyneEditJournal>();
+	JournalRecordStartTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+	LastJournalKeyframeTick = 0;
+	JournalKeyframeIntervalScale = 1;
+	JournalDirtyChunks.Reset();
+	JournalParkedStates.Reset();
+	if (!JournalJobs.IsValid())
+	{
+		JournalJobs = MakeShared<FTerraDyneJobGroup, ESPMode::ThreadSafe>();
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneJournal: Recording started."));
+}
+
+FString ATerraDyneManager::StopJournalRecording(const FString& Name)
+{
+	if (!RecordingJournal.IsValid()) return FString();
+
+	TUniquePtr<FTerraDyneEditJournal> Journal = MoveTemp(RecordingJournal);
+	JournalDirtyChunks.Reset();
+	JournalParkedStates.Reset();
+
+	// The last states may still be compressing
+	JournalJobs->Wait();
+
+	const FString Path = FTerraDyneEditJournal::GetJournalPath(Name.IsEmpty() ? FDateTime::Now().ToString() : Name);
+	if (!Journal->SaveToFile(Path)) return FString();
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneJournal: Wrote %s: %d edits over %.1f s, %lld stream bytes (%.1f per edit), %d base chunks, %d keyframes, %.1f KB in memory."),
+		*Path, Journal->GetNumEdits(), Journal->GetLastTick() / Journal->GetTickRate(), Journal->GetStreamBytes(),
+		Journal->GetNumEdits() > 0 ? (double)Journal->GetStreamBytes() / Journal->GetNumEdits() : 0.0,
+		Journal->GetBaseStates().Num(), Journal->GetNumKeyframes(), Journal->GetAllocatedSize() / 1024.0);
+	return Path;
+}
+
+void ATerraDyneManager::RecordJournalEdit(const FTerraDyneJournalEdit& Edit, FIntPoint Min, FIntPoint Max)
+{
+	FTerraDyneEditJournal& Journal = *RecordingJournal;
+
+	// Keyframe the state before this edit once enough journal time has passed
+	const uint32 Interval = (uint32)FMath::Max(1, FMath::RoundToInt(JournalKeyframeInterval * Journal.GetTickRate())) * JournalKeyframeIntervalScale;
+	if (Journal.GetNumEdits() > 0 && Edit.Tick - LastJournalKeyframeTick >= Interval)
+	{
+		// Only chunks edited since the last keyframe are captured again; the rest share its bytes
+		TMap<FIntPoint, FTerraDyneEditJournal::FChunkState> Chunks;
+		Chunks.Reserve(Journal.GetBaseStates().Num());
+		for (const TPair<FIntPoint, FTerraDyneEditJournal::FChunkState>& Base : Journal.GetBaseStates())
+		{
+			ATerraDyneChunk* Chunk = JournalDirtyChunks.Contains(Base.Key) ? ChunkGrid.Find(Base.Key) : nullptr;
+			if (Chunk)
+			{
+				Chunks.Add(Base.Key, CaptureChunkState(Chunk));
+			}
+			else if (const FTerraDyneEditJournal::FChunkState* Parked = JournalParkedStates.Find(Base.Key))
+			{
+				Chunks.Add(Base.Key, *Parked);
+			}
+			else
+			{
+				Chunks.Add(Base.Key, *Journal.FindLatestState(Base.Key));
+			}
+		}
+		JournalDirtyChunks.Reset();
+		JournalParkedStates.Reset();
+
+		Journal.AddKeyframe(Edit.Tick).Chunks = MoveTemp(Chunks);
+		LastJournalKeyframeTick = Edit.Tick;
+
+		// Long recordings: keep seeking cheap without keeping every keyframe
+		if (Journal.GetNumKeyframes() > JournalMaxKeyframes)
+		{
+			Journal.ThinKeyframes();
+			JournalKeyframeIntervalScale *= 2;
+		}
+	}
+
+	// First touch: remember the chunk as it was before any recorded edit
+	ChunkGrid.ForEachInRect(Min, Max, [&](FIntPoint Coord, ATerraDyneChunk* Chunk)
+		{
+			JournalDirtyChunks.Add(Coord);
+			if (Journal.HasBaseState(Coord)) return;
+
+			Chunk->RunStartupInit();
+			Chunk->FlushTileData();
+			Journal.AddBaseState(Coord, CaptureChunkState(Chunk));
+		});
+
+	Journal.Append(Edit);
+}
+
+bool ATerraDyneManager::StartJournalReplay(const FString& Path, float Speed)
+{
+	TUniquePtr<FTerraDyneEditJournal> Journal = MakeUnique<FTerraDyneEditJournal>();
+	if (!Journal->LoadFromFile(Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneJournal: Could not load %s"), *Path);
+		return false;
+	}
+
+	ReplayJournal = MoveTemp(Journal);
+	ReplaySpeed = FMath::Max(Speed, 0.0f);
+	ReplayCursor = RestoreJournalKeyframe(0);
+	ReplayTick = 0.0;
+	ReplayWallStartTime = FPlatformTime::Seconds();
+	bReplayPlaying = true;
+	SetActorTickEnabled(true);
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneJournal: Replaying %s (%d edits over %.1f s) at %s."), *Path,
+		ReplayJournal->GetNumEdits(), ReplayJournal->GetLastTick() / ReplayJournal->GetTickRate(),
+		ReplaySpeed > 0.0f ? *FString::Printf(TEXT("%.1fx"), ReplaySpeed) : TEXT("full speed"));
+	return true;
+}
+
+void ATerraDyneManager::SeekJournalReplay(float Seconds)
+{
+	if (!ReplayJournal.IsValid()) return;
+
+	const uint32 TargetTick = (uint32)FMath::Max(0, FMath::FloorToInt(Seconds * ReplayJournal->GetTickRate()));
+	ReplayCursor = RestoreJournalKeyframe(TargetTick);
+	ApplyJournalEditsUntil(TargetTick, 0.0);
+	ReplayTick = TargetTick;
+}
+
+void ATerraDyneManager::StopJournalReplay()
+{
+	bReplayPlaying = false;
+}
+
+bool ATerraDyneManager::ResumeJournalReplay()
+{
+	if (!ReplayJournal.IsValid() || ReplayCursor.EditIndex >= ReplayJournal->GetNumEdits()) return false;
+
+	bReplayPlaying = true;
+	SetActorTickEnabled(true);
+	return true;
+}
+
+void ATerraDyneManager::TickJournalReplay(float DeltaSeconds)
+{
+	if (!ReplayJournal.IsValid() || !bReplayPlaying) return;
+
+	const double Deadline = FPlatformTime::Seconds() + JournalReplayBudgetMs / 1000.0;
+	const double TargetTick = ReplaySpeed > 0.0f ? ReplayTick + DeltaSeconds * ReplaySpeed * ReplayJournal->GetTickRate() : TNumericLimits<double>::Max();
+
+	// Behind schedule when the budget ran out: resume from the last applied edit next frame
+	const bool bCaughtUp = ApplyJournalEditsUntil(TargetTick, Deadline);
+	ReplayTick = (bCaughtUp && ReplaySpeed > 0.0f) ? TargetTick : (double)ReplayCursor.Tick;
+
+	if (ReplayCursor.EditIndex >= ReplayJournal->GetNumEdits())
+	{
+		bReplayPlaying = false;
+
+		const double WallSeconds = FPlatformTime::Seconds() - ReplayWallStartTime;
+		const double JournalSeconds = ReplayJournal->GetLastTick() / ReplayJournal->GetTickRate();
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneJournal: Replay finished: %d edits, %.1f s of journal in %.2f s (%.1fx real time)."),
+			ReplayJournal->GetNumEdits(), JournalSeconds, WallSeconds, WallSeconds > 0.0 ? JournalSeconds / WallSeconds : 0.0);
+	}
+}
+
+bool ATerraDyneManager::ApplyJournalEditsUntil(double TargetTick, double Deadline)
+{
+	TGuardValue<bool> ReplayGuard(bApplyingJournalEdit, true);
+
+	FTerraDyneJournalEdit Edit;
+	FTerraDyneEditJournal::FCursor Next = ReplayCursor;
+	while (ReplayJournal->ReadNext(Next, Edit))
+	{
+		if (Edit.Tick > TargetTick) return true;
+		if (Deadline > 0.0 && FPlatformTime::Seconds() > Deadline) return false;
+
+		ApplyGlobalBrush(FVector(Edit.Position, 0.0), Edit.Radius, Edit.Strength, Edit.bIsHole, Edit.PaintLayer);
+		ReplayCursor = Next;
+	}
+	return true;
+}
+
+FTerraDyneEditJournal::FCursor ATerraDyneManager::RestoreJournalKeyframe(uint32 Tick)
+{
+	// Chunks missing from the keyframe were not touched before it, so they are still at their base state
+	PendingJournalRestores.Reset();
+	const FTerraDyneEditJournal::FKeyframe* Keyframe = ReplayJournal->FindKeyframe(Tick);
+	for (const TPair<FIntPoint, FTerraDyneEditJournal::FChunkState>& Base : ReplayJournal->GetBaseStates())
+	{
+		const FTerraDyneEditJournal::FChunkState* State = Keyframe ? Keyframe->Chunks.Find(Base.Key) : nullptr;
+		RestoreChunkState(Base.Key, State ? *State : Base.Value);
+	}
+	return Keyframe ? Keyframe->Cursor : FTerraDyneEditJournal::FCursor();
+}
+
+FTerraDyneEditJournal::FChunkState ATerraDyneManager::CaptureChunkState(ATerraDyneChunk* Chunk)
+{
+	// The Game Thread only pays for the copy out of the caches
+	FTerraDyneChunkSnapshot Snapshot;
+	Chunk->CaptureSnapshot(Snapshot);
+
+	FTerraDyneEditJournal::FChunkState State = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+	FTerraDyneWorkerPool::Get().Launch(ETerraDyneJobPriority::Save,
+		[Snapshot = MoveTemp(Snapshot), State](const FTerraDyneCancellationToken&) mutable
+		{
+			// Failure leaves the bytes empty, which restores as nothing
+			UTerraDyneSerializer::SerializeToBytes(Snapshot, State.Get());
+			Snapshot.ReturnBuffers();
+		}, nullptr, JournalJobs);
+	return State;
+}
+
+void ATerraDyneManager::RestoreChunkState(FIntPoint Coord, const FTerraDyneEditJournal::FChunkState& State)
+{
+	ATerraDyneChunk* Chunk = ChunkGrid.Find(Coord);
+	if (!Chunk)
+	{
+		PendingJournalRestores.Add(Coord, State);
+		return;
+	}
+
+	// Chunk still waiting for its own init would overwrite the restored state
+	Chunk->RunStartupInit();
+	Chunk->FlushTileData();
+
+	FTerraDyneChunkSnapshot Snapshot;
+	if (UTerraDyneSerializer::DeserializeFromBytes(State.Get(), Snapshot))
+	{
+		Chunk->ApplySnapshot(MoveTemp(Snapshot));
+	}
+	else
+	{
+		Snapshot.ReturnBuffers();
+	}
+}
+
+FIntPoint ATerraDyneManager::WorldToGrid(const FVector& WorldLocation) const
+{
+	return FIntPoint(
+		FMath::FloorToInt(WorldLocation.X / GlobalChunkSize),
+		FMath::FloorToInt(WorldLocation.Y / GlobalChunkSize)
+	);
+}
+
+ATerraDyneChunk* ATerraDyneManager::GetChunkAtLocation(FVector WorldLocation)
+{
+	if (GlobalChunkSize <= 0) return nullptr;
+
+	return ChunkGrid.Find(WorldToGrid(WorldLocation));
+}
+
+ATerraDyneChunk* ATerraDyneManager::GetChunkAtCoordinate(FIntPoint GridCoord) const
+{
+	return ChunkGrid.Find(GridCoord);
+}
+
+void ATerraDyneManager::GetChunksInBounds(FBox2D WorldBounds, TArray<ATerraDyneChunk*>& OutChunks) const
+{
+	if (GlobalChunkSize <= 0) return;
+
+	const FIntPoint Min = WorldToGrid(FVector(WorldBounds.Min, 0.0));
+	const FIntPoint Max = WorldToGrid(FVector(WorldBounds.Max, 0.0));
+
+	ChunkGrid.ForEachInRect(Min, Max, [&](FIntPoint, ATerraDyneChunk* Chunk)
+		{
+			OutChunks.Add(Chunk);
+		});
+}
+
+void ATerraDyneManager::RebuildChunkMap()
+{
+	ChunkGrid.Reset();
+
+	UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	if (!Subsystem) return;
+
+	for (ATerraDyneChunk* Chunk : Subsystem->GetRegisteredChunks())
+	{
+		RegisterChunk(Chunk);
+	}
+}
+
+//--- Startup Queue ---//
+
+void ATerraDyneManager::QueueChunkInit(ATerraDyneChunk* Chunk)
+{
+	if (Chunk->bStartupInitQueued) return;
+
+	Chunk->bStartupInitQueued = true;
+	InitQueue.Add(Chunk);
+	bInitQueueNeedsSort = true;
+
+	SetActorTickEnabled(true);
+}
+
+void ATerraDyneManager::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	ProcessInitQueue();
+	TickJournalReplay(DeltaSeconds);
+
+	if (InitQueue.Num() == 0 && !IsReplayingJournal())
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void ATerraDyneManager::ProcessInitQueue()
+{
+	if (InitQueue.Num() == 0) return;
+
+	const double FrameStart = FPlatformTime::Seconds();
+	const double Budget = StartupBudgetMs / 1000.0;
+
+	if (bInitQueueNeedsSort)
+	{
+		// Nearest-first, stored back to front so batches pop off the end
+		TArray<FVector> Sources;
+		if (UTerraDyneSubsystem* Subsystem = GetWorld()->GetSubsystem<UTerraDyneSubsystem>())
+		{
+			Subsystem->GatherPhysicsSourceLocations(Sources);
+		}
+
+		if (Sources.Num() > 0)
+		{
+			auto DistSq = [&Sources](const TWeakObjectPtr<ATerraDyneChunk>& Entry)
+				{
+					const ATerraDyneChunk* Chunk = Entry.Get();
+					if (!Chunk) return 0.0;
+
+					double Best = TNumericLimits<double>::Max();
+					for (const FVector& Source : Sources)
+					{
+						Best = FMath::Min(Best, FVector::DistSquaredXY(Source, Chunk->GetActorLocation()));
+					}
+					return Best;
+				};
+
+			InitQueue.Sort([&DistSq](const TWeakObjectPtr<ATerraDyneChunk>& A, const TWeakObjectPtr<ATerraDyneChunk>& B)
+				{
+					return DistSq(A) > DistSq(B);
+				});
+		}
+		bInitQueueNeedsSort = false;
+	}
+
+	// One tile decode of a batch: filled on a worker, handed to its chunk on the Game Thread
+	struct FTileDecode
+	{
+		const UTerraDyneTileData* Tile = nullptr;
+		const TArray<uint16>* QuantizedHeights = nullptr;
+		const TArray<FColor>* TileWeights = nullptr;
+		float ZScale = 0.0f;
+		TArray<float> Heights;
+		TArray<FColor> Weights;
+		uint64 Hash = 0;
+	};
+
+	TArray<ATerraDyneChunk*> Batch;
+	TArray<FTileDecode> Decodes;
+	Batch.Reserve(StartupBatchSize);
+	Decodes.Reserve(StartupBatchSize);
+
+	while (InitQueue.Num() > 0 && (FPlatformTime::Seconds() - FrameStart) < Budget)
+	{
+		Batch.Reset();
+		Decodes.Reset();
+		while (InitQueue.Num() > 0 && Batch.Num() < StartupBatchSize)
+		{
+			ATerraDyneChunk* Chunk = InitQueue.Pop(EAllowShrinking::No).Get();
+			if (IsValid(Chunk) && Chunk->IsStartupInitPending())
+			{
+				Batch.Add(Chunk);
+				FTileDecode& Decode = Decodes.AddDefaulted_GetRef();
+				Decode.Tile = Chunk->LinkedTileData.Get(); // Resolved here (null if not streamed yet)
+				Decode.QuantizedHeights = Decode.Tile ? &Decode.Tile->InitialHeightMap : nullptr;
+				Decode.TileWeights = Decode.Tile ? &Decode.Tile->InitialWeightMap : nullptr;
+				Decode.ZScale = Chunk->ZScale;
+			}
+		}
+		if (Batch.Num() == 0) break;
+
+		// Worker half: dequantize every tile of the batch at once. Workers get the payload arrays resolved
+		// above (nothing mutates or collects them while we wait here) and write only their own FTileDecode.
+		const double DequantizeStart = FPlatformTime::Seconds();
+		ParallelFor(Decodes.Num(), [&Decodes](int32 Index)
+			{
+				FTileDecode& Decode = Decodes[Index];
+				if (Decode.QuantizedHeights)
+				{
+					Decode.Hash = ATerraDyneChunk::DequantizeTile(*Decode.QuantizedHeights, *Decode.TileWeights, Decode.ZScale, Decode.Heights, Decode.Weights);
+				}
+			});
+		StartupStats.DequantizeMs += (float)((FPlatformTime::Seconds() - DequantizeStart) * 1000.0);
+
+		// Game Thread half: caches, RTs, uploads and (deferred) collision
+		for (int32 Index = 0; Index < Batch.Num(); Index++)
+		{
+			FTileDecode& Decode = Decodes[Index];
+			if (Decode.Tile)
+			{
+				Batch[Index]->AdoptDecodedTile(MoveTemp(Decode.Heights), MoveTemp(Decode.Weights), Decode.Tile->Resolution, Decode.Tile->RealWorldSize, Decode.Hash);
+			}
+			Batch[Index]->FinishStartupInit();
+		}
+		StartupStats.ChunksInitialized += Batch.Num();
+	}
+
+	StartupStats.GameThreadMs += (float)((FPlatformTime::Seconds() - FrameStart) * 1000.0);
+	StartupStats.FramesUsed++;
+
+	UpdateStartupMilestones();
+}
+
+void ATerraDyneManager::UpdateStartupMilestones()
+{
+	// Level chunks usually begin play (and queue) after us: an empty queue before the first batch means nothing yet
+	if (StartupStats.ChunksInitialized == 0) return;
+
+	const float Elapsed = (float)(FPlatformTime::Seconds() - StartupBeginTime);
+
+	if (StartupStats.TimeToFirstPlayableSeconds < 0.0f)
+	{
+		// Playable once every player stands on an initialized chunk (or nothing is left to wait for)
+		bool bPlayable = InitQueue.Num() == 0;
+		if (!bPlayable)
+		{
+			TArray<FVector> Sources;
+			if (UTerraDyneSubsystem* Subsystem = GetWorld()->GetSubsystem<UTerraDyneSubsystem>())
+			{
+				Subsystem->GatherPhysicsSourceLocations(Sources);
+			}
+
+			if (Sources.Num() > 0)
+			{
+				bPlayable = true;
+				for (const FVector& Source : Sources)
+				{
+					const ATerraDyneChunk* Chunk = ChunkGrid.Find(WorldToGrid(Source));
+					if (Chunk && Chunk->IsStartupInitPending())
+					{
+						bPlayable = false;
+						break;
+					}
+				}
+			}
+		}
+
+		if (bPlayable)
+		{
+			StartupStats.TimeToFirstPlayableSeconds = Elapsed;
+			UE_LOG(LogTemp, Log, TEXT("TerraDyneManager: First playable frame after %.3f s (%d chunk(s) still queued)."), Elapsed, InitQueue.Num());
+		}
+	}
+
+	if (StartupStats.TimeToFullyLoadedSeconds < 0.0f && InitQueue.Num() == 0)
+	{
+		StartupStats.TimeToFullyLoadedSeconds = Elapsed;
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneManager: Startup finished in %.3f s - %d chunk(s) over %d frame(s), %.2f ms Game Thread, %.2f ms dequantize."),
+			Elapsed, StartupStats.ChunksInitialized, StartupStats.FramesUsed, StartupStats.GameThreadMs, StartupStats.DequantizeMs);
+	}
+}
+
+//--- Memory Budget ---//
+
+bool ATerraDyneManager::IsInAnyView(const FBox& Bounds) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return false;
+
+	const FVector Center = Bounds.GetCenter();
+	const double Radius = Bounds.GetExtent().Size();
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC || !PC->IsLocalController()) continue;
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+		const FVector ToCenter = Center - ViewLocation;
+		const double Dist = ToCenter.Size();
+		if (Dist <= Radius) return true;
+
+		// Horizontal FOV is the wide one; the bounding sphere widens the cone
+		const float FOV = PC->PlayerCameraManager ? PC->PlayerCameraManager->GetFOVAngle() : 90.0f;
+		const double HalfAngle = FMath::DegreesToRadians(FOV * 0.5f) + FMath::Asin(FMath::Min(Radius / Dist, 1.0));
+		if (HalfAngle >= UE_PI || FVector::DotProduct(ViewRotation.Vector(), ToCenter / Dist) >= FMath::Cos(HalfAngle))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void ATerraDyneManager::UpdateMemoryBudget()
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	const double Now = World->GetTimeSeconds();
+	const float HalfSize = GlobalChunkSize * 0.5f;
+	const int32 ColdCollisionLOD = CollisionLODDistances.Num();
+	const int64 ChunkWarningBytes = (int64)(ChunkMemoryWarningMB * 1024.0 * 1024.0);
+
+	int64 TotalBytes = 0;
+	int32 NumCompressed = 0;
+	FTerraDyneChunkMemory Categories;
+	TArray<TPair<double, ATerraDyneChunk*>> ColdChunks;
+
+	ChunkGrid.ForEach([&](FIntPoint Coord, ATerraDyneChunk* Chunk)
+		{
+			const FVector Center = Chunk->GetActorLocation();
+			const FBox Bounds(Center - FVector(HalfSize), Center + FVector(HalfSize));
+			const bool bNearView = IsWithinGPUUpdateDistance(Center, HalfSize) || IsInAnyView(Bounds);
+
+			if (Chunk->AreCachesCompressed() && bNearView)
+			{
+				// Rehydrate ahead of the edits and collision builds that come with a nearby viewer
+				Chunk->EnsureResident();
+			}
+
+			const FTerraDyneChunkMemory Memory = Chunk->GetMemoryBreakdown();
+			const int64 ChunkBytes = Memory.GetTotal();
+			TotalBytes += ChunkBytes;
+			Categories += Memory;
+
+			if (ChunkWarningBytes > 0)
+			{
+				if (ChunkBytes > ChunkWarningBytes)
+				{
+					bool bAlreadyOver = false;
+					ChunksOverMemoryWarning.Add(Coord, &bAlreadyOver);
+					if (!bAlreadyOver)
+					{
+						UE_LOG(LogTemp, Warning, TEXT("TerraDyneManager: Chunk %s holds %.2f MB (warning at %.2f MB)."),
+							*Coord.ToString(), ChunkBytes / (1024.0 * 1024.0), ChunkMemoryWarningMB);
+					}
+				}
+				else
+				{
+					ChunksOverMemoryWarning.Remove(Coord);
+				}
+			}
+
+			if (!bEnableMemoryBudget) return;
+
+			if (Chunk->AreCachesCompressed())
+			{
+				NumCompressed++;
+				return;
+			}
+
+			const double LastTouch = Chunk->GetLastTouchTime();
+			if (!bNearView && Now - LastTouch > ColdChunkSeconds)
+			{
+				ColdChunks.Emplace(LastTouch, Chunk);
+			}
+		});
+
+	const int64 BudgetBytes = (int64)(MemoryBudgetMB * 1024.0 * 1024.0);
+	if (bEnableMemoryBudget && TotalBytes > BudgetBytes && ColdChunks.Num() > 0)
+	{
+		// Coldest first
+		ColdChunks.Sort([](const TPair<double, ATerraDyneChunk*>& A, const TPair<double, ATerraDyneChunk*>& B) { return A.Key < B.Key; });
+
+		const int32 MaxCompressions = FMath::Min(ColdChunks.Num(), MaxCompressionsPerPass);
+		for (int32 i = 0; i < MaxCompressions && TotalBytes > BudgetBytes; i++)
+		{
+			ATerraDyneChunk* Chunk = ColdChunks[i].Value;
+			const FTerraDyneChunkMemory Before = Chunk->GetMemoryBreakdown();
+			if (Chunk->CompressCaches(ColdCollisionLOD))
+			{
+				const FTerraDyneChunkMemory After = Chunk->GetMemoryBreakdown();
+				for (int32 Category = 0; Category < (int32)ETerraDyneMemoryCategory::Num; Category++)
+				{
+					Categories.Bytes[Category] += After.Bytes[Category] - Before.Bytes[Category];
+				}
+				TotalBytes -= Before.GetTotal() - After.GetTotal();
+				NumCompressed++;
+				MemoryStats.Compressions++;
+			}
+		}
+	}
+
+	Categories += GetPooledChunkMemory();
+
+	const FTerraDyneBufferPoolStats PoolStats = FTerraDyneSaveBuffers::GetStats();
+
+	MemoryStats.ResidentBytes = TotalBytes;
+	MemoryStats.CompressedChunks = NumCompressed;
+	MemoryStats.CacheBytes = Categories[ETerraDyneMemoryCategory::Caches] + Categories[ETerraDyneMemoryCategory::Compressed];
+	MemoryStats.RenderTargetBytes = Categories[ETerraDyneMemoryCategory::RenderTargets];
+	MemoryStats.CollisionBytes = Categories[ETerraDyneMemoryCategory::CollisionMesh] + Categories[ETerraDyneMemoryCategory::CookedCollision];
+	MemoryStats.GrassBytes = Categories[ETerraDyneMemoryCategory::Grass];
+	MemoryStats.SaveBytes = FTerraDyneSaveBuffers::GetInFlightBytes() + PoolStats.PooledBytes;
+	MemoryStats.TotalBytes = Categories.GetTotal() + MemoryStats.SaveBytes;
+
+	UpdateMemoryAlarms();
+}
+
+void ATerraDyneManager::UpdateMemoryAlarms()
+{
+	const int64 WarningBytes = (int64)(MemoryWarningMB * 1024.0 * 1024.0);
+	const int64 CriticalBytes = (int64)(MemoryCriticalMB * 1024.0 * 1024.0);
+	const int64 Total = MemoryStats.TotalBytes;
+
+	// Raise at the threshold, clear only below 90% of it, so a total hovering at the line doesn't flap
+	auto IsOver = [Total](int64 Threshold, bool bActive)
+	{
+		return Threshold > 0 && (bActive ? Total * 10 >= Threshold * 9 : Total >= Threshold);
+	};
+
+	const ETerraDyneMemoryAlarm Previous = MemoryStats.AlarmLevel;
+	ETerraDyneMemoryAlarm Level = ETerraDyneMemoryAlarm::None;
+	if (IsOver(CriticalBytes, Previous == ETerraDyneMemoryAlarm::Critical))
+	{
+		Level = ETerraDyneMemoryAlarm::Critical;
+	}
+	else if (IsOver(WarningBytes, Previous != ETerraDyneMemoryAlarm::None))
+	{
+		Level = ETerraDyneMemoryAlarm::Warning;
+	}
+
+	if (Level == Previous) return;
+	MemoryStats.AlarmLevel = Level;
+
+	const double TotalMB = Total / (1024.0 * 1024.0);
+	const int64 Threshold = Level == ETerraDyneMemoryAlarm::Critical ? CriticalBytes : WarningBytes;
+	switch (Level)
+	{
+	case ETerraDyneMemoryAlarm::Critical:
+		UE_LOG(LogTemp, Error, TEXT("TerraDyneManager: Memory CRITICAL: %.2f MB (threshold %.2f MB). Run terradyne.MemReport for a breakdown."), TotalMB, MemoryCriticalMB);
+		break;
+	case ETerraDyneMemoryAlarm::Warning:
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneManager: Memory warning: %.2f MB (threshold %.2f MB). Run terradyne.MemReport for a breakdown."), TotalMB, MemoryWarningMB);
+		break;
+	default:
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneManager: Memory back under budget: %.2f MB."), TotalMB);
+		break;
+	}
+
+	OnMemoryAlarm.Broadcast(Level, Total, Threshold);
+}
+
+FTerraDyneChunkMemory ATerraDyneManager::GetPooledChunkMemory() const
+{
+	FTerraDyneChunkMemory Totals;
+	for (const ATerraDyneChunk* Chunk : ChunkPool)
+	{
+		if (Chunk)
+		{
+			Totals += Chunk->GetMemoryBreakdown();
+		}
+	}
+	return Totals;
+}
+
+int64 ATerraDyneManager::GetTotalMemoryBytes() const
+{
+	FTerraDyneChunkMemory Totals = GetPooledChunkMemory();
+	ChunkGrid.ForEach([&Totals](FIntPoint, ATerraDyneChunk* Chunk)
+		{
+			Totals += Chunk->GetMemoryBreakdown();
+		});
+	return Totals.GetTotal() + FTerraDyneSaveBuffers::GetInFlightBytes() + FTerraDyneSaveBuffers::GetStats().PooledBytes;
+}
+
+void ATerraDyneManager::DumpMemoryReport(int32 MaxChunks) const
+{
+	constexpr int32 NumCategories = (int32)ETerraDyneMemoryCategory::Num;
+	const double KB = 1024.0;
+	const double MB = 1024.0 * 1024.0;
+
+	TArray<TPair<FIntPoint, FTerraDyneChunkMemory>> Chunks;
+	Chunks.Reserve(ChunkGrid.Num());
+	ChunkGrid.ForEach([&Chunks](FIntPoint Coord, ATerraDyneChunk* Chunk)
+		{
+			Chunks.Emplace(Coord, Chunk->GetMemoryBreakdown());
+		});
+
+	FTerraDyneChunkMemory ActiveTotals;
+	for (const TPair<FIntPoint, FTerraDyneChunkMemory>& Entry : Chunks)
+	{
+		ActiveTotals += Entry.Value;
+	}
+
+	const FTerraDyneChunkMemory PooledTotals = GetPooledChunkMemory();
+
+	const FTerraDyneBufferPoolStats PoolStats = FTerraDyneSaveBuffers::GetStats();
+	const int64 InFlightBytes = FTerraDyneSaveBuffers::GetInFlightBytes();
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: ---- %d chunks, %d pooled ----"), Chunks.Num(), ChunkPool.Num());
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: %-16s %12s %12s"), TEXT("Category"), TEXT("Active MB"), TEXT("Pooled MB"));
+	for (int32 Category = 0; Category < NumCategories; Category++)
+	{
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: %-16s %12.2f %12.2f"),
+			FTerraDyneChunkMemory::GetCategoryName((ETerraDyneMemoryCategory)Category), ActiveTotals.Bytes[Category] / MB, PooledTotals.Bytes[Category] / MB);
+	}
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: %-16s %12.2f"), TEXT("SaveInFlight"), InFlightBytes / MB);
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: %-16s %12.2f"), TEXT("SaveBufferPool"), PoolStats.PooledBytes / MB);
+
+	const int64 Total = ActiveTotals.GetTotal() + PooledTotals.GetTotal() + InFlightBytes + PoolStats.PooledBytes;
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: %-16s %12.2f  (warning %.0f MB, critical %.0f MB, 0 = off)"), TEXT("Total"), Total / MB, MemoryWarningMB, MemoryCriticalMB);
+
+	// Largest chunks first
+	Chunks.Sort([](const TPair<FIntPoint, FTerraDyneChunkMemory>& A, const TPair<FIntPoint, FTerraDyneChunkMemory>& B)
+		{
+			return A.Value.GetTotal() > B.Value.GetTotal();
+		});
+
+	const int32 NumListed = MaxChunks > 0 ? FMath::Min(MaxChunks, Chunks.Num()) : Chunks.Num();
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: %-14s %10s %10s %10s %10s %10s %10s %10s (KB)"),
+		TEXT("Chunk"), TEXT("Total"), TEXT("Caches"), TEXT("Compressed"), TEXT("RTs"), TEXT("ColMesh"), TEXT("ColCooked"), TEXT("Grass"));
+	for (int32 i = 0; i < NumListed; i++)
+	{
+		const FTerraDyneChunkMemory& Memory = Chunks[i].Value;
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: %-14s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f"),
+			*Chunks[i].Key.ToString(), Memory.GetTotal() / KB,
+			Memory[ETerraDyneMemoryCategory::Caches] / KB, Memory[ETerraDyneMemoryCategory::Compressed] / KB,
+			Memory[ETerraDyneMemoryCategory::RenderTargets] / KB, Memory[ETerraDyneMemoryCategory::CollisionMesh] / KB,
+			Memory[ETerraDyneMemoryCategory::CookedCollision] / KB, Memory[ETerraDyneMemoryCategory::Grass] / KB);
+	}
+	if (NumListed < Chunks.Num())
+	{
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneMemory: ... %d more (terradyne.MemReport 0 lists all)"), Chunks.Num() - NumListed);
+	}
+}
+
+//--- Deferred GPU Updates ---//
+
+void ATerraDyneManager::QueueGPUFlush(ATerraDyneChunk* Chunk)
+{
+	GPUDirtyChunks.AddUnique(Chunk);
 
-	if (UWorld* World = GetWorld())
+	if (!GetWorldTimerManager().IsTimerActive(TimerHandle_GPUFlush))
 	{
-		if (UTerraDyneSubsystem* Subsystem = World->GetSubsystem<UTerraDyneSubsystem>())
-		{
-			Subsystem->RegisterManager(this);
-		}
+		GetWorldTimerManager().SetTimer(TimerHandle_GPUFlush, this, &ATerraDyneManager::FlushVisibleGPUUpdates, GPUFlushInterval, true);
 	}
+}
+
+bool ATerraDyneManager::IsWithinGPUUpdateDistance(const FVector& Location, float Padding) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return false;
 
-	// Auto-Import Check
-	if (bAutoImportAtRuntime)
+	const float RangeSq = FMath::Square(GPUUpdateDistance + Padding);
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
 	{
-		AActor* LandscapeActor = UGameplayStatics::GetActorOfClass(GetWorld(), ALandscapeProxy::StaticClass());
+		const APlayerController* PC = It->Get();
+		if (!PC || !PC->IsLocalController()) continue;
 
-		RebuildChunkMap();
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		if (FVector::DistSquaredXY(ViewLocation, Location) <= RangeSq)
+		{
+			return true;
+		}
+	}
+	return false;
+}
 
-		if (ActiveChunkMap.Num() == 0)
+void ATerraDyneManager::FlushVisibleGPUUpdates()
+{
+	for (int32 i = GPUDirtyChunks.Num() - 1; i >= 0; i--)
+	{
+		ATerraDyneChunk* Chunk = GPUDirtyChunks[i].Get();
+		if (Chunk && Chunk->HasPendingGPUUpdate())
 		{
-			if (ALandscapeProxy* LandProxy = Cast<ALandscapeProxy>(LandscapeActor))
-			{
-#if WITH_EDITOR
-				ImportFromLandscape(LandProxy, true);
-#endif
-			}
-			else
-			{
-				SpawnDefaultSandboxChunk();
-			}
+			if (Chunk->ShouldDeferGPUUpdate()) continue;
+			Chunk->ScheduleGPUFlush();
 		}
+		GPUDirtyChunks.RemoveAtSwap(i, EAllowShrinking::No);
 	}
 
-	RebuildChunkMap();
+	if (GPUDirtyChunks.Num() == 0)
+	{
+		GetWorldTimerManager().ClearTimer(TimerHandle_GPUFlush);
+	}
 }
 
-void ATerraDyneManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+void ATerraDyneManager::FlushAllGPUUpdates()
 {
-	if (UWorld* World = GetWorld())
+	for (const TWeakObjectPtr<ATerraDyneChunk>& Entry : GPUDirtyChunks)
 	{
-		if (UTerraDyneSubsystem* Subsystem = World->GetSubsystem<UTerraDyneSubsystem>())
+		if (ATerraDyneChunk* Chunk = Entry.Get())
 		{
-			Subsystem->UnregisterManager(this);
+			Chunk->FlushPendingGPUUpdate();
 		}
 	}
-	Super::EndPlay(EndPlayReason);
+	GPUDirtyChunks.Reset();
+	GetWorldTimerManager().ClearTimer(TimerHandle_GPUFlush);
 }
 
-void ATerraDyneManager::SpawnDefaultSandboxChunk()
+//--- Chunk Streaming ---//
+
+FBox2D ATerraDyneManager::GetCellBounds(FIntPoint Coord) const
 {
-	GlobalChunkSize = 10000.0f;
+	const FVector2D Min(Coord.X * GlobalChunkSize, Coord.Y * GlobalChunkSize);
+	return FBox2D(Min, Min + FVector2D(GlobalChunkSize));
+}
 
-	FActorSpawnParameters Params;
-	Params.bDeferConstruction = true;
-	ATerraDyneChunk* Chunk = GetWorld()->SpawnActor<ATerraDyneChunk>(ChunkClass, FTransform::Identity, Params);
+void ATerraDyneManager::UpdateStreamingSources(const TArray<AActor*>& Actors, double Now)
+{
+	// Anything faster is a teleport/respawn, not motion worth extrapolating
+	static constexpr double MaxPlausibleSpeed = 200000.0; // cm/s
 
-	if (Chunk)
+	TArray<FTerraDyneStreamingSource> Updated;
+	Updated.Reserve(Actors.Num());
+
+	for (const AActor* Actor : Actors)
 	{
-		Chunk->InitializeChunk(FIntPoint(0, 0), GlobalChunkSize, 128, nullptr);
+		const FVector Location = Actor->GetActorLocation();
+		const FTerraDyneStreamingSource* Previous = StreamingSources.FindByPredicate([Actor](const FTerraDyneStreamingSource& Entry)
+			{
+				return Entry.Actor.Get() == Actor;
+			});
 
-		if (MasterMaterial) Chunk->SetMaterial(MasterMaterial);
-		if (HeightBrushMaterial) Chunk->BrushMaterialBase = HeightBrushMaterial;
-		if (WeightBrushMaterial) Chunk->PaintMaterialBase = WeightBrushMaterial;
+		FTerraDyneStreamingSource& Source = Updated.AddDefaulted_GetRef();
+		Source.Actor = Actor;
+		Source.LastLocation = Location;
+		Source.LastTime = Now;
 
-		Chunk->RebuildPhysicsMesh();
-		Chunk->FinishSpawning(FTransform::Identity);
+		if (!Previous) continue;
+
+		const double DeltaTime = Now - Previous->LastTime;
+		if (DeltaTime <= UE_KINDA_SMALL_NUMBER)
+		{
+			Source.Velocity = Previous->Velocity;
+			continue;
+		}
 
-		int64 Hash = GetChunkHash(0, 0);
-		ActiveChunkMap.Add(Hash, Chunk);
+		const FVector Instant = (Location - Previous->LastLocation) / DeltaTime;
+		if (Instant.SizeSquared() > FMath::Square(MaxPlausibleSpeed)) continue;
 
-		UE_LOG(LogTemp, Warning, TEXT("TerraDyne Automation: Sandbox Chunk Spawned."));
+		// Frame-rate independent EMA
+		const double Alpha = 1.0 - FMath::Exp(-DeltaTime / PrefetchVelocitySmoothing);
+		Source.Velocity = FMath::Lerp(Previous->Velocity, Instant, Alpha);
 	}
+
+	StreamingSources = MoveTemp(Updated);
 }
 
-void ATerraDyneManager::ApplyGlobalBrush(FVector WorldLocation, float Radius, float Strength, bool bIsHole, int32 PaintLayer)
+void ATerraDyneManager::GatherPrefetchCandidates(TMap<FIntPoint, float>& OutETA) const
 {
-	if (GlobalChunkSize <= 0.0f)
+	auto Consider = [&OutETA](FIntPoint Coord, float ETA)
+		{
+			float& Best = OutETA.FindOrAdd(Coord, TNumericLimits<float>::Max());
+			Best = FMath::Min(Best, ETA);
+		};
+
+	for (const FTerraDyneStreamingSource& Source : StreamingSources)
 	{
-		RebuildChunkMap();
-		if (GlobalChunkSize <= 0) return;
+		const FVector2D Origin(Source.LastLocation);
+		const FVector2D Velocity(Source.Velocity);
+		const float Speed = Velocity.Size();
+		const float ApproachSpeed = FMath::Max(Speed, PrefetchMinSpeed);
+
+		// 1. Everything within the fixed radius, ETA by straight-line distance
+		const FVector2D Reach(TileStreamingDistance);
+		const FIntPoint Min = WorldToGrid(FVector(Origin - Reach, 0.0));
+		const FIntPoint Max = WorldToGrid(FVector(Origin + Reach, 0.0));
+		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+		{
+			for (int32 X = Min.X; X <= Max.X; X++)
+			{
+				const float DistSq = GetCellBounds(FIntPoint(X, Y)).ComputeSquaredDistanceToPoint(Origin);
+				if (DistSq <= FMath::Square(TileStreamingDistance))
+				{
+					Consider(FIntPoint(X, Y), FMath::Sqrt(DistSq) / ApproachSpeed);
+				}
+			}
+		}
+
+		// 2. A corridor along the extrapolated path, ETA by travel time
+		if (Speed < PrefetchMinSpeed || PrefetchHorizonSeconds <= 0.0f) continue;
+
+		const float Step = FMath::Max(GlobalChunkSize * 0.5f / Speed, 0.05f);
+		const FVector2D Corridor(PrefetchCorridorRadius);
+		for (float T = Step; T <= PrefetchHorizonSeconds; T += Step)
+		{
+			const FVector2D Predicted = Origin + Velocity * T;
+			const FIntPoint PMin = WorldToGrid(FVector(Predicted - Corridor, 0.0));
+			const FIntPoint PMax = WorldToGrid(FVector(Predicted + Corridor, 0.0));
+			for (int32 Y = PMin.Y; Y <= PMax.Y; Y++)
+			{
+				for (int32 X = PMin.X; X <= PMax.X; X++)
+				{
+					const float DistSq = GetCellBounds(FIntPoint(X, Y)).ComputeSquaredDistanceToPoint(Predicted);
+					if (DistSq <= FMath::Square(PrefetchCorridorRadius))
+					{
+						Consider(FIntPoint(X, Y), T + FMath::Sqrt(DistSq) / Speed);
+					}
+				}
+			}
+		}
 	}
+}
 
-	FBox2D BrushBounds(
-		FVector2D(WorldLocation.X - Radius, WorldLocation.Y - Radius),
-		FVector2D(WorldLocation.X + Radius, WorldLocation.Y + Radius)
-	);
+void ATerraDyneManager::UpdateChunkStreaming()
+{
+	UWorld* World = GetWorld();
+	UTerraDyneSubsystem* Subsystem = World ? World->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	if (!Subsystem || GlobalChunkSize <= 0.0f) return;
+
+	const double Now = World->GetRealTimeSeconds();
 
-	int32 MinX = FMath::FloorToInt(BrushBounds.Min.X / GlobalChunkSize);
-	int32 MinY = FMath::FloorToInt(BrushBounds.Min.Y / GlobalChunkSize);
-	int32 MaxX = FMath::FloorToInt(BrushBounds.Max.X / GlobalChunkSize);
-	int32 MaxY = FMath::FloorToInt(BrushBounds.Max.Y / GlobalChunkSize);
+	TArray<AActor*> Actors;
+	Subsystem->GatherPhysicsSources(Actors);
+	UpdateStreamingSources(Actors, Now);
+	if (StreamingSources.Num() == 0) return;
 
-	for (int32 X = MinX; X <= MaxX; X++)
+	const bool bStreamSaves = !StreamingSaveSlot.IsEmpty();
+
+	// 1. Arrivals: anything a source stands on must load now, and is late if it isn't there yet
+	for (const FTerraDyneStreamingSource& Source : StreamingSources)
 	{
-		for (int32 Y = MinY; Y <= MaxY; Y++)
+		const FVector2D Origin(Source.LastLocation);
+		const FVector2D Reach(StreamingArrivalDistance);
+		const FIntPoint Min = WorldToGrid(FVector(Origin - Reach, 0.0));
+		const FIntPoint Max = WorldToGrid(FVector(Origin + Reach, 0.0));
+
+		for (int32 Y = Min.Y; Y <= Max.Y; Y++)
 		{
-			int64 Hash = GetChunkHash(X, Y);
-			if (ATerraDyneChunk** FoundChunk = ActiveChunkMap.Find(Hash))
+			for (int32 X = Min.X; X <= Max.X; X++)
 			{
-				if (*FoundChunk)
+				const FIntPoint Coord(X, Y);
+				if (GetCellBounds(Coord).ComputeSquaredDistanceToPoint(Origin) > FMath::Square(StreamingArrivalDistance)) continue;
+
+				if (ATerraDyneChunk* Chunk = ChunkGrid.Find(Coord))
+				{
+					if (Chunk->IsAwaitingTileData())
+					{
+						if (Chunk->TileNeededTime < 0.0) Chunk->TileNeededTime = Now;
+						if (!Chunk->IsTileDataRequested())
+						{
+							Chunk->RequestTileData(FStreamableManager::AsyncLoadHighPriority);
+							StreamingStats.TileRequests++;
+						}
+					}
+				}
+
+				if (bStreamSaves)
 				{
-					FVector LocalPos = WorldLocation - (*FoundChunk)->GetActorLocation();
-					(*FoundChunk)->ApplyLocalIdempotentEdit(LocalPos, Radius, Strength, bIsHole, PaintLayer);
+					if (FPendingSaveLoad* Pending = PendingSaveLoads.Find(Coord))
+					{
+						if (Pending->NeededTime < 0.0) Pending->NeededTime = Now;
+					}
+					else if (!ProbedSaveCells.Contains(Coord))
+					{
+						// Needed now: ignores the in-flight cap
+						RequestSavedChunk(Coord);
+						PendingSaveLoads[Coord].NeededTime = Now;
+					}
 				}
 			}
 		}
 	}
+
+	// 2. Prefetch: radius + predicted path, lowest ETA first
+	TMap<FIntPoint, float> Candidates;
+	GatherPrefetchCandidates(Candidates);
+	Candidates.ValueSort([](float A, float B) { return A < B; });
+
+	int32 Issued = 0;
+	for (const TPair<FIntPoint, float>& Candidate : Candidates)
+	{
+		if (Issued >= MaxPrefetchRequestsPerUpdate) break;
+
+		ATerraDyneChunk* Chunk = ChunkGrid.Find(Candidate.Key);
+		if (Chunk && Chunk->IsAwaitingTileData() && !Chunk->IsTileDataRequested())
+		{
+			// Sooner arrival -> higher async loading priority
+			const float Urgency = PrefetchHorizonSeconds > 0.0f ? 1.0f - FMath::Clamp(Candidate.Value / PrefetchHorizonSeconds, 0.0f, 1.0f) : 0.0f;
+			Chunk->RequestTileData(FStreamableManager::DefaultAsyncLoadPriority + FMath::RoundToInt(Urgency * (FStreamableManager::AsyncLoadHighPriority - FStreamableManager::DefaultAsyncLoadPriority)));
+			StreamingStats.TileRequests++;
+			Issued++;
+		}
+
+		if (bStreamSaves && PendingSaveLoads.Num() < MaxInFlightSaveLoads && !ProbedSaveCells.Contains(Candidate.Key) && !PendingSaveLoads.Contains(Candidate.Key))
+		{
+			RequestSavedChunk(Candidate.Key);
+			Issued++;
+		}
+	}
+
+	// Forget probes of empty cells that fell out of range (chunks forget theirs in UnregisterChunk)
+	for (auto It = ProbedSaveCells.CreateIterator(); It; ++It)
+	{
+		if (!Candidates.Contains(*It) && !PendingSaveLoads.Contains(*It) && !ChunkGrid.Find(*It))
+		{
+			It.RemoveCurrent();
+		}
+	}
 }
 
-ATerraDyneChunk* ATerraDyneManager::GetChunkAtLocation(FVector WorldLocation)
+void ATerraDyneManager::RequestSavedChunk(FIntPoint Coord)
 {
-	if (GlobalChunkSize <= 0) return nullptr;
+	ProbedSaveCells.Add(Coord);
+
+	FPendingSaveLoad& Pending = PendingSaveLoads.Add(Coord);
+	if (const ATerraDyneChunk* Chunk = ChunkGrid.Find(Coord))
+	{
+		Pending.EditSerial = Chunk->EditSerial;
+	}
 
-	int32 X = FMath::FloorToInt(WorldLocation.X / GlobalChunkSize);
-	int32 Y = FMath::FloorToInt(WorldLocation.Y / GlobalChunkSize);
+	const TSharedRef<FTerraDyneRegionFile> Region = FTerraDyneRegionFile::Get(StreamingSaveSlot);
 
-	if (ATerraDyneChunk** Chunk = ActiveChunkMap.Find(GetChunkHash(X, Y)))
+	// Index lookup, mapped read, zlib inflate and deserialization all happen on the worker
+	if (!SaveLoadToken.IsValid())
 	{
-		return *Chunk;
+		SaveLoadToken = MakeShared<FTerraDyneCancellationToken, ESPMode::ThreadSafe>();
 	}
-	return nullptr;
+
+	TWeakObjectPtr<ATerraDyneManager> WeakThis(this);
+	FTerraDyneWorkerPool::Get().Launch(ETerraDyneJobPriority::Streaming, [WeakThis, Coord, Region](const FTerraDyneCancellationToken& Token)
+		{
+			TSharedPtr<FTerraDyneChunkSnapshot> Snapshot = MakeShared<FTerraDyneChunkSnapshot>();
+			const bool bLoaded = UTerraDyneSerializer::LoadChunkFromRegion(*Region, Coord, *Snapshot);
+			if (Token.IsCancelled()) return;
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Coord, Snapshot, bLoaded]()
+				{
+					ATerraDyneManager* Manager = WeakThis.Get();
+					if (!Manager) return;
+
+					UTerraDyneSubsystem* Subsystem = Manager->GetWorld()->GetSubsystem<UTerraDyneSubsystem>();
+					if (!bLoaded || !Subsystem)
+					{
+						Manager->OnSavedChunkLoaded(Coord, MoveTemp(*Snapshot), bLoaded);
+						return;
+					}
+
+					// Applying re-uploads the RTs and may cook collision: wait for the streaming budget
+					const FVector2D Center = Manager->GetCellBounds(Coord).GetCenter();
+					Subsystem->EnqueueWork(ETerraDyneWorkCategory::Streaming, nullptr, FVector(Center, Manager->GetActorLocation().Z),
+						[WeakThis, Coord, Snapshot]()
+						{
+							if (ATerraDyneManager* Manager = WeakThis.Get())
+							{
+								Manager->OnSavedChunkLoaded(Coord, MoveTemp(*Snapshot), true);
+							}
+						});
+				});
+		}, SaveLoadToken);
 }
 
-void ATerraDyneManager::RebuildChunkMap()
+void ATerraDyneManager::OnSavedChunkLoaded(FIntPoint Coord, FTerraDyneChunkSnapshot&& Snapshot, bool bLoaded)
 {
-	ActiveChunkMap.Reset();
-	TArray<AActor*> FoundActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), ATerraDyneChunk::StaticClass(), FoundActors);
+	FPendingSaveLoad Pending;
+	PendingSaveLoads.RemoveAndCopyValue(Coord, Pending);
+
+	// No file for this cell is the common case
+	if (!bLoaded) return;
 
-	for (AActor* Actor : FoundActors)
+	if (Snapshot.GridCoordinate != Coord)
 	{
-		ATerraDyneChunk* Chunk = Cast<ATerraDyneChunk>(Actor);
-		if (Chunk)
-		{
-			if (GlobalChunkSize <= 0) GlobalChunkSize = Chunk->ChunkSizeWorldUnits;
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneManager: Saved frame for %s holds chunk %s; skipped."), *Coord.ToString(), *Snapshot.GridCoordinate.ToString());
+		Snapshot.ReturnBuffers();
+		return;
+	}
+
+	ATerraDyneChunk* Chunk = ChunkGrid.Find(Coord);
+	if (Chunk && Chunk->EditSerial != Pending.EditSerial)
+	{
+		// The save predates those edits; applying it would roll them back
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneManager: Chunk %s was edited while its save loaded; kept the edits."), *Coord.ToString());
+		Snapshot.ReturnBuffers();
+		return;
+	}
 
-			int64 Hash = GetChunkHash(Chunk->GridCoordinate.X, Chunk->GridCoordinate.Y);
-			ActiveChunkMap.Add(Hash, Chunk);
+	if (!Chunk)
+	{
+		Chunk = AcquireChunk(Coord);
+		if (!Chunk)
+		{
+			Snapshot.ReturnBuffers();
+			return;
 		}
 	}
+
+	// Startup init would otherwise overwrite the restored state later
+	Chunk->RunStartupInit();
+	Chunk->ApplySnapshot(MoveTemp(Snapshot));
+
+	StreamingStats.SavedChunksLoaded++;
+	RecordStreamingArrival(Pending.NeededTime);
 }
 
-int64 ATerraDyneManager::GetChunkHash(int32 X, int32 Y) const
+FTerraDyneSaveStats ATerraDyneManager::GetSaveStats() const
 {
-	return ((int64)X << 32) | (uint32)Y;
+	const FTerraDyneBufferPoolStats PoolStats = FTerraDyneSaveBuffers::GetStats();
+
+	FTerraDyneSaveStats Stats;
+	Stats.ChunksSaved = FTerraDyneSaveBuffers::GetSavesWritten();
+	Stats.ChunksLoaded = FTerraDyneSaveBuffers::GetLoadsRead();
+	Stats.BufferAcquires = PoolStats.Acquires;
+	Stats.BufferReuses = PoolStats.Reuses;
+	Stats.BufferAllocations = PoolStats.Allocations;
+	Stats.PooledBytes = PoolStats.PooledBytes;
+	Stats.InFlightBytes = FTerraDyneSaveBuffers::GetInFlightBytes();
+	return Stats;
 }
 
-#if WITH_EDITOR
+void ATerraDyneManager::RecordStreamingArrival(double NeededTime)
+{
+	if (NeededTime < 0.0)
+	{
+		StreamingStats.ArrivedOnTime++;
+		return;
+	}
+
+	const float Late = GetWorld() ? (float)(GetWorld()->GetRealTimeSeconds() - NeededTime) : 0.0f;
+	StreamingStats.ArrivedLate++;
+	StreamingStats.TotalLateSeconds += Late;
+	StreamingStats.WorstLateSeconds = FMath::Max(StreamingStats.WorstLateSeconds, Late);
+
+	UE_LOG(LogTemp, Verbose, TEXT("TerraDyneManager: Chunk data arrived %.3f s after it was needed."), Late);
+}
 
-// Helper for private weightmap access
-static UTexture2D* GetPrivateWeightmap(ULandscapeComponent* Comp)
+//--- Collision LOD ---//
+
+int32 ATerraDyneManager::SelectCollisionLOD(float Distance, int32 CurrentLOD) const
 {
-	if (!Comp) return nullptr;
-	FArrayProperty* Prop = CastField<FArrayProperty>(Comp->GetClass()->FindPropertyByName(FName("WeightmapTextures")));
-	if (Prop)
+	int32 LOD = 0;
+	for (int32 i = 0; i < CollisionLODDistances.Num(); i++)
 	{
-		void* Addr = Prop->ContainerPtrToValuePtr<void>(Comp);
-		FScriptArrayHelper Helper(Prop, Addr);
-		if (Helper.Num() > 0)
+		// Edge i separates LOD i and i+1: chunks already past it must come closer to return
+		const float Bias = (CurrentLOD > i) ? -CollisionLODHysteresis : CollisionLODHysteresis;
+		if (Distance > CollisionLODDistances[i] + Bias)
+		{
+			LOD = i + 1;
+		}
+		else
 		{
-			FObjectProperty* Inner = CastField<FObjectProperty>(Prop->Inner);
-			return Cast<UTexture2D>(Inner->GetObjectPropertyValue(Helper.GetRawPtr(0)));
+			break;
 		}
 	}
-	return nullptr;
+	return LOD;
 }
 
-// Resampling Function
-void ATerraDyneManager::ResampleLandscapeData(ATerraDyneChunk* Chunk, ALandscapeProxy* Source)
+void ATerraDyneManager::UpdateCollisionStreaming()
 {
-	if (!Chunk || !Source) return;
+	UWorld* World = GetWorld();
+	UTerraDyneSubsystem* Subsystem = World ? World->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	if (!Subsystem || ChunkGrid.Num() == 0) return;
+
+	TArray<FVector> Sources;
+	Subsystem->GatherPhysicsSourceLocations(Sources);
 
-	FTransform ChunkTransform = Chunk->GetActorTransform();
-	int32 Res = 128; // Standard Res
+	const bool bLazy = UsesLazyCollision();
+	if (!bLazy && Sources.Num() == 0) return; // Nobody to be near; keep current levels
 
-	// Ensure cache is ready
-	Chunk->HeightCache.SetNumUninitialized(Res * Res);
-	float ChunkSize = Chunk->ChunkSizeWorldUnits;
+	TArray<FBox> QueryRegions;
+	if (bLazy)
+	{
+		Subsystem->GatherCollisionQueryRegions(QueryRegions);
+	}
+
+	const double Now = World->GetTimeSeconds();
+	const float HalfSize = GlobalChunkSize * 0.5f;
+	const float DemandMarginSq = FMath::Square(CollisionDemandMargin);
+
+	int32 NumBuilt = 0;
+	int32 NumReleased = 0;
 
-	ParallelFor(Res * Res, [&](int32 Index)
+	ChunkGrid.ForEach([&](FIntPoint, ATerraDyneChunk* Chunk)
 		{
-			int32 X = Index % Res;
-			int32 Y = Index / Res;
+			// Distance from the nearest source to the chunk's XY footprint
+			const FVector Center = Chunk->GetActorLocation();
+			const FBox2D Bounds(FVector2D(Center) - FVector2D(HalfSize), FVector2D(Center) + FVector2D(HalfSize));
+
+			float MinDistSq = TNumericLimits<float>::Max();
+			for (const FVector& Source : Sources)
+			{
+				MinDistSq = FMath::Min(MinDistSq, (float)Bounds.ComputeSquaredDistanceToPoint(FVector2D(Source)));
+			}
+
+			const int32 TargetLOD = Sources.Num() > 0 ? SelectCollisionLOD(FMath::Sqrt(MinDistSq), Chunk->GetCollisionLOD()) : Chunk->GetCollisionLOD();
 
-			double U = (double)X / (double)(Res - 1);
-			double V = (double)Y / (double)(Res - 1);
+			if (!bLazy)
+			{
+				Chunk->SetCollisionLOD(TargetLOD);
+				return;
+			}
 
-			FVector LocalPos(U * ChunkSize, V * ChunkSize, 0.0);
-			FVector WorldPos = ChunkTransform.TransformPosition(LocalPos);
+			bool bDemanded = MinDistSq <= DemandMarginSq;
 
-			TOptional<float> HeightVal = Source->GetHeightAtLocation(WorldPos);
+			if (!bDemanded)
+			{
+				const FBox2D Expanded = Bounds.ExpandBy(CollisionDemandMargin);
+				for (const FBox& Region : QueryRegions)
+				{
+					if (Expanded.Intersect(FBox2D(FVector2D(Region.Min), FVector2D(Region.Max))))
+					{
+						bDemanded = true;
+						break;
+					}
+				}
+			}
 
-			if (HeightVal.IsSet())
+			// Only pay for the overlap query where nothing else would build collision
+			if (!bDemanded && bDetectPhysicsBodies && !Chunk->HasCollision())
 			{
-				Chunk->HeightCache[Index] = HeightVal.GetValue() - ChunkTransform.GetLocation().Z;
+				bDemanded = HasPhysicsBodyNear(Chunk, HalfSize + CollisionDemandMargin);
 			}
-			else
+
+			if (bDemanded)
 			{
-				Chunk->HeightCache[Index] = 0.0f;
+				Chunk->LastCollisionDemandTime = Now;
+				if (!Chunk->HasCollision())
+				{
+					Chunk->EnsureCollision(TargetLOD);
+					NumBuilt++;
+					return;
+				}
+			}
+			else if (Chunk->HasCollision() && CollisionIdleTimeout > 0.0f && (Now - Chunk->LastCollisionDemandTime) > CollisionIdleTimeout)
+			{
+				Chunk->ReleaseCollision();
+				NumReleased++;
+				return;
 			}
+
+			if (Chunk->HasCollision())
+			{
+				Chunk->SetCollisionLOD(TargetLOD);
+			}
+		});
+
+	if (NumBuilt > 0 || NumReleased > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("TerraDyneManager: Lazy collision built %d, released %d chunk(s)."), NumBuilt, NumReleased);
+	}
+}
+
+bool ATerraDyneManager::HasPhysicsBodyNear(const ATerraDyneChunk* Chunk, float HalfExtent) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return false;
+
+	// Terrain height is unbounded in Z, so the probe spans the whole column above and below the chunk
+	const FCollisionShape Box = FCollisionShape::MakeBox(FVector(HalfExtent, HalfExtent, HALF_WORLD_MAX * 0.5));
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(TerraDyneLazyCollision), false);
+	Params.AddIgnoredActor(Chunk);
+
+	return World->OverlapAnyTestByObjectType(Chunk->GetActorLocation(), FQuat::Identity, FCollisionObjectQueryParams(ECC_PhysicsBody), Box, Params);
+}
+
+void ATerraDyneManager::EnsureCollisionInBounds(FBox2D WorldBounds)
+{
+	if (!WorldBounds.bIsValid || GlobalChunkSize <= 0.0f) return;
+
+	const double Now = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+
+	ChunkGrid.ForEachInRect(WorldToGrid(FVector(WorldBounds.Min, 0.0)), WorldToGrid(FVector(WorldBounds.Max, 0.0)), [Now](FIntPoint, ATerraDyneChunk* Chunk)
+		{
+			Chunk->RunStartupInit();
+			Chunk->FlushTileData();
+			Chunk->LastCollisionDemandTime = Now;
+			Chunk->BuildCollisionNow();
 		});
+}
+
+//--- Chunk Registry ---//
+
+void ATerraDyneManager::RegisterChunk(ATerraDyneChunk* Chunk)
+{
+	if (!IsValid(Chunk) || Chunk->IsPooled()) return;
+
+	if (GlobalChunkSize <= 0) GlobalChunkSize = Chunk->ChunkSizeWorldUnits;
+
+	ChunkGrid.Add(Chunk->GridCoordinate, Chunk);
+
+	// Direct injection replaces the per-chunk Manager lookup
+	InjectMaterials(Chunk, false);
+
+	if (Chunk->IsStartupInitPending())
+	{
+		QueueChunkInit(Chunk);
+	}
+
+	// A journal replay restored this cell while it was away
+	FTerraDyneEditJournal::FChunkState JournalState = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+	if (PendingJournalRestores.RemoveAndCopyValue(Chunk->GridCoordinate, JournalState))
+	{
+		RestoreChunkState(Chunk->GridCoordinate, JournalState);
+	}
+
+	// Recording: a chunk coming back may not hold the state the last keyframe has for it
+	if (RecordingJournal.IsValid() && RecordingJournal->HasBaseState(Chunk->GridCoordinate))
+	{
+		JournalDirtyChunks.Add(Chunk->GridCoordinate);
+	}
+}
 
-	// Finalize
-	Chunk->RebuildPhysicsMesh();
-	// Force a visual flush
-	Chunk->ApplyLocalIdempotentEdit(FVector(0), 10.0f, 0.0f, false);
+void ATerraDyneManager::UnregisterChunk(ATerraDyneChunk* Chunk)
+{
+	if (!Chunk) return;
+
+	// Recording: its edits since the last keyframe would be lost with it
+	if (RecordingJournal.IsValid() && JournalDirtyChunks.Remove(Chunk->GridCoordinate) > 0 && ChunkGrid.Find(Chunk->GridCoordinate) == Chunk)
+	{
+		JournalParkedStates.Add(Chunk->GridCoordinate, CaptureChunkState(Chunk));
+	}
+
+	if (ChunkGrid.Find(Chunk->GridCoordinate) == Chunk)
+	{
+		// A later tenant of the cell starts from the save again, and counts its edits from zero
+		ProbedSaveCells.Remove(Chunk->GridCoordinate);
+		if (FPendingSaveLoad* Pending = PendingSaveLoads.Find(Chunk->GridCoordinate))
+		{
+			Pending->EditSerial = 0;
+		}
+
+		// ...and warns about its own size again
+		ChunksOverMemoryWarning.Remove(Chunk->GridCoordinate);
+	}
+
+	ChunkGrid.Remove(Chunk->GridCoordinate, Chunk);
+}
+
+#if WITH_EDITOR
+
+/**
+ * One Landscape component's worth of import work.
+ * Filled on the Game Thread (texture reads), resampled on workers, consumed on the Game Thread (spawn).
+ */
+struct FTerraDyneImportJob
+{
+	ULandscapeComponent* Component = nullptr;
+	FIntPoint GridCoord;
+	FTransform ChunkTransform;
+	float HeightScaleZ = 1.0f;
+
+	// Raw decode (ComponentSizeVerts^2)
+	int32 SourceVerts = 0;
+	TArray<FColor> RawHeights;
+	TArray<uint8> RawLayers[4];
+	int32 NumLayers = 0;
+
+	// Resampled output (Resolution^2)
+	TArray<float> Heights;
+	TArray<FColor> Weights;
+};
+
+// Reads heights/weights straight out of the component's textures (no traces)
+static bool DecodeLandscapeComponent(FTerraDyneImportJob& Job)
+{
+	FLandscapeComponentDataInterface DataInterface(Job.Component);
+
+	DataInterface.GetHeightmapTextureData(Job.RawHeights, true);
+	Job.SourceVerts = Job.Component->ComponentSizeQuads + 1;
+	if (Job.RawHeights.Num() != Job.SourceVerts * Job.SourceVerts)
+	{
+		return false;
+	}
+
+	// First 4 painted layers map to the chunk's RGBA WeightMap channels
+	Job.NumLayers = 0;
+	for (const FWeightmapLayerAllocationInfo& Allocation : Job.Component->GetWeightmapLayerAllocations())
+	{
+		if (Job.NumLayers >= 4) break;
+		if (!Allocation.LayerInfo) continue;
+
+		TArray<uint8>& LayerData = Job.RawLayers[Job.NumLayers];
+		if (DataInterface.GetWeightmapTextureData(Allocation.LayerInfo, LayerData) && LayerData.Num() == Job.RawHeights.Num())
+		{
+			Job.NumLayers++;
+		}
+		else
+		{
+			LayerData.Reset();
+		}
+	}
+	return true;
+}
+
+// Pure CPU work: decode 16-bit heights, pack layers and resample onto the chunk grid
+static void ResampleImportJob(FTerraDyneImportJob& Job, int32 Res)
+{
+	const int32 NumSource = Job.RawHeights.Num();
+
+	TArray<float> SourceHeights;
+	SourceHeights.SetNumUninitialized(NumSource);
+	for (int32 i = 0; i < NumSource; i++)
+	{
+		const FColor& C = Job.RawHeights[i];
+		const uint16 Packed = ((uint16)C.R << 8) | C.G;
+		SourceHeights[i] = LandscapeDataAccess::GetLocalHeight(Packed) * Job.HeightScaleZ;
+	}
+
+	Job.Heights.SetNumUninitialized(Res * Res);
+	FTerraDyneResampler::ResampleBilinear(SourceHeights.GetData(), Job.SourceVerts, Job.SourceVerts, Job.Heights.GetData(), Res);
+
+	Job.Weights.SetNumZeroed(Res * Res);
+	if (Job.NumLayers > 0)
+	{
+		TArray<FColor> SourceWeights;
+		SourceWeights.SetNumZeroed(NumSource);
+		for (int32 i = 0; i < NumSource; i++)
+		{
+			FColor& W = SourceWeights[i];
+			W.R = Job.NumLayers > 0 ? Job.RawLayers[0][i] : 0;
+			W.G = Job.NumLayers > 1 ? Job.RawLayers[1][i] : 0;
+			W.B = Job.NumLayers > 2 ? Job.RawLayers[2][i] : 0;
+			W.A = Job.NumLayers > 3 ? Job.RawLayers[3][i] : 0;
+		}
+		FTerraDyneResampler::ResampleBilinear(SourceWeights.GetData(), Job.SourceVerts, Job.SourceVerts, Job.Weights.GetData(), Res);
+	}
+
+	// Raw data is no longer needed; free it on the worker
+	Job.RawHeights.Empty();
+	for (TArray<uint8>& Layer : Job.RawLayers)
+	{
+		Layer.Empty();
+	}
 }
 
 void ATerraDyneManager::ImportFromLandscape(ALandscapeProxy* SourceLandscape, bool bHideSource)
@@ -234,50 +1733,75 @@ void ATerraDyneManager::ImportFromLandscape(ALandscapeProxy* SourceLandscape, bo
 	TArray<ULandscapeComponent*> Components = SourceLandscape->LandscapeComponents;
 	if (Components.Num() == 0) return;
 
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 Res = 128;
+
 	float CompResolution = (float)Components[0]->ComponentSizeQuads;
 	float Scale = Components[0]->GetComponentTransform().GetScale3D().X;
 	GlobalChunkSize = CompResolution * Scale;
 
-	int32 ChunksCreated = 0;
+	// 1. Decode (Game Thread: texture mip access)
+	TArray<FTerraDyneImportJob> Jobs;
+	Jobs.Reserve(Components.Num());
 
 	for (ULandscapeComponent* Comp : Components)
 	{
-		FIntPoint GridCoord(
+		if (!Comp) continue;
+
+		const FTransform& CompTransform = Comp->GetComponentTransform();
+
+		FTerraDyneImportJob& Job = Jobs.AddDefaulted_GetRef();
+		Job.Component = Comp;
+		Job.GridCoord = FIntPoint(
 			FMath::RoundToInt(Comp->GetComponentLocation().X / GlobalChunkSize),
 			FMath::RoundToInt(Comp->GetComponentLocation().Y / GlobalChunkSize)
 		);
+		Job.HeightScaleZ = CompTransform.GetScale3D().Z;
+
+		// Chunk meshes are centered on the actor: place it at the component's center, unscaled
+		const float HalfQuads = Comp->ComponentSizeQuads * 0.5f;
+		Job.ChunkTransform = FTransform(CompTransform.GetRotation(), CompTransform.TransformPosition(FVector(HalfQuads, HalfQuads, 0.0)));
+
+		if (!DecodeLandscapeComponent(Job))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TerraDyne: Could not decode heightmap of %s, skipping."), *Comp->GetName());
+			Jobs.Pop(EAllowShrinking::No);
+		}
+	}
+
+	// 2. Resample (all components in parallel)
+	ParallelFor(Jobs.Num(), [&Jobs, Res](int32 Index)
+		{
+			ResampleImportJob(Jobs[Index], Res);
+		});
+
+	// 3. Spawn (Game Thread)
+	int32 ChunksCreated = 0;
 
+	for (FTerraDyneImportJob& Job : Jobs)
+	{
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.bDeferConstruction = true;
-		SpawnParams.OverrideLevel = Comp->GetOwner()->GetLevel();
+		SpawnParams.OverrideLevel = Job.Component->GetOwner()->GetLevel();
 
 		ATerraDyneChunk* NewChunk = GetWorld()->SpawnActor<ATerraDyneChunk>(
 			ChunkClass,
-			Comp->GetComponentTransform(),
+			Job.ChunkTransform,
 			SpawnParams
 		);
 
 		if (NewChunk)
 		{
-			UTexture2D* HeightTex = Comp->GetHeightmap();
-			UTexture2D* WeightTex = GetPrivateWeightmap(Comp);
-
-			NewChunk->InitializeChunk(GridCoord, GlobalChunkSize, 128, HeightTex, WeightTex);
-
-			if (MasterMaterial) NewChunk->SetMaterial(MasterMaterial);
-			if (HeightBrushMaterial) NewChunk->BrushMaterialBase = HeightBrushMaterial;
-			if (WeightBrushMaterial) NewChunk->PaintMaterialBase = WeightBrushMaterial;
-
-			NewChunk->FinishSpawning(Comp->GetComponentTransform());
+			NewChunk->InitializeChunk(Job.GridCoord, GlobalChunkSize, Res, nullptr);
+			InjectMaterials(NewChunk);
 
-			// THE FIX: Resample physical data
-			ResampleLandscapeData(NewChunk, SourceLandscape);
+			NewChunk->FinishSpawning(Job.ChunkTransform);
+			NewChunk->ApplyImportedData(MoveTemp(Job.Heights), MoveTemp(Job.Weights));
 
 			NewChunk->SetIsSpatiallyLoaded(true);
 			NewChunk->SetFolderPath(FName("TerraDyne_Chunks"));
 
-			int64 Hash = GetChunkHash(GridCoord.X, GridCoord.Y);
-			ActiveChunkMap.Add(Hash, NewChunk);
+			RegisterChunk(NewChunk);
 			ChunksCreated++;
 		}
 	}
@@ -288,7 +1812,7 @@ void ATerraDyneManager::ImportFromLandscape(ALandscapeProxy* SourceLandscape, bo
 		SourceLandscape->SetActorEnableCollision(false);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("TerraDyne: Import Complete. Resampled %d Chunks."), ChunksCreated);
+	UE_LOG(LogTemp, Log, TEXT("TerraDyne: Import Complete. Decoded %d Chunks in %.2f s."), ChunksCreated, FPlatformTime::Seconds() - StartTime);
 }
 
 #endif
\ No newline at end of file
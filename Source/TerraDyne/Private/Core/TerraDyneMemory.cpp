@@ -0,0 +1,33 @@
+#include "Core/TerraDyneMemory.h"
+#include "Core/TerraDyneManager.h"
+#include "Core/TerraDyneSubsystem.h"
+
+// Engine Includes
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+LLM_DEFINE_TAG(TerraDyne);
+LLM_DEFINE_TAG(TerraDyne_Caches, TEXT("Caches"), TEXT("TerraDyne"));
+LLM_DEFINE_TAG(TerraDyne_RenderTargets, TEXT("RenderTargets"), TEXT("TerraDyne"));
+LLM_DEFINE_TAG(TerraDyne_Collision, TEXT("Collision"), TEXT("TerraDyne"));
+LLM_DEFINE_TAG(TerraDyne_Grass, TEXT("Grass"), TEXT("TerraDyne"));
+LLM_DEFINE_TAG(TerraDyne_Save, TEXT("Save"), TEXT("TerraDyne"));
+
+//--- Console ---//
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTerraDyneMemReport(
+	TEXT("terradyne.MemReport"),
+	TEXT("Prints TerraDyne memory by category and the largest chunks. Optional argument: number of chunks to list (default 20, 0 = all)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UTerraDyneSubsystem* Subsystem = World ? World->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+			ATerraDyneManager* Manager = Subsystem ? Subsystem->GetTerrainManager() : nullptr;
+			if (!Manager)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("TerraDyneMemory: No TerraDyne manager in this world."));
+				return;
+			}
+
+			const int32 MaxChunks = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 20;
+			Manager->DumpMemoryReport(MaxChunks);
+		}));
@@ -0,0 +1,19 @@
+#include "Core/TerraDyneResampler.h"
+
+// TerraDyneCore
+#include "TerraDyneKernels.h"
+
+static_assert(sizeof(FColor) == sizeof(TerraDyneCore::FTexelBGRA), "FColor and FTexelBGRA must share a layout");
+
+void FTerraDyneResampler::ResampleBilinear(const float* Src, int32 SrcWidth, int32 SrcHeight, float* Dst, int32 DstRes)
+{
+	TerraDyneCore::ResampleBilinear(Src, SrcWidth, SrcHeight, Dst, DstRes);
+}
+
+void FTerraDyneResampler::ResampleBilinear(const FColor* Src, int32 SrcWidth, int32 SrcHeight, FColor* Dst, int32 DstRes)
+{
+	// FColor is stored B, G, R, A on every platform UE supports, exactly like FTexelBGRA
+	TerraDyneCore::ResampleBilinear(
+		reinterpret_cast<const TerraDyneCore::FTexelBGRA*>(Src), SrcWidth, SrcHeight,
+		reinterpret_cast<TerraDyneCore::FTexelBGRA*>(Dst), DstRes);
+}
@@ -0,0 +1,49 @@
+#include "Core/TerraDyneStats.h"
+
+DEFINE_STAT(STAT_TerraDyne_BrushKernel);
+DEFINE_STAT(STAT_TerraDyne_PhysicsSync);
+DEFINE_STAT(STAT_TerraDyne_CollisionBuild);
+DEFINE_STAT(STAT_TerraDyne_CollisionCook);
+DEFINE_STAT(STAT_TerraDyne_RTDraw);
+DEFINE_STAT(STAT_TerraDyne_Serialization);
+DEFINE_STAT(STAT_TerraDyne_Compression);
+DEFINE_STAT(STAT_TerraDyne_Grass);
+
+DEFINE_STAT(STAT_TerraDyne_Edits);
+DEFINE_STAT(STAT_TerraDyne_DirtyChunks);
+DEFINE_STAT(STAT_TerraDyne_CookedSections);
+DEFINE_STAT(STAT_TerraDyne_BytesSaved);
+
+CSV_DEFINE_CATEGORY_MODULE(TERRADYNE_API, TerraDyne, false);
+
+UE_TRACE_CHANNEL_DEFINE(TerraDyneChannel);
+
+std::atomic<int32> FTerraDyneFrameCounters::Edits { 0 };
+std::atomic<int32> FTerraDyneFrameCounters::DirtyChunks { 0 };
+std::atomic<int32> FTerraDyneFrameCounters::CookedSections { 0 };
+std::atomic<int64> FTerraDyneFrameCounters::BytesSaved { 0 };
+uint64 FTerraDyneFrameCounters::LastPublishedFrame = 0;
+
+void FTerraDyneFrameCounters::Publish()
+{
+	check(IsInGameThread());
+
+	// Every world's subsystem ticks; the first one each frame publishes for all of them
+	if (LastPublishedFrame == GFrameCounter) return;
+	LastPublishedFrame = GFrameCounter;
+
+	const int32 FrameEdits = Edits.exchange(0, std::memory_order_relaxed);
+	const int32 FrameDirtyChunks = DirtyChunks.exchange(0, std::memory_order_relaxed);
+	const int32 FrameCookedSections = CookedSections.exchange(0, std::memory_order_relaxed);
+	const int64 FrameBytesSaved = BytesSaved.exchange(0, std::memory_order_relaxed);
+
+	SET_DWORD_STAT(STAT_TerraDyne_Edits, FrameEdits);
+	SET_DWORD_STAT(STAT_TerraDyne_DirtyChunks, FrameDirtyChunks);
+	SET_DWORD_STAT(STAT_TerraDyne_CookedSections, FrameCookedSections);
+	SET_DWORD_STAT(STAT_TerraDyne_BytesSaved, (uint32)FMath::Min<int64>(FrameBytesSaved, MAX_uint32));
+
+	CSV_CUSTOM_STAT(TerraDyne, Edits, FrameEdits, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(TerraDyne, DirtyChunks, FrameDirtyChunks, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(TerraDyne, CookedSections, FrameCookedSections, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(TerraDyne, BytesSaved, (float)FrameBytesSaved, ECsvCustomStatOp::Set);
+}
@@ -1,8 +1,23 @@
 #include "Core/TerraDyneSubsystem.h"
 #include "Core/TerraDyneManager.h"
+#include "World/TerraDyneChunk.h"
 #include "Grass/TerraDyneGrassSystem.h"
 #include "IO/TerraDyneAsyncSaver.h"
+#include "Core/TerraDyneWorkerPool.h"
+#include "Core/TerraDyneStats.h"
 #include "Async/TaskGraphInterfaces.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+
+static TAutoConsoleVariable<int32> CVarTerraDyneHeadless(
+	TEXT("terradyne.Headless"),
+	-1,
+	TEXT("-1: auto (headless on dedicated servers and -nullrhi), 0: always render, 1: force headless.\n")
+	TEXT("Read when chunks allocate their resources; a Manager RenderMode other than Auto wins."),
+	ECVF_Default);
 
 void UTerraDyneSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -32,13 +47,49 @@ void UTerraDyneSubsystem::Deinitialize()
 		GrassSystem.Reset();
 	}
 
+	WorkScheduler.Reset();
+	PendingTerrainChanges.Reset();
+	TerrainChangeSubscribers.Reset();
 	ActiveManager.Reset();
+	RegisteredChunks.Reset();
+	PhysicsSources.Reset();
+	CollisionQueryRegions.Reset();
 
 	UE_LOG(LogTemp, Log, TEXT("TerraDyneSubsystem: Deinitialized."));
 
 	Super::Deinitialize();
 }
 
+void UTerraDyneSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	FTerraDyneFrameCounters::Publish();
+	DispatchTerrainChanges();
+
+	if (WorkScheduler.IsEmpty()) return;
+
+	const ATerraDyneManager* Manager = GetTerrainManager();
+	const FTerraDyneWorkBudgets Budgets = Manager ? Manager->WorkBudgets : FTerraDyneWorkBudgets();
+
+	float BudgetsMs[FTerraDyneWorkScheduler::NumCategories];
+	BudgetsMs[(int32)ETerraDyneWorkCategory::Collision] = Budgets.CollisionMs;
+	BudgetsMs[(int32)ETerraDyneWorkCategory::GPUUpload] = Budgets.GPUUploadMs;
+	BudgetsMs[(int32)ETerraDyneWorkCategory::Grass] = Budgets.GrassMs;
+	BudgetsMs[(int32)ETerraDyneWorkCategory::Streaming] = Budgets.StreamingMs;
+	BudgetsMs[(int32)ETerraDyneWorkCategory::Save] = Budgets.SaveMs;
+
+	TArray<FVector> Viewers;
+	GatherViewerLocations(Viewers);
+
+	WorkScheduler.Tick(Viewers, BudgetsMs, Budgets.StarvationSeconds);
+}
+
+TStatId UTerraDyneSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTerraDyneSubsystem, STATGROUP_Tickables);
+}
+
 //--- Manager Registry ---//
 
 void UTerraDyneSubsystem::RegisterManager(ATerraDyneManager* InManager)
@@ -70,6 +121,290 @@ ATerraDyneManager* UTerraDyneSubsystem::GetTerrainManager() const
 	return nullptr;
 }
 
+//--- Chunk Registry ---//
+
+void UTerraDyneSubsystem::RegisterChunk(ATerraDyneChunk* InChunk)
+{
+	if (!InChunk) return;
+
+	RegisteredChunks.AddUnique(InChunk);
+
+	if (ATerraDyneManager* Manager = GetTerrainManager())
+	{
+		Manager->RegisterChunk(InChunk);
+	}
+}
+
+void UTerraDyneSubsystem::UnregisterChunk(ATerraDyneChunk* InChunk)
+{
+	if (!InChunk) return;
+
+	RegisteredChunks.RemoveSwap(InChunk);
+
+	if (ATerraDyneManager* Manager = GetTerrainManager())
+	{
+		Manager->UnregisterChunk(InChunk);
+	}
+}
+
+//--- Physics Sources ---//
+
+void UTerraDyneSubsystem::RegisterPhysicsSource(AActor* Source)
+{
+	if (!Source) return;
+
+	// Drop sources destroyed without unregistering
+	PhysicsSources.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Entry) { return !Entry.IsValid(); });
+	PhysicsSources.AddUnique(Source);
+}
+
+void UTerraDyneSubsystem::UnregisterPhysicsSource(AActor* Source)
+{
+	PhysicsSources.RemoveSwap(Source);
+}
+
+void UTerraDyneSubsystem::GatherPhysicsSources(TArray<AActor*>& OutSources) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PC = It->Get())
+		{
+			if (APawn* Pawn = PC->GetPawn())
+			{
+				OutSources.Add(Pawn);
+			}
+		}
+	}
+
+	for (const TWeakObjectPtr<AActor>& Source : PhysicsSources)
+	{
+		if (AActor* Actor = Source.Get())
+		{
+			OutSources.Add(Actor);
+		}
+	}
+}
+
+void UTerraDyneSubsystem::GatherPhysicsSourceLocations(TArray<FVector>& OutLocations) const
+{
+	TArray<AActor*> Sources;
+	GatherPhysicsSources(Sources);
+
+	OutLocations.Reserve(OutLocations.Num() + Sources.Num());
+	for (const AActor* Source : Sources)
+	{
+		OutLocations.Add(Source->GetActorLocation());
+	}
+}
+
+void UTerraDyneSubsystem::GatherViewerLocations(TArray<FVector>& OutLocations) const
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PC = It->Get();
+		if (!PC) continue;
+
+		if (PC->IsLocalController())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			OutLocations.Add(ViewLocation);
+		}
+		else if (const APawn* Pawn = PC->GetPawn())
+		{
+			OutLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+}
+
+int32 UTerraDyneSubsystem::AddCollisionQueryRegion(FBox WorldBounds)
+{
+	if (!WorldBounds.IsValid) return INDEX_NONE;
+
+	const int32 Handle = NextQueryRegionHandle++;
+	CollisionQueryRegions.Add(Handle, WorldBounds);
+	return Handle;
+}
+
+void UTerraDyneSubsystem::RemoveCollisionQueryRegion(int32 Handle)
+{
+	CollisionQueryRegions.Remove(Handle);
+}
+
+void UTerraDyneSubsystem::GatherCollisionQueryRegions(TArray<FBox>& OutRegions) const
+{
+	OutRegions.Reserve(OutRegions.Num() + CollisionQueryRegions.Num());
+	for (const TPair<int32, FBox>& Pair : CollisionQueryRegions)
+	{
+		OutRegions.Add(Pair.Value);
+	}
+}
+
+//--- Render Mode ---//
+
+bool UTerraDyneSubsystem::IsHeadless() const
+{
+	if (RenderModeOverride != ETerraDyneRenderMode::Auto)
+	{
+		return RenderModeOverride == ETerraDyneRenderMode::Headless;
+	}
+
+	const int32 CVarValue = CVarTerraDyneHeadless.GetValueOnGameThread();
+	if (CVarValue >= 0)
+	{
+		return CVarValue > 0;
+	}
+
+	const UWorld* World = GetWorld();
+	return IsRunningDedicatedServer() || !FApp::CanEverRender() || (World && World->GetNetMode() == NM_DedicatedServer);
+}
+
+//--- Terrain Change Events ---//
+
+// Beyond this many disjoint regions per frame, new ones are folded into their cheapest neighbour
+static constexpr int32 MaxPendingTerrainChanges = 64;
+
+int32 UTerraDyneSubsystem::SubscribeTerrainChanges(const FBox2D& Area, FTerraDyneTerrainChangedDelegate&& Callback)
+{
+	if (!Callback.IsBound()) return 0;
+
+	FTerrainChangeSubscriber& Subscriber = TerrainChangeSubscribers.AddDefaulted_GetRef();
+	Subscriber.Handle = NextTerrainChangeHandle++;
+	Subscriber.Area = Area;
+	Subscriber.Native = MoveTemp(Callback);
+	return Subscriber.Handle;
+}
+
+int32 UTerraDyneSubsystem::SubscribeTerrainChangesBP(FBox2D Area, FTerraDyneTerrainChangedDynamic Callback)
+{
+	if (!Callback.IsBound()) return 0;
+
+	FTerrainChangeSubscriber& Subscriber = TerrainChangeSubscribers.AddDefaulted_GetRef();
+	Subscriber.Handle = NextTerrainChangeHandle++;
+	Subscriber.Area = Area;
+	Subscriber.Dynamic = Callback;
+	return Subscriber.Handle;
+}
+
+void UTerraDyneSubsystem::UnsubscribeTerrainChanges(int32 Handle)
+{
+	TerrainChangeSubscribers.RemoveAll([Handle](const FTerrainChangeSubscriber& Subscriber) { return Subscriber.Handle == Handle; });
+}
+
+void UTerraDyneSubsystem::SetTerrainChangeArea(int32 Handle, FBox2D Area)
+{
+	for (FTerrainChangeSubscriber& Subscriber : TerrainChangeSubscribers)
+	{
+		if (Subscriber.Handle == Handle)
+		{
+			Subscriber.Area = Area;
+			return;
+		}
+	}
+}
+
+void UTerraDyneSubsystem::ReportTerrainChange(const FTerraDyneTerrainChange& Change)
+{
+	if (!Change.Bounds.bIsValid || TerrainChangeSubscribers.Num() == 0) return;
+
+	FTerraDyneTerrainChange Merged = Change;
+
+	// Absorb every pending region we touch; the grown box may touch more, so repeat until stable
+	bool bAbsorbed = true;
+	while (bAbsorbed)
+	{
+		bAbsorbed = false;
+		for (int32 i = PendingTerrainChanges.Num() - 1; i >= 0; i--)
+		{
+			const FTerraDyneTerrainChange& Pending = PendingTerrainChanges[i];
+			if (!Pending.Bounds.Intersect(Merged.Bounds)) continue;
+
+			Merged.Bounds += Pending.Bounds;
+			Merged.MaxHeightDelta = FMath::Max(Merged.MaxHeightDelta, Pending.MaxHeightDelta);
+			Merged.bWeightsChanged |= Pending.bWeightsChanged;
+			PendingTerrainChanges.RemoveAtSwap(i, EAllowShrinking::No);
+			bAbsorbed = true;
+		}
+	}
+
+	if (PendingTerrainChanges.Num() < MaxPendingTerrainChanges)
+	{
+		PendingTerrainChanges.Add(Merged);
+		return;
+	}
+
+	// Too many disjoint regions: grow whichever one needs the least extra area
+	int32 BestIndex = 0;
+	double BestGrowth = TNumericLimits<double>::Max();
+	for (int32 i = 0; i < PendingTerrainChanges.Num(); i++)
+	{
+		const FBox2D& Bounds = PendingTerrainChanges[i].Bounds;
+		const double Growth = (Bounds + Merged.Bounds).GetArea() - Bounds.GetArea();
+		if (Growth < BestGrowth)
+		{
+			BestGrowth = Growth;
+			BestIndex = i;
+		}
+	}
+
+	FTerraDyneTerrainChange& Target = PendingTerrainChanges[BestIndex];
+	Target.Bounds += Merged.Bounds;
+	Target.MaxHeightDelta = FMath::Max(Target.MaxHeightDelta, Merged.MaxHeightDelta);
+	Target.bWeightsChanged |= Merged.bWeightsChanged;
+}
+
+void UTerraDyneSubsystem::DispatchTerrainChanges()
+{
+	if (PendingTerrainChanges.Num() == 0) return;
+
+	// Callbacks may edit terrain or (un)subscribe: both land in the next frame's batch
+	const TArray<FTerraDyneTerrainChange> Changes = MoveTemp(PendingTerrainChanges);
+	PendingTerrainChanges.Reset();
+	const TArray<FTerrainChangeSubscriber> Subscribers = TerrainChangeSubscribers;
+
+	TArray<FTerraDyneTerrainChange> Relevant;
+	TArray<int32> DeadHandles;
+	for (const FTerrainChangeSubscriber& Subscriber : Subscribers)
+	{
+		if (!Subscriber.Native.IsBound() && !Subscriber.Dynamic.IsBound())
+		{
+			DeadHandles.Add(Subscriber.Handle);
+			continue;
+		}
+
+		Relevant.Reset();
+		for (const FTerraDyneTerrainChange& Change : Changes)
+		{
+			if (!Subscriber.Area.bIsValid || Subscriber.Area.Intersect(Change.Bounds))
+			{
+				Relevant.Add(Change);
+			}
+		}
+		if (Relevant.Num() == 0) continue;
+
+		if (Subscriber.Native.IsBound())
+		{
+			Subscriber.Native.Execute(Relevant);
+		}
+		else
+		{
+			Subscriber.Dynamic.Execute(Relevant);
+		}
+	}
+
+	for (int32 Handle : DeadHandles)
+	{
+		UnsubscribeTerrainChanges(Handle);
+	}
+}
+
 //--- Grass System Access ---//
 
 TSharedPtr<FTerraDyneGrassSystem> UTerraDyneSubsystem::GetGrassSystem() const
@@ -81,18 +416,18 @@ TSharedPtr<FTerraDyneGrassSystem> UTerraDyneSubsystem::GetGrassSystem() const
 
 void UTerraDyneSubsystem::FlushPendingTasks()
 {
+	// 0. Launch saves still waiting for their frame budget
+	WorkScheduler.Drain(ETerraDyneWorkCategory::Save);
+
 	// 1. Cancel/Finish Grass Generation checks
 	if (GrassSystem.IsValid())
 	{
 		GrassSystem->CancelAllTasks();
 	}
 
-	// 2. Wait for IO (Thread Pool)
-	// If we have critical save games writing to disk, we generally don't want to kill the process.
-	// FNonAbandonableTasks running on the thread pool usually finish on their own, 
-	// but explicit synchronization can be done here if we tracked specific IO tasks.
-	
-	// In a production environment, you might use a specific FGraphEvent to track active loads/saves
-	// and wait for them:
-	// FTaskGraphInterface::Get().WaitUntilTaskCompletes(MyTrackingHandle);
+	// 2. Wait for IO, collision builds and edit-graph nodes (all TerraDyne worker pool jobs)
+	// Saves are never cancelled, so this returns once every slot file is on disk.
+	// Edit-graph joins queued on the Game Thread by now find their chunk through a weak pointer.
+	// Cancelled jobs finish immediately; completions they would have posted are dropped by their owners.
+	FTerraDyneWorkerPool::Get().WaitForAll();
 }
\ No newline at end of file
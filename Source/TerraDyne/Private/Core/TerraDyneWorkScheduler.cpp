@@ -0,0 +1,219 @@
+#include "Core/TerraDyneWorkScheduler.h"
+
+void FTerraDyneWorkScheduler::FQueue::RebuildIndex()
+{
+	KeyToIndex.Reset();
+	for (int32 i = 0; i < Items.Num(); i++)
+	{
+		if (Items[i].Key)
+		{
+			KeyToIndex.Add(Items[i].Key, i);
+		}
+	}
+}
+
+void FTerraDyneWorkScheduler::Enqueue(ETerraDyneWorkCategory Category, const void* Key, const FVector& Location, TUniqueFunction<void()>&& Work, double Delay)
+{
+	FQueue& Queue = Queues[(int32)Category];
+	const double Now = FPlatformTime::Seconds();
+
+	if (Key)
+	{
+		if (const int32* Existing = Queue.KeyToIndex.Find(Key))
+		{
+			FItem& Item = Queue.Items[*Existing];
+			Item.Location = Location;
+			Item.Work = MoveTemp(Work);
+			Item.ReadyTime = Now + Delay;
+			Stats[(int32)Category].Coalesced++;
+			return;
+		}
+		Queue.KeyToIndex.Add(Key, Queue.Items.Num());
+	}
+
+	FItem& Item = Queue.Items.AddDefaulted_GetRef();
+	Item.Key = Key;
+	Item.Location = Location;
+	Item.Work = MoveTemp(Work);
+	Item.EnqueueTime = Now;
+	Item.ReadyTime = Now + Delay;
+}
+
+void FTerraDyneWorkScheduler::CancelAll(const void* Key)
+{
+	if (!Key) return;
+
+	// Taken out for this tick: mark instead of removing, the loop is iterating them
+	for (TArray<FItem>* Batch : InFlight)
+	{
+		for (FItem& Item : *Batch)
+		{
+			if (Item.Key == Key)
+			{
+				Item.bCancelled = true;
+			}
+		}
+	}
+
+	for (FQueue& Queue : Queues)
+	{
+		if (Queue.KeyToIndex.Contains(Key))
+		{
+			Queue.Items.RemoveAll([Key](const FItem& Item) { return Item.Key == Key; });
+			Queue.RebuildIndex();
+		}
+	}
+}
+
+void FTerraDyneWorkScheduler::Requeue(FQueue& Queue, FItem&& Item)
+{
+	if (Item.Key)
+	{
+		if (const int32* Existing = Queue.KeyToIndex.Find(Item.Key))
+		{
+			// Re-enqueued while we held it: the newer work wins, the older age is kept
+			FItem& Newer = Queue.Items[*Existing];
+			Newer.EnqueueTime = FMath::Min(Newer.EnqueueTime, Item.EnqueueTime);
+			return;
+		}
+		Queue.KeyToIndex.Add(Item.Key, Queue.Items.Num());
+	}
+	Queue.Items.Add(MoveTemp(Item));
+}
+
+void FTerraDyneWorkScheduler::Tick(TConstArrayView<FVector> Viewers, TConstArrayView<float> BudgetsMs, float StarvationSeconds)
+{
+	check(BudgetsMs.Num() == NumCategories);
+
+	for (int32 CategoryIndex = 0; CategoryIndex < NumCategories; CategoryIndex++)
+	{
+		FQueue& Queue = Queues[CategoryIndex];
+		FCategoryStats& CategoryStats = Stats[CategoryIndex];
+		CategoryStats.LastMs = 0.0f;
+		if (Queue.Items.Num() == 0) continue;
+
+		const double Now = FPlatformTime::Seconds();
+
+		// Take the ready items out, so work that enqueues more work can't invalidate our view
+		TArray<FItem> Ready;
+		for (int32 i = Queue.Items.Num() - 1; i >= 0; i--)
+		{
+			if (Queue.Items[i].ReadyTime <= Now)
+			{
+				Ready.Add(MoveTemp(Queue.Items[i]));
+				Queue.Items.RemoveAtSwap(i, EAllowShrinking::No);
+			}
+		}
+		if (Ready.Num() == 0) continue;
+		Queue.RebuildIndex();
+
+		// Starved items first (oldest first), then nearest viewer first
+		for (FItem& Item : Ready)
+		{
+			const double Age = Now - Item.EnqueueTime;
+			if (Age > StarvationSeconds)
+			{
+				Item.Priority = -Age;
+				continue;
+			}
+
+			double BestDistSq = 0.0;
+			for (int32 v = 0; v < Viewers.Num(); v++)
+			{
+				const double DistSq = FVector::DistSquared(Viewers[v], Item.Location);
+				BestDistSq = (v == 0) ? DistSq : FMath::Min(BestDistSq, DistSq);
+			}
+			Item.Priority = BestDistSq;
+		}
+		Ready.Sort([](const FItem& A, const FItem& B) { return A.Priority < B.Priority; });
+
+		const double BudgetSeconds = FMath::Max(BudgetsMs[CategoryIndex], 0.0f) * 0.001;
+		InFlight.Push(&Ready);
+		int32 Next = 0;
+		do
+		{
+			// Work run earlier in this batch may have cancelled the key
+			if (!Ready[Next].bCancelled)
+			{
+				Ready[Next].Work();
+				CategoryStats.Executed++;
+			}
+			Next++;
+		}
+		while (Next < Ready.Num() && FPlatformTime::Seconds() - Now < BudgetSeconds);
+		InFlight.Pop(EAllowShrinking::No);
+
+		CategoryStats.LastMs = (float)((FPlatformTime::Seconds() - Now) * 1000.0);
+		CategoryStats.PeakMs = FMath::Max(CategoryStats.PeakMs, CategoryStats.LastMs);
+
+		for (; Next < Ready.Num(); Next++)
+		{
+			if (!Ready[Next].bCancelled)
+			{
+				Requeue(Queue, MoveTemp(Ready[Next]));
+				CategoryStats.CarriedOver++;
+			}
+		}
+	}
+}
+
+void FTerraDyneWorkScheduler::Drain(ETerraDyneWorkCategory Category)
+{
+	FQueue& Queue = Queues[(int32)Category];
+
+	// Work may enqueue more work in the same category; keep going until it settles
+	while (Queue.Items.Num() > 0)
+	{
+		TArray<FItem> Items = MoveTemp(Queue.Items);
+		Queue.Items.Reset();
+		Queue.KeyToIndex.Reset();
+
+		InFlight.Push(&Items);
+		for (FItem& Item : Items)
+		{
+			if (Item.bCancelled) continue;
+			Item.Work();
+			Stats[(int32)Category].Executed++;
+		}
+		InFlight.Pop(EAllowShrinking::No);
+	}
+}
+
+void FTerraDyneWorkScheduler::Reset()
+{
+	for (FQueue& Queue : Queues)
+	{
+		Queue.Items.Reset();
+		Queue.KeyToIndex.Reset();
+	}
+}
+
+bool FTerraDyneWorkScheduler::IsEmpty() const
+{
+	for (const FQueue& Queue : Queues)
+	{
+		if (Queue.Items.Num() > 0) return false;
+	}
+	return true;
+}
+
+void FTerraDyneWorkScheduler::ResetStats()
+{
+	for (FCategoryStats& CategoryStats : Stats)
+	{
+		CategoryStats = FCategoryStats();
+	}
+}
+
+const TCHAR* FTerraDyneWorkScheduler::GetCategoryName(ETerraDyneWorkCategory Category)
+{
+	switch (Category)
+	{
+	case ETerraDyneWorkCategory::Collision: return TEXT("Collision");
+	case ETerraDyneWorkCategory::GPUUpload: return TEXT("GPUUpload");
+	case ETerraDyneWorkCategory::Grass:     return TEXT("Grass");
+	case ETerraDyneWorkCategory::Streaming: return TEXT("Streaming");
+	case ETerraDyneWorkCategory::Save:      return TEXT("Save");
+	default:                                return TEXT("Unknown");
+	}
+}
@@ -0,0 +1,194 @@
+#include "Core/TerraDyneWorkerPool.h"
+
+// Engine Includes
+#include "Misc/QueuedThreadPool.h"
+#include "Misc/IQueuedWork.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarTerraDyneWorkerThreads(
+	TEXT("terradyne.WorkerThreads"),
+	0,
+	TEXT("Threads in the TerraDyne worker pool. 0 picks half the engine worker count (1..4).\n")
+	TEXT("Read once, when the pool is first used."),
+	ECVF_Default);
+
+static TUniquePtr<FTerraDyneWorkerPool> GTerraDyneWorkerPool;
+
+/** One queued job; deletes itself after running or being abandoned. */
+class FTerraDyneJob final : public IQueuedWork
+{
+public:
+	FTerraDyneJob(FTerraDyneWorkerPool& InOwner, FTerraDyneWorkerPool::FJobFunction&& InWork, FTerraDyneCancellationTokenPtr InToken, FTerraDyneJobGroupPtr InGroup)
+		: Owner(InOwner)
+		, Work(MoveTemp(InWork))
+		, Token(MoveTemp(InToken))
+		, Group(MoveTemp(InGroup))
+	{
+	}
+
+	virtual void DoThreadedWork() override
+	{
+		if (!Token->IsCancelled())
+		{
+			Work(*Token);
+		}
+		Finish();
+	}
+
+	virtual void Abandon() override
+	{
+		Finish();
+	}
+
+private:
+	void Finish()
+	{
+		// The work (and what it captured) is gone before anyone waiting on the group wakes up
+		FTerraDyneWorkerPool& Pool = Owner;
+		FTerraDyneJobGroupPtr FinishedGroup = MoveTemp(Group);
+		delete this;
+		if (FinishedGroup.IsValid())
+		{
+			FinishedGroup->Done();
+		}
+		Pool.OnJobFinished();
+	}
+
+	FTerraDyneWorkerPool& Owner;
+	FTerraDyneWorkerPool::FJobFunction Work;
+	FTerraDyneCancellationTokenPtr Token;
+	FTerraDyneJobGroupPtr Group;
+};
+
+//--- Job Groups ---//
+
+FTerraDyneJobGroup::FTerraDyneJobGroup()
+	: Idle(FPlatformProcess::GetSynchEventFromPool(true))
+{
+	Idle->Trigger();
+}
+
+FTerraDyneJobGroup::~FTerraDyneJobGroup()
+{
+	FPlatformProcess::ReturnSynchEventToPool(Idle);
+}
+
+void FTerraDyneJobGroup::Add()
+{
+	FScopeLock Lock(&Mutex);
+	if (NumOutstanding.fetch_add(1) == 0)
+	{
+		Idle->Reset();
+	}
+}
+
+void FTerraDyneJobGroup::Done()
+{
+	FScopeLock Lock(&Mutex);
+	if (NumOutstanding.fetch_sub(1) == 1)
+	{
+		Idle->Trigger();
+	}
+}
+
+void FTerraDyneJobGroup::Wait() const
+{
+	Idle->Wait();
+
+	// Done() may still hold the lock after triggering; don't let the caller destroy the group under it
+	FScopeLock Lock(&Mutex);
+}
+
+//--- Pool ---//
+
+static EQueuedWorkPriority ToQueuedWorkPriority(ETerraDyneJobPriority Priority)
+{
+	switch (Priority)
+	{
+	case ETerraDyneJobPriority::Interactive: return EQueuedWorkPriority::Highest;
+	case ETerraDyneJobPriority::Streaming:   return EQueuedWorkPriority::High;
+	case ETerraDyneJobPriority::Grass:       return EQueuedWorkPriority::Normal;
+	default:                                 return EQueuedWorkPriority::Low;
+	}
+}
+
+FTerraDyneWorkerPool& FTerraDyneWorkerPool::Get()
+{
+	check(IsInGameThread() || GTerraDyneWorkerPool.IsValid());
+
+	if (!GTerraDyneWorkerPool.IsValid())
+	{
+		GTerraDyneWorkerPool.Reset(new FTerraDyneWorkerPool());
+	}
+	return *GTerraDyneWorkerPool;
+}
+
+void FTerraDyneWorkerPool::Shutdown()
+{
+	GTerraDyneWorkerPool.Reset();
+}
+
+FTerraDyneWorkerPool::FTerraDyneWorkerPool()
+{
+	if (!FPlatformProcess::SupportsMultithreading()) return;
+
+	NumThreads = CVarTerraDyneWorkerThreads.GetValueOnGameThread();
+	if (NumThreads <= 0)
+	{
+		NumThreads = FMath::Clamp(FPlatformMisc::NumberOfWorkerThreadsToSpawn() / 2, 1, 4);
+	}
+
+	Pool = FQueuedThreadPool::Allocate();
+	if (!Pool->Create(NumThreads, 128 * 1024, TPri_BelowNormal, TEXT("TerraDyneWorker")))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneWorkerPool: Failed to create %d threads; jobs will run inline."), NumThreads);
+		delete Pool;
+		Pool = nullptr;
+		NumThreads = 0;
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneWorkerPool: Started %d threads."), NumThreads);
+}
+
+FTerraDyneWorkerPool::~FTerraDyneWorkerPool()
+{
+	WaitForAll();
+
+	if (Pool)
+	{
+		Pool->Destroy();
+		delete Pool;
+		Pool = nullptr;
+	}
+}
+
+FTerraDyneCancellationTokenPtr FTerraDyneWorkerPool::Launch(ETerraDyneJobPriority Priority, FJobFunction&& Work, FTerraDyneCancellationTokenPtr Token, FTerraDyneJobGroupPtr Group)
+{
+	if (!Token.IsValid())
+	{
+		Token = MakeShared<FTerraDyneCancellationToken, ESPMode::ThreadSafe>();
+	}
+
+	AllJobs.Add();
+	if (Group.IsValid())
+	{
+		Group->Add();
+	}
+	FTerraDyneJob* Job = new FTerraDyneJob(*this, MoveTemp(Work), Token, MoveTemp(Group));
+
+	if (Pool)
+	{
+		Pool->AddQueuedWork(Job, ToQueuedWorkPriority(Priority));
+	}
+	else
+	{
+		Job->DoThreadedWork();
+	}
+	return Token;
+}
+
@@ -1,25 +1,50 @@
 #include "Grass/TerraDyneGrassSystem.h"
-#include "Async/AsyncWork.h"
+#include "Core/TerraDyneWorkerPool.h"
+#include "Core/TerraDyneStats.h"
+#include "Core/TerraDyneMemory.h"
 #include "Engine/World.h"
+#include "Async/Async.h"
 
 // --- Background Task Definition --- //
-class FTerraDyneGrassGenTask : public FNonAbandonableTask
+class FTerraDyneGrassGenTask
 {
-	friend class FAutoDeleteAsyncTask<FTerraDyneGrassGenTask>;
-
 	TWeakObjectPtr<UWorld> World;
 	FBox TargetBounds;
 
+	// Reported from the destructor, so a task the pool skips or drops still reports (as not regenerated)
+	TUniqueFunction<void(bool)> OnFinished;
+	bool bRegenerated = false;
+
 public:
-	FTerraDyneGrassGenTask(TWeakObjectPtr<UWorld> InWorld, FBox InBounds)
-		: World(InWorld), TargetBounds(InBounds)
+	FTerraDyneGrassGenTask(TWeakObjectPtr<UWorld> InWorld, FBox InBounds, TUniqueFunction<void(bool)>&& InOnFinished)
+		: World(InWorld), TargetBounds(InBounds), OnFinished(MoveTemp(InOnFinished))
+	{
+	}
+
+	FTerraDyneGrassGenTask(FTerraDyneGrassGenTask&& Other)
+		: World(Other.World), TargetBounds(Other.TargetBounds), OnFinished(MoveTemp(Other.OnFinished)), bRegenerated(Other.bRegenerated)
 	{
+		Other.OnFinished = nullptr;
 	}
 
-	void DoWork()
+	~FTerraDyneGrassGenTask()
+	{
+		if (OnFinished)
+		{
+			AsyncTask(ENamedThreads::GameThread, [OnFinished = MoveTemp(OnFinished), bRegenerated = bRegenerated]()
+				{
+					OnFinished(bRegenerated);
+				});
+		}
+	}
+
+	void DoWork(const FTerraDyneCancellationToken& Token)
 	{
 		// 1. Thread Safety Check
-		if (!World.IsValid()) return;
+		if (Token.IsCancelled() || !World.IsValid()) return;
+
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Grass);
+		TERRADYNE_LLM_SCOPE(Grass);
 
 		// 2. Heavy Math: Calculate Grass Positions
 		// (In a real implementation, you would raycast against the DynamicMesh 
@@ -27,11 +52,8 @@ public:
 
 		// 3. Sync back to Game Thread
 		// Async(ENamedThreads::GameThread, [...](){ ... Update HISM ... });
-	}
 
-	FORCEINLINE TStatId GetStatId() const
-	{
-		RETURN_QUICK_DECLARE_CYCLE_STAT(FTerraDyneGrassGenTask, STATGROUP_ThreadPoolAsyncTasks);
+		bRegenerated = true;
 	}
 };
 
@@ -48,15 +70,33 @@ void FTerraDyneGrassSystem::Shutdown()
 	WorldRef.Reset();
 }
 
-void FTerraDyneGrassSystem::RequestRegen(const FBox& WorldBounds)
+void FTerraDyneGrassSystem::RequestRegen(const FBox& WorldBounds, TUniqueFunction<void(bool)>&& OnFinished)
 {
-	if (!WorldRef.IsValid()) return;
+	if (!WorldRef.IsValid())
+	{
+		if (OnFinished) OnFinished(false);
+		return;
+	}
+
+	if (!TaskToken.IsValid())
+	{
+		TaskToken = MakeShared<FTerraDyneCancellationToken, ESPMode::ThreadSafe>();
+	}
 
 	// Spawn a background task
-	(new FAutoDeleteAsyncTask<FTerraDyneGrassGenTask>(WorldRef, WorldBounds))->StartBackgroundTask();
+	FTerraDyneWorkerPool::Get().Launch(ETerraDyneJobPriority::Grass,
+		[Task = FTerraDyneGrassGenTask(WorldRef, WorldBounds, MoveTemp(OnFinished))](const FTerraDyneCancellationToken& Token) mutable
+		{
+			Task.DoWork(Token);
+		}, TaskToken);
 }
 
 void FTerraDyneGrassSystem::CancelAllTasks()
 {
-	// Logic to invalidate pending tasks would go here
+	// Every task launched so far shares this token; later requests get a fresh one
+	if (TaskToken.IsValid())
+	{
+		TaskToken->Cancel();
+		TaskToken.Reset();
+	}
 }
\ No newline at end of file
@@ -1,65 +1,41 @@
 #include "IO/TerraDyneAsyncSaver.h"
+#include "Core/TerraDyneStats.h"
+#include "Core/TerraDyneMemory.h"
+#include "IO/TerraDyneSerializer.h"
 
 // Engine Includes
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
-#include "Misc/Compression.h"
-#include "Serialization/BufferArchive.h"
-#include "Serialization/MemoryWriter.h"
 #include "HAL/PlatformFilemanager.h"
 
 void FTerraDyneAsyncSaver::DoWork()
 {
+	TERRADYNE_LLM_SCOPE(Save);
+
 	if (!Snapshot.IsValid())
 	{
+		Snapshot.ReturnBuffers();
+		RegionWrite.Release();
+		InFlight.Release();
 		return;
 	}
 
-	// 1. Serialize Raw Data to Memory
-	TArray<uint8> UncompressedBuffer;
-	FMemoryWriter Writer(UncompressedBuffer);
-
-	// --- FILE FORMAT VERSION 1 ---
-	int32 Version = 1;
-	Writer << Version;
-
-	// Identity
-	Writer << Snapshot.GridCoordinate;
-	Writer << Snapshot.Resolution;
-	Writer << Snapshot.RealWorldSize;
-
-	// Payloads
-	Writer << Snapshot.HeightData;
-	Writer << Snapshot.WeightData;
-
-	// 2. Compress Data
-	TArray<uint8> CompressedBuffer;
-	// FIX: Must be non-const for serialization operators, even if writing
-	int32 UncompressedSize = UncompressedBuffer.Num();
-
-	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, UncompressedSize);
-	CompressedBuffer.AddUninitialized(CompressedSize);
-
-	bool bCompressionSuccess = FCompression::CompressMemory(
-		NAME_Zlib,
-		CompressedBuffer.GetData(),
-		CompressedSize,
-		UncompressedBuffer.GetData(),
-		UncompressedSize
-	);
+	TTerraDyneBufferPool<uint8>& BytePool = FTerraDyneSaveBuffers::Bytes();
 
-	if (bCompressionSuccess)
+	// 1-3. Serialize and compress into a pooled file image
+	TArray<uint8> FileBuffer = BytePool.Acquire(UTerraDyneSerializer::GetSerializedBound(Snapshot));
+	if (Region.IsValid())
+	{
+		// 4. Append to the slot's region file (the index is committed by the last write in flight)
+		if (UTerraDyneSerializer::SerializeToBytes(Snapshot, FileBuffer) && Region->Append(Snapshot.GridCoordinate, FileBuffer.GetData(), FileBuffer.Num()))
+		{
+			bWritten = true;
+			FTerraDyneSaveBuffers::RecordSave();
+			FTerraDyneFrameCounters::AddBytesSaved(FileBuffer.Num());
+		}
+	}
+	else if (UTerraDyneSerializer::SerializeToBytes(Snapshot, FileBuffer))
 	{
-		CompressedBuffer.SetNum(CompressedSize);
-
-		// 3. Final Package 
-		FBufferArchive FinalArchive;
-
-		int32 MagicHeader = 0x5444594E; // "TDYN"
-		FinalArchive << MagicHeader;
-		FinalArchive << UncompressedSize; // This line crashed before because UncompressedSize was const
-		FinalArchive << CompressedBuffer;
-
 		// 4. Write to Disk
 		FString Folder = FPaths::GetPath(FilePath);
 		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -68,8 +44,18 @@ void FTerraDyneAsyncSaver::DoWork()
 			PlatformFile.CreateDirectoryTree(*Folder);
 		}
 
-		FFileHelper::SaveArrayToFile(FinalArchive, *FilePath);
+		if (FFileHelper::SaveArrayToFile(FileBuffer, *FilePath))
+		{
+			bWritten = true;
+			FTerraDyneSaveBuffers::RecordSave();
+			FTerraDyneFrameCounters::AddBytesSaved(FileBuffer.Num());
+		}
 	}
+
+	BytePool.Release(MoveTemp(FileBuffer));
+	Snapshot.ReturnBuffers();
+	RegionWrite.Release();
+	InFlight.Release();
 }
 
 //--- Path Helpers ---
@@ -82,4 +68,26 @@ FString FTerraDyneIOPaths::GetSaveSlotPath(FString SlotName)
 FString FTerraDyneIOPaths::GetChunkFilename(FIntPoint Coord)
 {
 	return FString::Printf(TEXT("TD_Chunk_%d_%d.bin"), Coord.X, Coord.Y);
+}
+
+FString FTerraDyneIOPaths::GetRegionFilePath(const FString& SlotName)
+{
+	return GetSaveSlotPath(SlotName) / TEXT("Chunks.tdr");
+}
+
+FString FTerraDyneIOPaths::GetLegacySlotPath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / SlotName;
+}
+
+bool FTerraDyneIOPaths::ParseLegacyChunkFilename(const FString& Filename, FIntPoint& OutCoord)
+{
+	// Chk_<X>_<Y>.bin
+	FString Left, X, Y;
+	const FString Base = FPaths::GetBaseFilename(Filename);
+	if (!Base.Split(TEXT("_"), &Left, &X) || Left != TEXT("Chk") || !X.Split(TEXT("_"), &X, &Y)) return false;
+	if (!X.IsNumeric() || !Y.IsNumeric()) return false;
+
+	OutCoord = FIntPoint(FCString::Atoi(*X), FCString::Atoi(*Y));
+	return true;
 }
\ No newline at end of file
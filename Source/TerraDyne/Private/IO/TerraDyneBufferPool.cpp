@@ -0,0 +1,39 @@
+#include "IO/TerraDyneBufferPool.h"
+
+std::atomic<int64> FTerraDyneSaveBuffers::SavesWritten { 0 };
+std::atomic<int64> FTerraDyneSaveBuffers::LoadsRead { 0 };
+std::atomic<int64> FTerraDyneSaveBuffers::InFlightBytes { 0 };
+
+TTerraDyneBufferPool<uint8>& FTerraDyneSaveBuffers::Bytes()
+{
+	static TTerraDyneBufferPool<uint8> Pool;
+	return Pool;
+}
+
+TTerraDyneBufferPool<float>& FTerraDyneSaveBuffers::Heights()
+{
+	static TTerraDyneBufferPool<float> Pool;
+	return Pool;
+}
+
+TTerraDyneBufferPool<FColor>& FTerraDyneSaveBuffers::Weights()
+{
+	static TTerraDyneBufferPool<FColor> Pool;
+	return Pool;
+}
+
+FTerraDyneBufferPoolStats FTerraDyneSaveBuffers::GetStats()
+{
+	FTerraDyneBufferPoolStats Stats;
+	Bytes().AccumulateStats(Stats);
+	Heights().AccumulateStats(Stats);
+	Weights().AccumulateStats(Stats);
+	return Stats;
+}
+
+void FTerraDyneSaveBuffers::Trim()
+{
+	Bytes().Trim();
+	Heights().Trim();
+	Weights().Trim();
+}
@@ -0,0 +1,562 @@
+#include "IO/TerraDyneRegionFile.h"
+#include "IO/TerraDyneAsyncSaver.h"
+#include "IO/TerraDyneBufferPool.h"
+#include "Core/TerraDyneMemory.h"
+
+// Engine Includes
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+using TerraDyneCore::FRegionEntry;
+using TerraDyneCore::FRegionFileLayout;
+using TerraDyneCore::FRegionHeader;
+
+// How long a writer waits for in-flight mapped reads (one inflate each) to let go of the file
+static constexpr double RegionWriterWaitSeconds = 2.0;
+
+// Every commit appends a fresh index and every save supersedes a frame: rewrite the file once that
+// much is dead and it outweighs the live data (so a file is at most about twice its live size)
+static constexpr int64 RegionAutoCompactMinDeadBytes = 16 * 1024 * 1024;
+
+//--- Scopes ---//
+
+FTerraDyneRegionFile::FWriteScope::FWriteScope(const TSharedRef<FTerraDyneRegionFile>& InFile)
+	: File(InFile)
+{
+	FScopeLock Lock(&File->Mutex);
+	File->PendingWrites++;
+}
+
+void FTerraDyneRegionFile::FWriteScope::Release()
+{
+	if (File.IsValid())
+	{
+		File->EndWrite();
+		File.Reset();
+	}
+}
+
+FTerraDyneRegionFile::FChunkRead::~FChunkRead()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	if (Bytes.GetAllocatedSize() > 0)
+	{
+		FTerraDyneSaveBuffers::Bytes().Release(MoveTemp(Bytes));
+	}
+}
+
+//--- Registry ---//
+
+TSharedRef<FTerraDyneRegionFile> FTerraDyneRegionFile::Get(const FString& SlotName)
+{
+	static FCriticalSection RegistryMutex;
+	static TMap<FString, TSharedRef<FTerraDyneRegionFile>> Registry;
+
+	const FString Path = FTerraDyneIOPaths::GetRegionFilePath(SlotName);
+
+	FScopeLock Lock(&RegistryMutex);
+	if (const TSharedRef<FTerraDyneRegionFile>* Existing = Registry.Find(Path))
+	{
+		return *Existing;
+	}
+
+	// Still under the registry lock: nobody reads the slot before its legacy saves are in
+	TSharedRef<FTerraDyneRegionFile> File = Registry.Add(Path, MakeShared<FTerraDyneRegionFile>(Path));
+	File->ImportLegacyChunks(SlotName);
+	return File;
+}
+
+FTerraDyneRegionFile::FTerraDyneRegionFile(const FString& InFilePath)
+	: FilePath(InFilePath)
+{
+}
+
+FTerraDyneRegionFile::~FTerraDyneRegionFile()
+{
+	FScopeLock Lock(&Mutex);
+	CommitLocked();
+}
+
+void FTerraDyneRegionFile::ImportLegacyChunks(const FString& SlotName)
+{
+	const FString LegacyFolder = FTerraDyneIOPaths::GetLegacySlotPath(SlotName);
+	TArray<FString> LegacyFiles;
+	IFileManager::Get().FindFiles(LegacyFiles, *(LegacyFolder / FTerraDyneIOPaths::GetLegacyChunkWildcard()), true, false);
+	if (LegacyFiles.Num() == 0) return;
+
+	TERRADYNE_LLM_SCOPE(Save);
+
+	// Legacy files hold the very frames Append() expects
+	TTerraDyneBufferPool<uint8>& BytePool = FTerraDyneSaveBuffers::Bytes();
+	TArray<uint8> Frame = BytePool.Acquire(0);
+	TArray<FString> Imported;
+	for (const FString& Filename : LegacyFiles)
+	{
+		FIntPoint Coord;
+		if (!FTerraDyneIOPaths::ParseLegacyChunkFilename(Filename, Coord)) continue;
+
+		const FString LegacyPath = LegacyFolder / Filename;
+		if (Contains(Coord))
+		{
+			Imported.Add(LegacyPath); // Saved again since: the region frame is newer
+			continue;
+		}
+
+		Frame.Reset();
+		if (FFileHelper::LoadFileToArray(Frame, *LegacyPath) && Append(Coord, Frame.GetData(), Frame.Num()))
+		{
+			Imported.Add(LegacyPath);
+		}
+	}
+	BytePool.Release(MoveTemp(Frame));
+
+	// Only delete what the committed index now covers
+	if (Imported.Num() == 0 || !Commit()) return;
+	for (const FString& LegacyPath : Imported)
+	{
+		IFileManager::Get().Delete(*LegacyPath);
+	}
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneRegionFile: Imported %d legacy chunk saves from %s into %s"), Imported.Num(), *LegacyFolder, *FilePath);
+}
+
+//--- Index ---//
+
+void FTerraDyneRegionFile::LoadIndexLocked()
+{
+	if (bIndexLoaded) return;
+	bIndexLoaded = true;
+	AppendOffset = FRegionFileLayout::HeaderSize;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TUniquePtr<IFileHandle> Reader(PlatformFile.OpenRead(*FilePath));
+	if (!Reader) return; // Nothing saved in this slot yet
+
+	const int64 FileSize = Reader->Size();
+	uint8 HeaderBytes[FRegionFileLayout::HeaderSize];
+	FRegionHeader Header;
+	if (!Reader->Read(HeaderBytes, sizeof(HeaderBytes)) || !FRegionFileLayout::ReadHeader(HeaderBytes, sizeof(HeaderBytes), FileSize, Header))
+	{
+		// Never overwrite what might still be recovered by hand
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneRegionFile: %s has no valid header; new saves are appended past it."), *FilePath);
+		AppendOffset = FMath::Max<int64>(FileSize, FRegionFileLayout::HeaderSize);
+		return;
+	}
+
+	TArray<uint8> IndexBytes;
+	IndexBytes.SetNumUninitialized(FRegionFileLayout::GetIndexSize(Header.NumEntries));
+	TArray<FRegionEntry> Entries;
+	Entries.SetNum(Header.NumEntries);
+
+	if (!Reader->Seek(Header.IndexOffset) || !Reader->Read(IndexBytes.GetData(), IndexBytes.Num()) ||
+		!FRegionFileLayout::ReadIndex(IndexBytes.GetData(), IndexBytes.Num(), Header, Entries.GetData()))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneRegionFile: %s has a corrupt index; new saves are appended past it."), *FilePath);
+		AppendOffset = FMath::Max<int64>(FileSize, FRegionFileLayout::HeaderSize);
+		return;
+	}
+
+	Index.Reserve(Entries.Num());
+	for (const FRegionEntry& Entry : Entries)
+	{
+		Index.Add(FIntPoint(Entry.GridX, Entry.GridY), Entry);
+	}
+
+	// Frames written after the last commit were never indexed: overwrite them
+	AppendOffset = Header.CommittedEnd;
+}
+
+TArray<FRegionEntry> FTerraDyneRegionFile::GetSortedEntriesLocked() const
+{
+	TArray<FRegionEntry> Entries;
+	Index.GenerateValueArray(Entries);
+	Entries.Sort([](const FRegionEntry& A, const FRegionEntry& B)
+		{
+			return A.GridY != B.GridY ? A.GridY < B.GridY : A.GridX < B.GridX;
+		});
+	return Entries;
+}
+
+int64 FTerraDyneRegionFile::GetLiveBytesLocked() const
+{
+	int64 Live = 0;
+	for (const TPair<FIntPoint, FRegionEntry>& Pair : Index)
+	{
+		Live += Pair.Value.Size;
+	}
+	return Live;
+}
+
+//--- Writes ---//
+
+bool FTerraDyneRegionFile::EnsureWriterLocked()
+{
+	if (Writer) return true;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString Folder = FPaths::GetPath(FilePath);
+	if (!PlatformFile.DirectoryExists(*Folder))
+	{
+		PlatformFile.CreateDirectoryTree(*Folder);
+	}
+
+	const bool bNewFile = !PlatformFile.FileExists(*FilePath);
+	Writer.Reset(PlatformFile.OpenWrite(*FilePath, true, true));
+
+	// Some platforms map without write sharing: wait for the reads still mapping the file (no new ones start under the lock)
+	const double Deadline = FPlatformTime::Seconds() + RegionWriterWaitSeconds;
+	while (!Writer && MappedFile.IsValid() && FPlatformTime::Seconds() < Deadline)
+	{
+		FPlatformProcess::Sleep(0.001f);
+		Writer.Reset(PlatformFile.OpenWrite(*FilePath, true, true));
+	}
+
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerraDyneRegionFile: Cannot open %s for writing"), *FilePath);
+		return false;
+	}
+
+	if (bNewFile)
+	{
+		// Valid (and empty) from the first byte on
+		uint8 HeaderBytes[FRegionFileLayout::HeaderSize];
+		FRegionFileLayout::WriteHeader(FRegionFileLayout::MakeEmptyHeader(), HeaderBytes);
+		Writer->Seek(0);
+		Writer->Write(HeaderBytes, sizeof(HeaderBytes));
+	}
+	return true;
+}
+
+bool FTerraDyneRegionFile::Append(FIntPoint Coord, const uint8* Frame, int64 Size)
+{
+	if (!Frame || Size <= 0 || Size > MAX_int32) return false;
+
+	FScopeLock Lock(&Mutex);
+	LoadIndexLocked();
+	if (!EnsureWriterLocked()) return false;
+
+	if (!Writer->Seek(AppendOffset) || !Writer->Write(Frame, Size))
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerraDyneRegionFile: Failed to append chunk %s to %s"), *Coord.ToString(), *FilePath);
+		return false;
+	}
+
+	FRegionEntry& Entry = Index.FindOrAdd(Coord);
+	Entry.GridX = Coord.X;
+	Entry.GridY = Coord.Y;
+	Entry.Offset = AppendOffset;
+	Entry.Size = (int32)Size;
+
+	AppendOffset += Size;
+	bIndexDirty = true;
+	return true;
+}
+
+void FTerraDyneRegionFile::EndWrite()
+{
+	bool bCompact = false;
+	{
+		FScopeLock Lock(&Mutex);
+		if (--PendingWrites == 0)
+		{
+			bCompact = CommitLocked() && ShouldAutoCompactLocked();
+		}
+	}
+
+	if (bCompact)
+	{
+		Compact();
+	}
+}
+
+bool FTerraDyneRegionFile::ShouldAutoCompactLocked() const
+{
+	if (PendingWrites > 0 || bCompacting || MappedFile.IsValid()) return false;
+
+	const int64 Live = GetLiveBytesLocked();
+	const int64 Dead = AppendOffset - (int64)FRegionFileLayout::HeaderSize - Live;
+	return Dead >= RegionAutoCompactMinDeadBytes && Dead > Live;
+}
+
+bool FTerraDyneRegionFile::Commit()
+{
+	FScopeLock Lock(&Mutex);
+	return CommitLocked();
+}
+
+bool FTerraDyneRegionFile::CommitLocked()
+{
+	if (!bIndexDirty) return true;
+	if (!EnsureWriterLocked()) return false;
+
+	TERRADYNE_LLM_SCOPE(Save);
+
+	const TArray<FRegionEntry> Entries = GetSortedEntriesLocked();
+	TArray<uint8> IndexBytes;
+	IndexBytes.SetNumUninitialized(FRegionFileLayout::GetIndexSize(Entries.Num()));
+	FRegionFileLayout::WriteIndex(Entries.GetData(), Entries.Num(), IndexBytes.GetData());
+
+	FRegionHeader Header;
+	Header.NumEntries = Entries.Num();
+	Header.IndexOffset = AppendOffset;
+	Header.CommittedEnd = AppendOffset + IndexBytes.Num();
+
+	uint8 HeaderBytes[FRegionFileLayout::HeaderSize];
+	FRegionFileLayout::WriteHeader(Header, HeaderBytes);
+
+	// Index first and flushed, header last: a crash in between keeps the previous commit
+	const bool bCommitted =
+		Writer->Seek(Header.IndexOffset) && Writer->Write(IndexBytes.GetData(), IndexBytes.Num()) && Writer->Flush() &&
+		Writer->Seek(0) && Writer->Write(HeaderBytes, sizeof(HeaderBytes)) && Writer->Flush();
+
+	if (!bCommitted)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerraDyneRegionFile: Failed to commit the index of %s"), *FilePath);
+		return false;
+	}
+
+	// The next frames go after this index; it becomes dead weight once superseded
+	AppendOffset = Header.CommittedEnd;
+	bIndexDirty = false;
+	Writer.Reset();
+	return true;
+}
+
+bool FTerraDyneRegionFile::Compact()
+{
+	// 1. Under the lock: commit, then take the live frames as of now
+	TArray<FRegionEntry> Entries;
+	{
+		FScopeLock Lock(&Mutex);
+		LoadIndexLocked();
+		if (bCompacting || !CommitLocked()) return false;
+
+		// Outstanding reads still point into the old file
+		if (MappedFile.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TerraDyneRegionFile: %s is being read; compaction skipped."), *FilePath);
+			return false;
+		}
+		if (Index.Num() == 0) return true;
+
+		Entries = GetSortedEntriesLocked();
+		bCompacting = true; // Reads stop mapping the file until the swap
+	}
+
+	TERRADYNE_LLM_SCOPE(Save);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString TempPath = FilePath + TEXT(".compact");
+	TUniquePtr<IFileHandle> Source(PlatformFile.OpenRead(*FilePath, true));
+	TUniquePtr<IFileHandle> Target(PlatformFile.OpenWrite(*TempPath));
+
+	TTerraDyneBufferPool<uint8>& BytePool = FTerraDyneSaveBuffers::Bytes();
+	TArray<uint8> Frame = BytePool.Acquire(0);
+	int64 Offset = FRegionFileLayout::HeaderSize;
+	auto CopyFrame = [&Source, &Target, &Frame, &Offset](FRegionEntry& Entry)
+		{
+			Frame.SetNumUninitialized(Entry.Size, EAllowShrinking::No);
+			if (!Source->Seek(Entry.Offset) || !Source->Read(Frame.GetData(), Entry.Size) || !Target->Write(Frame.GetData(), Entry.Size)) return false;
+			Entry.Offset = Offset;
+			Offset += Entry.Size;
+			return true;
+		};
+
+	// 2. Without the lock: committed frames never change and saves only append past them, so the bulk
+	//    of the copy runs while saves and reads go on. Live frames back to back, in index order.
+	TMap<FIntPoint, TPair<int64, int64>> Moved; // Cell -> (offset in the old file, offset in the new one)
+	Moved.Reserve(Entries.Num());
+	bool bCopied = Source && Target && Target->Seek(Offset);
+	for (FRegionEntry& Entry : Entries)
+	{
+		const int64 OldOffset = Entry.Offset;
+		bCopied = bCopied && CopyFrame(Entry);
+		if (!bCopied) break;
+		Moved.Add(FIntPoint(Entry.GridX, Entry.GridY), TPair<int64, int64>(OldOffset, Entry.Offset));
+	}
+
+	// 3. Under the lock again: frames saved meanwhile, the index and the swap
+	FScopeLock Lock(&Mutex);
+	bCompacting = false;
+	bCopied = bCopied && CommitLocked(); // Also closes the writer, so the old file can be moved
+
+	Entries = GetSortedEntriesLocked();
+	for (FRegionEntry& Entry : Entries)
+	{
+		const TPair<int64, int64>* Copy = Moved.Find(FIntPoint(Entry.GridX, Entry.GridY));
+		if (Copy && Copy->Key == Entry.Offset)
+		{
+			Entry.Offset = Copy->Value;
+		}
+		else
+		{
+			bCopied = bCopied && CopyFrame(Entry); // New, or saved again during the copy
+		}
+	}
+	BytePool.Release(MoveTemp(Frame));
+
+	TArray<uint8> IndexBytes;
+	IndexBytes.SetNumUninitialized(FRegionFileLayout::GetIndexSize(Entries.Num()));
+	FRegionFileLayout::WriteIndex(Entries.GetData(), Entries.Num(), IndexBytes.GetData());
+
+	FRegionHeader Header;
+	Header.NumEntries = Entries.Num();
+	Header.IndexOffset = Offset;
+	Header.CommittedEnd = Offset + IndexBytes.Num();
+
+	uint8 HeaderBytes[FRegionFileLayout::HeaderSize];
+	FRegionFileLayout::WriteHeader(Header, HeaderBytes);
+
+	bCopied = bCopied && Target->Write(IndexBytes.GetData(), IndexBytes.Num()) &&
+		Target->Seek(0) && Target->Write(HeaderBytes, sizeof(HeaderBytes)) && Target->Flush(true);
+	Source.Reset();
+	Target.Reset();
+
+	// A read that mapped the file before the copy started would pin it (the mapping check above ran unlocked since)
+	bCopied = bCopied && !MappedFile.IsValid();
+
+	// Swap through a backup, so the slot is never left without a complete file
+	const FString BackupPath = FilePath + TEXT(".old");
+	PlatformFile.DeleteFile(*BackupPath);
+	bool bSwapped = bCopied && PlatformFile.MoveFile(*BackupPath, *FilePath);
+	if (bSwapped && !PlatformFile.MoveFile(*FilePath, *TempPath))
+	{
+		PlatformFile.MoveFile(*FilePath, *BackupPath);
+		bSwapped = false;
+	}
+
+	if (!bSwapped)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerraDyneRegionFile: Compaction of %s failed; the original is kept."), *FilePath);
+		PlatformFile.DeleteFile(*TempPath);
+		return false;
+	}
+	PlatformFile.DeleteFile(*BackupPath);
+
+	const int64 OldSize = AppendOffset;
+	Generation++;
+	for (const FRegionEntry& Entry : Entries)
+	{
+		Index[FIntPoint(Entry.GridX, Entry.GridY)] = Entry;
+	}
+	AppendOffset = Header.CommittedEnd;
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneRegionFile: Compacted %s from %.2f MB to %.2f MB (%d chunks)"),
+		*FilePath, OldSize / (1024.0 * 1024.0), AppendOffset / (1024.0 * 1024.0), Entries.Num());
+	return true;
+}
+
+//--- Reads ---//
+
+bool FTerraDyneRegionFile::Read(FIntPoint Coord, FChunkRead& Out)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Frames never move, except when a compaction swaps the file in between: then look the cell up again
+	for (int32 Attempt = 0; Attempt < 2; Attempt++)
+	{
+		FRegionEntry Entry;
+		uint32 ReadGeneration;
+		{
+			FScopeLock Lock(&Mutex);
+			LoadIndexLocked();
+
+			const FRegionEntry* Found = Index.Find(Coord);
+			if (!Found) return false;
+			Entry = *Found;
+			ReadGeneration = Generation;
+
+			// Never map while a writer is open (a mapping without write sharing would fail it, or fail itself),
+			// nor during a compaction (the mapping would pin the file it swaps out)
+			if (!Writer && !bCompacting && MapLocked(Entry, Out)) return true;
+		}
+
+		// No mapping on this platform, the file is busy, or the frame is newer than the mapping:
+		// one read into pooled memory, outside the lock
+		TUniquePtr<IFileHandle> Reader(PlatformFile.OpenRead(*FilePath, true));
+		if (!Reader) return false;
+
+		if (Out.Bytes.GetAllocatedSize() == 0)
+		{
+			Out.Bytes = FTerraDyneSaveBuffers::Bytes().Acquire(Entry.Size);
+		}
+		Out.Bytes.SetNumUninitialized(Entry.Size, EAllowShrinking::No);
+		const bool bRead = Reader->Seek(Entry.Offset) && Reader->Read(Out.Bytes.GetData(), Entry.Size);
+		Reader.Reset();
+
+		FScopeLock Lock(&Mutex);
+		if (Generation == ReadGeneration) return bRead;
+	}
+	return false;
+}
+
+bool FTerraDyneRegionFile::MapLocked(const FRegionEntry& Entry, FChunkRead& Out)
+{
+	// Shared with the reads in flight. Only one mapping at a time (so MappedFile sees every reader):
+	// a frame appended since it was mapped lies past its size and is read instead.
+	TSharedPtr<IMappedFileHandle> Mapped = MappedFile.Pin();
+	if (!Mapped.IsValid())
+	{
+		Mapped = MakeShareable(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+		MappedFile = Mapped;
+	}
+
+	if (!Mapped.IsValid() || Mapped->GetFileSize() < Entry.Offset + Entry.Size) return false;
+
+	Out.MappedRegion.Reset(Mapped->MapRegion(Entry.Offset, Entry.Size));
+	if (!Out.MappedRegion) return false;
+
+	Out.MappedFile = MoveTemp(Mapped);
+	return true;
+}
+
+bool FTerraDyneRegionFile::Contains(FIntPoint Coord)
+{
+	FScopeLock Lock(&Mutex);
+	LoadIndexLocked();
+	return Index.Contains(Coord);
+}
+
+int32 FTerraDyneRegionFile::GetNumChunks()
+{
+	FScopeLock Lock(&Mutex);
+	LoadIndexLocked();
+	return Index.Num();
+}
+
+int64 FTerraDyneRegionFile::GetDeadBytes()
+{
+	FScopeLock Lock(&Mutex);
+	LoadIndexLocked();
+	return FMath::Max<int64>(AppendOffset - (int64)FRegionFileLayout::HeaderSize - GetLiveBytesLocked(), 0);
+}
+
+//--- Console ---//
+
+static FAutoConsoleCommand CmdTerraDyneRegion(
+	TEXT("terradyne.Region"),
+	TEXT("Prints the region file of a save slot. 'terradyne.Region <Slot> compact' also drops superseded frames."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			if (Args.Num() == 0)
+			{
+				UE_LOG(LogTemp, Log, TEXT("TerraDyneRegionFile: Usage: terradyne.Region <Slot> [compact]"));
+				return;
+			}
+
+			const TSharedRef<FTerraDyneRegionFile> File = FTerraDyneRegionFile::Get(Args[0]);
+			if (Args.Num() > 1 && Args[1].Equals(TEXT("compact"), ESearchCase::IgnoreCase))
+			{
+				File->Compact();
+			}
+
+			UE_LOG(LogTemp, Log, TEXT("TerraDyneRegionFile: %s: %d chunks, %.2f MB on disk, %.2f MB reclaimable"),
+				*File->GetFilePath(), File->GetNumChunks(),
+				FMath::Max<int64>(IFileManager::Get().FileSize(*File->GetFilePath()), 0) / (1024.0 * 1024.0), File->GetDeadBytes() / (1024.0 * 1024.0));
+		}));
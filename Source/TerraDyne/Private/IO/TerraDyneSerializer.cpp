@@ -1,93 +1,237 @@
 #include "IO/TerraDyneSerializer.h"
+#include "Core/TerraDyneStats.h"
+#include "Core/TerraDyneMemory.h"
+
+// TerraDyneCore
+#include "TerraDyneChunkCodec.h"
 
 // Engine Includes
 #include "Misc/FileHelper.h"
-#include "Misc/Compression.h"
-#include "Serialization/MemoryReader.h"
-
-// Magic Header used to verify file integrity (matches Saver)
-const int32 TERRADYNE_MAGIC = 0x5444594E; // "TDYN"
+#include "HAL/FileManager.h"
 
 bool UTerraDyneSerializer::LoadChunkFromDisk(const FString& FilePath, FTerraDyneChunkSnapshot& OutSnapshot)
 {
 	if (FilePath.IsEmpty()) return false;
 
-	TArray<uint8> FileBytes;
-	if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+	// File likely doesn't exist yet (not saved), which is fine.
+	const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+	if (FileSize <= 0) return false;
+
+	TERRADYNE_LLM_SCOPE(Save);
+
+	TTerraDyneBufferPool<uint8>& BytePool = FTerraDyneSaveBuffers::Bytes();
+	TArray<uint8> FileBytes = BytePool.Acquire(FileSize);
+
+	bool bLoaded = false;
+	if (FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+	{
+		bLoaded = DeserializeFromBytes(FileBytes, OutSnapshot);
+	}
+
+	BytePool.Release(MoveTemp(FileBytes));
+	if (bLoaded)
 	{
-		// File likely doesn't exist yet (not saved), which is fine.
-		return false; 
+		FTerraDyneSaveBuffers::RecordLoad();
 	}
+	return bLoaded;
+}
+
+bool UTerraDyneSerializer::LoadChunkFromRegion(FTerraDyneRegionFile& Region, FIntPoint Coord, FTerraDyneChunkSnapshot& OutSnapshot)
+{
+	TERRADYNE_LLM_SCOPE(Save);
 
-	return DeserializeFromBytes(FileBytes, OutSnapshot);
+	// Most cells were never saved: that is an index lookup, not a file system probe
+	FTerraDyneRegionFile::FChunkRead Frame;
+	if (!Region.Read(Coord, Frame)) return false;
+
+	const bool bLoaded = DeserializeFromMemory(Frame.GetData(), Frame.Num(), OutSnapshot);
+	if (bLoaded)
+	{
+		FTerraDyneSaveBuffers::RecordLoad();
+	}
+	return bLoaded;
 }
 
 bool UTerraDyneSerializer::DeserializeFromBytes(const TArray<uint8>& Bytes, FTerraDyneChunkSnapshot& OutSnapshot)
 {
-	if (Bytes.Num() < 8) return false; // Too small for header
+	return DeserializeFromMemory(Bytes.GetData(), Bytes.Num(), OutSnapshot);
+}
 
-	FMemoryReader Loader(Bytes, true); // True = persistent (doesn't matter here since we copy)
+bool UTerraDyneSerializer::DeserializeFromMemory(const uint8* Data, int64 Size, FTerraDyneChunkSnapshot& OutSnapshot)
+{
+	using TerraDyneCore::FChunkCodec;
 
-	// 1. Check Header
-	int32 Magic;
-	Loader << Magic;
-	if (Magic != TERRADYNE_MAGIC)
+	// 1. Check Header and locate the Compressed Payload (decompressed in place, no copy)
+	TerraDyneCore::FChunkFrameView Frame;
+	if (!Data || Size <= 0 || !FChunkCodec::ReadFrame(Data, Size, Frame))
 	{
 		UE_LOG(LogTemp, Warning, TEXT("TerraDyneSerializer: Invalid File Header"));
 		return false;
 	}
 
-	// 2. Read Meta
-	int32 UncompressedSize = 0;
-	Loader << UncompressedSize;
+	// 2. Decompress into pooled memory
+	TTerraDyneBufferPool<uint8>& BytePool = FTerraDyneSaveBuffers::Bytes();
+	TArray<uint8> UncompressedBytes = BytePool.Acquire(Frame.UncompressedSize);
+	UncompressedBytes.SetNumUninitialized(Frame.UncompressedSize, EAllowShrinking::No);
 
-	// 3. Read Compressed Payload
-	TArray<uint8> CompressedBuffer;
-	Loader << CompressedBuffer;
+	bool bUncompressSuccess;
+	{
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Compression);
+		bUncompressSuccess = FChunkCodec::DecompressFrame(Frame, UncompressedBytes.GetData(), UncompressedBytes.Num());
+	}
 
-	// safety check
-	if (UncompressedSize <= 0 || CompressedBuffer.Num() == 0) return false;
+	bool bRead = false;
+	if (!bUncompressSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerraDyneSerializer: Decompression Failed"));
+	}
+	else
+	{
+		// 3. Serialize Object Data
+		bRead = ReadSnapshotFromPayload(UncompressedBytes.GetData(), UncompressedBytes.Num(), OutSnapshot);
+	}
 
-	// 4. Decompress
-	TArray<uint8> UncompressedBytes;
-	UncompressedBytes.SetNum(UncompressedSize);
+	BytePool.Release(MoveTemp(UncompressedBytes));
+	return bRead;
+}
 
-	bool bUncompressSuccess = FCompression::UncompressMemory(
-		NAME_Zlib,
-		UncompressedBytes.GetData(),
-		UncompressedSize,
-		CompressedBuffer.GetData(),
-		CompressedBuffer.Num()
-	);
+int64 UTerraDyneSerializer::GetSerializedBound(const FTerraDyneChunkSnapshot& Snapshot)
+{
+	using TerraDyneCore::FChunkCodec;
 
-	if (!bUncompressSuccess)
+	// A delta payload is only written when it is smaller than the full one
+	return (int64)FChunkCodec::GetFrameBound(FChunkCodec::GetPayloadSize(Snapshot.HeightData.Num(), Snapshot.WeightData.Num()));
+}
+
+bool UTerraDyneSerializer::SerializeToBytes(const FTerraDyneChunkSnapshot& Snapshot, TArray<uint8>& OutBytes)
+{
+	using TerraDyneCore::FChunkCodec;
+
+	TTerraDyneBufferPool<uint8>& BytePool = FTerraDyneSaveBuffers::Bytes();
+
+	// 1. Serialize Raw Data straight into pooled memory (FChunkCodec knows the exact size up front)
+	TerraDyneCore::FChunkInfo Info;
+	Info.GridX = Snapshot.GridCoordinate.X;
+	Info.GridY = Snapshot.GridCoordinate.Y;
+	Info.Resolution = Snapshot.Resolution;
+	Info.RealWorldSize = Snapshot.RealWorldSize;
+
+	// A loaded delta is only the blocks; it has to be laid over its tile (ApplySnapshot) before it can be saved again
+	if (Snapshot.bPackedDelta)
 	{
-		UE_LOG(LogTemp, Error, TEXT("TerraDyneSerializer: Decompression Failed"));
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneSerializer: Snapshot %s is a packed delta; apply it to its chunk before saving."), *Snapshot.GridCoordinate.ToString());
+		OutBytes.Reset();
 		return false;
 	}
 
-	// 5. Serialize Object Data
-	FMemoryReader Ar(UncompressedBytes, true);
-	return ReadSnapshotFromArchive(Ar, OutSnapshot);
+	const int32 NumHeights = Snapshot.HeightData.Num();
+	const int32 NumWeights = Snapshot.WeightData.Num();
+	const TerraDyneCore::FTexelBGRA* Weights = reinterpret_cast<const TerraDyneCore::FTexelBGRA*>(Snapshot.WeightData.GetData());
+	const int64 FullPayloadSize = (int64)FChunkCodec::GetPayloadSize(NumHeights, NumWeights);
+
+	// v2 when the chunk still sits on its baked tile and the modified blocks are the smaller encoding
+	const bool bCanDelta = Snapshot.BaseHash != 0 && NumHeights == Snapshot.Resolution * Snapshot.Resolution && NumWeights == NumHeights;
+	const int64 DeltaPayloadSize = bCanDelta
+		? (int64)FChunkCodec::GetDeltaPayloadSize(Snapshot.Resolution, FChunkCodec::DeltaBlockSize, Snapshot.DeltaBlocks.GetData(), Snapshot.DeltaBlocks.Num())
+		: MAX_int64;
+	const bool bWriteDelta = DeltaPayloadSize < FullPayloadSize;
+	const int64 PayloadSize = bWriteDelta ? DeltaPayloadSize : FullPayloadSize;
+
+	TArray<uint8> UncompressedBuffer = BytePool.Acquire(PayloadSize);
+	UncompressedBuffer.SetNumUninitialized(PayloadSize, EAllowShrinking::No);
+	{
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Serialization);
+		if (bWriteDelta)
+		{
+			FChunkCodec::WriteDeltaPayload(Info, Snapshot.BaseHash, FChunkCodec::DeltaBlockSize,
+				Snapshot.DeltaBlocks.GetData(), Snapshot.DeltaBlocks.Num(),
+				Snapshot.HeightData.GetData(), Weights, UncompressedBuffer.GetData());
+		}
+		else
+		{
+			FChunkCodec::WritePayload(Info, Snapshot.HeightData.GetData(), NumHeights, Weights, NumWeights, UncompressedBuffer.GetData());
+		}
+	}
+
+	// 2. Compress Data into a complete frame (Magic, UncompressedSize, CompressedSize, zlib stream)
+	const int64 FrameBound = (int64)FChunkCodec::GetFrameBound(PayloadSize);
+	OutBytes.SetNumUninitialized(FrameBound, EAllowShrinking::No);
+
+	size_t FrameSize = 0;
+	bool bCompressionSuccess;
+	{
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Compression);
+		bCompressionSuccess = FChunkCodec::CompressFrame(UncompressedBuffer.GetData(), PayloadSize, OutBytes.GetData(), FrameBound, FrameSize);
+	}
+
+	if (bCompressionSuccess)
+	{
+		OutBytes.SetNum((int32)FrameSize, EAllowShrinking::No);
+	}
+	else
+	{
+		OutBytes.Reset();
+	}
+
+	BytePool.Release(MoveTemp(UncompressedBuffer));
+	return bCompressionSuccess;
 }
 
-bool UTerraDyneSerializer::ReadSnapshotFromArchive(FArchive& Ar, FTerraDyneChunkSnapshot& OutSnapshot)
+bool UTerraDyneSerializer::ReadSnapshotFromPayload(const uint8* Data, int64 Size, FTerraDyneChunkSnapshot& OutSnapshot)
 {
-	// Must match the write order in TerraDyneAsyncSaver.cpp
-	
-	int32 Version = 0;
-	Ar << Version;
+	// Layout is owned by FChunkCodec, shared with FTerraDyneAsyncSaver
+	TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Serialization);
+
+	using TerraDyneCore::FChunkCodec;
 
-	if (Version == 1)
+	TerraDyneCore::FChunkPayloadView Payload;
+	if (!FChunkCodec::ReadPayload(Data, Size, Payload))
 	{
-		Ar << OutSnapshot.GridCoordinate;
-		Ar << OutSnapshot.Resolution;
-		Ar << OutSnapshot.RealWorldSize;
-		Ar << OutSnapshot.HeightData; // TArray handles count+data automatically
-		Ar << OutSnapshot.WeightData;
+		if (Payload.Version != FChunkCodec::Version && Payload.Version != FChunkCodec::DeltaVersion)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TerraDyneSerializer: Unknown Data Version %d"), Payload.Version);
+		}
+		return false;
+	}
+
+	OutSnapshot.GridCoordinate = FIntPoint(Payload.Info.GridX, Payload.Info.GridY);
+	OutSnapshot.Resolution = Payload.Info.Resolution;
+	OutSnapshot.RealWorldSize = Payload.Info.RealWorldSize;
+	OutSnapshot.BaseHash = 0;
+	OutSnapshot.DeltaBlocks.Reset();
+	OutSnapshot.bPackedDelta = false;
+
+	if (Payload.IsDelta())
+	{
+		if (Payload.BlockSize != FChunkCodec::DeltaBlockSize)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TerraDyneSerializer: Unsupported delta block size %d"), Payload.BlockSize);
+			return false;
+		}
+
+		// v2: only the saved blocks, packed; the chunk lays them over its baked tile.
+		// ReadPayload() checked every record against the payload, so the cell count is what the file holds.
+		const int32 Cells = (int32)Payload.NumBlockCells;
+		OutSnapshot.BaseHash = Payload.BaseHash;
+		OutSnapshot.bPackedDelta = true;
+		OutSnapshot.DeltaBlocks.SetNumUninitialized(Payload.NumBlocks);
+		OutSnapshot.HeightData = FTerraDyneSaveBuffers::Heights().Acquire(Cells);
+		OutSnapshot.HeightData.SetNumUninitialized(Cells, EAllowShrinking::No);
+		OutSnapshot.WeightData = FTerraDyneSaveBuffers::Weights().Acquire(Cells);
+		OutSnapshot.WeightData.SetNumUninitialized(Cells, EAllowShrinking::No);
+
+		FChunkCodec::UnpackDeltaBlocks(Payload, OutSnapshot.HeightData.GetData(),
+			reinterpret_cast<TerraDyneCore::FTexelBGRA*>(OutSnapshot.WeightData.GetData()), OutSnapshot.DeltaBlocks.GetData());
 		return true;
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("TerraDyneSerializer: Unknown Data Version %d"), Version);
-	return false;
-}
\ No newline at end of file
+	// The payload arrays may be unaligned; copy them into pooled arrays
+	OutSnapshot.HeightData = FTerraDyneSaveBuffers::Heights().Acquire(Payload.NumHeights);
+	OutSnapshot.HeightData.SetNumUninitialized(Payload.NumHeights, EAllowShrinking::No);
+	FMemory::Memcpy(OutSnapshot.HeightData.GetData(), Payload.Heights, (SIZE_T)Payload.NumHeights * sizeof(float));
+
+	OutSnapshot.WeightData = FTerraDyneSaveBuffers::Weights().Acquire(Payload.NumWeights);
+	OutSnapshot.WeightData.SetNumUninitialized(Payload.NumWeights, EAllowShrinking::No);
+	FMemory::Memcpy(OutSnapshot.WeightData.GetData(), Payload.Weights, (SIZE_T)Payload.NumWeights * sizeof(FColor));
+	return true;
+}
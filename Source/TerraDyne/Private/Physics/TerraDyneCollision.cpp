@@ -1,4 +1,6 @@
 #include "Physics/TerraDyneCollision.h"
+#include "Core/TerraDyneStats.h"
+#include "Core/TerraDyneMemory.h"
 
 // Engine Includes
 #include "Components/DynamicMeshComponent.h"
@@ -72,6 +74,79 @@ void UTerraDyneCollisionLib::ApplyHeightDataToMesh(
 	}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::VertexPositions);
 }
 
+/** Grid row/column of a collision vertex: vertices spread evenly over the grid, nearest sample. */
+static int32 GetHeightfieldSampleIndex(int32 Vertex, int32 QuadsPerSide, int32 MaxIndex)
+{
+	return FMath::Clamp(FMath::RoundToInt((float)Vertex / QuadsPerSide * MaxIndex), 0, MaxIndex);
+}
+
+void UTerraDyneCollisionLib::SampleHeightfield(const TArray<float>& HeightData, int32 Resolution, int32 QuadsPerSide, TArray<float>& OutSamples)
+{
+	OutSamples.Reset();
+	if (Resolution < 2 || QuadsPerSide < 1 || HeightData.Num() != (Resolution * Resolution)) return;
+
+	const int32 VertsPerSide = QuadsPerSide + 1;
+	const int32 MaxIndex = Resolution - 1;
+	OutSamples.SetNumUninitialized(VertsPerSide * VertsPerSide);
+	for (int32 Y = 0; Y < VertsPerSide; Y++)
+	{
+		const int32 GridY = GetHeightfieldSampleIndex(Y, QuadsPerSide, MaxIndex);
+		for (int32 X = 0; X < VertsPerSide; X++)
+		{
+			OutSamples[Y * VertsPerSide + X] = HeightData[GridY * Resolution + GetHeightfieldSampleIndex(X, QuadsPerSide, MaxIndex)];
+		}
+	}
+}
+
+void UTerraDyneCollisionLib::BuildHeightfieldMesh(
+	UE::Geometry::FDynamicMesh3& OutMesh,
+	const TArray<float>& HeightData,
+	int32 Resolution,
+	float ChunkSize,
+	int32 QuadsPerSide)
+{
+	TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_CollisionBuild);
+	TERRADYNE_LLM_SCOPE(Collision);
+
+	OutMesh.Clear();
+
+	if (Resolution < 2 || QuadsPerSide < 1 || HeightData.Num() != (Resolution * Resolution))
+	{
+		return;
+	}
+
+	const int32 VertsPerSide = QuadsPerSide + 1;
+	const double HalfSize = ChunkSize * 0.5;
+	const double Step = ChunkSize / QuadsPerSide;
+	const int32 MaxIndex = Resolution - 1;
+
+	// 1. Vertices (row-major, centered on the actor like AppendRectangleXY)
+	for (int32 Y = 0; Y < VertsPerSide; Y++)
+	{
+		const int32 GridY = GetHeightfieldSampleIndex(Y, QuadsPerSide, MaxIndex);
+		for (int32 X = 0; X < VertsPerSide; X++)
+		{
+			const int32 GridX = GetHeightfieldSampleIndex(X, QuadsPerSide, MaxIndex);
+			OutMesh.AppendVertex(FVector3d(X * Step - HalfSize, Y * Step - HalfSize, (double)HeightData[(GridY * Resolution) + GridX]));
+		}
+	}
+
+	// 2. Triangles (two per quad, facing +Z)
+	for (int32 Y = 0; Y < QuadsPerSide; Y++)
+	{
+		for (int32 X = 0; X < QuadsPerSide; X++)
+		{
+			const int32 V00 = Y * VertsPerSide + X;
+			const int32 V10 = V00 + 1;
+			const int32 V01 = V00 + VertsPerSide;
+			const int32 V11 = V01 + 1;
+
+			OutMesh.AppendTriangle(V00, V10, V11);
+			OutMesh.AppendTriangle(V00, V11, V01);
+		}
+	}
+}
+
 void UTerraDyneCollisionLib::ConfigureForTerrainPhysics(UDynamicMeshComponent* TargetComponent)
 {
 	if (!TargetComponent) return;
@@ -1,4 +1,5 @@
 #include "TerraDyneModule.h"
+#include "Core/TerraDyneWorkerPool.h"
 #include "Modules/ModuleManager.h"
 #include "ShaderCore.h" // For mapping shader directories if you add custom shaders later
 #include "Interfaces/IPluginManager.h"
@@ -30,6 +31,9 @@ void FTerraDyneModule::ShutdownModule()
 	// For modules that support dynamic reloading, we call this function before unloading the module.
 	
 	UE_LOG(LogTerraDyne, Log, TEXT("TerraDyne Runtime Module Shutting Down."));
+
+	// Lets in-flight saves finish before the threads go away
+	FTerraDyneWorkerPool::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
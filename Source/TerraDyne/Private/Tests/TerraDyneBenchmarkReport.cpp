@@ -0,0 +1,104 @@
+#include "Tests/TerraDyneBenchmarkReport.h"
+
+// Engine Includes
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformProperties.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+static const TCHAR* TerraDyneBenchmarkSection = TEXT("TerraDyne.Benchmarks");
+
+FTerraDyneBenchmarkReport& FTerraDyneBenchmarkReport::Get()
+{
+	static FTerraDyneBenchmarkReport Report;
+	return Report;
+}
+
+TOptional<double> FTerraDyneBenchmarkReport::FindThreshold(const FString& Name) const
+{
+	double Limit = 0.0;
+	if (!GConfig || !GConfig->GetDouble(TerraDyneBenchmarkSection, *Name, Limit, GEngineIni))
+	{
+		return TOptional<double>();
+	}
+	return Limit;
+}
+
+bool FTerraDyneBenchmarkReport::Record(const FString& Name, double Value, const TCHAR* Unit, bool bHigherIsBetter)
+{
+	FMetric* Metric = Metrics.FindByPredicate([&Name](const FMetric& M) { return M.Name == Name; });
+	if (!Metric)
+	{
+		Metric = &Metrics.AddDefaulted_GetRef();
+		Metric->Name = Name;
+	}
+
+	Metric->Value = Value;
+	Metric->Unit = Unit;
+	Metric->bHigherIsBetter = bHigherIsBetter;
+	Metric->Threshold = FindThreshold(Name);
+
+	if (Metric->Threshold.IsSet())
+	{
+		// Loosening raises a ceiling and lowers a floor
+		double Scale = 1.0;
+		GConfig->GetDouble(TerraDyneBenchmarkSection, TEXT("ThresholdScale"), Scale, GEngineIni);
+		Scale = FMath::Max(Scale, UE_KINDA_SMALL_NUMBER);
+		Metric->Threshold = bHigherIsBetter ? Metric->Threshold.GetValue() / Scale : Metric->Threshold.GetValue() * Scale;
+	}
+
+	Metric->bPassed = !Metric->Threshold.IsSet() ||
+		(bHigherIsBetter ? Value >= Metric->Threshold.GetValue() : Value <= Metric->Threshold.GetValue());
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneBenchmark: %-40s %12.3f %s%s"), *Name, Value, Unit,
+		Metric->bPassed ? TEXT("") : TEXT("  REGRESSION"));
+	return Metric->bPassed;
+}
+
+FString FTerraDyneBenchmarkReport::ToJson() const
+{
+	FString Json = FString::Printf(TEXT("{\n\t\"timestamp\": \"%s\",\n\t\"platform\": \"%s\",\n\t\"cpu\": \"%s\",\n\t\"metrics\": [\n"),
+		*FDateTime::UtcNow().ToIso8601(), ANSI_TO_TCHAR(FPlatformProperties::IniPlatformName()), *FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+
+	for (int32 i = 0; i < Metrics.Num(); i++)
+	{
+		const FMetric& Metric = Metrics[i];
+		const FString Threshold = Metric.Threshold.IsSet() ? FString::Printf(TEXT("%.6f"), Metric.Threshold.GetValue()) : TEXT("null");
+
+		Json += FString::Printf(
+			TEXT("\t\t{ \"name\": \"%s\", \"value\": %.6f, \"unit\": \"%s\", \"higher_is_better\": %s, \"threshold\": %s, \"passed\": %s }%s\n"),
+			*Metric.Name, Metric.Value, *Metric.Unit, Metric.bHigherIsBetter ? TEXT("true") : TEXT("false"), *Threshold,
+			Metric.bPassed ? TEXT("true") : TEXT("false"), i < Metrics.Num() - 1 ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t]\n}\n");
+	return Json;
+}
+
+FString FTerraDyneBenchmarkReport::GetReportPath() const
+{
+	FString Path;
+	if (FParse::Value(FCommandLine::Get(), TEXT("-TerraDyneBenchReport="), Path) && !Path.IsEmpty())
+	{
+		return Path;
+	}
+	return FPaths::AutomationDir() / TEXT("TerraDyneBenchmarks.json");
+}
+
+bool FTerraDyneBenchmarkReport::Write() const
+{
+	const FString Path = GetReportPath();
+	if (!FFileHelper::SaveStringToFile(ToJson(), *Path))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneBenchmark: Failed to write %s"), *Path);
+		return false;
+	}
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
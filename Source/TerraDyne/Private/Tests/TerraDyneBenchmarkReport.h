@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+/**
+ * FTerraDyneBenchmarkReport
+ *
+ * Collects the metrics of the TerraDyne.Benchmark.* automation tests and writes them as JSON
+ * (default Saved/Automation/TerraDyneBenchmarks.json, override with -TerraDyneBenchReport=<Path>).
+ *
+ * Regression thresholds live in the [TerraDyne.Benchmarks] section of the engine ini, one key per
+ * metric name. A lower-is-better metric fails above its limit, a higher-is-better one below it:
+ *
+ *   [TerraDyne.Benchmarks]
+ *   Brush.Res257.R500.MsPerStroke=0.5
+ *   Serializer.Res257.SaveMBps=50
+ *   ThresholdScale=1.5
+ *
+ * ThresholdScale (default 1) loosens every limit, e.g. on slow CI machines.
+ */
+class FTerraDyneBenchmarkReport
+{
+public:
+	struct FMetric
+	{
+		FString Name;
+		double Value = 0.0;
+		FString Unit;
+		bool bHigherIsBetter = false;
+		TOptional<double> Threshold;
+		bool bPassed = true;
+	};
+
+	static FTerraDyneBenchmarkReport& Get();
+
+	/** Records (or replaces) a metric and checks it against its configured threshold. Returns false on a regression. */
+	bool Record(const FString& Name, double Value, const TCHAR* Unit, bool bHigherIsBetter = false);
+
+	/** Last recorded value of every metric, in recording order. */
+	const TArray<FMetric>& GetMetrics() const { return Metrics; }
+
+	FString ToJson() const;
+
+	/** Rewrites the report file with everything recorded so far (each test calls this, so partial runs still report). */
+	bool Write() const;
+
+	FString GetReportPath() const;
+
+private:
+	TOptional<double> FindThreshold(const FString& Name) const;
+
+	TArray<FMetric> Metrics;
+};
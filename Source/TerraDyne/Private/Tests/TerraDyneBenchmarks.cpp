@@ -0,0 +1,317 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/TerraDyneBenchmarkReport.h"
+#include "Tests/TerraDyneTestWorld.h"
+#include "Core/TerraDyneManager.h"
+#include "Core/TerraDyneSubsystem.h"
+#include "Core/TerraDyneWorkerPool.h"
+#include "World/TerraDyneChunk.h"
+#include "Physics/TerraDyneCollision.h"
+#include "IO/TerraDyneAsyncSaver.h"
+#include "IO/TerraDyneSerializer.h"
+
+// Engine Includes
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "DynamicMesh/DynamicMesh3.h"
+
+/**
+ * TerraDyne.Benchmark.*
+ *
+ * Headless throughput benchmarks of the hot paths. Run on Linux with:
+ *   UnrealEditor-Cmd <Project> -nullrhi -unattended -ExecCmds="Automation RunTests TerraDyne.Benchmark; Quit"
+ * Every test appends its metrics to the FTerraDyneBenchmarkReport JSON and fails on a configured regression.
+ */
+namespace TerraDyneBenchmarks
+{
+	constexpr EAutomationTestFlags Flags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter;
+
+	constexpr float ChunkSize = FTerraDyneTestWorld::ChunkSize;
+	const int32 Resolutions[] = { 129, 257, 513 };
+
+	/** Runs Body Iterations times and returns the mean milliseconds per iteration. */
+	template <typename FuncType>
+	double TimeMs(int32 Iterations, FuncType&& Body)
+	{
+		const double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < Iterations; i++)
+		{
+			Body(i);
+		}
+		return (FPlatformTime::Seconds() - Start) * 1000.0 / FMath::Max(Iterations, 1);
+	}
+
+	/** Rolling terrain, so compression and collision see realistic data rather than a flat plane. */
+	void FillHeights(TArray<float>& Heights, TArray<FColor>& Weights, int32 Res)
+	{
+		Heights.SetNumUninitialized(Res * Res);
+		Weights.SetNumUninitialized(Res * Res);
+		for (int32 y = 0; y < Res; y++)
+		{
+			for (int32 x = 0; x < Res; x++)
+			{
+				const FVector2D P(x / 32.0f, y / 32.0f);
+				Heights[y * Res + x] = FMath::PerlinNoise2D(P) * 800.0f + FMath::PerlinNoise2D(P * 4.0f) * 100.0f;
+				Weights[y * Res + x] = FColor((uint8)(x & 0xFF), (uint8)(y & 0xFF), 0, 255);
+			}
+		}
+	}
+
+	/** Records a metric and turns a regression into a test error. */
+	void Report(FAutomationTestBase& Test, const FString& Name, double Value, const TCHAR* Unit, bool bHigherIsBetter = false)
+	{
+		if (!FTerraDyneBenchmarkReport::Get().Record(Name, Value, Unit, bHigherIsBetter))
+		{
+			Test.AddError(FString::Printf(TEXT("%s regressed: %.3f %s"), *Name, Value, Unit));
+		}
+	}
+}
+
+//--- Brush Throughput ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneBenchmarkBrush, "TerraDyne.Benchmark.Brush", TerraDyneBenchmarks::Flags)
+
+bool FTerraDyneBenchmarkBrush::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneBenchmarks;
+	FTerraDyneTestWorld World;
+
+	// Radius as a fraction of the chunk: a footprint, a crater, most of the tile
+	const float RadiusFractions[] = { 0.02f, 0.1f, 0.4f };
+	constexpr int32 Strokes = 200;
+
+	for (int32 Res : Resolutions)
+	{
+		ATerraDyneChunk* Chunk = World.SpawnChunk(Res);
+		for (float Fraction : RadiusFractions)
+		{
+			const float Radius = ChunkSize * Fraction;
+			const double Ms = TimeMs(Strokes, [&](int32 i)
+				{
+					// Alternate raise/lower so the surface stays bounded
+					const FVector Offset(FMath::Sin(i * 0.37f) * ChunkSize * 0.25f, FMath::Cos(i * 0.53f) * ChunkSize * 0.25f, 0.0f);
+					Chunk->ApplyLocalIdempotentEdit(Offset, Radius, (i & 1) ? 5.0f : -5.0f, false);
+				});
+
+			const FString Name = FString::Printf(TEXT("Brush.Res%d.R%d"), Res, FMath::RoundToInt(Fraction * 100.0f));
+			Report(*this, Name + TEXT(".MsPerStroke"), Ms, TEXT("ms"));
+
+			const double Texels = UE_PI * FMath::Square(Fraction * (Res - 1));
+			Report(*this, Name + TEXT(".MTexelsPerSec"), Texels / (Ms * 1000.0), TEXT("Mtexel/s"), true);
+		}
+		Chunk->Destroy();
+	}
+
+	FTerraDyneBenchmarkReport::Get().Write();
+	return true;
+}
+
+//--- Collision Build / Cook ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneBenchmarkCollision, "TerraDyne.Benchmark.Collision", TerraDyneBenchmarks::Flags)
+
+bool FTerraDyneBenchmarkCollision::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneBenchmarks;
+	FTerraDyneTestWorld World;
+	constexpr int32 Iterations = 10;
+
+	for (int32 Res : Resolutions)
+	{
+		TArray<float> Heights;
+		TArray<FColor> Weights;
+		FillHeights(Heights, Weights, Res);
+
+		// Mesh build alone (what the worker pool runs)
+		const double BuildMs = TimeMs(Iterations, [&](int32)
+			{
+				UE::Geometry::FDynamicMesh3 Mesh;
+				UTerraDyneCollisionLib::BuildHeightfieldMesh(Mesh, Heights, Res, ChunkSize, Res - 1);
+			});
+
+		// Full synchronous sync: build, swap into the component, cook
+		ATerraDyneChunk* Chunk = World.SpawnChunk(Res);
+		Chunk->ApplyImportedData(MoveTemp(Heights), MoveTemp(Weights));
+		const double SyncMs = TimeMs(Iterations, [&](int32)
+			{
+				Chunk->ReleaseCollision();
+				Chunk->BuildCollisionNow();
+			});
+		TestTrue(FString::Printf(TEXT("Res %d chunk has collision"), Res), Chunk->HasCollision());
+		Chunk->Destroy();
+
+		const FString Name = FString::Printf(TEXT("Collision.Res%d"), Res);
+		Report(*this, Name + TEXT(".MeshBuildMs"), BuildMs, TEXT("ms"));
+		Report(*this, Name + TEXT(".PhysicsSyncMs"), SyncMs, TEXT("ms"));
+		Report(*this, Name + TEXT(".CookMs"), FMath::Max(SyncMs - BuildMs, 0.0), TEXT("ms"));
+	}
+
+	FTerraDyneBenchmarkReport::Get().Write();
+	return true;
+}
+
+//--- Serializer ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneBenchmarkSerializer, "TerraDyne.Benchmark.Serializer", TerraDyneBenchmarks::Flags)
+
+bool FTerraDyneBenchmarkSerializer::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneBenchmarks;
+	constexpr int32 Iterations = 8;
+	const FString Folder = FPaths::AutomationTransientDir() / TEXT("TerraDyneBenchmark");
+
+	for (int32 Res : Resolutions)
+	{
+		FTerraDyneChunkSnapshot Source;
+		Source.GridCoordinate = FIntPoint(3, -7);
+		Source.Resolution = Res;
+		Source.RealWorldSize = ChunkSize;
+		FillHeights(Source.HeightData, Source.WeightData, Res);
+
+		const FString Path = Folder / FString::Printf(TEXT("Res%d.bin"), Res);
+		const double PayloadMB = (Source.HeightData.Num() * sizeof(float) + Source.WeightData.Num() * sizeof(FColor)) / (1024.0 * 1024.0);
+
+		bool bWritten = true;
+		const double SaveMs = TimeMs(Iterations, [&](int32)
+			{
+				FTerraDyneAsyncSaver Saver(Source, Path);
+				Saver.DoWork();
+				bWritten &= Saver.WasWritten();
+			});
+		if (!TestTrue(FString::Printf(TEXT("Res %d file written"), Res), bWritten)) continue;
+
+		const int64 FileBytes = IFileManager::Get().FileSize(*Path);
+
+		bool bLoaded = true;
+		FTerraDyneChunkSnapshot Loaded;
+		const double LoadMs = TimeMs(Iterations, [&](int32)
+			{
+				Loaded.ReturnBuffers();
+				bLoaded &= UTerraDyneSerializer::LoadChunkFromDisk(Path, Loaded);
+			});
+		TestTrue(FString::Printf(TEXT("Res %d file loaded"), Res), bLoaded);
+		TestTrue(FString::Printf(TEXT("Res %d round trip"), Res), Loaded.HeightData == Source.HeightData && Loaded.WeightData == Source.WeightData);
+		Loaded.ReturnBuffers();
+
+		// The same chunk through a region file: index lookup and a mapped read instead of a file open
+		const TSharedRef<FTerraDyneRegionFile> Region = MakeShared<FTerraDyneRegionFile>(Folder / FString::Printf(TEXT("Res%d.tdr"), Res));
+		{
+			FTerraDyneChunkSnapshot Copy = Source;
+			FTerraDyneAsyncSaver Saver(MoveTemp(Copy), Region);
+			Saver.DoWork();
+		}
+
+		bool bRegionLoaded = true;
+		const double RegionLoadMs = TimeMs(Iterations, [&](int32)
+			{
+				Loaded.ReturnBuffers();
+				bRegionLoaded &= UTerraDyneSerializer::LoadChunkFromRegion(*Region, Source.GridCoordinate, Loaded);
+			});
+		TestTrue(FString::Printf(TEXT("Res %d region round trip"), Res), bRegionLoaded && Loaded.HeightData == Source.HeightData && Loaded.WeightData == Source.WeightData);
+		Loaded.ReturnBuffers();
+
+		const FString Name = FString::Printf(TEXT("Serializer.Res%d"), Res);
+		Report(*this, Name + TEXT(".SaveMBps"), PayloadMB / (SaveMs / 1000.0), TEXT("MB/s"), true);
+		Report(*this, Name + TEXT(".LoadMBps"), PayloadMB / (LoadMs / 1000.0), TEXT("MB/s"), true);
+		Report(*this, Name + TEXT(".RegionLoadMBps"), PayloadMB / (RegionLoadMs / 1000.0), TEXT("MB/s"), true);
+		Report(*this, Name + TEXT(".CompressionRatio"), FileBytes > 0 ? PayloadMB * 1024.0 * 1024.0 / FileBytes : 0.0, TEXT("x"), true);
+	}
+
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+	FTerraDyneBenchmarkReport::Get().Write();
+	return true;
+}
+
+//--- Multi-Chunk Brush Scaling ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneBenchmarkMultiChunkBrush, "TerraDyne.Benchmark.MultiChunkBrush", TerraDyneBenchmarks::Flags)
+
+bool FTerraDyneBenchmarkMultiChunkBrush::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneBenchmarks;
+	FTerraDyneTestWorld World;
+	constexpr int32 Res = 129;
+	constexpr int32 GridSize = 8;
+	constexpr int32 Strokes = 50;
+
+	ATerraDyneManager* Manager = World.SpawnManager(Res);
+	for (int32 y = 0; y < GridSize; y++)
+	{
+		for (int32 x = 0; x < GridSize; x++)
+		{
+			Manager->AcquireChunk(FIntPoint(x, y));
+		}
+	}
+
+	// Centered on a chunk corner: radius 0.4 touches 4 chunks, 1.4 touches 16, 2.4 touches 36
+	const FVector Center(GridSize * 0.5f * ChunkSize, GridSize * 0.5f * ChunkSize, 0.0f);
+	const float RadiusChunks[] = { 0.4f, 1.4f, 2.4f };
+
+	for (float RadiusInChunks : RadiusChunks)
+	{
+		TArray<ATerraDyneChunk*> Touched;
+		const float Radius = RadiusInChunks * ChunkSize;
+		Manager->GetChunksInBounds(FBox2D(FVector2D(Center) - FVector2D(Radius), FVector2D(Center) + FVector2D(Radius)), Touched);
+
+		const double Ms = TimeMs(Strokes, [&](int32 i)
+			{
+				Manager->ApplyGlobalBrush(Center, Radius, (i & 1) ? 5.0f : -5.0f, false);
+			});
+
+		const FString Name = FString::Printf(TEXT("MultiChunk.Res%d.Chunks%d"), Res, Touched.Num());
+		Report(*this, Name + TEXT(".MsPerStroke"), Ms, TEXT("ms"));
+		Report(*this, Name + TEXT(".MsPerChunk"), Ms / FMath::Max(Touched.Num(), 1), TEXT("ms"));
+	}
+
+	FTerraDyneBenchmarkReport::Get().Write();
+	return true;
+}
+
+//--- Chunk Spawn / Init ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneBenchmarkChunkSpawn, "TerraDyne.Benchmark.ChunkSpawn", TerraDyneBenchmarks::Flags)
+
+bool FTerraDyneBenchmarkChunkSpawn::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneBenchmarks;
+	constexpr int32 NumChunks = 32;
+
+	for (int32 Res : Resolutions)
+	{
+		FTerraDyneTestWorld World;
+		ATerraDyneManager* Manager = World.SpawnManager(Res);
+
+		TArray<ATerraDyneChunk*> Chunks;
+		const double ColdMs = TimeMs(NumChunks, [&](int32 i)
+			{
+				Chunks.Add(Manager->AcquireChunk(FIntPoint(i % 8, i / 8)));
+			});
+		TestEqual(FString::Printf(TEXT("Res %d chunks spawned"), Res), Chunks.FilterByPredicate([](ATerraDyneChunk* C) { return C != nullptr; }).Num(), NumChunks);
+
+		for (ATerraDyneChunk* Chunk : Chunks)
+		{
+			Manager->ReleaseChunk(Chunk);
+		}
+
+		// Same slots again, now served from the pool
+		const double PooledMs = TimeMs(NumChunks, [&](int32 i)
+			{
+				Manager->AcquireChunk(FIntPoint(i % 8, i / 8));
+			});
+
+		const FString Name = FString::Printf(TEXT("ChunkSpawn.Res%d"), Res);
+		Report(*this, Name + TEXT(".ColdMs"), ColdMs, TEXT("ms"));
+		Report(*this, Name + TEXT(".PooledMs"), PooledMs, TEXT("ms"));
+	}
+
+	FTerraDyneBenchmarkReport::Get().Write();
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,124 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/TerraDyneTestWorld.h"
+#include "World/TerraDyneChunk.h"
+#include "World/TerraDyneTileData.h"
+#include "IO/TerraDyneAsyncSaver.h"
+#include "IO/TerraDyneSerializer.h"
+#include "UObject/Package.h"
+
+/**
+ * TerraDyne.Chunk.*
+ *
+ * Standalone chunks in a headless world (see FTerraDyneTestWorld), no Manager.
+ */
+namespace TerraDyneChunkTests
+{
+	constexpr EAutomationTestFlags Flags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	/** A transient baked tile with uneven heights and weights, so every block differs from its neighbours. */
+	UTerraDyneTileData* MakeTile(int32 Res)
+	{
+		UTerraDyneTileData* Tile = NewObject<UTerraDyneTileData>(GetTransientPackage());
+		Tile->Resolution = Res;
+		Tile->RealWorldSize = FTerraDyneTestWorld::ChunkSize;
+		Tile->BakedZScale = 100.0f;
+		Tile->InitialHeightMap.SetNumUninitialized(Res * Res);
+		Tile->InitialWeightMap.SetNumUninitialized(Res * Res);
+		for (int32 i = 0; i < Res * Res; i++)
+		{
+			Tile->InitialHeightMap[i] = (uint16)(32768 + (i * 2654435761u >> 20) % 4096);
+			Tile->InitialWeightMap[i] = FColor((uint8)i, (uint8)(i * 3), 0, 0);
+		}
+		return Tile;
+	}
+
+	/** A chunk decoded from Tile, still linked to it (as a level chunk after streaming). */
+	ATerraDyneChunk* SpawnTileChunk(FTerraDyneTestWorld& World, UTerraDyneTileData* Tile, FIntPoint Coord)
+	{
+		ATerraDyneChunk* Chunk = World.SpawnChunk(Tile->Resolution, Coord);
+		Chunk->LinkedTileData = Tile;
+		Chunk->InitializeFromAsset(Tile);
+		return Chunk;
+	}
+
+	bool SameTerrain(ATerraDyneChunk* A, ATerraDyneChunk* B)
+	{
+		FTerraDyneChunkSnapshot StateA, StateB;
+		A->CaptureSnapshot(StateA);
+		B->CaptureSnapshot(StateB);
+		const bool bSame = StateA.HeightData == StateB.HeightData && StateA.WeightData == StateB.WeightData;
+		StateA.ReturnBuffers();
+		StateB.ReturnBuffers();
+		return bSame;
+	}
+}
+
+//--- Delta Saves ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneChunkDeltaSaveLoad, "TerraDyne.Chunk.DeltaSaveLoad", TerraDyneChunkTests::Flags)
+
+bool FTerraDyneChunkDeltaSaveLoad::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneChunkTests;
+	constexpr int32 Res = 65;
+
+	FTerraDyneTestWorld World;
+	UTerraDyneTileData* Tile = MakeTile(Res);
+
+	// Edit one corner (heights and paint) and save as a delta against the tile
+	ATerraDyneChunk* Source = SpawnTileChunk(World, Tile, FIntPoint(0, 0));
+	Source->ApplyLocalIdempotentEdit(FVector(-4000.0, -4000.0, 0.0), 600.0f, 40.0f, false);
+	Source->ApplyLocalIdempotentEdit(FVector(-4000.0, -4000.0, 0.0), 600.0f, 1.0f, false, 2);
+
+	FTerraDyneChunkSnapshot Saved;
+	Source->CaptureSnapshot(Saved, true);
+	TestTrue(TEXT("Capture carries the tile hash"), Saved.BaseHash != 0);
+	TestTrue(TEXT("Only the edited blocks are listed"), Saved.DeltaBlocks.Num() > 0 && Saved.DeltaBlocks.Num() < 4);
+
+	TArray<uint8> Bytes;
+	TestTrue(TEXT("Delta serialized"), UTerraDyneSerializer::SerializeToBytes(Saved, Bytes));
+	Saved.ReturnBuffers();
+
+	auto Load = [this, &Bytes]()
+	{
+		FTerraDyneChunkSnapshot Loaded;
+		TestTrue(TEXT("Delta deserialized"), UTerraDyneSerializer::DeserializeFromBytes(Bytes, Loaded));
+		return Loaded;
+	};
+
+	{
+		FTerraDyneChunkSnapshot Loaded = Load();
+		TestTrue(TEXT("Loaded delta is packed"), Loaded.bPackedDelta && Loaded.HeightData.Num() < Res * Res && Loaded.WeightData.Num() == Loaded.HeightData.Num());
+
+		TArray<uint8> Resaved;
+		TestFalse(TEXT("A packed delta can't be saved as is"), UTerraDyneSerializer::SerializeToBytes(Loaded, Resaved));
+		Loaded.ReturnBuffers();
+	}
+
+	// Loaded onto an untouched chunk of the same tile: tile + delta is the saved terrain
+	ATerraDyneChunk* Target = SpawnTileChunk(World, Tile, FIntPoint(1, 0));
+	Target->ApplySnapshot(Load());
+	TestFalse(TEXT("Untouched tile applies in place"), Target->IsAwaitingTileData());
+	TestTrue(TEXT("Delta load reproduces the saved terrain"), SameTerrain(Source, Target));
+
+	// A chunk with its own runtime edits: the load replaces them (like a full save) and re-decodes the tile,
+	// and an edit issued before the decode finishes lands on top of the loaded state
+	ATerraDyneChunk* Edited = SpawnTileChunk(World, Tile, FIntPoint(2, 0));
+	Edited->ApplyLocalIdempotentEdit(FVector(3000.0, 3000.0, 0.0), 800.0f, -60.0f, false);
+	Edited->ApplySnapshot(Load());
+	TestTrue(TEXT("Edited chunk re-decodes its tile"), Edited->IsAwaitingTileData() || SameTerrain(Source, Edited));
+
+	const FVector Later(0.0, 2000.0, 0.0);
+	Edited->ApplyLocalIdempotentEdit(Later, 700.0f, 25.0f, false);
+	Target->ApplyLocalIdempotentEdit(Later, 700.0f, 25.0f, false);
+	TestFalse(TEXT("Edit flushed the decode"), Edited->IsAwaitingTileData());
+	TestTrue(TEXT("Runtime edits replaced, later edit kept"), SameTerrain(Target, Edited));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
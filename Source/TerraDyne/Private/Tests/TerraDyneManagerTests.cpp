@@ -0,0 +1,91 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Tests/TerraDyneTestWorld.h"
+#include "Core/TerraDyneManager.h"
+#include "World/TerraDyneChunk.h"
+#include "World/TerraDyneTileData.h"
+#include "UObject/Package.h"
+
+/**
+ * TerraDyne.Manager.*
+ *
+ * ATerraDyneManager and its chunks in a headless world (see FTerraDyneTestWorld).
+ */
+namespace TerraDyneManagerTests
+{
+	constexpr EAutomationTestFlags Flags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+}
+
+//--- Startup ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneManagerStartupMilestones, "TerraDyne.Manager.StartupMilestones", TerraDyneManagerTests::Flags)
+
+bool FTerraDyneManagerStartupMilestones::RunTest(const FString& Parameters)
+{
+	FTerraDyneTestWorld World;
+	constexpr int32 NumChunks = 6;
+
+	// The usual level order: the Manager begins play first, the level chunks register afterwards
+	ATerraDyneManager* Manager = World.SpawnManager(17);
+	Manager->StartupBatchSize = 2;
+	TestTrue(TEXT("Nothing recorded at Manager BeginPlay"), Manager->GetStartupStats().TimeToFullyLoadedSeconds < 0.0f);
+
+	TArray<ATerraDyneChunk*> Chunks;
+	for (int32 i = 0; i < NumChunks; i++)
+	{
+		Chunks.Add(World.SpawnLevelChunk(FIntPoint(i, 0)));
+	}
+	TestTrue(TEXT("Registered chunks wait for the init queue"), Chunks.Last()->IsStartupInitPending());
+	TestTrue(TEXT("First playable not recorded before any init"), Manager->GetStartupStats().TimeToFirstPlayableSeconds < 0.0f);
+	TestTrue(TEXT("Fully loaded not recorded before any init"), Manager->GetStartupStats().TimeToFullyLoadedSeconds < 0.0f);
+
+	// Drive the queue one frame at a time
+	for (int32 Frame = 0; Frame < 100 && Manager->GetStartupStats().TimeToFullyLoadedSeconds < 0.0f; Frame++)
+	{
+		Manager->Tick(1.0f / 60.0f);
+	}
+
+	const FTerraDyneStartupStats& Stats = Manager->GetStartupStats();
+	TestEqual(TEXT("Every registered chunk went through the queue"), Stats.ChunksInitialized, NumChunks);
+	TestTrue(TEXT("Fully loaded recorded once the queue drained"), Stats.TimeToFullyLoadedSeconds >= 0.0f);
+	TestTrue(TEXT("First playable recorded no later than fully loaded"), Stats.TimeToFirstPlayableSeconds >= 0.0f && Stats.TimeToFirstPlayableSeconds <= Stats.TimeToFullyLoadedSeconds);
+	for (const ATerraDyneChunk* Chunk : Chunks)
+	{
+		TestFalse(FString::Printf(TEXT("Chunk %s initialized"), *Chunk->GridCoordinate.ToString()), Chunk->IsStartupInitPending());
+	}
+
+	return true;
+}
+
+//--- Chunk Pool ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneManagerChunkPool, "TerraDyne.Manager.ChunkPool", TerraDyneManagerTests::Flags)
+
+bool FTerraDyneManagerChunkPool::RunTest(const FString& Parameters)
+{
+	FTerraDyneTestWorld World;
+	ATerraDyneManager* Manager = World.SpawnManager(17);
+
+	ATerraDyneChunk* Level = World.SpawnLevelChunk(FIntPoint(0, 0));
+	TestTrue(TEXT("Acquiring a level chunk's cell returns the level chunk"), Manager->AcquireChunk(FIntPoint(0, 0)) == Level);
+
+	ATerraDyneChunk* Acquired = Manager->AcquireChunk(FIntPoint(1, 0));
+	TestTrue(TEXT("Acquiring the same cell twice returns one chunk"), Acquired && Manager->AcquireChunk(FIntPoint(1, 0)) == Acquired);
+
+	// A level chunk parked in the pool must not carry its tile to the next cell
+	Level->LinkedTileData = NewObject<UTerraDyneTileData>(GetTransientPackage());
+	Manager->ReleaseChunk(Level);
+	TestTrue(TEXT("Released chunk is pooled"), Level->IsPooled());
+
+	ATerraDyneChunk* Reused = Manager->AcquireChunk(FIntPoint(2, 0));
+	TestTrue(TEXT("The pool hands out the released chunk"), Reused == Level);
+	TestTrue(TEXT("Reused chunk has no tile link"), Reused && Reused->LinkedTileData.IsNull() && !Reused->IsAwaitingTileData());
+	TestTrue(TEXT("Reused chunk took the new cell"), Reused && Reused->GridCoordinate == FIntPoint(2, 0));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,209 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "IO/TerraDyneRegionFile.h"
+#include "IO/TerraDyneAsyncSaver.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+/**
+ * TerraDyne.RegionFile.*
+ *
+ * FTerraDyneRegionFile on a scratch file in the automation transient folder (no world needed).
+ */
+namespace TerraDyneRegionFileTests
+{
+	constexpr EAutomationTestFlags Flags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	/** A recognizable frame per cell and version. The region file stores frames as opaque bytes. */
+	TArray<uint8> MakeFrame(FIntPoint Coord, int32 Version)
+	{
+		TArray<uint8> Frame;
+		Frame.SetNumUninitialized(4096 + Coord.X * 16);
+		for (int32 i = 0; i < Frame.Num(); i++)
+		{
+			Frame[i] = (uint8)(i * 31 + Coord.X * 7 + Coord.Y * 13 + Version);
+		}
+		return Frame;
+	}
+
+	bool Matches(const FTerraDyneRegionFile::FChunkRead& Read, const TArray<uint8>& Frame)
+	{
+		return Read.Num() == Frame.Num() && FMemory::Memcmp(Read.GetData(), Frame.GetData(), Frame.Num()) == 0;
+	}
+}
+
+//--- Reads and Appends ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneRegionFileReadAppend, "TerraDyne.RegionFile.ReadAppendInterleaved", TerraDyneRegionFileTests::Flags)
+
+bool FTerraDyneRegionFileReadAppend::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneRegionFileTests;
+	constexpr int32 NumRounds = 32;
+
+	const FString Folder = FPaths::AutomationTransientDir() / TEXT("TerraDyneRegionFile");
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+
+	{
+		const TSharedRef<FTerraDyneRegionFile> Region = MakeShared<FTerraDyneRegionFile>(Folder / TEXT("Interleaved.tdr"));
+		const TArray<uint8> First = MakeFrame(FIntPoint(0, 0), 0);
+		TestTrue(TEXT("First append"), Region->Append(FIntPoint(0, 0), First.GetData(), First.Num()));
+		TestTrue(TEXT("First commit"), Region->Commit());
+
+		// Read, append, commit, read again: every save after a read must still open the writer
+		for (int32 Round = 1; Round <= NumRounds; Round++)
+		{
+			const FIntPoint Coord(Round % 5, Round / 5);
+			{
+				FTerraDyneRegionFile::FChunkRead Read;
+				TestTrue(FString::Printf(TEXT("Round %d: read of cell 0"), Round), Region->Read(FIntPoint(0, 0), Read));
+			}
+
+			const TArray<uint8> Frame = MakeFrame(Coord, Round);
+			if (!TestTrue(FString::Printf(TEXT("Round %d: append after a read"), Round), Region->Append(Coord, Frame.GetData(), Frame.Num()))) break;
+
+			// Between append and commit the writer is open: reads go through the fallback, not a mapping
+			{
+				FTerraDyneRegionFile::FChunkRead Read;
+				TestTrue(FString::Printf(TEXT("Round %d: read before commit"), Round), Region->Read(Coord, Read) && Matches(Read, Frame));
+			}
+			TestTrue(FString::Printf(TEXT("Round %d: commit"), Round), Region->Commit());
+
+			FTerraDyneRegionFile::FChunkRead Read;
+			TestTrue(FString::Printf(TEXT("Round %d: read after commit"), Round), Region->Read(Coord, Read) && Matches(Read, Frame));
+		}
+
+		// Reads on a worker while this thread keeps saving: writers wait out the mapped reads instead of failing
+		TAtomic<bool> bStop(false);
+		TAtomic<int32> FailedReads(0);
+		TFuture<void> Reader = Async(EAsyncExecution::ThreadPool, [Region, &bStop, &FailedReads]()
+			{
+				while (!bStop)
+				{
+					FTerraDyneRegionFile::FChunkRead Read;
+					if (!Region->Read(FIntPoint(0, 0), Read) || !Matches(Read, MakeFrame(FIntPoint(0, 0), 0)))
+					{
+						FailedReads++;
+					}
+				}
+			});
+
+		int32 FailedAppends = 0;
+		for (int32 Round = 0; Round < NumRounds; Round++)
+		{
+			const FIntPoint Coord(100 + Round, 0);
+			const TArray<uint8> Frame = MakeFrame(Coord, Round);
+			FailedAppends += Region->Append(Coord, Frame.GetData(), Frame.Num()) && Region->Commit() ? 0 : 1;
+		}
+		bStop = true;
+		Reader.Wait();
+
+		TestEqual(TEXT("No append failed next to concurrent reads"), FailedAppends, 0);
+		TestEqual(TEXT("No read failed next to concurrent appends"), FailedReads.Load(), 0);
+		TestEqual(TEXT("Every cell indexed"), Region->GetNumChunks(), 1 + 2 * NumRounds);
+
+		// With no read in flight the mapping is gone, so compaction can rewrite the file
+		TestTrue(TEXT("Compaction once the reads are done"), Region->Compact());
+		for (int32 Round = 0; Round < NumRounds; Round++)
+		{
+			const FIntPoint Coord(100 + Round, 0);
+			FTerraDyneRegionFile::FChunkRead Read;
+			TestTrue(FString::Printf(TEXT("Cell %s survives compaction"), *Coord.ToString()), Region->Read(Coord, Read) && Matches(Read, MakeFrame(Coord, Round)));
+		}
+	}
+
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+	return true;
+}
+
+//--- Legacy Saves ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneRegionFileLegacyImport, "TerraDyne.RegionFile.LegacyImport", TerraDyneRegionFileTests::Flags)
+
+bool FTerraDyneRegionFileLegacyImport::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneRegionFileTests;
+
+	const FString Slot = TEXT("TerraDyneLegacyImportTest");
+	const FString LegacyFolder = FTerraDyneIOPaths::GetLegacySlotPath(Slot);
+	const FString RegionFolder = FTerraDyneIOPaths::GetSaveSlotPath(Slot);
+	IFileManager::Get().DeleteDirectory(*LegacyFolder, false, true);
+	IFileManager::Get().DeleteDirectory(*RegionFolder, false, true);
+
+	const FIntPoint Cells[] = { FIntPoint(2, -3), FIntPoint(-1, 0), FIntPoint(14, 7) };
+	for (const FIntPoint& Cell : Cells)
+	{
+		const FString Path = LegacyFolder / FString::Printf(TEXT("Chk_%d_%d.bin"), Cell.X, Cell.Y);
+		TestTrue(FString::Printf(TEXT("Legacy save %s written"), *Cell.ToString()), FFileHelper::SaveArrayToFile(MakeFrame(Cell, 1), *Path));
+	}
+
+	FIntPoint Parsed;
+	TestTrue(TEXT("Negative cells parse"), FTerraDyneIOPaths::ParseLegacyChunkFilename(TEXT("Chk_-12_5.bin"), Parsed) && Parsed == FIntPoint(-12, 5));
+	TestFalse(TEXT("Other files are left alone"), FTerraDyneIOPaths::ParseLegacyChunkFilename(TEXT("Chk_Backup.bin"), Parsed));
+
+	// First open of the slot imports them
+	{
+		const TSharedRef<FTerraDyneRegionFile> Region = FTerraDyneRegionFile::Get(Slot);
+		for (const FIntPoint& Cell : Cells)
+		{
+			FTerraDyneRegionFile::FChunkRead Read;
+			TestTrue(FString::Printf(TEXT("Legacy save %s readable from the region"), *Cell.ToString()), Region->Read(Cell, Read) && Matches(Read, MakeFrame(Cell, 1)));
+			TestFalse(FString::Printf(TEXT("Legacy save %s deleted"), *Cell.ToString()),
+				IFileManager::Get().FileExists(*(LegacyFolder / FString::Printf(TEXT("Chk_%d_%d.bin"), Cell.X, Cell.Y))));
+		}
+	}
+
+	// A fresh instance (no registry) sees them in the committed index
+	{
+		FTerraDyneRegionFile Reopened(FTerraDyneIOPaths::GetRegionFilePath(Slot));
+		TestEqual(TEXT("Import committed"), Reopened.GetNumChunks(), (int32)UE_ARRAY_COUNT(Cells));
+	}
+
+	IFileManager::Get().DeleteDirectory(*LegacyFolder, false, true);
+	IFileManager::Get().DeleteDirectory(*RegionFolder, false, true);
+	return true;
+}
+
+//--- Compaction ---//
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneRegionFileAutoCompact, "TerraDyne.RegionFile.AutoCompact", TerraDyneRegionFileTests::Flags)
+
+bool FTerraDyneRegionFileAutoCompact::RunTest(const FString& Parameters)
+{
+	const FString Folder = FPaths::AutomationTransientDir() / TEXT("TerraDyneRegionFile");
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+
+	{
+		// One big cell saved over and over: every burst supersedes the last frame
+		const TSharedRef<FTerraDyneRegionFile> Region = MakeShared<FTerraDyneRegionFile>(Folder / TEXT("AutoCompact.tdr"));
+		TArray<uint8> Frame;
+		Frame.SetNumZeroed(6 * 1024 * 1024);
+
+		int64 MaxDeadBytes = 0;
+		for (int32 Burst = 0; Burst < 8; Burst++)
+		{
+			FTerraDyneRegionFile::FWriteScope Write = FTerraDyneRegionFile::BeginWrite(Region);
+			Frame[0] = (uint8)Burst;
+			TestTrue(FString::Printf(TEXT("Burst %d appended"), Burst), Region->Append(FIntPoint(0, 0), Frame.GetData(), Frame.Num()));
+			Write.Release();
+
+			MaxDeadBytes = FMath::Max(MaxDeadBytes, Region->GetDeadBytes());
+		}
+
+		TestTrue(TEXT("Dead bytes stay bounded"), MaxDeadBytes < 4 * (int64)Frame.Num());
+		TestTrue(TEXT("File stays near its live size"), IFileManager::Get().FileSize(*Region->GetFilePath()) < 5 * (int64)Frame.Num());
+
+		FTerraDyneRegionFile::FChunkRead Read;
+		TestTrue(TEXT("Latest frame survives"), Region->Read(FIntPoint(0, 0), Read) && Read.Num() == Frame.Num() && Read.GetData()[0] == 7);
+	}
+
+	IFileManager::Get().DeleteDirectory(*Folder, false, true);
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
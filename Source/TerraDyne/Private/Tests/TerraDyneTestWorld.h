@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/TerraDyneManager.h"
+#include "Core/TerraDyneSubsystem.h"
+#include "Core/TerraDyneWorkerPool.h"
+#include "World/TerraDyneChunk.h"
+
+// Engine Includes
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+/**
+ * FTerraDyneTestWorld
+ *
+ * A headless game world that lives for one automation test (TerraDyne.Benchmark.* and the functional tests).
+ * CPU heights, weights and collision only: no RHI needed.
+ */
+class FTerraDyneTestWorld
+{
+public:
+	static constexpr float ChunkSize = 10000.0f;
+
+	FTerraDyneTestWorld()
+	{
+		World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("TerraDyneTestWorld"));
+		FWorldContext& Context = GEngine->CreateNewWorldContext(EWorldType::Game);
+		Context.SetCurrentWorld(World);
+
+		if (UTerraDyneSubsystem* Subsystem = World->GetSubsystem<UTerraDyneSubsystem>())
+		{
+			Subsystem->SetRenderModeOverride(ETerraDyneRenderMode::Headless);
+		}
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+	}
+
+	~FTerraDyneTestWorld()
+	{
+		FTerraDyneWorkerPool::Get().WaitForAll();
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	UWorld* Get() const { return World; }
+
+	/** A standalone chunk with flat caches and a full-detail collision topology. */
+	ATerraDyneChunk* SpawnChunk(int32 Res, FIntPoint Coord = FIntPoint(0, 0))
+	{
+		const FTransform Transform = GetCellTransform(Coord);
+		ATerraDyneChunk* Chunk = World->SpawnActorDeferred<ATerraDyneChunk>(ATerraDyneChunk::StaticClass(), Transform);
+		Chunk->InitializeChunk(Coord, ChunkSize, Res, nullptr);
+		Chunk->FinishSpawning(Transform);
+		return Chunk;
+	}
+
+	/** A chunk as placed in a level: no caches yet, so its BeginPlay hands the init to the Manager's queue. */
+	ATerraDyneChunk* SpawnLevelChunk(FIntPoint Coord)
+	{
+		const FTransform Transform = GetCellTransform(Coord);
+		ATerraDyneChunk* Chunk = World->SpawnActorDeferred<ATerraDyneChunk>(ATerraDyneChunk::StaticClass(), Transform);
+		Chunk->GridCoordinate = Coord;
+		Chunk->ChunkSizeWorldUnits = ChunkSize;
+		Chunk->FinishSpawning(Transform);
+		return Chunk;
+	}
+
+	/** A headless Manager whose pooled chunks use Res; no auto-import, no memory budget. */
+	ATerraDyneManager* SpawnManager(int32 Res)
+	{
+		ATerraDyneManager* Manager = World->SpawnActorDeferred<ATerraDyneManager>(ATerraDyneManager::StaticClass(), FTransform::Identity);
+		Manager->bAutoImportAtRuntime = false;
+		Manager->bEnableMemoryBudget = false;
+		Manager->RenderMode = ETerraDyneRenderMode::Headless;
+		Manager->GlobalChunkSize = ChunkSize;
+		Manager->PooledChunkResolution = Res;
+		Manager->ChunkPoolMaxSize = 1024;
+		Manager->FinishSpawning(FTransform::Identity);
+		return Manager;
+	}
+
+	/** Chunk meshes are centered on the actor; grid cell X covers [X, X+1) * ChunkSize. */
+	static FTransform GetCellTransform(FIntPoint Coord)
+	{
+		return FTransform(FVector((Coord.X + 0.5) * ChunkSize, (Coord.Y + 0.5) * ChunkSize, 0.0));
+	}
+
+private:
+	UWorld* World = nullptr;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,96 @@
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Core/TerraDyneWorkScheduler.h"
+
+/**
+ * TerraDyne.WorkScheduler.*
+ *
+ * FTerraDyneWorkScheduler in isolation (no world needed).
+ */
+namespace TerraDyneWorkSchedulerTests
+{
+	constexpr EAutomationTestFlags Flags = EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::EngineFilter;
+
+	/** Two ready Collision items: A nearest the viewer, so it runs first; A's work cancels B. */
+	struct FCancelFixture
+	{
+		FTerraDyneWorkScheduler Scheduler;
+		int32 KeyA = 0;
+		int32 KeyB = 0;
+		int32 RunsA = 0;
+		int32 RunsB = 0;
+		int32 RunsReplacement = 0;
+
+		void Enqueue(bool bReenqueueB)
+		{
+			Scheduler.Enqueue(ETerraDyneWorkCategory::Collision, &KeyA, FVector::ZeroVector, [this, bReenqueueB]()
+				{
+					RunsA++;
+					Scheduler.CancelAll(&KeyB);
+					if (bReenqueueB)
+					{
+						Scheduler.Enqueue(ETerraDyneWorkCategory::Collision, &KeyB, FVector::ZeroVector, [this]() { RunsReplacement++; });
+					}
+				});
+			Scheduler.Enqueue(ETerraDyneWorkCategory::Collision, &KeyB, FVector(100000.0, 0.0, 0.0), [this]() { RunsB++; });
+		}
+
+		void Tick(float BudgetMs)
+		{
+			float Budgets[FTerraDyneWorkScheduler::NumCategories];
+			for (float& Budget : Budgets)
+			{
+				Budget = BudgetMs;
+			}
+			const FVector Viewer = FVector::ZeroVector;
+			Scheduler.Tick(MakeArrayView(&Viewer, 1), MakeArrayView(Budgets), 1000.0f);
+		}
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTerraDyneWorkSchedulerCancelInTick, "TerraDyne.WorkScheduler.CancelDuringTick", TerraDyneWorkSchedulerTests::Flags)
+
+bool FTerraDyneWorkSchedulerCancelInTick::RunTest(const FString& Parameters)
+{
+	using namespace TerraDyneWorkSchedulerTests;
+
+	// Within budget: B was already taken out with A, it must not run anyway
+	{
+		FCancelFixture Fixture;
+		Fixture.Enqueue(false);
+		Fixture.Tick(1000.0f);
+		TestEqual(TEXT("Executed: A runs"), Fixture.RunsA, 1);
+		TestEqual(TEXT("Executed: cancelled B is skipped"), Fixture.RunsB, 0);
+		TestTrue(TEXT("Executed: queue empty"), Fixture.Scheduler.IsEmpty());
+	}
+
+	// Out of budget: B would carry over, it must be dropped instead of requeued
+	{
+		FCancelFixture Fixture;
+		Fixture.Enqueue(false);
+		Fixture.Tick(0.0f);
+		TestEqual(TEXT("Carry-over: A runs"), Fixture.RunsA, 1);
+		TestFalse(TEXT("Carry-over: cancelled B is not requeued"), Fixture.Scheduler.IsQueued(ETerraDyneWorkCategory::Collision, &Fixture.KeyB));
+		Fixture.Tick(1000.0f);
+		TestEqual(TEXT("Carry-over: cancelled B never runs"), Fixture.RunsB, 0);
+	}
+
+	// Cancelled, then enqueued again in the same tick: only the new work survives
+	for (const float BudgetMs : { 0.0f, 1000.0f })
+	{
+		FCancelFixture Fixture;
+		Fixture.Enqueue(true);
+		Fixture.Tick(BudgetMs);
+		TestTrue(TEXT("Re-enqueue: the new B is queued"), Fixture.Scheduler.IsQueued(ETerraDyneWorkCategory::Collision, &Fixture.KeyB));
+		Fixture.Tick(1000.0f);
+		TestEqual(TEXT("Re-enqueue: the old B never runs"), Fixture.RunsB, 0);
+		TestEqual(TEXT("Re-enqueue: the new B runs once"), Fixture.RunsReplacement, 1);
+	}
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
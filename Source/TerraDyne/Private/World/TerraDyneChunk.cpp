@@ -6,17 +6,34 @@
 #include "GeometryScript/MeshSpatialFunctions.h"
 #include "GeometryScript/MeshBasicEditFunctions.h"
 #include "Kismet/KismetRenderingLibrary.h"
-#include "Kismet/GameplayStatics.h"
 #include "Components/DynamicMeshComponent.h"
 #include "Engine/TextureRenderTarget2D.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "TimerManager.h"
 #include "Async/Async.h"
+#include "RenderingThread.h"
+#include "RHICommandList.h"
+#include "TextureResource.h"
+#include "DynamicMesh/DynamicMesh3.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 
 // TerraDyne Includes
 #include "Core/TerraDyneSubsystem.h"
 #include "Grass/TerraDyneGrassSystem.h"
 #include "Core/TerraDyneManager.h"
+#include "Physics/TerraDyneCollision.h"
+#include "Core/TerraDyneResampler.h"
+#include "Core/TerraDyneEditGraph.h"
+#include "Core/TerraDyneStats.h"
+#include "Core/TerraDyneMemory.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "AI/NavigationSystemBase.h"
+#include "Misc/Compression.h"
+
+// TerraDyneCore
+#include "TerraDyneKernels.h"
+#include "TerraDyneChunkCodec.h"
 
 // Helper Macros
 #define GRID_INDEX(X, Y) ((Y) * Resolution + (X))
@@ -34,6 +51,7 @@ ATerraDyneChunk::ATerraDyneChunk()
 	PhysicsMesh->CollisionType = ECollisionTraceFlag::CTF_UseComplexAsSimple;
 	PhysicsMesh->SetGenerateOverlapEvents(false);
 
+	// Always created so the CDO (and every subobject path) is the same in every process; headless runs drop it in BeginPlay
 	VisualMesh = CreateDefaultSubobject<UVirtualHeightfieldMeshComponent>(TEXT("VisualMesh"));
 	VisualMesh->SetupAttachment(RootComponent);
 
@@ -46,6 +64,8 @@ ATerraDyneChunk::ATerraDyneChunk()
 
 UTextureRenderTarget2D* ATerraDyneChunk::CreateInternalRT(int32 Res, ETextureRenderTargetFormat Format, FLinearColor ClearColor)
 {
+	TERRADYNE_LLM_SCOPE(RenderTargets);
+
 	UTextureRenderTarget2D* RT = NewObject<UTextureRenderTarget2D>(this);
 	RT->RenderTargetFormat = Format;
 	RT->InitAutoFormat(Res, Res);
@@ -54,33 +74,132 @@ UTextureRenderTarget2D* ATerraDyneChunk::CreateInternalRT(int32 Res, ETextureRen
 	return RT;
 }
 
+UTextureRenderTarget2D* ATerraDyneChunk::ReuseOrCreateRT(UTextureRenderTarget2D* Existing, int32 Res, ETextureRenderTargetFormat Format, FLinearColor ClearColor)
+{
+	// Headless: nothing samples the RTs, every GPU path checks for null
+	if (IsHeadless()) return nullptr;
+
+	if (Existing && Existing->SizeX == Res && Existing->SizeY == Res && Existing->RenderTargetFormat == Format)
+	{
+		// Pooled path: no allocation, just wipe the previous tenant's data
+		UKismetRenderingLibrary::ClearRenderTarget2D(this, Existing, ClearColor);
+		return Existing;
+	}
+	return CreateInternalRT(Res, Format, ClearColor);
+}
+
 void ATerraDyneChunk::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Self Healing: If empty, init default so physics works
-	if (HeightCache.Num() == 0 && !LinkedTileData)
+	// Tile chunks carry their size (baked with the placeholder), so nothing is loaded to index them
+	if (const UTerraDyneTileData* Tile = LinkedTileData.Get())
 	{
-		InitializeChunk(GridCoordinate, ChunkSizeWorldUnits, 128, nullptr);
-		RebuildPhysicsMesh(); // Vital force build
-		UE_LOG(LogTemp, Log, TEXT("TerraDyneChunk: Self-Initialized empty chunk at %s"), *GetActorLocation().ToString());
+		ChunkSizeWorldUnits = Tile->RealWorldSize;
+	}
+	bStartupInitPending = !LinkedTileData.IsNull() || HeightCache.Num() == 0;
+
+	if (VisualMesh && IsHeadless())
+	{
+		VisualMesh->DestroyComponent();
+		VisualMesh = nullptr;
+		HeightRT = nullptr;
+		WeightRT = nullptr;
+		VisualMID = nullptr;
+	}
+
+	// The Manager (if any) injects materials and queues the heavy init
+	UTerraDyneSubsystem* Subsystem = GetWorld()->GetSubsystem<UTerraDyneSubsystem>();
+	if (Subsystem)
+	{
+		Subsystem->RegisterChunk(this);
+	}
+
+	if (bStartupInitPending && !bStartupInitQueued)
+	{
+		// The Manager may still BeginPlay this frame; give it one tick to pick us up
+		GetWorldTimerManager().SetTimerForNextTick(this, &ATerraDyneChunk::RunStartupInitIfOrphaned);
+	}
+}
+
+void ATerraDyneChunk::RunStartupInitIfOrphaned()
+{
+	if (bStartupInitPending && !bStartupInitQueued)
+	{
+		RunStartupInit();
+	}
+}
+
+void ATerraDyneChunk::RunStartupInit()
+{
+	if (!bStartupInitPending) return;
+
+	if (const UTerraDyneTileData* Tile = LinkedTileData.Get())
+	{
+		DequantizeFromAsset(Tile);
 	}
-	else if (LinkedTileData)
+	FinishStartupInit();
+}
+
+void ATerraDyneChunk::FinishStartupInit()
+{
+	bStartupInitPending = false;
+	bStartupInitQueued = false;
+
+	if (!LinkedTileData.IsNull())
 	{
-		InitializeFromAsset(LinkedTileData);
+		if (LinkedTileData.Get())
+		{
+			// Already resident (and dequantized by the caller)
+			CommitCaches();
+			ReleaseTileData();
+			return;
+		}
+
+		// Not loaded yet: show the baked low-res heights until the Manager finds us relevant
+		ShowPlaceholder();
+		bAwaitingTileData = true;
+		if (!FindManager())
+		{
+			RequestTileData();
+		}
+		return;
 	}
 
-	// Material Injection from Manager
-	if (ATerraDyneManager* Manager = Cast<ATerraDyneManager>(UGameplayStatics::GetActorOfClass(GetWorld(), ATerraDyneManager::StaticClass())))
+	// Self Healing: If empty, init default so physics works
+	if (HeightCache.Num() == 0)
 	{
-		if (!BrushMaterialBase && Manager->HeightBrushMaterial) BrushMaterialBase = Manager->HeightBrushMaterial;
-		if (!PaintMaterialBase && Manager->WeightBrushMaterial) PaintMaterialBase = Manager->WeightBrushMaterial;
+		InitializeChunk(GridCoordinate, ChunkSizeWorldUnits, 128, nullptr);
+		if (ShouldDeferCollision())
+		{
+			ReleaseCollision(); // Built on demand by the Manager
+		}
+		else
+		{
+			RebuildPhysicsMesh(); // Vital force build
+		}
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneChunk: Self-Initialized empty chunk at %s"), *GetActorLocation().ToString());
 	}
 }
 
 void ATerraDyneChunk::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_CollisionUpdate);
+	CancelBackgroundJobs();
+
+	if (TileDataHandle.IsValid())
+	{
+		TileDataHandle->CancelHandle();
+		TileDataHandle.Reset();
+	}
+
+	if (UTerraDyneSubsystem* Subsystem = GetWorld()->GetSubsystem<UTerraDyneSubsystem>())
+	{
+		Subsystem->CancelWork(this);
+		Subsystem->UnregisterChunk(this);
+	}
+	AbandonTrackedEdits();
+	PendingDelta.ReturnBuffers();
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -88,19 +207,75 @@ void ATerraDyneChunk::InitializeFromAsset(UTerraDyneTileData* TileData)
 {
 	if (!TileData) return;
 
+	DiscardCompressedCaches();
+	DequantizeFromAsset(TileData);
+	CommitCaches();
+}
+
+void ATerraDyneChunk::DequantizeFromAsset(const UTerraDyneTileData* TileData)
+{
 	Resolution = TileData->Resolution;
 	ChunkSizeWorldUnits = TileData->RealWorldSize;
 
-	HeightCache.SetNumUninitialized(TileData->InitialHeightMap.Num());
-	ParallelFor(TileData->InitialHeightMap.Num(), [&](int32 i)
-		{
-			float Normalized = (float)TileData->InitialHeightMap[i] / 65535.0f;
-			HeightCache[i] = Normalized * (ZScale * 512.0f);
-		});
+	SetDeltaBase(DequantizeTile(TileData, ZScale, HeightCache, WeightCache));
+}
+
+void ATerraDyneChunk::AdoptDecodedTile(TArray<float>&& Heights, TArray<FColor>&& Weights, int32 TileResolution, float TileSize, uint64 TileHash)
+{
+	Resolution = TileResolution;
+	ChunkSizeWorldUnits = TileSize;
+	HeightCache = MoveTemp(Heights);
+	WeightCache = MoveTemp(Weights);
+	SetDeltaBase(TileHash);
+}
+
+uint64 ATerraDyneChunk::DequantizeTile(const UTerraDyneTileData* TileData, float InZScale, TArray<float>& OutHeights, TArray<FColor>& OutWeights)
+{
+	return DequantizeTile(TileData->InitialHeightMap, TileData->InitialWeightMap, InZScale, OutHeights, OutWeights);
+}
+
+uint64 ATerraDyneChunk::DequantizeTile(const TArray<uint16>& QuantizedHeights, const TArray<FColor>& TileWeights, float InZScale, TArray<float>& OutHeights, TArray<FColor>& OutWeights)
+{
+	// Serial on purpose: callers already run one chunk per worker
+	const int32 Num = QuantizedHeights.Num();
+	OutHeights.SetNumUninitialized(Num);
+	TerraDyneCore::DequantizeHeights(QuantizedHeights.GetData(), OutHeights.GetData(), Num, TerraDyneCore::GetHeightQuantizationStep(InZScale));
+
+	if (TileWeights.Num() == Num)
+	{
+		OutWeights = TileWeights;
+	}
+	else
+	{
+		OutWeights.Reset();
+		OutWeights.SetNumZeroed(Num);
+	}
+
+	// Identifies this exact decode, so delta saves can tell whether they still apply
+	return TerraDyneCore::FChunkCodec::HashBase(OutHeights.GetData(), reinterpret_cast<const TerraDyneCore::FTexelBGRA*>(OutWeights.GetData()), Num);
+}
 
-	HeightRT = CreateInternalRT(Resolution, RTF_R16f, FLinearColor::Black);
-	WeightRT = CreateInternalRT(Resolution, RTF_RGBA8, FLinearColor(0, 0, 0, 0));
+void ATerraDyneChunk::CommitCaches()
+{
+	HeightRT = ReuseOrCreateRT(HeightRT, Resolution, RTF_R16f, FLinearColor::Black);
+	WeightRT = ReuseOrCreateRT(WeightRT, Resolution, RTF_RGBA8, FLinearColor(0, 0, 0, 0));
 	UpdateVisualTexture();
+	BindVisualTextures();
+
+	if (ShouldDeferCollision())
+	{
+		if (bHasCollision || PendingCollisionLOD != INDEX_NONE)
+		{
+			// Already demanded (e.g. built on the placeholder): rebuild it from the new heights
+			StartCollisionBuild(PendingCollisionLOD != INDEX_NONE ? PendingCollisionLOD : CollisionLOD);
+		}
+		else
+		{
+			// Lazy collision: nothing is cooked until a physics source comes close
+			ReleaseCollision();
+		}
+		return;
+	}
 
 	RebuildPhysicsMesh(); // Build collision
 
@@ -110,14 +285,64 @@ void ATerraDyneChunk::InitializeFromAsset(UTerraDyneTileData* TileData)
 
 void ATerraDyneChunk::InitializeChunk(FIntPoint Coord, float Size, int32 InRes, UTexture2D* SourceHeight, UTexture2D* SourceWeight)
 {
+	DiscardCompressedCaches();
+
 	GridCoordinate = Coord;
 	ChunkSizeWorldUnits = Size;
 	Resolution = InRes;
+	ClearDeltaBase();
+
+	TERRADYNE_LLM_SCOPE(Caches);
 
+	// Reset() keeps the allocation, so pooled chunks re-use their height buffer
+	HeightCache.Reset();
 	HeightCache.SetNumZeroed(Resolution * Resolution);
+	WeightCache.Reset();
+	WeightCache.SetNumZeroed(Resolution * Resolution);
+
+	HeightRT = ReuseOrCreateRT(HeightRT, Resolution, RTF_R16f, FLinearColor::Black);
+	WeightRT = ReuseOrCreateRT(WeightRT, Resolution, RTF_RGBA8, FLinearColor(0, 0, 0, 0));
+	BindVisualTextures();
+}
+
+void ATerraDyneChunk::BindVisualTextures()
+{
+	// Materials are injected at registration, usually before the RTs exist (or after they were replaced)
+	if (VisualMID)
+	{
+		VisualMID->SetTextureParameterValue(TEXT("HeightMap"), HeightRT);
+		VisualMID->SetTextureParameterValue(TEXT("WeightMap"), WeightRT);
+	}
+}
+
+void ATerraDyneChunk::ApplyImportedData(TArray<float>&& Heights, TArray<FColor>&& Weights)
+{
+	const int32 Expected = Resolution * Resolution;
+	if (Heights.Num() != Expected) return;
+
+	DiscardCompressedCaches();
+	ClearDeltaBase();
+	HeightCache = MoveTemp(Heights);
+	if (Weights.Num() == Expected)
+	{
+		WeightCache = MoveTemp(Weights);
+	}
+
+	UpdateVisualTexture();
+
+	if (ShouldDeferCollision())
+	{
+		ReleaseCollision();
+		return;
+	}
+
+	if (BuiltMeshResolution != Resolution || !FMath::IsNearlyEqual(BuiltMeshSize, ChunkSizeWorldUnits))
+	{
+		RebuildPhysicsMesh();
+	}
 
-	HeightRT = CreateInternalRT(Resolution, RTF_R16f, FLinearColor::Black);
-	WeightRT = CreateInternalRT(Resolution, RTF_RGBA8, FLinearColor(0, 0, 0, 0));
+	bPhysicsIsDirty = true;
+	PerformDeferredCollisionUpdate();
 }
 
 void ATerraDyneChunk::RebuildPhysicsMesh()
@@ -135,174 +360,1420 @@ void ATerraDyneChunk::RebuildPhysicsMesh()
 		Resolution / 2, Resolution / 2
 	);
 
-	PhysicsMesh->UpdateCollision(true);
+	BuiltMeshResolution = Resolution;
+	BuiltMeshSize = ChunkSizeWorldUnits;
+
+	// Full-detail grid; invalidates any in-flight LOD build
+	CollisionLOD = 0;
+	PendingCollisionLOD = INDEX_NONE;
+	CollisionBuildSerial++;
+
+	bHasCollision = true;
+	PhysicsMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+	CookCollision();
 }
 
-void ATerraDyneChunk::ApplyLocalIdempotentEdit(FVector RelativePos, float Radius, float Strength, bool bIsHole, int32 PaintLayer)
+int32 ATerraDyneChunk::GetCollisionQuadsForLOD(int32 LOD) const
 {
-	if (HeightCache.Num() == 0) return;
+	return FMath::Max((Resolution / 2) >> FMath::Max(LOD, 0), 1);
+}
 
-	if (PaintLayer >= 0)
-	{
-		ApplyPaintBrush(GetActorLocation() + RelativePos, Radius, 1.0f, PaintLayer);
-		return;
-	}
+void ATerraDyneChunk::SetCollisionLOD(int32 NewLOD)
+{
+	NewLOD = FMath::Max(NewLOD, 0);
 
-	float HalfSize = ChunkSizeWorldUnits * 0.5f;
-	float gridX = ((RelativePos.X + HalfSize) / ChunkSizeWorldUnits) * (Resolution - 1);
-	float gridY = ((RelativePos.Y + HalfSize) / ChunkSizeWorldUnits) * (Resolution - 1);
-	float radGrid = (Radius / ChunkSizeWorldUnits) * (Resolution - 1);
+	// Collision-less chunks only get a mesh through EnsureCollision()
+	if (!bHasCollision) return;
 
-	int32 minX = FMath::Clamp(FMath::FloorToInt(gridX - radGrid), 0, Resolution - 1);
-	int32 maxX = FMath::Clamp(FMath::CeilToInt(gridX + radGrid), 0, Resolution - 1);
-	int32 minY = FMath::Clamp(FMath::FloorToInt(gridY - radGrid), 0, Resolution - 1);
-	int32 maxY = FMath::Clamp(FMath::CeilToInt(gridY + radGrid), 0, Resolution - 1);
+	const int32 TargetLOD = (PendingCollisionLOD != INDEX_NONE) ? PendingCollisionLOD : CollisionLOD;
+	if (NewLOD == TargetLOD) return;
 
-	bool bModified = false;
+	// Cold chunks only wake up for more detail, never to re-coarsen
+	if (bCachesCompressed && NewLOD > TargetLOD) return;
 
-	if (!bIsHole)
+	StartCollisionBuild(NewLOD);
+}
+
+void ATerraDyneChunk::EnsureCollision(int32 LOD)
+{
+	if (bHasCollision || PendingCollisionLOD != INDEX_NONE) return;
+
+	StartCollisionBuild(FMath::Max(LOD, 0));
+}
+
+void ATerraDyneChunk::BuildCollisionNow()
+{
+	if (bHasCollision && CollisionLOD == 0 && PendingCollisionLOD == INDEX_NONE) return;
+	EnsureResident();
+	if (HeightCache.Num() == 0) return;
+
+	// Synchronous full-detail build for callers that trace this frame
+	CollisionBuildSerial++;
+	UE::Geometry::FDynamicMesh3 Mesh;
+	UTerraDyneCollisionLib::BuildHeightfieldMesh(Mesh, HeightCache, Resolution, ChunkSizeWorldUnits, GetCollisionQuadsForLOD(0));
+	FinishCollisionRebuild(MoveTemp(Mesh), 0);
+}
+
+void ATerraDyneChunk::ReleaseCollision()
+{
+	// Drop any in-flight build
+	PendingCollisionLOD = INDEX_NONE;
+	CollisionBuildSerial++;
+	if (CollisionBuildToken.IsValid())
 	{
-		for (int32 y = minY; y <= maxY; y++)
-		{
-			for (int32 x = minX; x <= maxX; x++)
-			{
-				float dist = FVector2D::Distance(FVector2D(x, y), FVector2D(gridX, gridY));
-				if (dist <= radGrid)
-				{
-					float Alpha = 1.0f - (dist / radGrid);
-					int32 idx = GRID_INDEX(x, y);
-					HeightCache[idx] += Strength * Alpha;
-					bModified = true;
-				}
-			}
-		}
+		CollisionBuildToken->Cancel();
+		CollisionBuildToken.Reset();
 	}
 
-	if (!bModified) return;
+	bHasCollision = false;
+	bPhysicsIsDirty = false;
+	BuiltMeshResolution = 0;
 
-	// GPU Draw
-	if (!TerrainMID && BrushMaterialBase)
+	if (PhysicsMesh)
 	{
-		TerrainMID = UMaterialInstanceDynamic::Create(BrushMaterialBase, this);
+		PhysicsMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		PhysicsMesh->GetDynamicMesh()->Reset();
+		PhysicsMesh->UpdateCollision(false); // Frees the cooked body
 	}
+}
 
-	if (TerrainMID && HeightRT)
-	{
-		FVector2D BrushUV(
-			(RelativePos.X + HalfSize) / ChunkSizeWorldUnits,
-			(RelativePos.Y + HalfSize) / ChunkSizeWorldUnits
-		);
+void ATerraDyneChunk::StartCollisionBuild(int32 NewLOD)
+{
+	EnsureResident();
+	if (HeightCache.Num() == 0) return;
 
-		TerrainMID->SetVectorParameterValue(TEXT("BrushPos"), FLinearColor(BrushUV.X, BrushUV.Y, 0, 0));
-		TerrainMID->SetScalarParameterValue(TEXT("Radius"), Radius / ChunkSizeWorldUnits);
-		TerrainMID->SetScalarParameterValue(TEXT("Strength"), Strength);
+	PendingCollisionLOD = NewLOD;
+	const uint32 Serial = ++CollisionBuildSerial;
+
+	// Snapshot the inputs (only the heights this LOD samples); the worker never touches the actor
+	const float Size = ChunkSizeWorldUnits;
+	const int32 Quads = GetCollisionQuadsForLOD(NewLOD);
+	TArray<float> Samples;
+	UTerraDyneCollisionLib::SampleHeightfield(HeightCache, Resolution, Quads, Samples);
 
-		UKismetRenderingLibrary::DrawMaterialToRenderTarget(this, HeightRT, TerrainMID);
+	// A superseded build that hasn't started yet is skipped outright
+	if (CollisionBuildToken.IsValid())
+	{
+		CollisionBuildToken->Cancel();
 	}
 
-	bPhysicsIsDirty = true;
-	GetWorld()->GetTimerManager().SetTimer(
-		TimerHandle_CollisionUpdate,
-		this,
-		&ATerraDyneChunk::PerformDeferredCollisionUpdate,
-		CollisionUpdateDelay,
-		false
-	);
+	TWeakObjectPtr<ATerraDyneChunk> WeakThis(this);
+	CollisionBuildToken = FTerraDyneWorkerPool::Get().Launch(ETerraDyneJobPriority::Interactive,
+		[WeakThis, Serial, NewLOD, Samples = MoveTemp(Samples), Size, Quads](const FTerraDyneCancellationToken& Token)
+		{
+			TSharedPtr<UE::Geometry::FDynamicMesh3> Mesh = MakeShared<UE::Geometry::FDynamicMesh3>();
+			UTerraDyneCollisionLib::BuildHeightfieldMesh(*Mesh, Samples, Quads + 1, Size, Quads);
+			if (Token.IsCancelled()) return;
 
-	// Vegetation Update
-	if (UTerraDyneSubsystem* Subsystem = GetWorld()->GetSubsystem<UTerraDyneSubsystem>())
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial, NewLOD, Mesh]()
+				{
+					ATerraDyneChunk* Chunk = WeakThis.Get();
+					if (!Chunk || Chunk->CollisionBuildSerial != Serial) return; // Superseded
+
+					Chunk->FinishCollisionRebuild(MoveTemp(*Mesh), NewLOD);
+				});
+		});
+}
+
+void ATerraDyneChunk::CancelBackgroundJobs()
+{
+	if (CollisionBuildToken.IsValid())
 	{
-		if (TSharedPtr<FTerraDyneGrassSystem> GrassSys = Subsystem->GetGrassSystem())
-		{
-			FBox WorldBounds = FBox(GetActorLocation() + RelativePos - FVector(Radius), GetActorLocation() + RelativePos + FVector(Radius));
-			GrassSys->RequestRegen(WorldBounds);
-		}
+		CollisionBuildToken->Cancel();
+		CollisionBuildToken.Reset();
+	}
+
+	// A cancelled decode never calls back, so nothing else would clear the flag
+	if (TileDecodeToken.IsValid())
+	{
+		TileDecodeToken->Cancel();
+		TileDecodeToken.Reset();
+		bTileDecodeInFlight = false;
 	}
 }
 
-void ATerraDyneChunk::ApplyPaintBrush(FVector WorldPos, float Radius, float Strength, int32 LayerChannel)
+void ATerraDyneChunk::TrackEdit(TArray<uint32>& Edits, ETerraDyneEditStage Stage)
 {
-	if (!PaintMaterialBase || !WeightRT) return;
+	const uint32 EditId = FTerraDyneEditLatency::GetCurrentEdit();
+	if (EditId == 0) return;
 
-	UMaterialInstanceDynamic* PaintMID = UMaterialInstanceDynamic::Create(PaintMaterialBase, this);
+	// Brushes overlapping several texels of one chunk only count once
+	if (Edits.Num() > 0 && Edits.Last() == EditId) return;
 
-	FVector LocalPos = GetActorTransform().InverseTransformPosition(WorldPos);
-	float HalfSize = ChunkSizeWorldUnits * 0.5f;
-	FVector2D UV(
-		(LocalPos.X + HalfSize) / ChunkSizeWorldUnits,
-		(LocalPos.Y + HalfSize) / ChunkSizeWorldUnits
-	);
+	// Products that never arrive (e.g. a chunk nobody saves) must not grow without bound
+	constexpr int32 MaxTrackedEdits = 1024;
+	if (Edits.Num() >= MaxTrackedEdits)
+	{
+		FTerraDyneEditLatency::Abandon(MakeArrayView(Edits.GetData(), MaxTrackedEdits / 2), Stage);
+		Edits.RemoveAt(0, MaxTrackedEdits / 2, EAllowShrinking::No);
+	}
 
-	PaintMID->SetVectorParameterValue(TEXT("BrushPos"), FLinearColor(UV.X, UV.Y, 0, 0));
-	PaintMID->SetScalarParameterValue(TEXT("Radius"), Radius / ChunkSizeWorldUnits);
-	PaintMID->SetScalarParameterValue(TEXT("Strength"), Strength);
+	FTerraDyneEditLatency::AddPending(EditId, Stage);
+	Edits.Add(EditId);
+}
 
-	FLinearColor Mask(
-		LayerChannel == 0 ? 1 : 0,
-		LayerChannel == 1 ? 1 : 0,
-		LayerChannel == 2 ? 1 : 0,
-		LayerChannel == 3 ? 1 : 0
-	);
-	PaintMID->SetVectorParameterValue(TEXT("ChannelMask"), Mask);
+void ATerraDyneChunk::ResolveEdits(TArray<uint32>& Edits, ETerraDyneEditStage Stage, bool bReached)
+{
+	if (Edits.Num() == 0) return;
 
-	UKismetRenderingLibrary::DrawMaterialToRenderTarget(this, WeightRT, PaintMID);
+	if (bReached)
+	{
+		FTerraDyneEditLatency::Complete(Edits, Stage);
+	}
+	else
+	{
+		FTerraDyneEditLatency::Abandon(Edits, Stage);
+	}
+	Edits.Reset();
 }
 
-void ATerraDyneChunk::PerformDeferredCollisionUpdate()
+void ATerraDyneChunk::AbandonTrackedEdits()
 {
-	if (!bPhysicsIsDirty) return;
-	SyncPhysicsGeometry();
+	ResolveEdits(PendingGPUEdits, ETerraDyneEditStage::GPUUploaded, false);
+	ResolveEdits(PendingCollisionEdits, ETerraDyneEditStage::CollisionLive, false);
+	ResolveEdits(CollisionEditsInFlight, ETerraDyneEditStage::CollisionLive, false);
+	ResolveEdits(PendingGrassEdits, ETerraDyneEditStage::GrassUpdated, false);
+	ResolveEdits(PendingSaveEdits, ETerraDyneEditStage::Persisted, false);
+}
+
+void ATerraDyneChunk::CookCollision()
+{
+	TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_CollisionCook);
+	TERRADYNE_LLM_SCOPE(Collision);
+	FTerraDyneFrameCounters::AddCookedSection();
+
 	PhysicsMesh->UpdateCollision(true);
-	bPhysicsIsDirty = false;
 }
 
-void ATerraDyneChunk::SyncPhysicsGeometry()
+void ATerraDyneChunk::FinishCollisionRebuild(UE::Geometry::FDynamicMesh3&& NewMesh, int32 LOD, bool bResyncHeights)
 {
-	PhysicsMesh->GetDynamicMesh()->EditMesh([&](FDynamicMesh3& Mesh)
-		{
-			for (int32 vid : Mesh.VertexIndicesItr())
-			{
-				FVector3d Pos = Mesh.GetVertex(vid);
+	if (!PhysicsMesh) return;
 
-				float HalfSize = ChunkSizeWorldUnits * 0.5f;
-				int32 X = FMath::Clamp(FMath::RoundToInt(((Pos.X + HalfSize) / ChunkSizeWorldUnits) * (Resolution - 1)), 0, Resolution - 1);
-				int32 Y = FMath::Clamp(FMath::RoundToInt(((Pos.Y + HalfSize) / ChunkSizeWorldUnits) * (Resolution - 1)), 0, Resolution - 1);
+	TERRADYNE_LLM_SCOPE(Collision);
+	PhysicsMesh->SetMesh(MoveTemp(NewMesh));
 
-				float NewZ = HeightCache[GRID_INDEX(X, Y)];
-				Mesh.SetVertex(vid, FVector3d(Pos.X, Pos.Y, NewZ));
-			}
+	CollisionLOD = LOD;
+	PendingCollisionLOD = INDEX_NONE;
+	bHasCollision = true;
+	PhysicsMesh->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
 
-		}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::VertexPositions);
-}
+	// Only the full-detail grid can be re-used in place by the pool
+	BuiltMeshResolution = (LOD == 0) ? Resolution : 0;
+	BuiltMeshSize = ChunkSizeWorldUnits;
 
-void ATerraDyneChunk::UpdateVisualTexture()
-{
+	// Edits that landed during the build only reached the old mesh; re-project the cache
+	if (bResyncHeights)
+	{
+		SyncPhysicsGeometry();
+	}
+	CookCollision();
 }
 
-void ATerraDyneChunk::SetMaterial(UMaterialInterface* InMaterial)
+void ATerraDyneChunk::ApplyLocalIdempotentEdit(FVector RelativePos, float Radius, float Strength, bool bIsHole, int32 PaintLayer)
 {
-	if (!VisualMesh || !InMaterial) return;
+	// An edit on the placeholder would be overwritten by the tile (and any pending delta) once it decodes
+	FlushTileData();
+	EnsureResident();
+	if (HeightCache.Num() == 0) return;
 
-	UMaterialInstanceDynamic* MID = UMaterialInstanceDynamic::Create(InMaterial, this);
-	MID->SetTextureParameterValue(TEXT("HeightMap"), HeightRT);
-	MID->SetTextureParameterValue(TEXT("WeightMap"), WeightRT);
-	MID->SetScalarParameterValue(TEXT("ZScale"), ZScale);
+	LastEditTime = GetWorld()->GetTimeSeconds();
+	EditSerial++;
+	FTerraDyneFrameCounters::AddEdit();
 
-	if (UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(VisualMesh))
+	if (PaintLayer >= 0)
 	{
-		PrimComp->SetMaterial(0, MID);
+		ApplyPaintBrush(GetActorLocation() + RelativePos, Radius, 1.0f, PaintLayer);
+		return;
 	}
-}
 
-void ATerraDyneChunk::SaveAsync(FString SlotName)
-{
-	FTerraDyneChunkSnapshot Snapshot;
-	Snapshot.GridCoordinate = GridCoordinate;
-	Snapshot.HeightData = HeightCache;
-	Snapshot.Resolution = Resolution;
-	Snapshot.RealWorldSize = ChunkSizeWorldUnits;
+	const float HalfSize = ChunkSizeWorldUnits * 0.5f;
+	const TerraDyneCore::FBrushFootprint Brush = TerraDyneCore::MakeBrushFootprint(RelativePos.X, RelativePos.Y, Radius, ChunkSizeWorldUnits, Resolution);
+
+	TerraDyneCore::FBrushResult Result;
+	if (!bIsHole)
+	{
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_BrushKernel);
+		Result = TerraDyneCore::ApplyHeightBrush(TerraDyneCore::TGridView<float>(HeightCache.GetData(), Resolution), Brush, Strength);
+	}
+
+	if (!Result.bModified) return;
+	const float MaxDelta = Result.MaxDelta;
 
-	FString Path = FPaths::ProjectSavedDir() / SlotName / FString::Printf(TEXT("Chk_%d_%d.bin"), GridCoordinate.X, GridCoordinate.Y);
+	// Latency tracing: register before any product below can complete on the spot
+	UTerraDyneSubsystem* Subsystem = GetWorld()->GetSubsystem<UTerraDyneSubsystem>();
+	if (HeightRT)
+	{
+		TrackEdit(PendingGPUEdits, ETerraDyneEditStage::GPUUploaded);
+	}
+	if (bHasCollision || PendingCollisionLOD != INDEX_NONE)
+	{
+		TrackEdit(PendingCollisionEdits, ETerraDyneEditStage::CollisionLive);
+	}
+	if (Subsystem && !Subsystem->IsHeadless() && Subsystem->GetGrassSystem().IsValid())
+	{
+		TrackEdit(PendingGrassEdits, ETerraDyneEditStage::GrassUpdated);
+	}
+	TrackEdit(PendingSaveEdits, ETerraDyneEditStage::Persisted);
 
-	(new FAutoDeleteAsyncTask<FTerraDyneAsyncSaver>(Snapshot, Path))->StartBackgroundTask();
-}
\ No newline at end of file
+	// GPU Draw (none when headless, deferred into the dirty region while nobody can see the chunk)
+	const FIntRect DirtyRegion(Brush.Rect.MinX, Brush.Rect.MinY, Brush.Rect.MaxX, Brush.Rect.MaxY);
+	MarkBlocksModified(DirtyRegion);
+	if (!HeightRT)
+	{
+		// Headless: CPU caches and collision only
+	}
+	else if (ShouldDeferGPUUpdate())
+	{
+		MarkGPURegionDirty(DirtyRegion);
+	}
+	else if (!TerrainMID && !BrushMaterialBase)
+	{
+		UpdateVisualRegion(DirtyRegion);
+	}
+	else
+	{
+		if (!TerrainMID)
+		{
+			TerrainMID = UMaterialInstanceDynamic::Create(BrushMaterialBase, this);
+		}
+
+		FVector2D BrushUV(
+			(RelativePos.X + HalfSize) / ChunkSizeWorldUnits,
+			(RelativePos.Y + HalfSize) / ChunkSizeWorldUnits
+		);
+
+		TerrainMID->SetVectorParameterValue(TEXT("BrushPos"), FLinearColor(BrushUV.X, BrushUV.Y, 0, 0));
+		TerrainMID->SetScalarParameterValue(TEXT("Radius"), Radius / ChunkSizeWorldUnits);
+		TerrainMID->SetScalarParameterValue(TEXT("Strength"), Strength);
+
+		{
+			TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_RTDraw);
+			UKismetRenderingLibrary::DrawMaterialToRenderTarget(this, HeightRT, TerrainMID);
+		}
+		ResolveEdits(PendingGPUEdits, ETerraDyneEditStage::GPUUploaded, true);
+	}
+
+	if (!bPhysicsIsDirty)
+	{
+		FTerraDyneFrameCounters::AddDirtyChunk();
+	}
+	bPhysicsIsDirty = true;
+	ReportTerrainChange(DirtyRegion, MaxDelta, false);
+
+	PendingGrassBounds += FBox(GetActorLocation() + RelativePos - FVector(Radius), GetActorLocation() + RelativePos + FVector(Radius));
+
+	if (!Subsystem)
+	{
+		FlushDerivedProducts();
+		return;
+	}
+
+	// Derived products: debounced and budgeted by the scheduler (re-stamping restarts the delay)
+	TWeakObjectPtr<ATerraDyneChunk> WeakThis(this);
+	Subsystem->EnqueueWork(ETerraDyneWorkCategory::Collision, this, GetActorLocation(), [WeakThis]()
+		{
+			if (ATerraDyneChunk* Chunk = WeakThis.Get())
+			{
+				Chunk->FlushDerivedProducts();
+			}
+		}, CollisionUpdateDelay);
+}
+
+void ATerraDyneChunk::FlushDerivedProducts()
+{
+	const bool bBuildCollision = bPhysicsIsDirty && (bHasCollision || PendingCollisionLOD != INDEX_NONE);
+	const bool bPackTexture = bHasPendingGPURegion && !ShouldDeferGPUUpdate();
+	const bool bRegenGrass = PendingGrassBounds.IsValid != 0;
+
+	// Without collision the on-demand build reads the latest HeightCache anyway
+	bPhysicsIsDirty = false;
+	if (bBuildCollision)
+	{
+		// Every edit up to this snapshot goes live with the newest build
+		CollisionEditsInFlight.Append(MoveTemp(PendingCollisionEdits));
+		PendingCollisionEdits.Reset();
+	}
+	else
+	{
+		ResolveEdits(PendingCollisionEdits, ETerraDyneEditStage::CollisionLive, false);
+	}
+	if (!bBuildCollision && !bPackTexture && !bRegenGrass) return;
+
+	struct FOutputs
+	{
+		UE::Geometry::FDynamicMesh3 Mesh;
+		FTerraDynePackedRegion Texture;
+	};
+	TSharedPtr<FOutputs> Outputs = MakeShared<FOutputs>();
+
+	// Each node gets its own immutable snapshot of just what it reads, so the Game Thread may keep editing
+	const float Size = ChunkSizeWorldUnits;
+
+	FTerraDyneEditGraph Graph;
+
+	int32 LOD = INDEX_NONE;
+	uint32 Serial = 0;
+	if (bBuildCollision)
+	{
+		// Supersedes any in-flight build (it snapshotted older heights)
+		LOD = (PendingCollisionLOD != INDEX_NONE) ? PendingCollisionLOD : CollisionLOD;
+		PendingCollisionLOD = LOD;
+		Serial = ++CollisionBuildSerial;
+		if (CollisionBuildToken.IsValid())
+		{
+			CollisionBuildToken->Cancel();
+		}
+		CollisionBuildToken = MakeShared<FTerraDyneCancellationToken, ESPMode::ThreadSafe>();
+
+		// The vertices of this LOD only: a quarter of the cache at LOD 0, less further out
+		const int32 Quads = GetCollisionQuadsForLOD(LOD);
+		TArray<float> Samples;
+		UTerraDyneCollisionLib::SampleHeightfield(HeightCache, Resolution, Quads, Samples);
+		Graph.AddNode(TEXT("TerraDyneCollisionMesh"), ETerraDyneEditResource::Heights, ETerraDyneEditResource::CollisionMesh,
+			[Outputs, Samples = MoveTemp(Samples), Size, Quads]()
+			{
+				UTerraDyneCollisionLib::BuildHeightfieldMesh(Outputs->Mesh, Samples, Quads + 1, Size, Quads);
+			}, CollisionBuildToken);
+	}
+
+	TArray<uint32> GPUEdits;
+	if (bPackTexture)
+	{
+		GPUEdits = MoveTemp(PendingGPUEdits);
+		PendingGPUEdits.Reset();
+
+		const int32 Num = Resolution * Resolution;
+		FIntRect Region = PendingGPURegion;
+		Region.Clip(FIntRect(0, 0, Resolution, Resolution));
+		const bool bPackHeights = HeightRT != nullptr && HeightCache.Num() == Num;
+		const bool bPackWeights = WeightRT != nullptr && WeightCache.Num() == Num;
+		bHasPendingGPURegion = false;
+
+		// The dirty rows only, copied tight (stride = width)
+		const int32 Width = FMath::Max(Region.Width(), 0);
+		const int32 Rows = FMath::Max(Region.Height(), 0);
+		TArray<float> RegionHeights;
+		TArray<FColor> RegionWeights;
+		RegionHeights.SetNumUninitialized(bPackHeights ? Width * Rows : 0);
+		RegionWeights.SetNumUninitialized(bPackWeights ? Width * Rows : 0);
+		for (int32 y = 0; y < Rows; y++)
+		{
+			const int32 Src = (Region.Min.Y + y) * Resolution + Region.Min.X;
+			if (bPackHeights) FMemory::Memcpy(&RegionHeights[y * Width], &HeightCache[Src], Width * sizeof(float));
+			if (bPackWeights) FMemory::Memcpy(&RegionWeights[y * Width], &WeightCache[Src], Width * sizeof(FColor));
+		}
+
+		Graph.AddNode(TEXT("TerraDyneTexturePack"), ETerraDyneEditResource::Heights | ETerraDyneEditResource::Weights, ETerraDyneEditResource::PackedTexture,
+			[Outputs, RegionHeights = MoveTemp(RegionHeights), RegionWeights = MoveTemp(RegionWeights), Region, Width, Rows, bPackHeights, bPackWeights]()
+			{
+				Outputs->Texture.Region = Region;
+				PackVisualRows(bPackHeights ? RegionHeights.GetData() : nullptr, bPackWeights ? RegionWeights.GetData() : nullptr, Width, Width, Rows, Outputs->Texture);
+			});
+	}
+
+	// Sync point: everything that touches components or UObjects
+	TWeakObjectPtr<ATerraDyneChunk> WeakThis(this);
+	Graph.Launch(ETerraDyneJobPriority::Interactive, [WeakThis, Outputs, GPUEdits = MoveTemp(GPUEdits), bBuildCollision, bPackTexture, bRegenGrass, LOD, Serial]() mutable
+		{
+			ATerraDyneChunk* Chunk = WeakThis.Get();
+			if (!Chunk)
+			{
+				FTerraDyneEditLatency::Abandon(GPUEdits, ETerraDyneEditStage::GPUUploaded);
+				return;
+			}
+
+			if (bPackTexture)
+			{
+				Chunk->SubmitVisualRegion(MoveTemp(Outputs->Texture));
+				ResolveEdits(GPUEdits, ETerraDyneEditStage::GPUUploaded, true);
+			}
+
+			if (bBuildCollision && Chunk->CollisionBuildSerial == Serial)
+			{
+				// Newer edits re-flush with their own snapshot, so no re-projection here
+				Chunk->FinishCollisionRebuild(MoveTemp(Outputs->Mesh), LOD, false);
+				FNavigationSystem::UpdateComponentData(*Chunk->PhysicsMesh);
+				ResolveEdits(Chunk->CollisionEditsInFlight, ETerraDyneEditStage::CollisionLive, true);
+			}
+
+			if (bRegenGrass)
+			{
+				Chunk->QueueGrassRegen();
+			}
+		});
+}
+
+void ATerraDyneChunk::QueueGrassRegen()
+{
+	UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	if (!Subsystem || Subsystem->IsHeadless() || !Subsystem->GetGrassSystem().IsValid())
+	{
+		ResolveEdits(PendingGrassEdits, ETerraDyneEditStage::GrassUpdated, false);
+		PendingGrassBounds.Init();
+		return;
+	}
+
+	// Stamps keep growing the bounds until the grass budget gets to us
+	TWeakObjectPtr<ATerraDyneChunk> WeakThis(this);
+	Subsystem->EnqueueWork(ETerraDyneWorkCategory::Grass, this, GetActorLocation(), [WeakThis]()
+		{
+			ATerraDyneChunk* Chunk = WeakThis.Get();
+			if (!Chunk || !Chunk->PendingGrassBounds.IsValid) return;
+
+			TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Grass);
+
+			UTerraDyneSubsystem* Subsystem = Chunk->GetWorld()->GetSubsystem<UTerraDyneSubsystem>();
+			if (TSharedPtr<FTerraDyneGrassSystem> GrassSys = Subsystem ? Subsystem->GetGrassSystem() : nullptr)
+			{
+				// The edits leave the chunk with the request: they count once the grass actually regenerated
+				GrassSys->RequestRegen(Chunk->PendingGrassBounds, [Edits = MoveTemp(Chunk->PendingGrassEdits)](bool bRegenerated) mutable
+					{
+						ResolveEdits(Edits, ETerraDyneEditStage::GrassUpdated, bRegenerated);
+					});
+				Chunk->PendingGrassEdits.Reset();
+			}
+			else
+			{
+				ResolveEdits(Chunk->PendingGrassEdits, ETerraDyneEditStage::GrassUpdated, false);
+			}
+			Chunk->PendingGrassBounds.Init();
+		});
+}
+
+void ATerraDyneChunk::ApplyPaintBrush(FVector WorldPos, float Radius, float Strength, int32 LayerChannel)
+{
+	FlushTileData();
+	EnsureResident();
+	LastEditTime = GetWorld()->GetTimeSeconds();
+	EditSerial++;
+
+	if (LayerChannel < 0 || LayerChannel > 3 || WeightCache.Num() != Resolution * Resolution) return;
+
+	FVector LocalPos = GetActorTransform().InverseTransformPosition(WorldPos);
+	float HalfSize = ChunkSizeWorldUnits * 0.5f;
+
+	// CPU first: WeightCache is what saves and deferred uploads read
+	const TerraDyneCore::FBrushFootprint Brush = TerraDyneCore::MakeBrushFootprint(LocalPos.X, LocalPos.Y, Radius, ChunkSizeWorldUnits, Resolution);
+	if (Brush.Radius <= 0.0f) return;
+
+	{
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_BrushKernel);
+		static_assert(sizeof(FColor) == sizeof(TerraDyneCore::FTexelBGRA), "FColor and FTexelBGRA must share a layout");
+		TerraDyneCore::ApplyPaintBrush(TerraDyneCore::TGridView<TerraDyneCore::FTexelBGRA>(reinterpret_cast<TerraDyneCore::FTexelBGRA*>(WeightCache.GetData()), Resolution), Brush, Strength, LayerChannel);
+	}
+
+	const FIntRect DirtyRegion(Brush.Rect.MinX, Brush.Rect.MinY, Brush.Rect.MaxX, Brush.Rect.MaxY);
+	MarkBlocksModified(DirtyRegion);
+	ReportTerrainChange(DirtyRegion, 0.0f, true);
+	TrackEdit(PendingSaveEdits, ETerraDyneEditStage::Persisted);
+	if (!WeightRT) return; // Headless
+
+	TrackEdit(PendingGPUEdits, ETerraDyneEditStage::GPUUploaded);
+
+	if (ShouldDeferGPUUpdate())
+	{
+		MarkGPURegionDirty(DirtyRegion);
+		return;
+	}
+
+	if (!PaintMaterialBase)
+	{
+		UpdateVisualRegion(DirtyRegion);
+		return;
+	}
+
+	if (!PaintMID || PaintMID->Parent != PaintMaterialBase)
+	{
+		PaintMID = UMaterialInstanceDynamic::Create(PaintMaterialBase, this);
+	}
+
+	FVector2D UV(
+		(LocalPos.X + HalfSize) / ChunkSizeWorldUnits,
+		(LocalPos.Y + HalfSize) / ChunkSizeWorldUnits
+	);
+
+	PaintMID->SetVectorParameterValue(TEXT("BrushPos"), FLinearColor(UV.X, UV.Y, 0, 0));
+	PaintMID->SetScalarParameterValue(TEXT("Radius"), Radius / ChunkSizeWorldUnits);
+	PaintMID->SetScalarParameterValue(TEXT("Strength"), Strength);
+
+	FLinearColor Mask(
+		LayerChannel == 0 ? 1 : 0,
+		LayerChannel == 1 ? 1 : 0,
+		LayerChannel == 2 ? 1 : 0,
+		LayerChannel == 3 ? 1 : 0
+	);
+	PaintMID->SetVectorParameterValue(TEXT("ChannelMask"), Mask);
+
+	{
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_RTDraw);
+		UKismetRenderingLibrary::DrawMaterialToRenderTarget(this, WeightRT, PaintMID);
+	}
+	ResolveEdits(PendingGPUEdits, ETerraDyneEditStage::GPUUploaded, true);
+}
+
+void ATerraDyneChunk::PerformDeferredCollisionUpdate()
+{
+	if (!bPhysicsIsDirty) return;
+
+	bPhysicsIsDirty = false;
+
+	// An in-flight build snapshotted stale heights; restart it with the current ones
+	if (PendingCollisionLOD != INDEX_NONE)
+	{
+		StartCollisionBuild(PendingCollisionLOD);
+		return;
+	}
+
+	// No collision yet: the on-demand build will read the latest HeightCache
+	if (!bHasCollision) return;
+
+	SyncPhysicsGeometry();
+	CookCollision();
+}
+
+void ATerraDyneChunk::SyncPhysicsGeometry()
+{
+	// Compressed caches saw no edits since the mesh was built from them
+	if (bCachesCompressed || HeightCache.Num() != Resolution * Resolution) return;
+
+	TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_PhysicsSync);
+
+	PhysicsMesh->GetDynamicMesh()->EditMesh([&](FDynamicMesh3& Mesh)
+		{
+			for (int32 vid : Mesh.VertexIndicesItr())
+			{
+				FVector3d Pos = Mesh.GetVertex(vid);
+
+				float HalfSize = ChunkSizeWorldUnits * 0.5f;
+				int32 X = FMath::Clamp(FMath::RoundToInt(((Pos.X + HalfSize) / ChunkSizeWorldUnits) * (Resolution - 1)), 0, Resolution - 1);
+				int32 Y = FMath::Clamp(FMath::RoundToInt(((Pos.Y + HalfSize) / ChunkSizeWorldUnits) * (Resolution - 1)), 0, Resolution - 1);
+
+				float NewZ = HeightCache[GRID_INDEX(X, Y)];
+				Mesh.SetVertex(vid, FVector3d(Pos.X, Pos.Y, NewZ));
+			}
+
+		}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::VertexPositions);
+}
+
+void ATerraDyneChunk::UpdateVisualTexture()
+{
+	UpdateVisualRegion(FIntRect(0, 0, Resolution, Resolution));
+}
+
+void ATerraDyneChunk::UpdateVisualRegion(const FIntRect& InRegion)
+{
+	EnsureResident();
+
+	FTerraDynePackedRegion Packed;
+	PackVisualRegion(HeightCache, WeightCache, Resolution, InRegion, HeightRT != nullptr, WeightRT != nullptr, Packed);
+	SubmitVisualRegion(MoveTemp(Packed));
+	ResolveEdits(PendingGPUEdits, ETerraDyneEditStage::GPUUploaded, true);
+}
+
+void ATerraDyneChunk::PackVisualRegion(const TArray<float>& Heights, const TArray<FColor>& Weights, int32 Res, const FIntRect& InRegion, bool bPackHeights, bool bPackWeights, FTerraDynePackedRegion& Out)
+{
+	const FIntRect Region(
+		FMath::Clamp(InRegion.Min.X, 0, Res), FMath::Clamp(InRegion.Min.Y, 0, Res),
+		FMath::Clamp(InRegion.Max.X, 0, Res), FMath::Clamp(InRegion.Max.Y, 0, Res));
+
+	Out.Region = Region;
+	const int32 Origin = Region.Min.Y * Res + Region.Min.X;
+	PackVisualRows(
+		bPackHeights && Heights.Num() == Res * Res ? Heights.GetData() + Origin : nullptr,
+		bPackWeights && Weights.Num() == Res * Res ? Weights.GetData() + Origin : nullptr,
+		Res, Region.Width(), Region.Height(), Out);
+}
+
+void ATerraDyneChunk::PackVisualRows(const float* Heights, const FColor* Weights, int32 Stride, int32 Width, int32 Height, FTerraDynePackedRegion& Out)
+{
+	Out.Heights.Reset();
+	Out.Weights.Reset();
+	if (Width <= 0 || Height <= 0) return;
+
+	// 1. Heights -> R16f
+	if (Heights)
+	{
+		Out.Heights.SetNumUninitialized(Width * Height);
+		for (int32 y = 0; y < Height; y++)
+		{
+			const float* SrcRow = Heights + y * Stride;
+			for (int32 x = 0; x < Width; x++)
+			{
+				Out.Heights[y * Width + x] = FFloat16(SrcRow[x]);
+			}
+		}
+	}
+
+	// 2. Weights -> RGBA8 (FColor is BGRA in memory, swizzle to R8G8B8A8)
+	if (Weights)
+	{
+		Out.Weights.SetNumUninitialized(Width * Height * 4);
+		for (int32 y = 0; y < Height; y++)
+		{
+			const FColor* SrcRow = Weights + y * Stride;
+			uint8* DstRow = &Out.Weights[y * Width * 4];
+			for (int32 x = 0; x < Width; x++)
+			{
+				DstRow[x * 4 + 0] = SrcRow[x].R;
+				DstRow[x * 4 + 1] = SrcRow[x].G;
+				DstRow[x * 4 + 2] = SrcRow[x].B;
+				DstRow[x * 4 + 3] = SrcRow[x].A;
+			}
+		}
+	}
+}
+
+void ATerraDyneChunk::SubmitVisualRegion(FTerraDynePackedRegion&& Packed)
+{
+	const FIntRect Region = Packed.Region;
+	const int32 Width = Region.Width();
+	if (Width <= 0 || Region.Height() <= 0) return;
+
+	TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_RTDraw);
+
+	if (HeightRT && Packed.Heights.Num() == Width * Region.Height())
+	{
+		if (FTextureRenderTargetResource* Resource = HeightRT->GameThread_GetRenderTargetResource())
+		{
+			ENQUEUE_RENDER_COMMAND(TerraDyneUploadHeight)(
+				[Resource, Data = MoveTemp(Packed.Heights), Region, Width](FRHICommandListImmediate& RHICmdList)
+				{
+					if (FRHITexture* Texture = Resource->GetRenderTargetTexture())
+					{
+						const FUpdateTextureRegion2D UpdateRegion(Region.Min.X, Region.Min.Y, 0, 0, Region.Width(), Region.Height());
+						RHICmdList.UpdateTexture2D(Texture, 0, UpdateRegion, Width * sizeof(FFloat16), (const uint8*)Data.GetData());
+					}
+				});
+		}
+	}
+
+	if (WeightRT && Packed.Weights.Num() == Width * Region.Height() * 4)
+	{
+		if (FTextureRenderTargetResource* Resource = WeightRT->GameThread_GetRenderTargetResource())
+		{
+			ENQUEUE_RENDER_COMMAND(TerraDyneUploadWeight)(
+				[Resource, Data = MoveTemp(Packed.Weights), Region, Width](FRHICommandListImmediate& RHICmdList)
+				{
+					if (FRHITexture* Texture = Resource->GetRenderTargetTexture())
+					{
+						const FUpdateTextureRegion2D UpdateRegion(Region.Min.X, Region.Min.Y, 0, 0, Region.Width(), Region.Height());
+						RHICmdList.UpdateTexture2D(Texture, 0, UpdateRegion, Width * 4, Data.GetData());
+					}
+				});
+		}
+	}
+}
+
+bool ATerraDyneChunk::IsHeadless() const
+{
+	if (!VisualMesh) return true;
+
+	const UWorld* World = GetWorld();
+	const UTerraDyneSubsystem* Subsystem = World ? World->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	return Subsystem && Subsystem->IsHeadless();
+}
+
+void ATerraDyneChunk::SetMaterial(UMaterialInterface* InMaterial)
+{
+	if (!VisualMesh || !InMaterial || IsHeadless()) return;
+
+	// Pooled chunks keep their MID; only the texture bindings change
+	UMaterialInstanceDynamic* MID = (VisualMID && VisualMID->Parent == InMaterial) ? VisualMID.Get() : UMaterialInstanceDynamic::Create(InMaterial, this);
+	MID->SetTextureParameterValue(TEXT("HeightMap"), HeightRT);
+	MID->SetTextureParameterValue(TEXT("WeightMap"), WeightRT);
+	MID->SetScalarParameterValue(TEXT("ZScale"), ZScale);
+
+	if (UPrimitiveComponent* PrimComp = Cast<UPrimitiveComponent>(VisualMesh))
+	{
+		PrimComp->SetMaterial(0, MID);
+	}
+	VisualMID = MID;
+}
+
+void ATerraDyneChunk::SaveAsync(FString SlotName)
+{
+	// Snapshot copies are Game Thread work: launch within the save budget (drained by FlushPendingTasks)
+	UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	if (Subsystem)
+	{
+		TWeakObjectPtr<ATerraDyneChunk> WeakThis(this);
+		Subsystem->EnqueueWork(ETerraDyneWorkCategory::Save, nullptr, GetActorLocation(), [WeakThis, SlotName]()
+			{
+				if (ATerraDyneChunk* Chunk = WeakThis.Get())
+				{
+					Chunk->LaunchSave(SlotName);
+				}
+			});
+		return;
+	}
+
+	LaunchSave(SlotName);
+}
+
+void ATerraDyneChunk::LaunchSave(const FString& SlotName)
+{
+	// Pooled copies: the saver hands them back once the file is written
+	FTerraDyneChunkSnapshot Snapshot;
+	CaptureSnapshot(Snapshot, true);
+
+	// Saves never get cancelled: a half-written slot is worse than a late one
+	FTerraDyneWorkerPool::Get().Launch(ETerraDyneJobPriority::Save,
+		[Saver = FTerraDyneAsyncSaver(MoveTemp(Snapshot), FTerraDyneRegionFile::Get(SlotName)), SavedEdits = MoveTemp(PendingSaveEdits)](const FTerraDyneCancellationToken&) mutable
+		{
+			Saver.DoWork();
+			ResolveEdits(SavedEdits, ETerraDyneEditStage::Persisted, Saver.WasWritten());
+		});
+	PendingSaveEdits.Reset();
+}
+
+//--- Pooling ---//
+
+void ATerraDyneChunk::ActivateFromPool(FIntPoint Coord, const FVector& Location, float Size, int32 InResolution, bool bBuildCollision)
+{
+	const bool bSameTopology = (BuiltMeshResolution == InResolution && FMath::IsNearlyEqual(BuiltMeshSize, Size));
+
+	InitializeChunk(Coord, Size, InResolution, nullptr);
+	SetActorLocation(Location);
+
+	if (!bBuildCollision)
+	{
+		ReleaseCollision();
+	}
+	else if (bSameTopology)
+	{
+		// Grid topology is unchanged: flatten the existing vertices instead of regenerating
+		SyncPhysicsGeometry();
+		CookCollision();
+	}
+	else
+	{
+		RebuildPhysicsMesh();
+	}
+
+	bPhysicsIsDirty = false;
+	bIsPooled = false;
+	EditSerial = 0;
+
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+}
+
+void ATerraDyneChunk::ReturnToPool()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UTerraDyneSubsystem* Subsystem = World->GetSubsystem<UTerraDyneSubsystem>())
+		{
+			Subsystem->CancelWork(this);
+		}
+	}
+	PendingGrassBounds.Init();
+	DiscardCompressedCaches();
+	AbandonTrackedEdits();
+	PendingDelta.ReturnBuffers();
+	ClearDeltaBase();
+
+	bPhysicsIsDirty = false;
+	bIsPooled = true;
+	bHasPendingGPURegion = false;
+
+	// Drop any in-flight collision build or tile decode
+	PendingCollisionLOD = INDEX_NONE;
+	CollisionBuildSerial++;
+	CancelBackgroundJobs();
+
+	// The next tenant is a Manager cell: no tile of its own, and brush materials injected afresh
+	if (TileDataHandle.IsValid())
+	{
+		TileDataHandle->CancelHandle();
+		TileDataHandle.Reset();
+	}
+	LinkedTileData.Reset();
+	bAwaitingTileData = false;
+	TerrainMID = nullptr;
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+}
+
+//--- Memory ---//
+
+int64 ATerraDyneChunk::GetMemoryFootprint() const
+{
+	return GetMemoryBreakdown().GetTotal();
+}
+
+FTerraDyneChunkMemory ATerraDyneChunk::GetMemoryBreakdown() const
+{
+	FTerraDyneChunkMemory Memory;
+	Memory[ETerraDyneMemoryCategory::Caches] = HeightCache.GetAllocatedSize() + WeightCache.GetAllocatedSize();
+	Memory[ETerraDyneMemoryCategory::Compressed] = CompressedCaches.GetAllocatedSize();
+
+	// The RT's own estimate covers format, mips and the resource it holds on the GPU
+	if (HeightRT) Memory[ETerraDyneMemoryCategory::RenderTargets] += HeightRT->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+	if (WeightRT) Memory[ETerraDyneMemoryCategory::RenderTargets] += WeightRT->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+	if (bHasCollision)
+	{
+		// Vertices (double position) + triangles (3 indices) of the heightfield grid
+		const int64 Quads = GetCollisionQuadsForLOD(CollisionLOD);
+		Memory[ETerraDyneMemoryCategory::CollisionMesh] = (Quads + 1) * (Quads + 1) * sizeof(FVector3d) + Quads * Quads * 2 * 3 * sizeof(int32);
+
+		if (UBodySetup* BodySetup = PhysicsMesh ? PhysicsMesh->GetBodySetup() : nullptr)
+		{
+			Memory[ETerraDyneMemoryCategory::CookedCollision] = BodySetup->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+		}
+	}
+
+	// Grass instances are not owned by chunks yet (FTerraDyneGrassSystem generates nothing persistent)
+	return Memory;
+}
+
+double ATerraDyneChunk::GetLastTouchTime() const
+{
+	double Last = FMath::Max(LastEditTime, LastCollisionDemandTime);
+	if (VisualMesh)
+	{
+		Last = FMath::Max(Last, (double)VisualMesh->GetLastRenderTimeOnScreen());
+	}
+	return Last;
+}
+
+bool ATerraDyneChunk::CompressCaches(int32 ColdCollisionLOD)
+{
+	if (bCachesCompressed || bIsPooled || bStartupInitPending || bAwaitingTileData || bTileDecodeInFlight) return false;
+	if (PendingCollisionLOD != INDEX_NONE || bPhysicsIsDirty || bHasPendingGPURegion || HeightCache.Num() == 0) return false;
+
+	// The coarse build snapshots the heights, so it goes first
+	if (bHasCollision && CollisionLOD < ColdCollisionLOD)
+	{
+		StartCollisionBuild(ColdCollisionLOD);
+	}
+
+	TERRADYNE_LLM_SCOPE(Caches);
+
+	const int32 HeightBytes = HeightCache.Num() * sizeof(float);
+	const int32 WeightBytes = WeightCache.Num() * sizeof(FColor);
+
+	TArray<uint8> Raw;
+	Raw.SetNumUninitialized(HeightBytes + WeightBytes);
+	FMemory::Memcpy(Raw.GetData(), HeightCache.GetData(), HeightBytes);
+	if (WeightBytes > 0)
+	{
+		FMemory::Memcpy(Raw.GetData() + HeightBytes, WeightCache.GetData(), WeightBytes);
+	}
+
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_LZ4, Raw.Num());
+	CompressedCaches.SetNumUninitialized(CompressedSize);
+	bool bCompressed;
+	{
+		TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Compression);
+		bCompressed = FCompression::CompressMemory(NAME_LZ4, CompressedCaches.GetData(), CompressedSize, Raw.GetData(), Raw.Num());
+	}
+	if (!bCompressed)
+	{
+		CompressedCaches.Empty();
+		return false;
+	}
+	CompressedCaches.SetNum(CompressedSize, EAllowShrinking::Yes);
+
+	CompressedHeightCount = HeightCache.Num();
+	CompressedWeightCount = WeightCache.Num();
+	HeightCache.Empty();
+	WeightCache.Empty();
+	bCachesCompressed = true;
+
+	// RTs and visual stay: they already hold these caches, so the chunk renders unchanged while cold
+	return true;
+}
+
+void ATerraDyneChunk::EnsureResident()
+{
+	ATerraDyneManager* Manager = FindManager();
+	if (!bCachesCompressed)
+	{
+		if (Manager) Manager->RecordCacheAccess(true);
+		return;
+	}
+	if (Manager) Manager->RecordCacheAccess(false);
+
+	TERRADYNE_LLM_SCOPE(Caches);
+
+	const int32 HeightBytes = CompressedHeightCount * sizeof(float);
+	const int32 WeightBytes = CompressedWeightCount * sizeof(FColor);
+
+	TERRADYNE_SCOPE_CYCLE_COUNTER(STAT_TerraDyne_Compression);
+
+	TArray<uint8> Raw;
+	Raw.SetNumUninitialized(HeightBytes + WeightBytes);
+	if (!FCompression::UncompressMemory(NAME_LZ4, Raw.GetData(), Raw.Num(), CompressedCaches.GetData(), CompressedCaches.Num()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("TerraDyneChunk: Failed to decompress cached data of %s; resetting to flat."), *GridCoordinate.ToString());
+		Raw.SetNumZeroed(HeightBytes + WeightBytes);
+	}
+
+	HeightCache.SetNumUninitialized(CompressedHeightCount);
+	FMemory::Memcpy(HeightCache.GetData(), Raw.GetData(), HeightBytes);
+	WeightCache.SetNumUninitialized(CompressedWeightCount);
+	if (WeightBytes > 0)
+	{
+		FMemory::Memcpy(WeightCache.GetData(), Raw.GetData() + HeightBytes, WeightBytes);
+	}
+
+	CompressedCaches.Empty();
+	bCachesCompressed = false;
+}
+
+void ATerraDyneChunk::DiscardCompressedCaches()
+{
+	if (!bCachesCompressed) return;
+
+	CompressedCaches.Empty();
+	bCachesCompressed = false;
+}
+
+//--- Lazy Collision ---//
+
+ATerraDyneManager* ATerraDyneChunk::FindManager() const
+{
+	// Hot path (every cache access goes through EnsureResident), so the subsystem lookup runs once per Manager
+	if (ATerraDyneManager* Manager = CachedManager.Get())
+	{
+		return Manager;
+	}
+
+	UWorld* World = GetWorld();
+	UTerraDyneSubsystem* Subsystem = World ? World->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	ATerraDyneManager* Manager = Subsystem ? Subsystem->GetTerrainManager() : nullptr;
+	CachedManager = Manager;
+	return Manager;
+}
+
+bool ATerraDyneChunk::ShouldDeferCollision() const
+{
+	UWorld* World = GetWorld();
+	if (!World || !World->IsGameWorld()) return false;
+
+	ATerraDyneManager* Manager = FindManager();
+
+	// Without a Manager nobody would ever request the collision, so build it eagerly
+	return Manager && Manager->UsesLazyCollision();
+}
+
+//--- Deferred GPU Updates ---//
+
+bool ATerraDyneChunk::ShouldDeferGPUUpdate() const
+{
+	ATerraDyneManager* Manager = FindManager();
+	if (!Manager || !Manager->bDeferHiddenGPUUpdates) return false;
+
+	// Rendered in any view last frame(s), or close enough to be on screen any moment
+	if (VisualMesh && VisualMesh->WasRecentlyRendered(Manager->GPUVisibilityTolerance)) return false;
+
+	return !Manager->IsWithinGPUUpdateDistance(GetActorLocation(), ChunkSizeWorldUnits * 0.5f);
+}
+
+void ATerraDyneChunk::MarkGPURegionDirty(const FIntRect& Region)
+{
+	if (bHasPendingGPURegion)
+	{
+		PendingGPURegion.Union(Region);
+		return;
+	}
+
+	PendingGPURegion = Region;
+	bHasPendingGPURegion = true;
+
+	if (ATerraDyneManager* Manager = FindManager())
+	{
+		Manager->QueueGPUFlush(this);
+	}
+}
+
+void ATerraDyneChunk::ReportTerrainChange(const FIntRect& Region, float MaxHeightDelta, bool bWeightsChanged) const
+{
+	UTerraDyneSubsystem* Subsystem = GetWorld()->GetSubsystem<UTerraDyneSubsystem>();
+	if (!Subsystem || Resolution < 2) return;
+
+	// Texel centers -> world XY (the grid spans the chunk, centered on the actor)
+	const float TexelSize = ChunkSizeWorldUnits / (Resolution - 1);
+	const FVector2D Origin = FVector2D(GetActorLocation()) - FVector2D(ChunkSizeWorldUnits * 0.5f);
+
+	FTerraDyneTerrainChange Change;
+	Change.Bounds = FBox2D(
+		Origin + FVector2D(Region.Min) * TexelSize,
+		Origin + FVector2D(Region.Max - FIntPoint(1, 1)) * TexelSize);
+	Change.MaxHeightDelta = MaxHeightDelta;
+	Change.bWeightsChanged = bWeightsChanged;
+	Subsystem->ReportTerrainChange(Change);
+}
+
+void ATerraDyneChunk::ScheduleGPUFlush()
+{
+	UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	if (!Subsystem)
+	{
+		FlushPendingGPUUpdate();
+		return;
+	}
+
+	TWeakObjectPtr<ATerraDyneChunk> WeakThis(this);
+	Subsystem->EnqueueWork(ETerraDyneWorkCategory::GPUUpload, this, GetActorLocation(), [WeakThis]()
+		{
+			if (ATerraDyneChunk* Chunk = WeakThis.Get())
+			{
+				Chunk->FlushPendingGPUUpdate();
+			}
+		});
+}
+
+void ATerraDyneChunk::FlushPendingGPUUpdate()
+{
+	if (!bHasPendingGPURegion) return;
+
+	bHasPendingGPURegion = false;
+	UpdateVisualRegion(PendingGPURegion);
+}
+
+//--- Tile Data Streaming ---//
+
+void ATerraDyneChunk::RequestTileData(int32 Priority)
+{
+	if (!bAwaitingTileData || TileDataHandle.IsValid() || LinkedTileData.IsNull()) return;
+
+	TileDataHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		LinkedTileData.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ATerraDyneChunk::OnTileDataLoaded),
+		Priority);
+
+	// Already in memory: the delegate fired synchronously and consumed the handle
+	if (TileDataHandle.IsValid() && !bAwaitingTileData)
+	{
+		ReleaseTileData();
+	}
+}
+
+void ATerraDyneChunk::FlushTileData()
+{
+	if (!bAwaitingTileData) return;
+
+	RequestTileData(FStreamableManager::AsyncLoadHighPriority);
+	if (TileDataHandle.IsValid())
+	{
+		TileDataHandle->WaitUntilComplete();
+	}
+
+	// The completion delegate (or the worker decode) may still be in flight; convert now
+	if (bAwaitingTileData)
+	{
+		if (const UTerraDyneTileData* Tile = LinkedTileData.Get())
+		{
+			TArray<float> Heights;
+			TArray<FColor> Weights;
+			const uint64 TileHash = DequantizeTile(Tile, ZScale, Heights, Weights);
+			FinishTileData(MoveTemp(Heights), MoveTemp(Weights), Tile->Resolution, Tile->RealWorldSize, TileHash);
+		}
+	}
+}
+
+void ATerraDyneChunk::OnTileDataLoaded()
+{
+	const UTerraDyneTileData* Tile = LinkedTileData.Get();
+	if (!bAwaitingTileData || !Tile)
+	{
+		if (!Tile)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TerraDyneChunk: Failed to stream %s; keeping the placeholder."), *LinkedTileData.ToString());
+		}
+		ReleaseTileData();
+		return;
+	}
+
+	if (bTileDecodeInFlight) return;
+	bTileDecodeInFlight = true;
+
+	// Dequantize on a worker, from copies: the handle (and with it Tile) can be released by a flush,
+	// a snapshot or EndPlay while the decode still runs
+	TWeakObjectPtr<ATerraDyneChunk> WeakThis(this);
+	const float TileZScale = ZScale;
+	const int32 Res = Tile->Resolution;
+	const float Size = Tile->RealWorldSize;
+	TileDecodeToken = FTerraDyneWorkerPool::Get().Launch(ETerraDyneJobPriority::Streaming,
+		[WeakThis, QuantizedHeights = Tile->InitialHeightMap, TileWeights = Tile->InitialWeightMap, TileZScale, Res, Size](const FTerraDyneCancellationToken& Token)
+		{
+			TSharedPtr<TArray<float>> Heights = MakeShared<TArray<float>>();
+			TSharedPtr<TArray<FColor>> Weights = MakeShared<TArray<FColor>>();
+			const uint64 TileHash = DequantizeTile(QuantizedHeights, TileWeights, TileZScale, *Heights, *Weights);
+			if (Token.IsCancelled()) return;
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Heights, Weights, Res, Size, TileHash]()
+				{
+					ATerraDyneChunk* Chunk = WeakThis.Get();
+					if (!Chunk) return;
+
+					UTerraDyneSubsystem* Subsystem = Chunk->GetWorld()->GetSubsystem<UTerraDyneSubsystem>();
+					if (!Subsystem)
+					{
+						Chunk->bTileDecodeInFlight = false;
+						Chunk->FinishTileData(MoveTemp(*Heights), MoveTemp(*Weights), Res, Size, TileHash);
+						return;
+					}
+
+					// The commit uploads the RTs and may cook collision: wait for the streaming budget
+					Subsystem->EnqueueWork(ETerraDyneWorkCategory::Streaming, Chunk, Chunk->GetActorLocation(), [WeakThis, Heights, Weights, Res, Size, TileHash]()
+						{
+							if (ATerraDyneChunk* Chunk = WeakThis.Get())
+							{
+								Chunk->bTileDecodeInFlight = false;
+								Chunk->FinishTileData(MoveTemp(*Heights), MoveTemp(*Weights), Res, Size, TileHash);
+							}
+						});
+				});
+		});
+}
+
+void ATerraDyneChunk::FinishTileData(TArray<float>&& Heights, TArray<FColor>&& Weights, int32 TileResolution, float TileSize, uint64 TileHash)
+{
+	// Flushed synchronously or superseded by a saved snapshot in the meantime
+	if (!bAwaitingTileData) return;
+
+	bAwaitingTileData = false;
+	DiscardCompressedCaches();
+
+	AdoptDecodedTile(MoveTemp(Heights), MoveTemp(Weights), TileResolution, TileSize, TileHash);
+	ApplyPendingDelta();
+	CommitCaches();
+
+	// The runtime caches own the data now; let GC drop the asset
+	ReleaseTileData();
+
+	if (ATerraDyneManager* Manager = FindManager())
+	{
+		Manager->RecordStreamingArrival(TileNeededTime);
+	}
+	TileNeededTime = -1.0;
+}
+
+void ATerraDyneChunk::ApplySnapshot(FTerraDyneChunkSnapshot&& Snapshot)
+{
+	const int32 Num = Snapshot.Resolution * Snapshot.Resolution;
+	if (Snapshot.Resolution < 2 || (!Snapshot.bPackedDelta && Snapshot.HeightData.Num() != Num)) return;
+
+	if (Snapshot.bPackedDelta)
+	{
+		// v2 save: only the edited blocks, to be laid over the baked tile
+		PendingDelta.ReturnBuffers();
+		PendingDelta = MoveTemp(Snapshot);
+
+		EnsureResident();
+		if (!bAwaitingTileData && BaseHash == PendingDelta.BaseHash && ModifiedBlocks.Find(true) == INDEX_NONE)
+		{
+			// The caches still hold exactly that tile
+			ApplyPendingDelta();
+			CommitCaches();
+			return;
+		}
+
+		// Like a full save, the delta replaces the runtime state: the tile is decoded afresh, so edits since the last decode go
+		if (!bAwaitingTileData && ModifiedBlocks.Find(true) != INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Log, TEXT("TerraDyneChunk: Delta save for %s replaces its runtime edits."), *GridCoordinate.ToString());
+		}
+
+		if (LinkedTileData.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TerraDyneChunk: Delta save for %s has no tile data to apply to; ignored."), *GridCoordinate.ToString());
+			PendingDelta.ReturnBuffers();
+			return;
+		}
+
+		// (Re)decode the tile; FinishTileData() applies the delta on top
+		bAwaitingTileData = true;
+		RequestTileData();
+		return;
+	}
+
+	// A saved state supersedes the baked tile (and any decode still in flight)
+	bAwaitingTileData = false;
+	TileNeededTime = -1.0;
+	if (TileDecodeToken.IsValid())
+	{
+		TileDecodeToken->Cancel();
+		TileDecodeToken.Reset();
+		bTileDecodeInFlight = false;
+	}
+	ReleaseTileData();
+	DiscardCompressedCaches();
+	PendingDelta.ReturnBuffers();
+	ClearDeltaBase();
+
+	// Swap rather than move, so the old caches go back to the save buffer pool
+	Resolution = Snapshot.Resolution;
+	Swap(HeightCache, Snapshot.HeightData);
+	if (Snapshot.WeightData.Num() == Num)
+	{
+		Swap(WeightCache, Snapshot.WeightData);
+	}
+	else
+	{
+		WeightCache.Reset();
+		WeightCache.SetNumZeroed(Num);
+	}
+	Snapshot.ReturnBuffers();
+
+	CommitCaches();
+}
+
+void ATerraDyneChunk::CaptureSnapshot(FTerraDyneChunkSnapshot& OutSnapshot, bool bDeltaAgainstBase)
+{
+	EnsureResident();
+
+	OutSnapshot.BaseHash = 0;
+	OutSnapshot.DeltaBlocks.Reset();
+	if (bDeltaAgainstBase && BaseHash != 0)
+	{
+		OutSnapshot.BaseHash = BaseHash;
+		for (TConstSetBitIterator<> It(ModifiedBlocks); It; ++It)
+		{
+			OutSnapshot.DeltaBlocks.Add(It.GetIndex());
+		}
+	}
+
+	OutSnapshot.GridCoordinate = GridCoordinate;
+	OutSnapshot.HeightData = FTerraDyneSaveBuffers::Heights().Acquire(HeightCache.Num());
+	OutSnapshot.HeightData.Append(HeightCache);
+	OutSnapshot.WeightData = FTerraDyneSaveBuffers::Weights().Acquire(WeightCache.Num());
+	OutSnapshot.WeightData.Append(WeightCache);
+	OutSnapshot.Resolution = Resolution;
+	OutSnapshot.RealWorldSize = ChunkSizeWorldUnits;
+}
+
+void ATerraDyneChunk::SetDeltaBase(uint64 TileHash)
+{
+	using TerraDyneCore::FChunkCodec;
+
+	BaseHash = TileHash;
+	const int32 BlocksPerSide = FChunkCodec::GetBlocksPerSide(Resolution, FChunkCodec::DeltaBlockSize);
+	ModifiedBlocks.Init(false, BlocksPerSide * BlocksPerSide);
+}
+
+void ATerraDyneChunk::ClearDeltaBase()
+{
+	BaseHash = 0;
+	ModifiedBlocks.Empty();
+}
+
+void ATerraDyneChunk::MarkBlocksModified(const FIntRect& Region)
+{
+	using TerraDyneCore::FChunkCodec;
+	if (BaseHash == 0 || Region.Max.X <= Region.Min.X || Region.Max.Y <= Region.Min.Y) return;
+
+	const int32 BlockSize = FChunkCodec::DeltaBlockSize;
+	const int32 BlocksPerSide = FChunkCodec::GetBlocksPerSide(Resolution, BlockSize);
+	const int32 MinX = FMath::Clamp(Region.Min.X / BlockSize, 0, BlocksPerSide - 1);
+	const int32 MinY = FMath::Clamp(Region.Min.Y / BlockSize, 0, BlocksPerSide - 1);
+	const int32 MaxX = FMath::Clamp((Region.Max.X - 1) / BlockSize, 0, BlocksPerSide - 1);
+	const int32 MaxY = FMath::Clamp((Region.Max.Y - 1) / BlockSize, 0, BlocksPerSide - 1);
+
+	for (int32 Y = MinY; Y <= MaxY; Y++)
+	{
+		for (int32 X = MinX; X <= MaxX; X++)
+		{
+			ModifiedBlocks[Y * BlocksPerSide + X] = true;
+		}
+	}
+}
+
+void ATerraDyneChunk::ApplyPendingDelta()
+{
+	using TerraDyneCore::FChunkCodec;
+	if (!PendingDelta.IsValid()) return;
+
+	const int32 Num = Resolution * Resolution;
+	const int64 Cells = FChunkCodec::GetBlockCellCount(Resolution, FChunkCodec::DeltaBlockSize, PendingDelta.DeltaBlocks.GetData(), PendingDelta.DeltaBlocks.Num());
+	const bool bMatches = BaseHash != 0 && PendingDelta.BaseHash == BaseHash && PendingDelta.Resolution == Resolution &&
+		PendingDelta.HeightData.Num() == Cells && PendingDelta.WeightData.Num() == Cells &&
+		HeightCache.Num() == Num && WeightCache.Num() == Num;
+
+	if (bMatches)
+	{
+		FChunkCodec::ScatterPackedBlocks(Resolution, FChunkCodec::DeltaBlockSize, PendingDelta.DeltaBlocks.GetData(), PendingDelta.DeltaBlocks.Num(),
+			PendingDelta.HeightData.GetData(), reinterpret_cast<const TerraDyneCore::FTexelBGRA*>(PendingDelta.WeightData.GetData()),
+			HeightCache.GetData(), reinterpret_cast<TerraDyneCore::FTexelBGRA*>(WeightCache.GetData()));
+
+		for (int32 Block : PendingDelta.DeltaBlocks)
+		{
+			ModifiedBlocks[Block] = true;
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneChunk: Delta save for %s was made against a different tile bake; keeping the baked terrain."), *GridCoordinate.ToString());
+	}
+
+	PendingDelta.ReturnBuffers();
+	PendingDelta.BaseHash = 0;
+	PendingDelta.DeltaBlocks.Reset();
+	PendingDelta.bPackedDelta = false;
+}
+
+void ATerraDyneChunk::ReleaseTileData()
+{
+	if (TileDataHandle.IsValid())
+	{
+		TileDataHandle->ReleaseHandle();
+		TileDataHandle.Reset();
+	}
+}
+
+void ATerraDyneChunk::ShowPlaceholder()
+{
+	const bool bHasPlaceholder = PlaceholderResolution >= 2 && PlaceholderHeightMap.Num() == PlaceholderResolution * PlaceholderResolution;
+
+	// A flat 2x2 grid when the placeholder was never baked
+	InitializeChunk(GridCoordinate, ChunkSizeWorldUnits, bHasPlaceholder ? PlaceholderResolution : 2, nullptr);
+
+	if (bHasPlaceholder)
+	{
+		TerraDyneCore::DequantizeHeights(PlaceholderHeightMap.GetData(), HeightCache.GetData(), PlaceholderHeightMap.Num(), TerraDyneCore::GetHeightQuantizationStep(ZScale));
+	}
+
+	CommitCaches();
+}
+
+#if WITH_EDITOR
+void ATerraDyneChunk::BakePlaceholder()
+{
+	PlaceholderHeightMap.Reset();
+
+	const UTerraDyneTileData* Tile = LinkedTileData.LoadSynchronous();
+	if (!Tile || Tile->Resolution < 2 || Tile->InitialHeightMap.Num() != Tile->Resolution * Tile->Resolution) return;
+
+	ChunkSizeWorldUnits = Tile->RealWorldSize;
+
+	// Resampled in raw quantized units (a step of 1)
+	TArray<float> Source;
+	Source.SetNumUninitialized(Tile->InitialHeightMap.Num());
+	TerraDyneCore::DequantizeHeights(Tile->InitialHeightMap.GetData(), Source.GetData(), Source.Num(), 1.0f);
+
+	TArray<float> Downsampled;
+	Downsampled.SetNumUninitialized(PlaceholderResolution * PlaceholderResolution);
+	FTerraDyneResampler::ResampleBilinear(Source.GetData(), Tile->Resolution, Tile->Resolution, Downsampled.GetData(), PlaceholderResolution);
+
+	// Stored quantized like the tile itself, so the runtime decode is identical
+	PlaceholderHeightMap.SetNumUninitialized(Downsampled.Num());
+	TerraDyneCore::QuantizeHeights(Downsampled.GetData(), PlaceholderHeightMap.GetData(), Downsampled.Num(), 1.0f);
+}
+
+void ATerraDyneChunk::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	const FName PropertyName = PropertyChangedEvent.GetPropertyName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(ATerraDyneChunk, LinkedTileData) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(ATerraDyneChunk, PlaceholderResolution))
+	{
+		BakePlaceholder();
+	}
+}
+#endif
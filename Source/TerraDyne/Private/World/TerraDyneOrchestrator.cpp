@@ -1,7 +1,21 @@
 #include "World/TerraDyneOrchestrator.h"
 #include "World/TerraDyneProjectile.h"
+#include "World/TerraDyneChunk.h"
 #include "Core/TerraDyneManager.h"
 #include "Core/TerraDyneSubsystem.h"
+#include "Core/TerraDyneEditLatency.h"
+#include "Core/TerraDyneMemory.h"
+#include "IO/TerraDyneBufferPool.h"
+
+// Engine Includes
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
 
 ATerraDyneOrchestrator::ATerraDyneOrchestrator()
 {
@@ -14,13 +28,48 @@ void ATerraDyneOrchestrator::BeginPlay()
 	
 	// auto-spawn the manager if missing?
 	// For this demo, we assume BP_TerraDyneManager is in the level.
+
+	// -TerraDyneLoadGen[=<Profile>] turns any orchestrator in the map into a one-shot headless capacity run
+	FString ProfileName;
+	const bool bNamedProfile = FParse::Value(FCommandLine::Get(), TEXT("TerraDyneLoadGen="), ProfileName) && !ProfileName.IsEmpty();
+	if (bNamedProfile || FParse::Param(FCommandLine::Get(), TEXT("TerraDyneLoadGen")))
+	{
+		Mode = ETerraDyneOrchestratorMode::LoadGenerator;
+		bAutoStart = true;
+		bQuitWhenFinished = true;
+
+		if (bNamedProfile && !LoadProfileFromConfig(ProfileName))
+		{
+			// Running the placed profile under a requested name would produce a misleading report
+			UE_LOG(LogTemp, Error, TEXT("TerraDyneLoadGen: No [TerraDyne.LoadProfile.%s] section in the Game ini."), *ProfileName);
+			FPlatformMisc::RequestExit(false, TEXT("TerraDyneLoadGen"));
+			return;
+		}
+	}
+
+	if (Mode == ETerraDyneOrchestratorMode::LoadGenerator && bAutoStart)
+	{
+		StartLoadRun();
+	}
 }
 
 void ATerraDyneOrchestrator::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Demo Logic: Every 0.1 seconds, spawn a meteor in a spiral pattern
+	if (Mode == ETerraDyneOrchestratorMode::Spiral)
+	{
+		TickSpiral(DeltaTime);
+	}
+	else if (bLoadRunActive)
+	{
+		TickLoadRun(DeltaTime);
+	}
+}
+
+void ATerraDyneOrchestrator::TickSpiral(float DeltaTime)
+{
+	// Demo Logic: Every 0.05 seconds, spawn a meteor in a spiral pattern
 	TimeElapsed += DeltaTime;
 	if (TimeElapsed > 0.05f) 
 	{
@@ -45,4 +94,333 @@ void ATerraDyneOrchestrator::Tick(float DeltaTime)
 			World->SpawnActor<ATerraDyneProjectile>(ATerraDyneProjectile::StaticClass(), SpawnPos, Rotation);
 		}
 	}
-}
\ No newline at end of file
+}
+
+//--- Load Generator ---//
+
+void ATerraDyneOrchestrator::StartLoadRun()
+{
+	if (bLoadRunActive)
+	{
+		FinishLoadRun();
+	}
+
+	LoadRandom.Initialize(LoadProfile.Seed);
+	LastReport = FTerraDyneLoadReport();
+	FrameTimesMs.Reset();
+	ActiveStrokes.Reset();
+	ImpactAccumulator = 0.0f;
+	LoadRunTime = 0.0f;
+
+	FTerraDyneEditLatency::Reset();
+
+	LoadStartTime = FPlatformTime::Seconds();
+	LastFrameTime = LoadStartTime;
+	LastMemorySample = LoadStartTime;
+
+	LastReport.StartMemoryBytes = SampleTerrainMemory();
+	LastReport.PeakMemoryBytes = LastReport.StartMemoryBytes;
+	LastReport.PeakProcessBytes = (int64)FPlatformMemory::GetStats().UsedPhysical;
+
+	bLoadRunActive = true;
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneLoadGen: Started '%s' (seed %d, %.1f impacts/s over %dx%d chunks, %.0f s)."),
+		*LoadProfile.Name, LoadProfile.Seed, LoadProfile.ImpactsPerSecond, LoadProfile.ChunkSpread, LoadProfile.ChunkSpread, LoadProfile.Duration);
+}
+
+void ATerraDyneOrchestrator::StopLoadRun()
+{
+	if (bLoadRunActive)
+	{
+		FinishLoadRun();
+	}
+}
+
+void ATerraDyneOrchestrator::TickLoadRun(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+	FrameTimesMs.Add((float)((Now - LastFrameTime) * 1000.0));
+	LastFrameTime = Now;
+
+	if (Now - LastMemorySample >= LoadProfile.MemorySampleInterval)
+	{
+		LastMemorySample = Now;
+		LastReport.PeakMemoryBytes = FMath::Max(LastReport.PeakMemoryBytes, SampleTerrainMemory());
+		LastReport.PeakProcessBytes = FMath::Max(LastReport.PeakProcessBytes, (int64)FPlatformMemory::GetStats().UsedPhysical);
+	}
+
+	UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	ATerraDyneManager* Manager = Subsystem ? Subsystem->GetTerrainManager() : nullptr;
+	if (!Manager) return;
+
+	// Impacts are placed per chunk, so wait until the grid knows its chunk size
+	if (Manager->GlobalChunkSize <= 0.0f)
+	{
+		Manager->RebuildChunkMap();
+		if (Manager->GlobalChunkSize <= 0.0f) return;
+	}
+
+	// Game time drives the schedule, so fixed-timestep runs replay the same edits frame for frame
+	LoadRunTime += DeltaTime;
+	ImpactAccumulator += LoadProfile.ImpactsPerSecond * DeltaTime;
+	while (ImpactAccumulator >= 1.0f)
+	{
+		ImpactAccumulator -= 1.0f;
+		StartImpact(Manager);
+	}
+
+	// One brush per stroke per tick, like a tool dragged across the terrain
+	for (int32 i = ActiveStrokes.Num() - 1; i >= 0; i--)
+	{
+		FActiveStroke& Stroke = ActiveStrokes[i];
+		Manager->ApplyGlobalBrush(Stroke.Position, Stroke.Radius, Stroke.Strength, false, Stroke.PaintLayer);
+		LastReport.BrushEdits++;
+
+		Stroke.Position += Stroke.Direction * (Stroke.Radius * LoadProfile.StrokeSpacing);
+		if (--Stroke.StepsLeft <= 0)
+		{
+			ActiveStrokes.RemoveAtSwap(i, EAllowShrinking::No);
+		}
+	}
+
+	if (LoadProfile.Duration > 0.0f && LoadRunTime >= LoadProfile.Duration)
+	{
+		FinishLoadRun();
+	}
+}
+
+void ATerraDyneOrchestrator::StartImpact(ATerraDyneManager* Manager)
+{
+	LastReport.Impacts++;
+
+	// Always draw the same number of values per impact, so changing a ratio doesn't reshuffle positions
+	const int32 Spread = FMath::Max(LoadProfile.ChunkSpread, 1);
+	const FIntPoint CenterCoord = Manager->WorldToGrid(GetActorLocation());
+	const FIntPoint Coord(
+		CenterCoord.X - Spread / 2 + LoadRandom.RandRange(0, Spread - 1),
+		CenterCoord.Y - Spread / 2 + LoadRandom.RandRange(0, Spread - 1));
+
+	const float ChunkSize = Manager->GlobalChunkSize;
+	const FVector Position(
+		(Coord.X + LoadRandom.GetFraction()) * ChunkSize,
+		(Coord.Y + LoadRandom.GetFraction()) * ChunkSize,
+		GetActorLocation().Z);
+
+	const float MinRadius = FMath::Min(LoadProfile.MinRadius, LoadProfile.MaxRadius);
+	const float BrushRadius = FMath::Lerp(MinRadius, LoadProfile.MaxRadius, FMath::Pow(LoadRandom.GetFraction(), LoadProfile.RadiusExponent));
+	const float Strength = LoadRandom.FRandRange(LoadProfile.MinStrength, LoadProfile.MaxStrength);
+	const bool bPaint = LoadRandom.GetFraction() < LoadProfile.PaintRatio;
+	const bool bStroke = LoadRandom.GetFraction() < LoadProfile.StrokeRatio;
+	const float Heading = LoadRandom.FRandRange(0.0f, UE_TWO_PI);
+
+	if (LoadProfile.bUsePhysicsProjectiles)
+	{
+		// The projectile digs and paints on its own when it lands
+		const FTransform SpawnTransform(FRotator(-90.0f, 0.0f, 0.0f), Position + FVector(0.0f, 0.0f, 4000.0f));
+		if (ATerraDyneProjectile* Projectile = GetWorld()->SpawnActorDeferred<ATerraDyneProjectile>(ATerraDyneProjectile::StaticClass(), SpawnTransform))
+		{
+			Projectile->CraterRadius = BrushRadius;
+			Projectile->CraterDepth = Strength;
+			Projectile->FinishSpawning(SpawnTransform);
+			LastReport.ProjectilesSpawned++;
+		}
+		return;
+	}
+
+	FActiveStroke& Stroke = ActiveStrokes.AddDefaulted_GetRef();
+	Stroke.Position = Position;
+	Stroke.Direction = FVector(FMath::Cos(Heading), FMath::Sin(Heading), 0.0f);
+	Stroke.Radius = BrushRadius;
+	Stroke.Strength = bPaint ? 1.0f : Strength;
+	Stroke.PaintLayer = bPaint ? LoadProfile.PaintLayer : -1;
+	Stroke.StepsLeft = bStroke ? FMath::Max(LoadProfile.StrokeSteps, 1) : 1;
+}
+
+void ATerraDyneOrchestrator::FinishLoadRun()
+{
+	bLoadRunActive = false;
+	ActiveStrokes.Reset();
+
+	LastReport.Seconds = (float)(FPlatformTime::Seconds() - LoadStartTime);
+	LastReport.Frames = FrameTimesMs.Num();
+	LastReport.EndMemoryBytes = SampleTerrainMemory();
+	LastReport.PeakMemoryBytes = FMath::Max(LastReport.PeakMemoryBytes, LastReport.EndMemoryBytes);
+
+	if (FrameTimesMs.Num() > 0)
+	{
+		TArray<float> Sorted = FrameTimesMs;
+		Sorted.Sort();
+
+		auto Percentile = [&Sorted](float P)
+		{
+			const int32 Index = FMath::Clamp(FMath::CeilToInt(P * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+			return Sorted[Index];
+		};
+		LastReport.FrameP50Ms = Percentile(0.50f);
+		LastReport.FrameP95Ms = Percentile(0.95f);
+		LastReport.FrameP99Ms = Percentile(0.99f);
+		LastReport.FrameMaxMs = Sorted.Last();
+	}
+
+	const FTerraDyneEditLatency::FStageSummary CPU = FTerraDyneEditLatency::GetSummary(ETerraDyneEditStage::CPUApplied);
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneLoadGen: '%s' finished: %d impacts, %d brush edits, %d projectiles in %.1f s over %d frames."),
+		*LoadProfile.Name, LastReport.Impacts, LastReport.BrushEdits, LastReport.ProjectilesSpawned, LastReport.Seconds, LastReport.Frames);
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneLoadGen: Frame p50 %.2f / p95 %.2f / p99 %.2f / max %.2f ms, CPU edit p99 %.2f ms, memory peak %.1f MB (start %.1f, end %.1f)."),
+		LastReport.FrameP50Ms, LastReport.FrameP95Ms, LastReport.FrameP99Ms, LastReport.FrameMaxMs, CPU.P99Ms,
+		LastReport.PeakMemoryBytes / (1024.0 * 1024.0), LastReport.StartMemoryBytes / (1024.0 * 1024.0), LastReport.EndMemoryBytes / (1024.0 * 1024.0));
+
+	const FString FilePath = FPaths::ProfilingDir() / FString::Printf(TEXT("TerraDyneLoad_%s.json"), *FPaths::MakeValidFileName(LoadProfile.Name));
+	if (FFileHelper::SaveStringToFile(LoadReportToJson(), *FilePath))
+	{
+		UE_LOG(LogTemp, Log, TEXT("TerraDyneLoadGen: Wrote %s"), *FilePath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TerraDyneLoadGen: Failed to write %s"), *FilePath);
+	}
+
+	if (bQuitWhenFinished)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("TerraDyneLoadGen"));
+	}
+}
+
+bool ATerraDyneOrchestrator::LoadProfileFromConfig(const FString& ProfileName)
+{
+	const FString Section = FString::Printf(TEXT("TerraDyne.LoadProfile.%s"), *ProfileName);
+	if (!GConfig || !GConfig->DoesSectionExist(*Section, GGameIni))
+	{
+		return false;
+	}
+
+	LoadProfile.Name = ProfileName;
+	for (TFieldIterator<FProperty> It(FTerraDyneLoadProfile::StaticStruct()); It; ++It)
+	{
+		FString Value;
+		if (GConfig->GetString(*Section, *It->GetName(), Value, GGameIni)
+			&& !It->ImportText_InContainer(*Value, &LoadProfile, nullptr, PPF_None))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TerraDyneLoadGen: [%s] %s=%s is not a valid value, keeping the default."), *Section, *It->GetName(), *Value);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("TerraDyneLoadGen: Using profile [%s]."), *Section);
+	return true;
+}
+
+int64 ATerraDyneOrchestrator::SampleTerrainMemory() const
+{
+	UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr;
+	if (!Subsystem) return 0;
+
+	if (const ATerraDyneManager* Manager = Subsystem->GetTerrainManager())
+	{
+		return Manager->GetTotalMemoryBytes();
+	}
+
+	// No Manager, so no pool: just the registered chunks
+	FTerraDyneChunkMemory Totals;
+	for (const ATerraDyneChunk* Chunk : Subsystem->GetRegisteredChunks())
+	{
+		if (Chunk)
+		{
+			Totals += Chunk->GetMemoryBreakdown();
+		}
+	}
+	return Totals.GetTotal() + FTerraDyneSaveBuffers::GetInFlightBytes() + FTerraDyneSaveBuffers::GetStats().PooledBytes;
+}
+
+/** Quotes and escapes a string for a JSON document (profile names come from the command line, ini sections and the Details panel). */
+static FString ToJsonString(const FString& Value)
+{
+	FString Out;
+	Out.Reserve(Value.Len() + 2);
+	Out += TEXT('"');
+	for (const TCHAR Char : Value)
+	{
+		switch (Char)
+		{
+		case TEXT('"'):  Out += TEXT("\\\""); break;
+		case TEXT('\\'): Out += TEXT("\\\\"); break;
+		case TEXT('\n'): Out += TEXT("\\n"); break;
+		case TEXT('\r'): Out += TEXT("\\r"); break;
+		case TEXT('\t'): Out += TEXT("\\t"); break;
+		default:
+			if (Char < 0x20)
+			{
+				Out += FString::Printf(TEXT("\\u%04x"), (uint32)Char);
+			}
+			else
+			{
+				Out += Char;
+			}
+			break;
+		}
+	}
+	Out += TEXT('"');
+	return Out;
+}
+
+FString ATerraDyneOrchestrator::LoadReportToJson() const
+{
+	const FTerraDyneLoadProfile& P = LoadProfile;
+	const FTerraDyneLoadReport& R = LastReport;
+
+	FString Json = TEXT("{\n");
+	Json += FString::Printf(
+		TEXT("\t\"profile\": { \"name\": %s, \"seed\": %d, \"duration\": %.3f, \"impacts_per_second\": %.3f, \"min_radius\": %.1f, \"max_radius\": %.1f, \"radius_exponent\": %.3f, ")
+		TEXT("\"min_strength\": %.1f, \"max_strength\": %.1f, \"chunk_spread\": %d, \"paint_ratio\": %.3f, \"stroke_ratio\": %.3f, \"stroke_steps\": %d, \"projectiles\": %s },\n"),
+		*ToJsonString(P.Name), P.Seed, P.Duration, P.ImpactsPerSecond, P.MinRadius, P.MaxRadius, P.RadiusExponent,
+		P.MinStrength, P.MaxStrength, P.ChunkSpread, P.PaintRatio, P.StrokeRatio, P.StrokeSteps, P.bUsePhysicsProjectiles ? TEXT("true") : TEXT("false"));
+	Json += FString::Printf(
+		TEXT("\t\"run\": { \"seconds\": %.3f, \"frames\": %d, \"impacts\": %d, \"brush_edits\": %d, \"projectiles\": %d },\n"),
+		R.Seconds, R.Frames, R.Impacts, R.BrushEdits, R.ProjectilesSpawned);
+	Json += FString::Printf(
+		TEXT("\t\"frame_ms\": { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f },\n"),
+		R.FrameP50Ms, R.FrameP95Ms, R.FrameP99Ms, R.FrameMaxMs);
+	Json += FString::Printf(
+		TEXT("\t\"memory_bytes\": { \"start\": %lld, \"peak\": %lld, \"end\": %lld, \"process_peak\": %lld },\n"),
+		R.StartMemoryBytes, R.PeakMemoryBytes, R.EndMemoryBytes, R.PeakProcessBytes);
+
+	Json += TEXT("\t\"edit_latency_ms\": [\n");
+	for (int32 Stage = 0; Stage < (int32)ETerraDyneEditStage::Num; Stage++)
+	{
+		const FTerraDyneEditLatency::FStageSummary Summary = FTerraDyneEditLatency::GetSummary((ETerraDyneEditStage)Stage);
+		Json += FString::Printf(
+			TEXT("\t\t{ \"stage\": \"%s\", \"count\": %lld, \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f }%s\n"),
+			FTerraDyneEditLatency::GetStageName((ETerraDyneEditStage)Stage), Summary.Count, Summary.P50Ms, Summary.P95Ms, Summary.P99Ms, Summary.MaxMs,
+			Stage < (int32)ETerraDyneEditStage::Num - 1 ? TEXT(",") : TEXT(""));
+	}
+	Json += TEXT("\t]\n}\n");
+	return Json;
+}
+
+//--- Console ---//
+
+static FAutoConsoleCommandWithWorldAndArgs CmdTerraDyneLoadGen(
+	TEXT("terradyne.LoadGen"),
+	TEXT("Starts or stops the load generator of every TerraDyne orchestrator in the world. Usage: terradyne.LoadGen start|stop"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			if (!World) return;
+
+			const bool bStop = Args.Num() > 0 && Args[0].Equals(TEXT("stop"), ESearchCase::IgnoreCase);
+			int32 Count = 0;
+			for (TActorIterator<ATerraDyneOrchestrator> It(World); It; ++It)
+			{
+				if (bStop)
+				{
+					It->StopLoadRun();
+				}
+				else
+				{
+					It->Mode = ETerraDyneOrchestratorMode::LoadGenerator;
+					It->StartLoadRun();
+				}
+				Count++;
+			}
+
+			if (Count == 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("TerraDyneLoadGen: No TerraDyneOrchestrator in this world."));
+			}
+		}));
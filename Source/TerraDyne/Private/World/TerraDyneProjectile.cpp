@@ -34,6 +34,26 @@ ATerraDyneProjectile::ATerraDyneProjectile()
 	MovementComp->Bounciness = 0.3f;
 }
 
+void ATerraDyneProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr)
+	{
+		Subsystem->RegisterPhysicsSource(this);
+	}
+}
+
+void ATerraDyneProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UTerraDyneSubsystem* Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UTerraDyneSubsystem>() : nullptr)
+	{
+		Subsystem->UnregisterPhysicsSource(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ATerraDyneProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
 	// Only interact with the world on heavy impacts
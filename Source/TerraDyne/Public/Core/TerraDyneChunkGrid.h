@@ -0,0 +1,165 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+class ATerraDyneChunk;
+
+/**
+ * FTerraDyneChunkGrid
+ *
+ * Two-level paged spatial index of the active chunks, keyed by grid coordinate.
+ * Level 1: a dense directory of pages covering the occupied page bounds.
+ * Level 2: 32x32 pages of chunk slots, allocated on first use and freed when empty.
+ *
+ * Lookups are two array indexings (no hashing). Rect walks visit page by page and
+ * row by row inside a page, so batched queries and cross-chunk kernels stay cache-friendly.
+ *
+ * The grid does not own the chunks. Entries are added/removed incrementally by the
+ * Manager as chunks register and unregister; it never scans the world.
+ */
+class TERRADYNE_API FTerraDyneChunkGrid
+{
+public:
+	static constexpr int32 PageShift = 5;
+	static constexpr int32 PageSize = 1 << PageShift; // 32
+	static constexpr int32 PageMask = PageSize - 1;
+
+	//--- Mutation ---//
+
+	/** Inserts (or replaces) the chunk stored at Coord. */
+	void Add(FIntPoint Coord, ATerraDyneChunk* Chunk);
+
+	/**
+	 * Clears the slot at Coord.
+	 * If Expected is provided, the slot is only cleared when it still holds that chunk.
+	 * @return True if a chunk was removed.
+	 */
+	bool Remove(FIntPoint Coord, const ATerraDyneChunk* Expected = nullptr);
+
+	/** Drops every page and the directory. */
+	void Reset();
+
+	//--- Queries ---//
+
+	/** O(1) lookup. Returns nullptr for empty slots. */
+	ATerraDyneChunk* Find(FIntPoint Coord) const
+	{
+		const FPage* Page = FindPage(ToPageCoord(Coord));
+		return Page ? Page->Slots[ToSlotIndex(Coord)] : nullptr;
+	}
+
+	/** Number of occupied slots. */
+	int32 Num() const { return NumChunks; }
+
+	/**
+	 * Visits every occupied slot in the inclusive rect [Min, Max].
+	 * Iterates page-major, then row-major inside each page.
+	 */
+	template<typename FuncType>
+	void ForEachInRect(FIntPoint Min, FIntPoint Max, FuncType&& Func) const
+	{
+		// Only pages inside the directory can hold chunks: huge query rects cost no more than the directory
+		const FIntPoint PageMin = ToPageCoord(Min).ComponentMax(DirectoryMin);
+		const FIntPoint PageMax = ToPageCoord(Max).ComponentMin(DirectoryMin + DirectorySize - FIntPoint(1, 1));
+		if (PageMin.X > PageMax.X || PageMin.Y > PageMax.Y) return;
+
+		for (int32 PY = PageMin.Y; PY <= PageMax.Y; PY++)
+		{
+			for (int32 PX = PageMin.X; PX <= PageMax.X; PX++)
+			{
+				const FPage* Page = FindPage(FIntPoint(PX, PY));
+				if (!Page) continue;
+
+				// Clip the rect to this page
+				const int32 BaseX = PX << PageShift;
+				const int32 BaseY = PY << PageShift;
+				const int32 X0 = FMath::Max(Min.X, BaseX) - BaseX;
+				const int32 X1 = FMath::Min(Max.X, BaseX + PageMask) - BaseX;
+				const int32 Y0 = FMath::Max(Min.Y, BaseY) - BaseY;
+				const int32 Y1 = FMath::Min(Max.Y, BaseY + PageMask) - BaseY;
+
+				for (int32 LY = Y0; LY <= Y1; LY++)
+				{
+					ATerraDyneChunk* const* Row = &Page->Slots[LY << PageShift];
+					for (int32 LX = X0; LX <= X1; LX++)
+					{
+						if (ATerraDyneChunk* Chunk = Row[LX])
+						{
+							Func(FIntPoint(BaseX + LX, BaseY + LY), Chunk);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/** Visits the occupied 8-neighbourhood of Coord (excluding Coord itself). */
+	template<typename FuncType>
+	void ForEachNeighbor(FIntPoint Coord, FuncType&& Func) const
+	{
+		ForEachInRect(Coord - FIntPoint(1, 1), Coord + FIntPoint(1, 1), [&](FIntPoint C, ATerraDyneChunk* Chunk)
+			{
+				if (C != Coord)
+				{
+					Func(C, Chunk);
+				}
+			});
+	}
+
+	/** Visits every occupied slot, page by page. */
+	template<typename FuncType>
+	void ForEach(FuncType&& Func) const
+	{
+		if (NumChunks == 0) return;
+		ForEachInRect(
+			FIntPoint(DirectoryMin.X << PageShift, DirectoryMin.Y << PageShift),
+			FIntPoint(((DirectoryMin.X + DirectorySize.X) << PageShift) - 1, ((DirectoryMin.Y + DirectorySize.Y) << PageShift) - 1),
+			Forward<FuncType>(Func));
+	}
+
+private:
+	struct FPage
+	{
+		ATerraDyneChunk* Slots[PageSize * PageSize];
+		int32 Count;
+
+		FPage() : Count(0)
+		{
+			FMemory::Memzero(Slots, sizeof(Slots));
+		}
+	};
+
+	// Arithmetic shift floors negative coordinates onto the correct page
+	static FIntPoint ToPageCoord(FIntPoint Coord)
+	{
+		return FIntPoint(Coord.X >> PageShift, Coord.Y >> PageShift);
+	}
+
+	static int32 ToSlotIndex(FIntPoint Coord)
+	{
+		return ((Coord.Y & PageMask) << PageShift) | (Coord.X & PageMask);
+	}
+
+	const FPage* FindPage(FIntPoint PageCoord) const
+	{
+		const int32 DX = PageCoord.X - DirectoryMin.X;
+		const int32 DY = PageCoord.Y - DirectoryMin.Y;
+		if ((uint32)DX >= (uint32)DirectorySize.X || (uint32)DY >= (uint32)DirectorySize.Y)
+		{
+			return nullptr;
+		}
+		return Directory[DY * DirectorySize.X + DX].Get();
+	}
+
+	/** Returns the directory slot for PageCoord, growing the directory if needed. */
+	TUniquePtr<FPage>& FindOrAddPageSlot(FIntPoint PageCoord);
+
+	// Dense directory over [DirectoryMin, DirectoryMin + DirectorySize)
+	TArray<TUniquePtr<FPage>> Directory;
+	FIntPoint DirectoryMin = FIntPoint::ZeroValue;
+	FIntPoint DirectorySize = FIntPoint::ZeroValue;
+
+	int32 NumChunks = 0;
+};
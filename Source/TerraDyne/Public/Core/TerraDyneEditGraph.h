@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/TerraDyneWorkerPool.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+/** Data an edit-graph node reads or writes. Snapshots are owned by the graph, never the actor. */
+enum class ETerraDyneEditResource : uint32
+{
+	None          = 0,
+	Heights       = 1 << 0, // Snapshot of HeightCache
+	Weights       = 1 << 1, // Snapshot of WeightCache
+	CollisionMesh = 1 << 2, // Rebuilt FDynamicMesh3
+	PackedTexture = 1 << 3, // FFloat16 / RGBA8 upload buffers
+};
+ENUM_CLASS_FLAGS(ETerraDyneEditResource);
+
+/**
+ * FTerraDyneEditGraph
+ *
+ * One flush worth of an edit's derived products as a small dependency graph on FTerraDyneWorkerPool.
+ * Each node declares its read and write sets. A node only waits for earlier nodes it conflicts
+ * with (read-after-write, write-after-write, write-after-read); everything else runs in parallel.
+ *
+ * Nodes are ordinary pool jobs, launched as their prerequisites finish, so FTerraDyneWorkerPool::WaitForAll()
+ * (and UTerraDyneSubsystem::FlushPendingTasks()) covers them. A node whose token is cancelled is skipped;
+ * its dependents and the join still run.
+ *
+ * The join runs on the Game Thread after every node has finished. That is where results are
+ * applied to components (SetMesh, render commands, nav, grass requests).
+ */
+class TERRADYNE_API FTerraDyneEditGraph
+{
+public:
+	/** Adds a worker node. Work must only touch the resources it declares. Token lets the owner cancel it (e.g. a superseded build). */
+	void AddNode(const TCHAR* DebugName, ETerraDyneEditResource Reads, ETerraDyneEditResource Writes, TUniqueFunction<void()>&& Work,
+		FTerraDyneCancellationTokenPtr Token = nullptr);
+
+	/**
+	 * Launches the nodes on the worker pool at Priority and queues Join on the Game Thread after all of them.
+	 * With no nodes, Join runs inline. The graph is empty afterwards.
+	 */
+	void Launch(ETerraDyneJobPriority Priority, TUniqueFunction<void()>&& Join);
+
+	int32 Num() const { return Nodes.Num(); }
+
+private:
+	struct FNode
+	{
+		const TCHAR* DebugName = nullptr;
+		ETerraDyneEditResource Reads = ETerraDyneEditResource::None;
+		ETerraDyneEditResource Writes = ETerraDyneEditResource::None;
+		TUniqueFunction<void()> Work;
+		FTerraDyneCancellationTokenPtr Token;
+	};
+
+	/** A launched graph, shared by its in-flight nodes. */
+	struct FRun;
+
+	TArray<FNode> Nodes;
+};
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+/** One brush op as passed to ATerraDyneManager::ApplyGlobalBrush(), stamped with its journal tick. */
+struct FTerraDyneJournalEdit
+{
+	uint32 Tick = 0;
+	FVector2D Position = FVector2D::ZeroVector; // World XY (brushes ignore Z)
+	float Radius = 0.0f;
+	float Strength = 0.0f;
+	bool bIsHole = false;
+	int32 PaintLayer = -1;
+};
+
+/**
+ * FTerraDyneEditJournal
+ *
+ * Compact binary log of terrain edits. Each record is delta-coded against the previous one:
+ * tick delta, op byte, position delta at 1 unit, radius at 1 unit, strength as half float
+ * (layout in TerraDyneCore::FJournalCodec). Typical records take 8-12 bytes. Recorded edits are quantized before they are applied, so
+ * replaying a journal reproduces the recorded terrain bit for bit.
+ *
+ * Chunk states are stored as chunk file images (UTerraDyneSerializer::SerializeToBytes):
+ * - Base states: each touched chunk as it was right before its first recorded edit. Untouched chunks are never stored.
+ * - Keyframes: every touched chunk at a given tick, plus the stream cursor there. Seeking restores the
+ *   nearest keyframe at or before the target and replays only the edits after it.
+ * States are shared: a chunk that didn't change between two keyframes points at the same bytes in both
+ * (also after loading a file, which stores each keyframe in full). While recording, the bytes of a state
+ * may still be compressing on the worker pool; whoever launched that must wait before reading them.
+ *
+ * Game Thread only.
+ */
+class TERRADYNE_API FTerraDyneEditJournal
+{
+public:
+	static constexpr uint32 FileMagic = 0x524A4454; // "TDJR"
+	static constexpr int32 FileVersion = 1;
+
+	/** Decoder position in the edit stream. Records are relative to the previous one, so this carries that state. */
+	struct FCursor
+	{
+		int32 Offset = 0;
+		int32 EditIndex = 0;
+		uint32 Tick = 0;
+		int32 X = 0;
+		int32 Y = 0;
+	};
+
+	/** One chunk file image, shared between the base states and keyframes that hold it. */
+	using FChunkState = TSharedRef<TArray<uint8>, ESPMode::ThreadSafe>;
+
+	/** Terrain state right before the edit at Cursor. Tick is that edit's tick. */
+	struct FKeyframe
+	{
+		uint32 Tick = 0;
+		FCursor Cursor;
+		TMap<FIntPoint, FChunkState> Chunks;
+	};
+
+	explicit FTerraDyneEditJournal(float InTickRate = 60.0f);
+
+	/** Rounds an edit to what the stream can hold. Record and apply the result, not the original. */
+	static FTerraDyneJournalEdit Quantize(const FTerraDyneJournalEdit& Edit);
+
+	/** Appends a quantized edit; ticks must not decrease. */
+	void Append(const FTerraDyneJournalEdit& Edit);
+
+	/** Decodes the edit at Cursor and advances it. False at the end of the stream (or on a corrupt record). */
+	bool ReadNext(FCursor& Cursor, FTerraDyneJournalEdit& OutEdit) const;
+
+	/** Cursor after the last record, i.e. where Append() writes next. */
+	const FCursor& GetEndCursor() const { return Tail; }
+
+	//--- Chunk States ---//
+
+	bool HasBaseState(FIntPoint Coord) const { return BaseStates.Contains(Coord); }
+	void AddBaseState(FIntPoint Coord, const FChunkState& State) { BaseStates.Add(Coord, State); }
+	const TMap<FIntPoint, FChunkState>& GetBaseStates() const { return BaseStates; }
+
+	/** Starts a keyframe at the end of the stream, i.e. before the next edit (which must carry tick Tick). */
+	FKeyframe& AddKeyframe(uint32 Tick);
+
+	/** Latest keyframe with Tick <= Tick, or null if seeking must start from the base states. */
+	const FKeyframe* FindKeyframe(uint32 Tick) const;
+
+	/** State of Coord as of the latest keyframe (or its base state if no keyframe holds it yet); null if never touched. */
+	const FChunkState* FindLatestState(FIntPoint Coord) const;
+
+	/** Drops every other keyframe (the latest one stays), halving their count and memory. */
+	void ThinKeyframes();
+
+	int32 GetNumKeyframes() const { return Keyframes.Num(); }
+
+	//--- Info ---//
+
+	float GetTickRate() const { return TickRate; }
+	int32 GetNumEdits() const { return Tail.EditIndex; }
+	uint32 GetLastTick() const { return Tail.Tick; }
+
+	/** Bytes of the edit stream alone. */
+	int64 GetStreamBytes() const { return Stream.Num(); }
+
+	/** Everything held in memory: stream, base states and keyframes (shared states counted once). */
+	int64 GetAllocatedSize() const;
+
+	//--- Files ---//
+
+	void Serialize(FArchive& Ar);
+	bool SaveToFile(const FString& Path) const;
+	bool LoadFromFile(const FString& Path);
+
+	/** Saved/TerraDyne/Journals/<Name>.tdj */
+	static FString GetJournalPath(const FString& Name);
+
+private:
+	/** Same layout as TMap<FIntPoint, TArray<uint8>> <<. Loading shares states equal to the ones in Previous. */
+	static void SerializeStates(FArchive& Ar, TMap<FIntPoint, FChunkState>& States, const TMap<FIntPoint, FChunkState>* Previous);
+
+	float TickRate;
+	TArray<uint8> Stream;
+	FCursor Tail;
+	TMap<FIntPoint, FChunkState> BaseStates;
+	TArray<FKeyframe> Keyframes;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+/** Pipeline stages an edit passes through after ATerraDyneManager::ApplyGlobalBrush(). */
+enum class ETerraDyneEditStage : uint8
+{
+	CPUApplied,    // Heights/weights written to every touched chunk's caches
+	GPUUploaded,   // Render targets updated (draw or texture upload submitted)
+	CollisionLive, // Rebuilt collision cooked on every touched chunk
+	GrassUpdated,  // Grass regeneration of the edited bounds finished
+	Persisted,     // Written to disk by a save
+	Num
+};
+
+/**
+ * FTerraDyneEditLatency
+ *
+ * End-to-end latency tracing of terrain edits. Each ApplyGlobalBrush() gets an edit ID. Chunks
+ * register the ID with every stage they still owe, and complete it when that product lands. A stage
+ * is reached once the last chunk completes it, and its latency goes into a per-stage histogram.
+ * Stages no chunk took part in (e.g. GPU uploads when headless) record nothing.
+ *
+ * Thread-safe; chunks only read the current edit on the Game Thread.
+ * Console: terradyne.EditLatency [reset], terradyne.EditLatency.Export [Path]
+ */
+class TERRADYNE_API FTerraDyneEditLatency
+{
+public:
+	/** Per-stage percentiles over the most recent samples, plus power-of-two millisecond buckets. */
+	struct FStageSummary
+	{
+		int64 Count = 0;
+		float P50Ms = 0.0f;
+		float P95Ms = 0.0f;
+		float P99Ms = 0.0f;
+		float MaxMs = 0.0f;
+		TArray<int64> Buckets; // Bucket i counts samples below 2^i ms (the last one is open-ended)
+	};
+
+	/** Scopes one brush application: chunks edited inside it pick up the edit ID. */
+	class FScope
+	{
+	public:
+		FScope() : EditId(BeginEdit()) {}
+		~FScope() { EndEdit(EditId); }
+		uint32 GetEditId() const { return EditId; }
+
+	private:
+		uint32 EditId;
+	};
+
+	static bool IsEnabled();
+
+	/** Starts tracing an edit and makes it current (0 when tracing is disabled). */
+	static uint32 BeginEdit();
+
+	/** Marks CPUApplied and resolves stages no chunk registered for. */
+	static void EndEdit(uint32 EditId);
+
+	/** Edit applied right now on the Game Thread, or 0. */
+	static uint32 GetCurrentEdit() { return CurrentEditId; }
+
+	static void AddPending(uint32 EditId, ETerraDyneEditStage Stage);
+	static void Complete(TConstArrayView<uint32> EditIds, ETerraDyneEditStage Stage);
+
+	/** Releases registrations whose product will never arrive (chunk pooled, grass disabled, save failed). */
+	static void Abandon(TConstArrayView<uint32> EditIds, ETerraDyneEditStage Stage);
+
+	static FStageSummary GetSummary(ETerraDyneEditStage Stage);
+	static void Reset();
+
+	/** Percentiles and buckets of every stage as a JSON document. */
+	static FString ToJson();
+
+	/** Writes ToJson() to Path (default: Saved/Profiling/TerraDyneEditLatency.json). */
+	static bool ExportJson(const FString& Path = FString());
+
+	static const TCHAR* GetStageName(ETerraDyneEditStage Stage);
+
+private:
+	static uint32 CurrentEditId;
+};
@@ -2,13 +2,222 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Core/TerraDyneChunkGrid.h"
+#include "Core/TerraDyneSubsystem.h"
+#include "Core/TerraDyneWorkerPool.h"
+#include "Core/TerraDyneEditJournal.h"
 #include "TerraDyneManager.generated.h"
 
 // Forward Declarations
 class ATerraDyneChunk;
+struct FTerraDyneChunkSnapshot;
+struct FTerraDyneChunkMemory;
 class ALandscapeProxy;
 class UMaterialInterface;
 
+/** Level-start timings gathered by the Manager's time-sliced init queue. */
+USTRUCT(BlueprintType)
+struct FTerraDyneStartupStats
+{
+	GENERATED_BODY()
+
+	/** Chunks initialized through the queue. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Startup")
+	int32 ChunksInitialized = 0;
+
+	/** Frames that spent time on the queue. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Startup")
+	int32 FramesUsed = 0;
+
+	/** Game Thread time spent inside the queue (ms), including the parallel dequantization waits. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Startup")
+	float GameThreadMs = 0.0f;
+
+	/** Wall time of the parallel dequantization passes (ms). */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Startup")
+	float DequantizeMs = 0.0f;
+
+	/** Seconds from Manager BeginPlay until the chunks under every player were ready (-1 while pending). */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Startup")
+	float TimeToFirstPlayableSeconds = -1.0f;
+
+	/** Seconds from Manager BeginPlay until the queue drained (-1 while pending). */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Startup")
+	float TimeToFullyLoadedSeconds = -1.0f;
+};
+
+/** Prefetch effectiveness counters for the chunk streaming layer. */
+USTRUCT(BlueprintType)
+struct FTerraDyneStreamingStats
+{
+	GENERATED_BODY()
+
+	/** Tile data loads issued. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Streaming")
+	int32 TileRequests = 0;
+
+	/** Saved chunk files decompressed and applied. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Streaming")
+	int32 SavedChunksLoaded = 0;
+
+	/** Chunks whose data was ready before any source reached them. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Streaming")
+	int32 ArrivedOnTime = 0;
+
+	/** Chunks a source reached (StreamingArrivalDistance) before their data was ready. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Streaming")
+	int32 ArrivedLate = 0;
+
+	/** Sum and worst case of how long late chunks were missing while needed (s). */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Streaming")
+	float TotalLateSeconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Streaming")
+	float WorstLateSeconds = 0.0f;
+};
+
+/** Severity of the memory alarm (see ATerraDyneManager::MemoryWarningMB / MemoryCriticalMB). */
+UENUM(BlueprintType)
+enum class ETerraDyneMemoryAlarm : uint8
+{
+	None,
+	Warning,
+	Critical
+};
+
+/** Residency counters of the memory budget (cold chunk compression). */
+USTRUCT(BlueprintType)
+struct FTerraDyneMemoryStats
+{
+	GENERATED_BODY()
+
+	/** Approximate bytes held by all indexed chunks at the last budget pass (caches, compressed blobs, RTs, collision). */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int64 ResidentBytes = 0;
+
+	/** Chunks whose caches are compressed right now. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int32 CompressedChunks = 0;
+
+	/** Chunks compressed since BeginPlay. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int32 Compressions = 0;
+
+	/** Cache accesses that found the data resident. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int32 CacheHits = 0;
+
+	/** Cache accesses (or approaching viewers) that had to decompress first. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int32 CacheMisses = 0;
+
+	/** Resident plus compressed CPU caches of all chunks, pooled ones included. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int64 CacheBytes = 0;
+
+	/** HeightRT + WeightRT of all chunks, pooled ones included. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int64 RenderTargetBytes = 0;
+
+	/** Collision mesh and cooked collision of all chunks. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int64 CollisionBytes = 0;
+
+	/** Grass instances of all chunks. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int64 GrassBytes = 0;
+
+	/** Snapshots of saves in flight plus the save buffer pools (process-wide). */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int64 SaveBytes = 0;
+
+	/** Sum of the categories above; what the alarm thresholds compare against. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	int64 TotalBytes = 0;
+
+	/** Alarm level after the last budget pass. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Memory")
+	ETerraDyneMemoryAlarm AlarmLevel = ETerraDyneMemoryAlarm::None;
+};
+
+/** Save pipeline counters (process-wide: the buffer pools are shared by every world). */
+USTRUCT(BlueprintType)
+struct FTerraDyneSaveStats
+{
+	GENERATED_BODY()
+
+	/** Chunk files written since startup. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Save")
+	int64 ChunksSaved = 0;
+
+	/** Chunk files read since startup. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Save")
+	int64 ChunksLoaded = 0;
+
+	/** Snapshot, serialization, compression and file buffers handed out. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Save")
+	int64 BufferAcquires = 0;
+
+	/** Acquires served from the pool. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Save")
+	int64 BufferReuses = 0;
+
+	/** Acquires that hit the heap; flat during a steady-state autosave. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Save")
+	int64 BufferAllocations = 0;
+
+	/** Bytes parked in the pools right now. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Save")
+	int64 PooledBytes = 0;
+
+	/** Snapshot payload of saves that have not finished yet. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Save")
+	int64 InFlightBytes = 0;
+};
+
+/** Per-frame Game Thread budgets of the subsystem's work scheduler (ms per category). */
+USTRUCT(BlueprintType)
+struct FTerraDyneWorkBudgets
+{
+	GENERATED_BODY()
+
+	/** Collision cooks started after edits. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Performance", meta = (ClampMin = "0.0"))
+	float CollisionMs = 2.0f;
+
+	/** Deferred render target region uploads. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Performance", meta = (ClampMin = "0.0"))
+	float GPUUploadMs = 1.0f;
+
+	/** Grass regeneration requests. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Performance", meta = (ClampMin = "0.0"))
+	float GrassMs = 0.5f;
+
+	/** Commits of streamed tile data and saved chunks. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Performance", meta = (ClampMin = "0.0"))
+	float StreamingMs = 2.0f;
+
+	/** Snapshotting chunks for async saves. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Performance", meta = (ClampMin = "0.0"))
+	float SaveMs = 0.5f;
+
+	/** Work waiting longer than this (s) runs ahead of nearer work. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Performance", meta = (ClampMin = "0.0"))
+	float StarvationSeconds = 0.5f;
+};
+
+/** Velocity tracking for one streaming source (EMA of its frame-to-frame motion). */
+struct FTerraDyneStreamingSource
+{
+	TWeakObjectPtr<const AActor> Actor;
+	FVector LastLocation = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	double LastTime = 0.0;
+};
+
+/** Fired when the memory alarm level changes (None = back under the warning threshold). */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FTerraDyneMemoryAlarmDelegate, ETerraDyneMemoryAlarm, Level, int64, TotalBytes, int64, ThresholdBytes);
+
 UCLASS(Blueprintable)
 class TERRADYNE_API ATerraDyneManager : public AActor
 {
@@ -35,6 +244,202 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Tools")
 	TObjectPtr<UMaterialInterface> WeightBrushMaterial;
 
+	//--- Pooling ---//
+
+	/** Chunks pre-spawned at BeginPlay (with RTs and collision) so streaming never pays for actor spawns. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Performance", meta = (ClampMin = "0"))
+	int32 ChunkPoolPrewarmCount = 0;
+
+	/** Upper bound of parked chunks. Released chunks beyond this are destroyed. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Performance", meta = (ClampMin = "0"))
+	int32 ChunkPoolMaxSize = 64;
+
+	/** Height resolution of runtime (pooled) chunks. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Performance", meta = (ClampMin = "2"))
+	int32 PooledChunkResolution = 128;
+
+	//--- Startup ---//
+
+	/** Game Thread budget per frame for the chunk init queue (ms). Only whole batches are cut. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Performance", meta = (ClampMin = "0.1"))
+	float StartupBudgetMs = 4.0f;
+
+	/** Chunks dequantized in parallel per batch. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Performance", meta = (ClampMin = "1"))
+	int32 StartupBatchSize = 16;
+
+	/** Frame budgets for collision, GPU upload, grass, streaming and save work. At least one item per category runs each frame. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Performance")
+	FTerraDyneWorkBudgets WorkBudgets;
+
+	//--- Memory Budget ---//
+
+	/** Compress the CPU caches of cold chunks while the TerraDyne footprint is over MemoryBudgetMB. Opt-in. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory")
+	bool bEnableMemoryBudget = false;
+
+	/** Target footprint of all chunks (MB). 0 compresses every cold chunk. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory", meta = (ClampMin = "0.0", EditCondition = "bEnableMemoryBudget"))
+	float MemoryBudgetMB = 256.0f;
+
+	/** A chunk unedited, unrendered and without collision demand for this long (s) is cold. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory", meta = (ClampMin = "1.0", EditCondition = "bEnableMemoryBudget"))
+	float ColdChunkSeconds = 30.0f;
+
+	/** Seconds between budget passes. Passes also rehydrate compressed chunks a viewer is approaching or facing (ahead of edits and collision), and check the alarms. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory", meta = (ClampMin = "0.05"))
+	float MemoryBudgetInterval = 0.25f;
+
+	/** Compressions per pass, to bound the Game Thread cost. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory", meta = (ClampMin = "1", EditCondition = "bEnableMemoryBudget"))
+	int32 MaxCompressionsPerPass = 8;
+
+	/** Total TerraDyne memory (chunks, pooled chunks, save buffers) that raises a Warning alarm (MB). 0 disables. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory", meta = (ClampMin = "0.0"))
+	float MemoryWarningMB = 0.0f;
+
+	/** Total TerraDyne memory that raises a Critical alarm (MB). 0 disables. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory", meta = (ClampMin = "0.0"))
+	float MemoryCriticalMB = 0.0f;
+
+	/** A single chunk above this logs a warning naming it (MB). 0 disables. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Memory", meta = (ClampMin = "0.0"))
+	float ChunkMemoryWarningMB = 0.0f;
+
+	/** Broadcast when the alarm level changes. An alarm clears once the total drops below 90% of its threshold. */
+	UPROPERTY(BlueprintAssignable, Category = "TerraDyne|Memory")
+	FTerraDyneMemoryAlarmDelegate OnMemoryAlarm;
+
+	//--- Rendering ---//
+
+	/**
+	 * Auto runs headless on dedicated servers and -nullrhi processes: chunks keep only CPU heights,
+	 * weights and collision, and never create the visual mesh, render targets or MIDs.
+	 */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Rendering")
+	ETerraDyneRenderMode RenderMode = ETerraDyneRenderMode::Auto;
+
+	//--- Deferred GPU Updates ---//
+
+	/** Brush stamps on chunks outside every view only touch the CPU caches until the chunk is seen. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Rendering")
+	bool bDeferHiddenGPUUpdates = true;
+
+	/** Chunks within this distance (cm) of a player view are updated immediately even when not rendered. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Rendering", meta = (ClampMin = "0.0", EditCondition = "bDeferHiddenGPUUpdates"))
+	float GPUUpdateDistance = 15000.0f;
+
+	/** Seconds since last render that still count as visible. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Rendering", meta = (ClampMin = "0.0", EditCondition = "bDeferHiddenGPUUpdates"))
+	float GPUVisibilityTolerance = 0.2f;
+
+	/** Seconds between checks of the deferred chunks. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Rendering", meta = (ClampMin = "0.01", EditCondition = "bDeferHiddenGPUUpdates"))
+	float GPUFlushInterval = 0.1f;
+
+	//--- Tile Streaming ---//
+
+	/** Chunks whose footprint is within this distance (cm) of a player or physics source stream their tile data in. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "0.0"))
+	float TileStreamingDistance = 30000.0f;
+
+	/** Seconds between streaming updates. 0 disables streaming (chunks keep their placeholders). */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "0.0"))
+	float TileStreamingInterval = 0.25f;
+
+	/** Save slot whose region file (see ATerraDyneChunk::SaveAsync) is streamed in. Empty disables save streaming. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Streaming")
+	FString StreamingSaveSlot;
+
+	/** Cells within this distance (cm) of a source must be final; data arriving later counts as late. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "0.0"))
+	float StreamingArrivalDistance = 5000.0f;
+
+	//--- Prefetch ---//
+
+	/** Seconds of extrapolated travel prefetched ahead of each moving source. 0 = distance-only streaming. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "0.0"))
+	float PrefetchHorizonSeconds = 4.0f;
+
+	/** Half-width (cm) of the corridor prefetched around the predicted path. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "0.0"))
+	float PrefetchCorridorRadius = 10000.0f;
+
+	/** Time constant (s) of the velocity EMA. Larger = steadier but slower to follow turns. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "0.01"))
+	float PrefetchVelocitySmoothing = 0.5f;
+
+	/** Sources slower than this (cm/s) get no path prediction. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "0.0"))
+	float PrefetchMinSpeed = 200.0f;
+
+	/** New loads issued per update, lowest ETA first. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "1"))
+	int32 MaxPrefetchRequestsPerUpdate = 16;
+
+	/** Saved chunk files being read and decompressed on workers at once. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "1"))
+	int32 MaxInFlightSaveLoads = 8;
+
+	//--- Collision LOD ---//
+
+	/**
+	 * Distance bands (cm, from the nearest physics source to the chunk bounds).
+	 * Beyond CollisionLODDistances[i] a chunk drops to LOD i+1; each level halves the grid density.
+	 */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Physics")
+	TArray<float> CollisionLODDistances = { 20000.0f, 50000.0f, 100000.0f };
+
+	/** Dead zone around each band edge so chunks near a boundary don't flip-flop. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Physics", meta = (ClampMin = "0.0"))
+	float CollisionLODHysteresis = 2500.0f;
+
+	/** Seconds between collision evaluations (LOD and lazy streaming). 0 disables both. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Physics", meta = (ClampMin = "0.0"))
+	float CollisionUpdateInterval = 0.5f;
+
+	//--- Lazy Collision ---//
+
+	/**
+	 * Chunks start without collision and only cook it once a pawn, registered physics source,
+	 * simulating body or query region comes within CollisionDemandMargin of their bounds.
+	 * Off by default: unregistered bodies and traces far from any source would find no ground.
+	 */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Physics")
+	bool bLazyCollision = false;
+
+	/** Extra distance (cm) around a chunk's footprint that still counts as "in bounds". */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Physics", meta = (ClampMin = "0.0", EditCondition = "bLazyCollision"))
+	float CollisionDemandMargin = 5000.0f;
+
+	/** Seconds without demand before a chunk's collision is released. 0 keeps it forever. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Physics", meta = (ClampMin = "0.0", EditCondition = "bLazyCollision"))
+	float CollisionIdleTimeout = 10.0f;
+
+	/** Also overlap-test collision-less chunks for unregistered simulating bodies (ECC_PhysicsBody). */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Physics", meta = (EditCondition = "bLazyCollision"))
+	bool bDetectPhysicsBodies = true;
+
+	/** True when chunks should wait for demand instead of cooking collision on creation. */
+	bool UsesLazyCollision() const { return bLazyCollision && CollisionUpdateInterval > 0.0f; }
+
+	//--- Edit Journal ---//
+
+	/**
+	 * Journal time between keyframes (s). Shorter seeks faster. A keyframe only compresses the chunks
+	 * edited since the previous one; the others share its bytes.
+	 */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Journal", meta = (ClampMin = "0.5"))
+	float JournalKeyframeInterval = 10.0f;
+
+	/** Keyframes a recording keeps. Past that, every other one is dropped and the interval doubles. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Journal", meta = (ClampMin = "2"))
+	int32 JournalMaxKeyframes = 64;
+
+	/** Game Thread time per frame a journal replay may spend applying edits (ms). */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Journal", meta = (ClampMin = "0.1"))
+	float JournalReplayBudgetMs = 8.0f;
+
 	//--- Debug/State ---//
 	UPROPERTY(VisibleAnywhere, Category = "TerraDyne|Debug")
 	float GlobalChunkSize;
@@ -48,26 +453,318 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Query")
 	ATerraDyneChunk* GetChunkAtLocation(FVector WorldLocation);
 
+	/** O(1) lookup by grid coordinate. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Query")
+	ATerraDyneChunk* GetChunkAtCoordinate(FIntPoint GridCoord) const;
+
+	/** Batched query: appends every active chunk overlapping the XY bounds (walks the grid page by page). */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Query")
+	void GetChunksInBounds(FBox2D WorldBounds, TArray<ATerraDyneChunk*>& OutChunks) const;
+
+	/** Rebuilds the spatial index from the chunks registered with UTerraDyneSubsystem (no world scan). */
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|System")
 	void RebuildChunkMap();
 
+	//--- Chunk Registry ---//
+
+	/** Inserts a chunk into the spatial index. Called through UTerraDyneSubsystem::RegisterChunk(). */
+	void RegisterChunk(ATerraDyneChunk* Chunk);
+
+	/** Removes a chunk from the spatial index. */
+	void UnregisterChunk(ATerraDyneChunk* Chunk);
+
+	/** Read access to the paged spatial index for cross-chunk kernels. */
+	const FTerraDyneChunkGrid& GetChunkGrid() const { return ChunkGrid; }
+
+	/**
+	 * Synchronously builds full-detail collision for every chunk overlapping the bounds.
+	 * Call before tracing into an area that lazy collision may not have reached yet.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void EnsureCollisionInBounds(FBox2D WorldBounds);
+
+	/** Prefetch hit/late counters of the streaming layer. */
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Stats")
+	const FTerraDyneStreamingStats& GetStreamingStats() const { return StreamingStats; }
+
+	/** Footprint and compression hit/miss counters. */
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Stats")
+	const FTerraDyneMemoryStats& GetMemoryStats() const { return MemoryStats; }
+
+	/** Save and load counts plus buffer pool allocation counters. */
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Stats")
+	FTerraDyneSaveStats GetSaveStats() const;
+
+	/** Logs memory per category and the MaxChunks largest chunks (0 = all). Console: terradyne.MemReport [MaxChunks] */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Stats")
+	void DumpMemoryReport(int32 MaxChunks = 20) const;
+
+	/** Active and pooled chunks plus save buffers, computed now: the Total line of terradyne.MemReport. */
+	int64 GetTotalMemoryBytes() const;
+
+	/** Called by chunks on every cache access. */
+	void RecordCacheAccess(bool bHit) { bHit ? MemoryStats.CacheHits++ : MemoryStats.CacheMisses++; }
+
+	/** Called when a chunk's streamed data lands. NeededTime is when a source first needed it (< 0 = never). */
+	void RecordStreamingArrival(double NeededTime);
+
+	/** Uploads every deferred GPU region regardless of visibility (e.g. before a capture). */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Rendering")
+	void FlushAllGPUUpdates();
+
+	/** Adds a chunk with a deferred GPU region to the flush list. */
+	void QueueGPUFlush(ATerraDyneChunk* Chunk);
+
+	/** True if a point is within GPUUpdateDistance (+ Padding) of any local player view. */
+	bool IsWithinGPUUpdateDistance(const FVector& Location, float Padding) const;
+
+	/** Timings of the level-start init queue. */
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Stats")
+	const FTerraDyneStartupStats& GetStartupStats() const { return StartupStats; }
+
+	/** Converts a world location into the grid coordinate of the chunk covering it. */
+	FIntPoint WorldToGrid(const FVector& WorldLocation) const;
+
+	/**
+	 * Takes a chunk from the pool (spawning only if the pool is empty), re-initializes it
+	 * for the given grid slot and registers it. Returns the registered chunk as is if the slot already has one.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Streaming")
+	ATerraDyneChunk* AcquireChunk(FIntPoint GridCoord);
+
+	/** Unregisters a chunk and parks it in the pool for re-use. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Streaming")
+	void ReleaseChunk(ATerraDyneChunk* Chunk);
+
+	/** Spawns parked chunks until the pool holds at least Count entries. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Streaming")
+	void PrewarmChunkPool(int32 Count);
+
+	//--- Edit Journal (console: terradyne.Journal) ---//
+
+	/** Starts recording every ApplyGlobalBrush() into a new FTerraDyneEditJournal. Recorded edits are quantized before they apply. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Journal")
+	void StartJournalRecording();
+
+	/** Stops recording and writes Saved/TerraDyne/Journals/<Name>.tdj (empty Name = timestamp). Returns the path, empty on failure. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Journal")
+	FString StopJournalRecording(const FString& Name = TEXT(""));
+
+	/**
+	 * Loads a journal, rewinds the chunks it touches to their recorded base state and plays it back.
+	 * Speed is a multiple of real time; 0 applies edits as fast as JournalReplayBudgetMs allows.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Journal")
+	bool StartJournalReplay(const FString& Path, float Speed = 0.0f);
+
+	/** Jumps the loaded replay to a journal time (s): restores the nearest keyframe at or before it, then applies the edits in between. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Journal")
+	void SeekJournalReplay(float Seconds);
+
+	/** Pauses playback; the terrain keeps the state reached so far. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Journal")
+	void StopJournalReplay();
+
+	/** Continues a paused (or sought) replay from its current journal time. False if no journal is loaded or it already ended. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Journal")
+	bool ResumeJournalReplay();
+
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Journal")
+	bool IsRecordingJournal() const { return RecordingJournal.IsValid(); }
+
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Journal")
+	bool IsReplayingJournal() const { return ReplayJournal.IsValid() && bReplayPlaying; }
+
 	//--- Editor/Import API ---//
 #if WITH_EDITOR
+	/**
+	 * Converts every Landscape component into a chunk.
+	 * Heights and the first 4 weight layers are decoded straight from the component textures
+	 * and resampled in parallel; no per-sample traces.
+	 */
 	UFUNCTION(BlueprintCallable, CallInEditor, Category = "TerraDyne|Tools")
 	void ImportFromLandscape(ALandscapeProxy* TargetLandscape, bool bHideSource = true);
-
-	// Helper for resampling
-	void ResampleLandscapeData(ATerraDyneChunk* Chunk, ALandscapeProxy* Source);
 #endif
 
+	virtual void Tick(float DeltaSeconds) override;
+
 protected:
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	// Paged spatial index of the active (non-pooled) chunks
+	FTerraDyneChunkGrid ChunkGrid;
+
+	// Parked chunks, hidden and collision-less, ready for re-use
 	UPROPERTY(Transient)
-	TMap<int64, ATerraDyneChunk*> ActiveChunkMap;
+	TArray<TObjectPtr<ATerraDyneChunk>> ChunkPool;
 
-	int64 GetChunkHash(int32 X, int32 Y) const;
 	void SpawnDefaultSandboxChunk();
+
+	//--- Startup Queue ---//
+
+	// Chunks waiting for their heavy init, nearest to the players first
+	TArray<TWeakObjectPtr<ATerraDyneChunk>> InitQueue;
+	bool bInitQueueNeedsSort = false;
+
+	FTerraDyneStartupStats StartupStats;
+	double StartupBeginTime = 0.0;
+
+	/** Hands a freshly registered chunk's init to the time-sliced queue. */
+	void QueueChunkInit(ATerraDyneChunk* Chunk);
+
+	/** Runs queued inits in parallel batches until the frame budget is spent. */
+	void ProcessInitQueue();
+
+	/** Records time-to-first-playable once no chunk under a player is still queued (after the first batch ran). */
+	void UpdateStartupMilestones();
+
+	/** Picks the LOD band for a distance, biased away from CurrentLOD by the hysteresis. */
+	int32 SelectCollisionLOD(float Distance, int32 CurrentLOD) const;
+
+	/** Timer callback: builds/releases lazy collision on demand and re-evaluates collision LOD. */
+	void UpdateCollisionStreaming();
+
+	/** True if an unregistered simulating body overlaps the chunk footprint (plus margin). */
+	bool HasPhysicsBodyNear(const ATerraDyneChunk* Chunk, float HalfExtent) const;
+
+	FTimerHandle TimerHandle_CollisionStreaming;
+
+	//--- Memory Budget ---//
+
+	/** Timer callback: measures the footprint, compresses the coldest chunks, rehydrates ones coming into view. */
+	void UpdateMemoryBudget();
+
+	/** Rough frustum test against every local player view (cone from the camera FOV). */
+	bool IsInAnyView(const FBox& Bounds) const;
+
+	/** Compares the pass totals against the alarm thresholds and reports level changes. */
+	void UpdateMemoryAlarms();
+
+	/** Pooled chunks keep their RTs and buffers, so every total includes them. */
+	FTerraDyneChunkMemory GetPooledChunkMemory() const;
+
+	bool HasMemoryAlarms() const { return MemoryWarningMB > 0.0f || MemoryCriticalMB > 0.0f || ChunkMemoryWarningMB > 0.0f; }
+
+	FTerraDyneMemoryStats MemoryStats;
+
+	// Chunks currently above ChunkMemoryWarningMB (logged once per crossing)
+	TSet<FIntPoint> ChunksOverMemoryWarning;
+
+	FTimerHandle TimerHandle_MemoryBudget;
+
+	//--- Deferred GPU Updates ---//
+
+	/** Timer callback: flushes deferred chunks that became visible or came close. */
+	void FlushVisibleGPUUpdates();
+
+	// Chunks holding a deferred GPU region
+	TArray<TWeakObjectPtr<ATerraDyneChunk>> GPUDirtyChunks;
+
+	FTimerHandle TimerHandle_GPUFlush;
+
+	//--- Chunk Streaming ---//
+
+	/**
+	 * Timer callback: updates source velocities, then requests tile data and saved chunk files
+	 * for the cells around each source and along its predicted path, lowest ETA first.
+	 */
+	void UpdateChunkStreaming();
+
+	/** Refreshes the velocity EMA of every source. */
+	void UpdateStreamingSources(const TArray<AActor*>& Actors, double Now);
+
+	/** Collects the cells worth loading with their estimated time of arrival (s). */
+	void GatherPrefetchCandidates(TMap<FIntPoint, float>& OutETA) const;
+
+	/** Reads and decompresses a saved chunk file on a worker. */
+	void RequestSavedChunk(FIntPoint Coord);
+
+	/** Game Thread completion of RequestSavedChunk(). */
+	void OnSavedChunkLoaded(FIntPoint Coord, FTerraDyneChunkSnapshot&& Snapshot, bool bLoaded);
+
+	/** World-space XY footprint of a grid cell. */
+	FBox2D GetCellBounds(FIntPoint Coord) const;
+
+	TArray<FTerraDyneStreamingSource> StreamingSources;
+
+	struct FPendingSaveLoad
+	{
+		double NeededTime = -1.0;  // Real time a source first needed it (-1 = not yet)
+		uint32 EditSerial = 0;     // The cell's chunk EditSerial when requested (0 = no chunk yet)
+	};
+
+	// Saved chunk loads in flight
+	TMap<FIntPoint, FPendingSaveLoad> PendingSaveLoads;
+
+	// Shared by every save load job; cancelled (and dropped) on EndPlay
+	FTerraDyneCancellationTokenPtr SaveLoadToken;
+
+	// Cells whose save file was already looked for (found or not). Bounded to live chunks and this update's
+	// prefetch candidates: released chunks and cells nobody approaches any more are probed again next time
+	TSet<FIntPoint> ProbedSaveCells;
+
+	FTerraDyneStreamingStats StreamingStats;
+
+	FTimerHandle TimerHandle_ChunkStreaming;
+
+	/** Spawns a fresh chunk straight into the pool. */
+	ATerraDyneChunk* SpawnPooledChunk();
+
+	//--- Edit Journal ---//
+
+	/** Stores base states of newly touched chunks (and a keyframe when due), then appends the edit. */
+	void RecordJournalEdit(const FTerraDyneJournalEdit& Edit, FIntPoint Min, FIntPoint Max);
+
+	/** Plays edits up to the replay time within JournalReplayBudgetMs. */
+	void TickJournalReplay(float DeltaSeconds);
+
+	/** Applies replay edits with Tick <= TargetTick until Deadline (0 = none). False if the deadline cut it short. */
+	bool ApplyJournalEditsUntil(double TargetTick, double Deadline);
+
+	/**
+	 * Puts every chunk the replay touches back to its state at the keyframe for Tick and returns the cursor there.
+	 * Chunks not registered right now get their state when they register (edits replayed meanwhile miss them).
+	 */
+	FTerraDyneEditJournal::FCursor RestoreJournalKeyframe(uint32 Tick);
+
+	/**
+	 * Chunk -> chunk file image, as stored in journals. Copies the caches now and compresses on the
+	 * worker pool (JournalJobs); the returned bytes are only complete once those jobs are done.
+	 */
+	FTerraDyneEditJournal::FChunkState CaptureChunkState(ATerraDyneChunk* Chunk);
+
+	/** Chunk file image -> chunk, now if it is registered, otherwise when it registers. */
+	void RestoreChunkState(FIntPoint Coord, const FTerraDyneEditJournal::FChunkState& State);
+
+	TUniquePtr<FTerraDyneEditJournal> RecordingJournal;
+	double JournalRecordStartTime = 0.0;
+	uint32 LastJournalKeyframeTick = 0;
+	uint32 JournalKeyframeIntervalScale = 1;  // Doubles every time the keyframes get thinned
+
+	// Chunks edited since the last keyframe, and the states of those that unregistered meanwhile
+	TSet<FIntPoint> JournalDirtyChunks;
+	TMap<FIntPoint, FTerraDyneEditJournal::FChunkState> JournalParkedStates;
+
+	// Compression jobs of CaptureChunkState()
+	FTerraDyneJobGroupPtr JournalJobs;
+
+	// Replay states of chunks that were not registered when their keyframe was restored
+	TMap<FIntPoint, FTerraDyneEditJournal::FChunkState> PendingJournalRestores;
+
+	TUniquePtr<FTerraDyneEditJournal> ReplayJournal;
+	FTerraDyneEditJournal::FCursor ReplayCursor;
+	double ReplayTick = 0.0;           // Journal time reached, in (fractional) ticks
+	double ReplayWallStartTime = 0.0;
+	float ReplaySpeed = 0.0f;
+	bool bReplayPlaying = false;
+	bool bApplyingJournalEdit = false; // Replayed edits are not recorded again
+
+	/**
+	 * Pushes the Manager's materials onto a chunk.
+	 * With bOverride false, materials the chunk already has (e.g. set in the level) are kept.
+	 */
+	void InjectMaterials(ATerraDyneChunk* Chunk, bool bOverride = true) const;
 };
\ No newline at end of file
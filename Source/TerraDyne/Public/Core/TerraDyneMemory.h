@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// NOTE: No .generated.h include because this header only declares LLM tags and raw C++ types.
+
+//--- Low Level Memory Tracker (-llm, stat LLM, LLM in Unreal Insights) ---//
+
+LLM_DECLARE_TAG_API(TerraDyne, TERRADYNE_API);
+LLM_DECLARE_TAG_API(TerraDyne_Caches, TERRADYNE_API);        // Height/weight caches and their compressed blobs
+LLM_DECLARE_TAG_API(TerraDyne_RenderTargets, TERRADYNE_API); // CPU side of HeightRT / WeightRT (GPU memory is tracked by the RHI)
+LLM_DECLARE_TAG_API(TerraDyne_Collision, TERRADYNE_API);     // Heightfield mesh builds and cooked collision
+LLM_DECLARE_TAG_API(TerraDyne_Grass, TERRADYNE_API);         // Grass generation and instances
+LLM_DECLARE_TAG_API(TerraDyne_Save, TERRADYNE_API);          // Snapshots, serialization scratch and the save buffer pools
+
+/** Tags every allocation in the current scope, e.g. TERRADYNE_LLM_SCOPE(Collision). */
+#define TERRADYNE_LLM_SCOPE(Category) LLM_SCOPE_BYTAG(TerraDyne_##Category)
+
+/** Runtime memory categories of one chunk. */
+enum class ETerraDyneMemoryCategory : uint8
+{
+	Caches,          // Resident HeightCache + WeightCache
+	Compressed,      // LZ4 blob of a cold chunk
+	RenderTargets,   // HeightRT + WeightRT
+	CollisionMesh,   // Dynamic mesh topology of the physics component
+	CookedCollision, // Body setup (cooked trimesh)
+	Grass,           // Grass instances owned by the chunk
+	Num
+};
+
+/**
+ * FTerraDyneChunkMemory
+ *
+ * Per-category byte counts of one chunk (or the sum of several).
+ * Filled by ATerraDyneChunk::GetMemoryBreakdown(); printed by terradyne.MemReport.
+ */
+struct FTerraDyneChunkMemory
+{
+	int64 Bytes[(int32)ETerraDyneMemoryCategory::Num] = {};
+
+	int64& operator[](ETerraDyneMemoryCategory Category) { return Bytes[(int32)Category]; }
+	int64 operator[](ETerraDyneMemoryCategory Category) const { return Bytes[(int32)Category]; }
+
+	int64 GetTotal() const
+	{
+		int64 Total = 0;
+		for (int64 Value : Bytes)
+		{
+			Total += Value;
+		}
+		return Total;
+	}
+
+	FTerraDyneChunkMemory& operator+=(const FTerraDyneChunkMemory& Other)
+	{
+		for (int32 i = 0; i < (int32)ETerraDyneMemoryCategory::Num; i++)
+		{
+			Bytes[i] += Other.Bytes[i];
+		}
+		return *this;
+	}
+
+	static const TCHAR* GetCategoryName(ETerraDyneMemoryCategory Category)
+	{
+		switch (Category)
+		{
+		case ETerraDyneMemoryCategory::Caches:          return TEXT("Caches");
+		case ETerraDyneMemoryCategory::Compressed:      return TEXT("Compressed");
+		case ETerraDyneMemoryCategory::RenderTargets:   return TEXT("RenderTargets");
+		case ETerraDyneMemoryCategory::CollisionMesh:   return TEXT("CollisionMesh");
+		case ETerraDyneMemoryCategory::CookedCollision: return TEXT("CookedCollision");
+		case ETerraDyneMemoryCategory::Grass:           return TEXT("Grass");
+		default:                                        return TEXT("Unknown");
+		}
+	}
+};
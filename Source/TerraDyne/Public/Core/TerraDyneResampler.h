@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FTerraDyneResampler
+ *
+ * Stateless SIMD kernels used to bring source grids (Landscape components, tile assets)
+ * onto a chunk's square height/weight grid. Thin engine-typed wrappers over the
+ * TerraDyneCore kernels, which are benchmarked standalone in Tools/TerraDyneCore.
+ *
+ * Grids are row-major. Corners map to corners: Src(0,0) -> Dst(0,0), Src(W-1,H-1) -> Dst(Res-1,Res-1).
+ * All functions are pure and thread-safe, so callers may run them inside ParallelFor.
+ */
+class TERRADYNE_API FTerraDyneResampler
+{
+public:
+	/**
+	 * Bilinear resample of a float grid. Processes 4 output samples per iteration.
+	 *
+	 * @param Src         Source samples (SrcWidth * SrcHeight).
+	 * @param SrcWidth    Source width (>= 1).
+	 * @param SrcHeight   Source height (>= 1).
+	 * @param Dst         Output buffer (DstRes * DstRes).
+	 * @param DstRes      Output resolution (>= 2).
+	 */
+	static void ResampleBilinear(const float* Src, int32 SrcWidth, int32 SrcHeight, float* Dst, int32 DstRes);
+
+	/**
+	 * Bilinear resample of an 8-bit RGBA grid. Each texel is one 4-wide vector, so all
+	 * channels are filtered in a single pass.
+	 */
+	static void ResampleBilinear(const FColor* Src, int32 SrcWidth, int32 SrcHeight, FColor* Dst, int32 DstRes);
+};
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+#include <atomic>
+
+// NOTE: No .generated.h include because this header only declares stats.
+
+//--- Stat Group (stat TerraDyne) ---//
+
+DECLARE_STATS_GROUP(TEXT("TerraDyne"), STATGROUP_TerraDyne, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Brush Kernel"), STAT_TerraDyne_BrushKernel, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Physics Sync"), STAT_TerraDyne_PhysicsSync, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Collision Mesh Build"), STAT_TerraDyne_CollisionBuild, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Collision Cook"), STAT_TerraDyne_CollisionCook, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("RT Draw / Upload"), STAT_TerraDyne_RTDraw, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serialization"), STAT_TerraDyne_Serialization, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Compression"), STAT_TerraDyne_Compression, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Grass"), STAT_TerraDyne_Grass, STATGROUP_TerraDyne, TERRADYNE_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Edits"), STAT_TerraDyne_Edits, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dirty Chunks"), STAT_TerraDyne_DirtyChunks, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cooked Sections"), STAT_TerraDyne_CookedSections, STATGROUP_TerraDyne, TERRADYNE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bytes Saved"), STAT_TerraDyne_BytesSaved, STATGROUP_TerraDyne, TERRADYNE_API);
+
+//--- CSV Profiler (-csvCategories=TerraDyne) ---//
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TERRADYNE_API, TerraDyne);
+
+//--- Unreal Insights (-trace=cpu,TerraDyne) ---//
+
+UE_TRACE_CHANNEL_EXTERN(TerraDyneChannel, TERRADYNE_API);
+
+/** Cycle stat plus a CPU trace scope on the TerraDyne channel. Usable on any thread. */
+#define TERRADYNE_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, TerraDyneChannel)
+
+/**
+ * FTerraDyneFrameCounters
+ *
+ * Per-frame totals, bumped from any thread and published once per frame by UTerraDyneSubsystem::Tick()
+ * as both counter stats and CSV stats.
+ */
+class TERRADYNE_API FTerraDyneFrameCounters
+{
+public:
+	static void AddEdit() { Edits.fetch_add(1, std::memory_order_relaxed); }
+	static void AddDirtyChunk() { DirtyChunks.fetch_add(1, std::memory_order_relaxed); }
+	static void AddCookedSection() { CookedSections.fetch_add(1, std::memory_order_relaxed); }
+	static void AddBytesSaved(int64 Bytes) { BytesSaved.fetch_add(Bytes, std::memory_order_relaxed); }
+
+	/** Emits this frame's totals and resets them. Only the first caller per frame publishes. */
+	static void Publish();
+
+private:
+	static std::atomic<int32> Edits;
+	static std::atomic<int32> DirtyChunks;
+	static std::atomic<int32> CookedSections;
+	static std::atomic<int64> BytesSaved;
+	static uint64 LastPublishedFrame;
+};
@@ -2,23 +2,67 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Core/TerraDyneWorkScheduler.h"
 #include "TerraDyneSubsystem.generated.h"
 
 // Forward Declarations
 class ATerraDyneManager;
+class ATerraDyneChunk;
 class FTerraDyneGrassSystem; 
 
+/** Whether chunks allocate render resources (visual mesh, render targets, MIDs). */
+UENUM(BlueprintType)
+enum class ETerraDyneRenderMode : uint8
+{
+	/** Headless on dedicated servers and -nullrhi / no-render processes. */
+	Auto,
+	/** Always allocate render resources. */
+	Rendered,
+	/** CPU heights, weights and collision only. */
+	Headless
+};
+
+/** One coalesced region of terrain that changed during a frame. */
+USTRUCT(BlueprintType)
+struct FTerraDyneTerrainChange
+{
+	GENERATED_BODY()
+
+	/** World-space XY rectangle covering every changed texel. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne")
+	FBox2D Bounds = FBox2D(ForceInit);
+
+	/** Largest absolute height change of any texel inside Bounds (0 for paint-only changes). */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne")
+	float MaxHeightDelta = 0.0f;
+
+	/** True if layer weights (paint) changed inside Bounds. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne")
+	bool bWeightsChanged = false;
+};
+
+/** Native terrain change callback; the view is only valid during the call. */
+DECLARE_DELEGATE_OneParam(FTerraDyneTerrainChangedDelegate, TConstArrayView<FTerraDyneTerrainChange>);
+
+/** Blueprint terrain change callback. */
+DECLARE_DYNAMIC_DELEGATE_OneParam(FTerraDyneTerrainChangedDynamic, const TArray<FTerraDyneTerrainChange>&, Changes);
+
 /**
  * UTerraDyneSubsystem
  * 
  * The central lifecycle registry for the TerraDyne plugin within a specific World.
  * Functions:
  * 1. Caches the active Terrain Manager for global O(1) access.
- * 2. Owns the Grass Generation Scheduler (Shared pointer) to prevent GC issues.
- * 3. Tracks background IO tasks to ensure data safety on World Teardown.
+ * 2. Keeps the registry of live chunks and forwards them to the Manager's spatial index.
+ * 3. Tracks physics sources and query regions that drive collision LOD and lazy collision.
+ * 4. Owns the Grass Generation Scheduler (Shared pointer) to prevent GC issues.
+ * 5. Tracks background IO tasks to ensure data safety on World Teardown.
+ * 6. Decides whether chunks run headless (no render resources).
+ * 7. Ticks the frame-budgeted work scheduler that all chunk Game Thread work goes through.
+ * 8. Coalesces terrain changes and delivers them once per frame to area-filtered subscribers.
  */
 UCLASS()
-class TERRADYNE_API UTerraDyneSubsystem : public UWorldSubsystem
+class TERRADYNE_API UTerraDyneSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
@@ -27,8 +71,10 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 	
-	// Called by the engine when the world ticks (if we need global time slicing)
-	// virtual void Tick(float DeltaTime) override; // Uncomment if inheriting FTickableGameObject
+	// Runs the work scheduler within the Manager's budgets
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickableInEditor() const override { return true; }
 
 	//--- Manager Registry ---//
 
@@ -48,6 +94,107 @@ public:
 	UFUNCTION(BlueprintPure, Category = "TerraDyne")
 	ATerraDyneManager* GetTerrainManager() const;
 
+	//--- Chunk Registry ---//
+
+	/**
+	 * Called by ATerraDyneChunk::BeginPlay().
+	 * Chunks that arrive before the Manager are kept here and indexed when it registers.
+	 */
+	void RegisterChunk(ATerraDyneChunk* InChunk);
+
+	/** Called by ATerraDyneChunk::EndPlay() */
+	void UnregisterChunk(ATerraDyneChunk* InChunk);
+
+	/** All live chunks in this world (including pooled ones). */
+	const TArray<TObjectPtr<ATerraDyneChunk>>& GetRegisteredChunks() const { return RegisteredChunks; }
+
+	//--- Physics Sources ---//
+
+	/**
+	 * Registers an actor whose proximity should keep nearby chunks at full collision detail
+	 * (vehicles, AI, physics props). Player pawns are always considered and need no registration.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void RegisterPhysicsSource(AActor* Source);
+
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void UnregisterPhysicsSource(AActor* Source);
+
+	/** Appends all registered sources and player pawns. */
+	void GatherPhysicsSources(TArray<AActor*>& OutSources) const;
+
+	/** Appends the locations of all registered sources and player pawns. */
+	void GatherPhysicsSourceLocations(TArray<FVector>& OutLocations) const;
+
+	/**
+	 * Keeps collision alive inside a world box (e.g. an AI nav area or a scripted trace volume)
+	 * while lazy collision is enabled on the Manager.
+	 * @return Handle for RemoveCollisionQueryRegion().
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	int32 AddCollisionQueryRegion(FBox WorldBounds);
+
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void RemoveCollisionQueryRegion(int32 Handle);
+
+	/** Appends every active query region. */
+	void GatherCollisionQueryRegions(TArray<FBox>& OutRegions) const;
+
+	//--- Work Scheduler ---//
+
+	/**
+	 * Queues Game Thread work under a category budget (see FTerraDyneWorkScheduler).
+	 * Key (usually the owning chunk) coalesces repeated requests; Delay debounces them.
+	 */
+	void EnqueueWork(ETerraDyneWorkCategory Category, const void* Key, const FVector& Location, TUniqueFunction<void()>&& Work, double Delay = 0.0)
+	{
+		WorkScheduler.Enqueue(Category, Key, Location, MoveTemp(Work), Delay);
+	}
+
+	/** Drops all queued work of an owner. Called by chunks on EndPlay and when pooled. */
+	void CancelWork(const void* Key) { WorkScheduler.CancelAll(Key); }
+
+	const FTerraDyneWorkScheduler& GetWorkScheduler() const { return WorkScheduler; }
+
+	/** Appends local view points, or pawn locations for remote players (dedicated servers). */
+	void GatherViewerLocations(TArray<FVector>& OutLocations) const;
+
+	//--- Terrain Change Events ---//
+
+	/**
+	 * Subscribes to terrain changes inside a world XY area (an invalid box means everywhere).
+	 * Changes are merged per frame and delivered from the subsystem tick; only the ones intersecting
+	 * Area are passed, so subscribers never need to rescan the world.
+	 * @return Handle for UnsubscribeTerrainChanges() / SetTerrainChangeArea().
+	 */
+	int32 SubscribeTerrainChanges(const FBox2D& Area, FTerraDyneTerrainChangedDelegate&& Callback);
+
+	/** Blueprint version of SubscribeTerrainChanges(). Unbound callbacks are dropped automatically. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Events", meta = (DisplayName = "Subscribe Terrain Changes"))
+	int32 SubscribeTerrainChangesBP(FBox2D Area, FTerraDyneTerrainChangedDynamic Callback);
+
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Events")
+	void UnsubscribeTerrainChanges(int32 Handle);
+
+	/** Moves a subscription's area (e.g. a cover system following its squad). */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Events")
+	void SetTerrainChangeArea(int32 Handle, FBox2D Area);
+
+	/** Called by chunks after each edit; merged with overlapping changes until the next dispatch. */
+	void ReportTerrainChange(const FTerraDyneTerrainChange& Change);
+
+	//--- Render Mode ---//
+
+	/**
+	 * True if chunks should skip every render resource and GPU draw.
+	 * Resolution order: the Manager's RenderMode, then the terradyne.Headless CVar, then auto-detection.
+	 */
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Rendering")
+	bool IsHeadless() const;
+
+	/** Set by ATerraDyneManager::PostInitializeComponents(), before any chunk begins play. */
+	void SetRenderModeOverride(ETerraDyneRenderMode InMode) { RenderModeOverride = InMode; }
+
 	//--- Grass System Access ---//
 
 	/** 
@@ -66,10 +213,42 @@ public:
 	void FlushPendingTasks();
 
 private:
+	/** Delivers this frame's coalesced changes to each subscriber whose area they touch. */
+	void DispatchTerrainChanges();
+
+	struct FTerrainChangeSubscriber
+	{
+		int32 Handle = 0;
+		FBox2D Area = FBox2D(ForceInit);
+		FTerraDyneTerrainChangedDelegate Native;
+		FTerraDyneTerrainChangedDynamic Dynamic;
+	};
+
 	// Weak pointer avoids keeping the actor alive if the level is unloaded violently
 	UPROPERTY(Transient)
 	TWeakObjectPtr<ATerraDyneManager> ActiveManager;
 
+	// Every chunk that has begun play in this world
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<ATerraDyneChunk>> RegisteredChunks;
+
+	// Actors registered via RegisterPhysicsSource()
+	TArray<TWeakObjectPtr<AActor>> PhysicsSources;
+
+	// Boxes registered via AddCollisionQueryRegion(), keyed by handle
+	TMap<int32, FBox> CollisionQueryRegions;
+	int32 NextQueryRegionHandle = 1;
+
+	ETerraDyneRenderMode RenderModeOverride = ETerraDyneRenderMode::Auto;
+
+	FTerraDyneWorkScheduler WorkScheduler;
+
+	// Changes reported since the last dispatch, merged wherever their bounds touch
+	TArray<FTerraDyneTerrainChange> PendingTerrainChanges;
+
+	TArray<FTerrainChangeSubscriber> TerrainChangeSubscribers;
+	int32 NextTerrainChangeHandle = 1;
+
 	// The background scheduler for vegetation. 
 	// Stored as a SharedPtr because it is a non-UObject C++ class.
 	TSharedPtr<FTerraDyneGrassSystem> GrassSystem;
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+/** Budget buckets of the Game Thread work scheduler. */
+enum class ETerraDyneWorkCategory : uint8
+{
+	Collision,
+	GPUUpload,
+	Grass,
+	Streaming,
+	Save,
+
+	Num
+};
+
+/**
+ * FTerraDyneWorkScheduler
+ *
+ * Central dirty list for the Game Thread side of TerraDyne work (collision cooks, RT uploads,
+ * grass requests, streamed data commits, save launches). Owned and ticked by UTerraDyneSubsystem.
+ *
+ * Each category runs its ready items nearest-viewer first until its millisecond budget is spent;
+ * the rest carries over to the next frame. At least one item runs per category per tick, and items
+ * older than the starvation limit jump the queue, so distant work always finishes eventually.
+ *
+ * Items are keyed per category: enqueuing an existing key replaces its work, location and ready
+ * time but keeps its age, so repeated edits to one chunk coalesce into a single run.
+ */
+class TERRADYNE_API FTerraDyneWorkScheduler
+{
+public:
+	static constexpr int32 NumCategories = (int32)ETerraDyneWorkCategory::Num;
+
+	/** Per-category counters (reset by ResetStats()). */
+	struct FCategoryStats
+	{
+		int32 Executed = 0;
+		int32 Coalesced = 0;
+		int32 CarriedOver = 0;
+		float LastMs = 0.0f;
+		float PeakMs = 0.0f;
+	};
+
+	/**
+	 * Queues (or coalesces) a work item.
+	 * @param Key      Identity for coalescing (usually the owning chunk). Null never coalesces.
+	 * @param Location World position used for viewer-distance priority.
+	 * @param Delay    Seconds before the item becomes ready (re-enqueuing restarts it, like a debounce).
+	 */
+	void Enqueue(ETerraDyneWorkCategory Category, const void* Key, const FVector& Location, TUniqueFunction<void()>&& Work, double Delay = 0.0);
+
+	/** Drops every item queued under Key in any category (owner destroyed or pooled), including items a running Tick()/Drain() already took out. */
+	void CancelAll(const void* Key);
+
+	/** True if Key has an item waiting in Category. */
+	bool IsQueued(ETerraDyneWorkCategory Category, const void* Key) const
+	{
+		return Queues[(int32)Category].KeyToIndex.Contains(Key);
+	}
+
+	/**
+	 * Runs ready work within the budgets.
+	 * @param Viewers           World positions the priority is measured against (may be empty).
+	 * @param BudgetsMs         NumCategories budgets in milliseconds.
+	 * @param StarvationSeconds Items waiting longer than this run before any nearer item.
+	 */
+	void Tick(TConstArrayView<FVector> Viewers, TConstArrayView<float> BudgetsMs, float StarvationSeconds);
+
+	/** Runs everything queued in Category now, ready or not (e.g. saves before teardown). */
+	void Drain(ETerraDyneWorkCategory Category);
+
+	void Reset();
+
+	int32 Num(ETerraDyneWorkCategory Category) const { return Queues[(int32)Category].Items.Num(); }
+	bool IsEmpty() const;
+
+	const FCategoryStats& GetStats(ETerraDyneWorkCategory Category) const { return Stats[(int32)Category]; }
+	void ResetStats();
+
+	static const TCHAR* GetCategoryName(ETerraDyneWorkCategory Category);
+
+private:
+	struct FItem
+	{
+		const void* Key = nullptr;
+		FVector Location = FVector::ZeroVector;
+		TUniqueFunction<void()> Work;
+		double EnqueueTime = 0.0;
+		double ReadyTime = 0.0;
+		double Priority = 0.0;
+		bool bCancelled = false;
+	};
+
+	struct FQueue
+	{
+		TArray<FItem> Items;
+		TMap<const void*, int32> KeyToIndex;
+
+		void RebuildIndex();
+	};
+
+	/** Puts an item that was taken out for a tick back, merging with a newer one under the same key. */
+	static void Requeue(FQueue& Queue, FItem&& Item);
+
+	FQueue Queues[NumCategories];
+
+	// Batches taken out of their queue by the running Tick()/Drain() (work may Drain() from inside a Tick()),
+	// so CancelAll() can still reach them
+	TArray<TArray<FItem>*, TInlineAllocator<2>> InFlight;
+	FCategoryStats Stats[NumCategories];
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+class FQueuedThreadPool;
+class FEvent;
+
+/** Priority classes of TerraDyne background jobs, highest first. */
+enum class ETerraDyneJobPriority : uint8
+{
+	Interactive, // Edit-driven collision builds
+	Streaming,   // Tile decodes, saved chunk loads
+	Grass,
+	Save
+};
+
+/**
+ * FTerraDyneCancellationToken
+ *
+ * Shared flag between whoever launched a job and the job itself.
+ * Queued jobs whose token is cancelled are skipped; running jobs poll IsCancelled() between steps.
+ */
+class FTerraDyneCancellationToken
+{
+public:
+	void Cancel() { bCancelled.store(true, std::memory_order_relaxed); }
+	bool IsCancelled() const { return bCancelled.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<bool> bCancelled { false };
+};
+
+using FTerraDyneCancellationTokenPtr = TSharedPtr<FTerraDyneCancellationToken, ESPMode::ThreadSafe>;
+
+/**
+ * FTerraDyneJobGroup
+ *
+ * Counts the jobs one owner launched into it (see FTerraDyneWorkerPool::Launch()), so that owner can
+ * wait for just its own jobs. Wait() blocks on an event. Shared with the jobs, so it may be released
+ * while they are still in flight.
+ */
+class TERRADYNE_API FTerraDyneJobGroup
+{
+public:
+	FTerraDyneJobGroup();
+	~FTerraDyneJobGroup();
+
+	FTerraDyneJobGroup(const FTerraDyneJobGroup&) = delete;
+	FTerraDyneJobGroup& operator=(const FTerraDyneJobGroup&) = delete;
+
+	/** Blocks until every job of the group has finished (cancelled ones finish immediately). */
+	void Wait() const;
+
+	int32 GetNumOutstanding() const { return NumOutstanding.load(); }
+
+private:
+	friend class FTerraDyneWorkerPool;
+	friend class FTerraDyneJob;
+
+	void Add();
+	void Done();
+
+	mutable FCriticalSection Mutex; // Keeps the count and the event in step
+	std::atomic<int32> NumOutstanding { 0 };
+	FEvent* Idle = nullptr; // Manual reset; triggered while nothing is outstanding
+};
+
+using FTerraDyneJobGroupPtr = TSharedPtr<FTerraDyneJobGroup, ESPMode::ThreadSafe>;
+
+/**
+ * FTerraDyneWorkerPool
+ *
+ * Process-wide thread pool owned by TerraDyne, so terrain jobs and engine jobs don't starve each
+ * other on the global pool during heavy bombardment. Jobs are queued by priority class.
+ *
+ * Thread count comes from terradyne.WorkerThreads, read when the pool is first used.
+ * The module shuts the pool down; UTerraDyneSubsystem::FlushPendingTasks() waits on it.
+ */
+class TERRADYNE_API FTerraDyneWorkerPool
+{
+public:
+	using FJobFunction = TUniqueFunction<void(const FTerraDyneCancellationToken&)>;
+
+	/** Returns the pool, creating it on first use. */
+	static FTerraDyneWorkerPool& Get();
+
+	/** Waits for outstanding jobs and destroys the threads. Called from FTerraDyneModule::ShutdownModule(). */
+	static void Shutdown();
+
+	/**
+	 * Queues a job. Runs inline when the platform has no threads.
+	 * @param Token  Optional token to share between jobs (e.g. one per chunk); a fresh one is made otherwise.
+	 * @param Group  Optional group counting the job until it finishes.
+	 * @return The token controlling this job.
+	 */
+	FTerraDyneCancellationTokenPtr Launch(ETerraDyneJobPriority Priority, FJobFunction&& Work, FTerraDyneCancellationTokenPtr Token = nullptr, FTerraDyneJobGroupPtr Group = nullptr);
+
+	/** Blocks until every queued and running job has finished (cancelled ones finish immediately). */
+	void WaitForAll() const { AllJobs.Wait(); }
+
+	int32 GetNumOutstanding() const { return AllJobs.GetNumOutstanding(); }
+	int32 GetNumThreads() const { return NumThreads; }
+
+	~FTerraDyneWorkerPool();
+
+private:
+	FTerraDyneWorkerPool();
+
+	friend class FTerraDyneJob;
+	void OnJobFinished() { AllJobs.Done(); }
+
+	FQueuedThreadPool* Pool = nullptr;
+	int32 NumThreads = 0;
+	FTerraDyneJobGroup AllJobs; // Every job, whatever group it also belongs to
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Grass/TerraDyneGrassTypes.h"
+#include "Core/TerraDyneWorkerPool.h"
 
 // NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
 
@@ -21,8 +22,10 @@ public:
 	/**
 	 * Called by Chunks when their data changes (Digging).
 	 * Queues a regeneration task for the specific bounds.
+	 * OnFinished runs on the Game Thread once the task is done: true if it regenerated, false if it was
+	 * cancelled or dropped first.
 	 */
-	void RequestRegen(const FBox& WorldBounds);
+	void RequestRegen(const FBox& WorldBounds, TUniqueFunction<void(bool)>&& OnFinished = nullptr);
 
 	/**
 	 * Emergency stop for all tasks (e.g. Level Unload).
@@ -32,4 +35,7 @@ public:
 private:
 	// World reference for line traces / spawning
 	TWeakObjectPtr<UWorld> WorldRef;
+
+	// Shared by the tasks launched since the last CancelAllTasks()
+	FTerraDyneCancellationTokenPtr TaskToken;
 };
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "CoreMinimal.h"
 #include "Async/AsyncWork.h"
+#include "IO/TerraDyneBufferPool.h"
+#include "IO/TerraDyneRegionFile.h"
 
 /**
  * FTerraDyneChunkSnapshot
@@ -23,22 +25,45 @@ struct FTerraDyneChunkSnapshot
 	// Metadata
 	int32 Resolution;
 	float RealWorldSize;
+
+	// Delta against the baked tile (save format v2). When BaseHash is set, only the cells inside
+	// DeltaBlocks (FChunkCodec::DeltaBlockSize blocks) are meaningful; the rest equals the base.
+	uint64 BaseHash = 0;
+	TArray<int32> DeltaBlocks;
+
+	// Set on a loaded v2 save: HeightData/WeightData hold only the DeltaBlocks' cells, packed as
+	// FChunkCodec::UnpackDeltaBlocks() lays them out, instead of full Resolution^2 grids.
+	bool bPackedDelta = false;
 	
 	// Empty check
 	bool IsValid() const 
 	{ 
 		return HeightData.Num() > 0; 
 	}
+
+	/** Bytes held by the payload arrays. */
+	int64 GetAllocatedSize() const
+	{
+		return HeightData.GetAllocatedSize() + WeightData.GetAllocatedSize() + DeltaBlocks.GetAllocatedSize();
+	}
+
+	/** Hands the payload arrays back to FTerraDyneSaveBuffers (after a save, or a load nobody wanted). */
+	void ReturnBuffers()
+	{
+		FTerraDyneSaveBuffers::Heights().Release(MoveTemp(HeightData));
+		FTerraDyneSaveBuffers::Weights().Release(MoveTemp(WeightData));
+	}
 };
 
 /**
  * FTerraDyneAsyncSaver
  * 
- * The worker class for FAutoDeleteAsyncTask.
- * Performs ZLib compression and file writing.
+ * The worker class for saves. Runs on the TerraDyne worker pool at Save priority.
+ * Performs ZLib compression and file writing, either to a loose file or appended to a slot's region file.
  * 
  * Usage:
- * (new FAutoDeleteAsyncTask<FTerraDyneAsyncSaver>(Snapshot, FilePath))->StartBackgroundTask();
+ * FTerraDyneWorkerPool::Get().Launch(ETerraDyneJobPriority::Save,
+ *     [Saver = FTerraDyneAsyncSaver(MoveTemp(Snapshot), FTerraDyneRegionFile::Get(SlotName))](const FTerraDyneCancellationToken&) mutable { Saver.DoWork(); });
  */
 class TERRADYNE_API FTerraDyneAsyncSaver : public FNonAbandonableTask
 {
@@ -48,6 +73,24 @@ public:
 	FTerraDyneAsyncSaver(const FTerraDyneChunkSnapshot& InSnapshot, const FString& InFilePath)
 		: Snapshot(InSnapshot)
 		, FilePath(InFilePath)
+		, InFlight(Snapshot.GetAllocatedSize())
+	{
+	}
+
+	/** Takes over the snapshot's (pooled) arrays instead of copying them. */
+	FTerraDyneAsyncSaver(FTerraDyneChunkSnapshot&& InSnapshot, const FString& InFilePath)
+		: Snapshot(MoveTemp(InSnapshot))
+		, FilePath(InFilePath)
+		, InFlight(Snapshot.GetAllocatedSize())
+	{
+	}
+
+	/** Appends to a region file instead; construct on the Game Thread, so the index waits for this write. */
+	FTerraDyneAsyncSaver(FTerraDyneChunkSnapshot&& InSnapshot, const TSharedRef<FTerraDyneRegionFile>& InRegion)
+		: Snapshot(MoveTemp(InSnapshot))
+		, Region(InRegion)
+		, RegionWrite(FTerraDyneRegionFile::BeginWrite(InRegion))
+		, InFlight(Snapshot.GetAllocatedSize())
 	{
 	}
 
@@ -55,10 +98,14 @@ public:
 	 * The Heavy Lifting.
 	 * 1. Serializes Snapshot to binary buffer.
 	 * 2. Compresses buffer using Zlib.
-	 * 3. Writes File to Disk.
+	 * 3. Writes File to Disk (or appends the frame to the region file).
+	 * All scratch comes from FTerraDyneSaveBuffers, and the snapshot arrays go back there afterwards.
 	 */
 	void DoWork();
 
+	/** True once DoWork() has written the file. */
+	bool WasWritten() const { return bWritten; }
+
 	/** Thread Stat ID for profiling */
 	FORCEINLINE TStatId GetStatId() const
 	{
@@ -68,16 +115,34 @@ public:
 private:
 	FTerraDyneChunkSnapshot Snapshot;
 	FString FilePath;
+	TSharedPtr<FTerraDyneRegionFile> Region;
+	FTerraDyneRegionFile::FWriteScope RegionWrite;
+	bool bWritten = false;
+
+	// Counted in FTerraDyneSaveBuffers::GetInFlightBytes() until DoWork() returns the buffers (or the job is dropped)
+	FTerraDyneSaveBuffers::FInFlightScope InFlight;
 };
 
 /**
- * UTerraDyneIOSubsystem
+ * FTerraDyneIOPaths
  * 
- * Optional helper statics for Path Management.
+ * The one place save locations are derived from: Saved/TerraDyne/<Slot>/...
  */
 class TERRADYNE_API FTerraDyneIOPaths
 {
 public:
 	static FString GetSaveSlotPath(FString SlotName);
+
+	/** Loose chunk file name inside a slot folder (exports, benchmarks). */
 	static FString GetChunkFilename(FIntPoint Coord);
+
+	/** The region file holding every chunk of a slot (see FTerraDyneRegionFile). */
+	static FString GetRegionFilePath(const FString& SlotName);
+
+	/** Folder of the loose Chk_X_Y.bin saves written before region files (Saved/<Slot>/). */
+	static FString GetLegacySlotPath(const FString& SlotName);
+
+	/** Wildcard and parser for those legacy file names. */
+	static const TCHAR* GetLegacyChunkWildcard() { return TEXT("Chk_*.bin"); }
+	static bool ParseLegacyChunkFilename(const FString& Filename, FIntPoint& OutCoord);
 };
\ No newline at end of file
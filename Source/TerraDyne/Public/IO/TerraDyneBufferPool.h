@@ -0,0 +1,201 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "Core/TerraDyneMemory.h"
+#include <atomic>
+
+// NOTE: No .generated.h include because these are raw C++ classes, not UObjects.
+
+/** Counters of one buffer pool (or all save pools summed). */
+struct FTerraDyneBufferPoolStats
+{
+	int64 Acquires = 0;
+	int64 Reuses = 0;      // Served from a free list
+	int64 Allocations = 0; // Had to hit the heap
+	int64 Discards = 0;    // Released while the size class was full
+	int64 PooledBytes = 0; // Held by free lists right now
+};
+
+/**
+ * TTerraDyneBufferPool
+ *
+ * Thread-safe free lists of TArray<T> in power-of-two size classes.
+ * Acquire() hands out an empty array whose capacity covers the request (rounded up to the class),
+ * so callers can AddUninitialized / FMemoryWriter into it without reallocating. Release() keeps the
+ * allocation for the next caller. Each class holds at most MaxPerClass buffers.
+ */
+template <typename T>
+class TTerraDyneBufferPool
+{
+public:
+	static constexpr int32 MinClassLog2 = 12; // 4 KB
+	static constexpr int32 MaxClassLog2 = 28; // 256 MB; bigger requests bypass the pool
+	static constexpr int32 NumClasses = MaxClassLog2 - MinClassLog2 + 1;
+	static constexpr int32 MaxPerClass = 8;
+
+	TArray<T> Acquire(int64 MinNum)
+	{
+		Acquires.fetch_add(1, std::memory_order_relaxed);
+
+		const int32 Class = GetClass(MinNum);
+		if (Class != INDEX_NONE)
+		{
+			FScopeLock Lock(&Mutex);
+			TArray<TArray<T>>& FreeList = FreeLists[Class];
+			if (FreeList.Num() > 0)
+			{
+				TArray<T> Buffer = FreeList.Pop(EAllowShrinking::No);
+				PooledBytes.fetch_sub(Buffer.GetAllocatedSize(), std::memory_order_relaxed);
+				Reuses.fetch_add(1, std::memory_order_relaxed);
+				return Buffer;
+			}
+		}
+
+		Allocations.fetch_add(1, std::memory_order_relaxed);
+		TERRADYNE_LLM_SCOPE(Save);
+		TArray<T> Buffer;
+		Buffer.Reserve(Class != INDEX_NONE ? GetClassCapacity(Class) : MinNum);
+		return Buffer;
+	}
+
+	void Release(TArray<T>&& Buffer)
+	{
+		// Classify by what the buffer can hold, so it only serves requests it covers
+		int32 Class = INDEX_NONE;
+		for (int32 c = NumClasses - 1; c >= 0; c--)
+		{
+			if (Buffer.Max() >= GetClassCapacity(c))
+			{
+				Class = c;
+				break;
+			}
+		}
+
+		Buffer.Reset();
+		if (Class == INDEX_NONE) return;
+
+		FScopeLock Lock(&Mutex);
+		TArray<TArray<T>>& FreeList = FreeLists[Class];
+		if (FreeList.Num() >= MaxPerClass)
+		{
+			Discards.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		PooledBytes.fetch_add(Buffer.GetAllocatedSize(), std::memory_order_relaxed);
+		FreeList.Add(MoveTemp(Buffer));
+	}
+
+	/** Frees every pooled buffer. */
+	void Trim()
+	{
+		FScopeLock Lock(&Mutex);
+		for (TArray<TArray<T>>& FreeList : FreeLists)
+		{
+			FreeList.Empty();
+		}
+		PooledBytes.store(0, std::memory_order_relaxed);
+	}
+
+	void AccumulateStats(FTerraDyneBufferPoolStats& Out) const
+	{
+		Out.Acquires += Acquires.load(std::memory_order_relaxed);
+		Out.Reuses += Reuses.load(std::memory_order_relaxed);
+		Out.Allocations += Allocations.load(std::memory_order_relaxed);
+		Out.Discards += Discards.load(std::memory_order_relaxed);
+		Out.PooledBytes += PooledBytes.load(std::memory_order_relaxed);
+	}
+
+private:
+	static int64 GetClassCapacity(int32 Class)
+	{
+		return (int64(1) << (Class + MinClassLog2)) / (int64)sizeof(T);
+	}
+
+	static int32 GetClass(int64 MinNum)
+	{
+		const uint64 Bytes = (uint64)FMath::Max<int64>(MinNum, 1) * sizeof(T);
+		const int32 Log2 = FMath::Max((int32)FMath::CeilLogTwo64(Bytes), MinClassLog2);
+		return Log2 <= MaxClassLog2 ? Log2 - MinClassLog2 : INDEX_NONE;
+	}
+
+	FCriticalSection Mutex;
+	TArray<TArray<T>> FreeLists[NumClasses];
+
+	std::atomic<int64> Acquires { 0 };
+	std::atomic<int64> Reuses { 0 };
+	std::atomic<int64> Allocations { 0 };
+	std::atomic<int64> Discards { 0 };
+	std::atomic<int64> PooledBytes { 0 };
+};
+
+/**
+ * FTerraDyneSaveBuffers
+ *
+ * The process-wide pools behind the save pipeline: snapshot copies of the chunk caches,
+ * serialization and compression scratch, and file reads on load.
+ * In steady state (same chunk resolution, bounded save concurrency) every buffer is a reuse.
+ */
+class TERRADYNE_API FTerraDyneSaveBuffers
+{
+public:
+	static TTerraDyneBufferPool<uint8>& Bytes();
+	static TTerraDyneBufferPool<float>& Heights();
+	static TTerraDyneBufferPool<FColor>& Weights();
+
+	/** Called by the saver / serializer once per chunk file. */
+	static void RecordSave() { SavesWritten.fetch_add(1, std::memory_order_relaxed); }
+	static void RecordLoad() { LoadsRead.fetch_add(1, std::memory_order_relaxed); }
+
+	static int64 GetSavesWritten() { return SavesWritten.load(std::memory_order_relaxed); }
+	static int64 GetLoadsRead() { return LoadsRead.load(std::memory_order_relaxed); }
+
+	/** Counts a snapshot's payload as in flight from capture until its save finishes or is dropped. Move-only. */
+	class FInFlightScope
+	{
+	public:
+		FInFlightScope() = default;
+		explicit FInFlightScope(int64 InBytes) : Bytes(InBytes) { InFlightBytes.fetch_add(Bytes, std::memory_order_relaxed); }
+		FInFlightScope(FInFlightScope&& Other) : Bytes(Other.Bytes) { Other.Bytes = 0; }
+		FInFlightScope& operator=(FInFlightScope&& Other)
+		{
+			if (this != &Other)
+			{
+				Release();
+				Bytes = Other.Bytes;
+				Other.Bytes = 0;
+			}
+			return *this;
+		}
+		FInFlightScope(const FInFlightScope&) = delete;
+		FInFlightScope& operator=(const FInFlightScope&) = delete;
+		~FInFlightScope() { Release(); }
+
+		void Release()
+		{
+			if (Bytes != 0)
+			{
+				InFlightBytes.fetch_sub(Bytes, std::memory_order_relaxed);
+				Bytes = 0;
+			}
+		}
+
+	private:
+		int64 Bytes = 0;
+	};
+
+	/** Snapshot payload captured for saves that have not finished yet. */
+	static int64 GetInFlightBytes() { return InFlightBytes.load(std::memory_order_relaxed); }
+
+	/** All three pools summed. */
+	static FTerraDyneBufferPoolStats GetStats();
+
+	/** Frees every pooled buffer (e.g. after a level's final save). */
+	static void Trim();
+
+private:
+	static std::atomic<int64> SavesWritten;
+	static std::atomic<int64> LoadsRead;
+	static std::atomic<int64> InFlightBytes;
+};
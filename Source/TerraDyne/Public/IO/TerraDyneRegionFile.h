@@ -0,0 +1,158 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/CriticalSection.h"
+
+// TerraDyneCore
+#include "TerraDyneRegionLayout.h"
+
+// NOTE: No .generated.h include because this is a raw C++ class, not a UObject.
+
+class IFileHandle;
+
+/**
+ * FTerraDyneRegionFile
+ *
+ * Every chunk of one save slot in a single indexed file (FTerraDyneIOPaths::GetRegionFilePath,
+ * layout in TerraDyneCore::FRegionFileLayout), instead of one file per chunk.
+ *
+ * Writes: savers append their frame under a short lock. The index is committed (appended, then the
+ *         header repointed) once the last write in flight finishes, so a burst of saves costs one index write.
+ * Reads:  the frame is mapped straight out of the page cache (IMappedFileRegion) and inflated from there;
+ *         if the platform can't map the file, or a writer has it open, it falls back to one read into a pooled
+ *         buffer, done outside the lock.
+ *         The mapping lives only as long as some FChunkRead holds it: platforms that map without write sharing
+ *         would otherwise refuse the next writer.
+ * Compact() rewrites the live frames into a fresh file, dropping superseded frames and old indices. The last
+ * write of a burst runs it on its own once the dead bytes pass 16 MB and outweigh the live ones.
+ * Loose Chk_X_Y.bin saves from before region files are imported (and deleted) the first time a slot is opened.
+ *
+ * Thread-safe. One instance per slot, shared through Get().
+ * Console: terradyne.Region <Slot> [compact]
+ */
+class TERRADYNE_API FTerraDyneRegionFile
+{
+public:
+	/** Counts a scheduled write from the Game Thread until its saver is done; the last one commits the index. Move-only. */
+	class FWriteScope
+	{
+	public:
+		FWriteScope() = default;
+		explicit FWriteScope(const TSharedRef<FTerraDyneRegionFile>& InFile);
+		FWriteScope(FWriteScope&& Other) : File(MoveTemp(Other.File)) {}
+		FWriteScope& operator=(FWriteScope&& Other)
+		{
+			if (this != &Other)
+			{
+				Release();
+				File = MoveTemp(Other.File);
+			}
+			return *this;
+		}
+		FWriteScope(const FWriteScope&) = delete;
+		FWriteScope& operator=(const FWriteScope&) = delete;
+		~FWriteScope() { Release(); }
+
+		void Release();
+
+	private:
+		TSharedPtr<FTerraDyneRegionFile> File;
+	};
+
+	/** One chunk frame: a mapped view of the file, or a pooled copy. Valid until destroyed. */
+	class FChunkRead
+	{
+	public:
+		FChunkRead() = default;
+		FChunkRead(FChunkRead&&) = default;
+		FChunkRead& operator=(FChunkRead&&) = default;
+		~FChunkRead();
+
+		const uint8* GetData() const { return MappedRegion ? MappedRegion->GetMappedPtr() : Bytes.GetData(); }
+		int64 Num() const { return MappedRegion ? MappedRegion->GetMappedSize() : Bytes.Num(); }
+		bool IsMapped() const { return MappedRegion.IsValid(); }
+
+	private:
+		friend class FTerraDyneRegionFile;
+
+		// Declaration order matters: the region must be unmapped before the handle closes
+		TSharedPtr<IMappedFileHandle> MappedFile;
+		TUniquePtr<IMappedFileRegion> MappedRegion;
+		TArray<uint8> Bytes;
+	};
+
+	/** The region file of a save slot (opened, its index read and legacy saves imported, on first use). */
+	static TSharedRef<FTerraDyneRegionFile> Get(const FString& SlotName);
+
+	explicit FTerraDyneRegionFile(const FString& InFilePath);
+	~FTerraDyneRegionFile();
+
+	const FString& GetFilePath() const { return FilePath; }
+
+	/** Registers a write that a saver will Append() later (call when scheduling it). */
+	static FWriteScope BeginWrite(const TSharedRef<FTerraDyneRegionFile>& File) { return FWriteScope(File); }
+
+	/** Appends a complete chunk frame, superseding any older frame of the same cell. */
+	bool Append(FIntPoint Coord, const uint8* Frame, int64 Size);
+
+	/** Maps (or reads) the frame of a cell. False if the slot holds no frame for it. */
+	bool Read(FIntPoint Coord, FChunkRead& Out);
+
+	bool Contains(FIntPoint Coord);
+
+	/** Writes the index and header now (normally done by the last FWriteScope). */
+	bool Commit();
+
+	/**
+	 * Rewrites the file with only the live frames. The copy runs outside the lock (saves and reads go on);
+	 * only frames saved meanwhile, the index and the swap hold it. Fails while reads still hold a mapping.
+	 */
+	bool Compact();
+
+	int32 GetNumChunks();
+
+	/** Bytes of superseded frames and old indices that Compact() would reclaim. */
+	int64 GetDeadBytes();
+
+private:
+	void EndWrite();
+
+	/** Appends every legacy loose save of a slot the index doesn't hold yet, commits, then deletes them. */
+	void ImportLegacyChunks(const FString& SlotName);
+
+	/** True when the dead bytes justify a rewrite and nothing (writes, reads) is in flight. */
+	bool ShouldAutoCompactLocked() const;
+
+	/** Maps the frame of Entry into Out. False if the platform can't, or the frame lies past the current mapping. */
+	bool MapLocked(const TerraDyneCore::FRegionEntry& Entry, FChunkRead& Out);
+
+	/** Reads the committed header and index (once). */
+	void LoadIndexLocked();
+
+	bool CommitLocked();
+	bool EnsureWriterLocked();
+	int64 GetLiveBytesLocked() const;
+
+	/** Index entries sorted by cell, as written to disk. */
+	TArray<TerraDyneCore::FRegionEntry> GetSortedEntriesLocked() const;
+
+	FCriticalSection Mutex;
+	FString FilePath;
+
+	TMap<FIntPoint, TerraDyneCore::FRegionEntry> Index;
+	bool bIndexLoaded = false;
+	bool bIndexDirty = false;
+	int64 AppendOffset = 0;
+	int32 PendingWrites = 0;
+
+	// Set while Compact() copies without the lock; bumped by every swap (unlocked reads check it)
+	bool bCompacting = false;
+	uint32 Generation = 0;
+
+	// Open between the first append and the next commit
+	TUniquePtr<IFileHandle> Writer;
+
+	// Owned by the FChunkReads using it; re-opened when gone or when a read reaches past the mapped size
+	TWeakPtr<IMappedFileHandle> MappedFile;
+};
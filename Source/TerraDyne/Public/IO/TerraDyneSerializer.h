@@ -32,6 +32,14 @@ public:
 	 */
 	static bool LoadChunkFromDisk(const FString& FilePath, FTerraDyneChunkSnapshot& OutSnapshot);
 
+	/**
+	 * Loads one chunk from a slot's region file. The frame is inflated straight out of the mapped file (no
+	 * read copy) into a pooled buffer, and the payload arrays are then copied out of that into the snapshot.
+	 *
+	 * @return              False if the slot holds no save for Coord, or it failed to decode.
+	 */
+	static bool LoadChunkFromRegion(FTerraDyneRegionFile& Region, FIntPoint Coord, FTerraDyneChunkSnapshot& OutSnapshot);
+
 	/**
 	 * Deserializes raw binary data (e.g. from network or memory cache) into a Snapshot.
 	 * Handles the decompression step internally.
@@ -42,7 +50,23 @@ public:
 	 */
 	static bool DeserializeFromBytes(const TArray<uint8>& Bytes, FTerraDyneChunkSnapshot& OutSnapshot);
 
+	/** DeserializeFromBytes() over memory the caller owns (e.g. a mapped file region). */
+	static bool DeserializeFromMemory(const uint8* Data, int64 Size, FTerraDyneChunkSnapshot& OutSnapshot);
+
+	/**
+	 * Serializes and compresses a Snapshot into a complete chunk file image (the inverse of DeserializeFromBytes).
+	 * Snapshots with a BaseHash are written as a v2 delta (only DeltaBlocks) whenever that is smaller.
+	 * OutBytes is resized in place, so a pooled buffer of GetSerializedBound() bytes never reallocates.
+	 *
+	 * @return              False if compression failed (OutBytes is then empty).
+	 */
+	static bool SerializeToBytes(const FTerraDyneChunkSnapshot& Snapshot, TArray<uint8>& OutBytes);
+
+	/** Worst-case size of SerializeToBytes() for a Snapshot. */
+	static int64 GetSerializedBound(const FTerraDyneChunkSnapshot& Snapshot);
+
 private:
-	// Internal helper to read our specific versioned binary format
-	static bool ReadSnapshotFromArchive(FArchive& Ar, FTerraDyneChunkSnapshot& OutSnapshot);
+	// Internal helper to read our specific versioned binary format (see TerraDyneCore::FChunkCodec).
+	// v1 fills the whole snapshot; v2 sets BaseHash and bPackedDelta and holds only the DeltaBlocks' cells.
+	static bool ReadSnapshotFromPayload(const uint8* Data, int64 Size, FTerraDyneChunkSnapshot& OutSnapshot);
 };
\ No newline at end of file
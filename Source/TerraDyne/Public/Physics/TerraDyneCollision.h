@@ -38,6 +38,30 @@ public:
 		float ZScale = 1.0f
 	);
 
+	/**
+	 * Builds a regular heightfield grid directly into an FDynamicMesh3 (no GeometryScript, no UObjects).
+	 * Safe to call from worker threads; used for async collision LOD rebuilds.
+	 *
+	 * @param OutMesh          Mesh to overwrite.
+	 * @param HeightData       Source of truth (CPU Cache) for Z heights.
+	 * @param Resolution       The resolution of the HeightData grid (e.g., 128).
+	 * @param ChunkSize        The physical width of the chunk in World Units (mesh is centered).
+	 * @param QuadsPerSide     Density of the generated grid (e.g., 64 for full detail at 128 res).
+	 */
+	static void BuildHeightfieldMesh(
+		UE::Geometry::FDynamicMesh3& OutMesh,
+		const TArray<float>& HeightData,
+		int32 Resolution,
+		float ChunkSize,
+		int32 QuadsPerSide
+	);
+
+	/**
+	 * Gathers the (QuadsPerSide + 1)^2 heights BuildHeightfieldMesh() reads at that density. Building from
+	 * the samples (Resolution = QuadsPerSide + 1) gives the same mesh, so async builds snapshot only these.
+	 */
+	static void SampleHeightfield(const TArray<float>& HeightData, int32 Resolution, int32 QuadsPerSide, TArray<float>& OutSamples);
+
 	/**
 	 * Configures a DynamicMeshComponent for optimal interaction with the Chaos Physics solver
 	 * in a Landscape context.
@@ -6,10 +6,24 @@
 #include "VirtualHeightfieldMeshComponent.h"
 #include "World/TerraDyneTileData.h"
 #include "Engine/TextureRenderTarget2D.h" // Critical for ETextureRenderTargetFormat
+#include "Engine/StreamableManager.h"
+#include "Core/TerraDyneWorkerPool.h"
+#include "Core/TerraDyneEditLatency.h"
+#include "Core/TerraDyneMemory.h"
+#include "IO/TerraDyneAsyncSaver.h" // For FTerraDyneChunkSnapshot (PendingDelta)
 #include "TerraDyneChunk.generated.h"
 
 // Forward Declarations
 class UMaterialInstanceDynamic;
+class ATerraDyneManager;
+
+/** A grid sub-rect packed for HeightRT (R16f) and WeightRT (RGBA8) uploads. */
+struct FTerraDynePackedRegion
+{
+	FIntRect Region;
+	TArray<FFloat16> Heights;
+	TArray<uint8> Weights;
+};
 
 /**
  * ATerraDyneChunk
@@ -65,9 +79,18 @@ public:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "TerraDyne|Identity")
 	float ChunkSizeWorldUnits;
 
-	// Phase 4: The baked static data source. 
+	// Phase 4: The baked static data source. Soft, so maps don't load every tile up front;
+	// streamed in by the Manager once the chunk becomes relevant.
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "TerraDyne|Identity")
-	TObjectPtr<UTerraDyneTileData> LinkedTileData;
+	TSoftObjectPtr<UTerraDyneTileData> LinkedTileData;
+
+	/** Samples per side of the low-res heights shown until LinkedTileData has streamed in. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Streaming", meta = (ClampMin = "2", ClampMax = "65"))
+	int32 PlaceholderResolution = 17;
+
+	/** Quantized placeholder heights (PlaceholderResolution^2), baked from LinkedTileData in the editor. */
+	UPROPERTY()
+	TArray<uint16> PlaceholderHeightMap;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Config")
 	float ZScale = 100.0f;
@@ -81,6 +104,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Init")
 	void InitializeChunk(FIntPoint Coord, float Size, int32 Resolution, UTexture2D* SourceHeight, UTexture2D* SourceWeight = nullptr);
 
+	/**
+	 * Takes ownership of decoded height/weight grids (Resolution * Resolution each),
+	 * uploads them to the render targets and syncs collision.
+	 * Used by the Landscape importer; Weights may be empty.
+	 */
+	void ApplyImportedData(TArray<float>&& Heights, TArray<FColor>&& Weights);
+
 	/** Initializes from baked asset. */
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Init")
 	void InitializeFromAsset(UTerraDyneTileData* TileData);
@@ -92,6 +122,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
 	void RebuildPhysicsMesh();
 
+	/**
+	 * Switches collision density. LOD 0 is the full grid (Resolution / 2 quads per side),
+	 * every further level halves it. The new mesh is built on a worker thread and swapped in
+	 * on the Game Thread; requests for the current/pending level are ignored.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void SetCollisionLOD(int32 NewLOD);
+
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Physics")
+	int32 GetCollisionLOD() const { return CollisionLOD; }
+
+	/** Number of quads per side for a given collision LOD. */
+	int32 GetCollisionQuadsForLOD(int32 LOD) const;
+
+	//--- Lazy Collision ---//
+
+	/** Starts an async collision build at the given LOD if the chunk has none. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void EnsureCollision(int32 LOD = 0);
+
+	/** Builds full-detail collision synchronously (for traces that must hit this frame). */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void BuildCollisionNow();
+
+	/** Drops the collision mesh and its cooked body. HeightCache is untouched. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Physics")
+	void ReleaseCollision();
+
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Physics")
+	bool HasCollision() const { return bHasCollision; }
+
+	/** True while an async collision build is in flight. */
+	bool IsCollisionBuildPending() const { return PendingCollisionLOD != INDEX_NONE; }
+
+	/** World time (s) at which a physics source last needed this chunk's collision. */
+	double LastCollisionDemandTime = 0.0;
+
 	/** Modifies the terrain geometry (Dig/Raise). */
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Edit")
 	void ApplyLocalIdempotentEdit(FVector RelativePos, float Radius, float Strength, bool bIsHole, int32 PaintLayer = -1);
@@ -100,14 +167,124 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Edit")
 	void ApplyPaintBrush(FVector WorldPos, float Radius, float Strength, int32 LayerChannel);
 
+	/** True if the chunk keeps no render resources (dedicated server, -nullrhi or forced by the Manager). */
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Visuals")
+	bool IsHeadless() const;
+
 	/** Material helper function. */
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Visuals")
 	void SetMaterial(UMaterialInterface* InMaterial);
 
-	/** Async Saving. */
+	/** Async Saving: appends the chunk to the slot's region file (FTerraDyneIOPaths::GetRegionFilePath). */
 	UFUNCTION(BlueprintCallable, Category = "TerraDyne|IO")
 	void SaveAsync(FString SlotName);
 
+	//--- Pooling ---//
+
+	/**
+	 * Re-initializes a pooled chunk in place for a new grid slot.
+	 * Keeps the existing render targets, height buffer and collision topology when the
+	 * resolution matches, so no GPU resources or mesh rebuilds are needed.
+	 */
+	void ActivateFromPool(FIntPoint Coord, const FVector& Location, float Size, int32 InResolution, bool bBuildCollision = true);
+
+	/** Hides the chunk, disables collision and stops pending work so it can sit in the pool. */
+	void ReturnToPool();
+
+	/** True while the chunk is parked in the Manager's pool. */
+	bool IsPooled() const { return bIsPooled; }
+
+	//--- Memory ---//
+
+	/** Approximate bytes held by the CPU caches (or their compressed blob), RTs and collision. Sum of GetMemoryBreakdown(). */
+	int64 GetMemoryFootprint() const;
+
+	/** Bytes per runtime category: caches, compressed blob, RTs, collision mesh, cooked collision, grass. */
+	FTerraDyneChunkMemory GetMemoryBreakdown() const;
+
+	/** True while the CPU caches live LZ4-compressed. RTs and visual are kept. */
+	bool AreCachesCompressed() const { return bCachesCompressed; }
+
+	/**
+	 * Cold-chunk eviction: LZ4-compresses the CPU caches in place and starts a collision rebuild at
+	 * ColdCollisionLOD if the chunk has collision. The RTs keep the last upload, so nothing pops.
+	 * @return False if the chunk is busy (streaming, pooled, mid-build, upload deferred) or already compressed.
+	 */
+	bool CompressCaches(int32 ColdCollisionLOD);
+
+	/** Restores compressed caches. Every cache access goes through here; hits and misses are counted by the Manager. */
+	void EnsureResident();
+
+	/** Latest of the last edit, last on-screen render and last collision demand (world seconds). */
+	double GetLastTouchTime() const;
+
+	/** World time (s) of the last height or paint stamp. */
+	double LastEditTime = 0.0;
+
+	/** Bumped by every height or paint stamp, reset when activated from the pool. Lets the Manager tell whether a chunk was edited since a point in time. */
+	uint32 EditSerial = 0;
+
+	//--- Startup ---//
+
+	/** True from BeginPlay until the chunk's heights, RTs and (possibly deferred) collision exist. */
+	bool IsStartupInitPending() const { return bStartupInitPending; }
+
+	/** Runs the whole startup init on the Game Thread, bypassing the Manager's queue. */
+	void RunStartupInit();
+
+	//--- Tile Data Streaming ---//
+
+	/** True while the placeholder is shown and LinkedTileData has not been converted yet. */
+	bool IsAwaitingTileData() const { return bAwaitingTileData; }
+
+	/** Starts the async load of LinkedTileData (no-op if already requested or converted). */
+	void RequestTileData(int32 Priority = FStreamableManager::DefaultAsyncLoadPriority);
+
+	/** Blocks until LinkedTileData is loaded and converted (for edits that can't wait). */
+	void FlushTileData();
+
+	/** True once RequestTileData() has issued a load that hasn't completed yet. */
+	bool IsTileDataRequested() const { return TileDataHandle.IsValid(); }
+
+	/**
+	 * Replaces the caches with a saved state (e.g. streamed from a save slot). Supersedes the tile data.
+	 *
+	 * A delta snapshot (bPackedDelta) is laid over a fresh decode of the baked tile instead, so it also replaces
+	 * the runtime state: edits made since the last decode are dropped, exactly as a full save drops them.
+	 * The decode runs on a worker unless the caches already hold the untouched tile; edits issued before it
+	 * finishes flush it first (FlushTileData), so they land on top of the loaded state instead of being lost.
+	 */
+	void ApplySnapshot(FTerraDyneChunkSnapshot&& Snapshot);
+
+	/**
+	 * Copies the caches into pooled snapshot arrays (handed back by the saver, or by Snapshot.ReturnBuffers()).
+	 * With bDeltaAgainstBase, a chunk still derived from its baked tile also reports the blocks edited since.
+	 */
+	void CaptureSnapshot(FTerraDyneChunkSnapshot& OutSnapshot, bool bDeltaAgainstBase = false);
+
+	//--- Deferred GPU Updates ---//
+
+	/** True if brush edits are waiting in PendingGPURegion for the chunk to become visible. */
+	bool HasPendingGPUUpdate() const { return bHasPendingGPURegion; }
+
+	/** Queues FlushPendingGPUUpdate() under the scheduler's GPU upload budget (immediate without a subsystem). */
+	void ScheduleGPUFlush();
+
+	/** Uploads the coalesced dirty region from the CPU caches to the RTs. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Rendering")
+	void FlushPendingGPUUpdate();
+
+	/** False while the chunk is on screen or within the Manager's GPU update distance of a view. */
+	bool ShouldDeferGPUUpdate() const;
+
+#if WITH_EDITOR
+	/** Re-bakes PlaceholderHeightMap (and the chunk size) from LinkedTileData. */
+	UFUNCTION(CallInEditor, Category = "TerraDyne|Streaming")
+	void BakePlaceholder();
+
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -119,21 +296,198 @@ private:
 	TArray<float> HeightCache;
 	int32 Resolution;
 
-	// Timer for Anti-Stutter system
-	FTimerHandle TimerHandle_CollisionUpdate;
+	// CPU-side layer weights (R/G/B/A = layers 0..3), same grid as HeightCache.
+	TArray<FColor> WeightCache;
+
+	// Grass bounds touched since the last scheduled regen request
+	FBox PendingGrassBounds = FBox(ForceInit);
+
+	// Latency tracing: edit IDs still waiting on each derived product of this chunk (see FTerraDyneEditLatency)
+	TArray<uint32> PendingGPUEdits;
+	TArray<uint32> PendingCollisionEdits;
+	TArray<uint32> CollisionEditsInFlight;
+	TArray<uint32> PendingGrassEdits;
+	TArray<uint32> PendingSaveEdits;
 	bool bPhysicsIsDirty;
 
+	// Pool state
+	bool bIsPooled = false;
+
+	// Cold-chunk compression: HeightCache + WeightCache bytes, LZ4
+	TArray<uint8> CompressedCaches;
+	int32 CompressedHeightCount = 0;
+	int32 CompressedWeightCount = 0;
+	bool bCachesCompressed = false;
+
+	// Startup state (queued = owned by the Manager's time-sliced init queue)
+	bool bStartupInitPending = false;
+	bool bStartupInitQueued = false;
+
+	// Grid texels (exclusive max) edited on the CPU but not yet uploaded, because nobody could see them
+	FIntRect PendingGPURegion;
+	bool bHasPendingGPURegion = false;
+
+	// Tile streaming state (the handle is released as soon as the tile is converted)
+	bool bAwaitingTileData = false;
+	bool bTileDecodeInFlight = false;
+	FTerraDyneCancellationTokenPtr TileDecodeToken;
+	TSharedPtr<FStreamableHandle> TileDataHandle;
+
+	// Real time at which the Manager found the tile data missing while a source stood on the chunk (-1 = not yet)
+	double TileNeededTime = -1.0;
+
+	// Delta saves: hash of the decoded tile the caches started from (0 = none), and the
+	// FChunkCodec::DeltaBlockSize blocks edited since. A v2 save waits in PendingDelta (packed blocks only) for its base to decode.
+	uint64 BaseHash = 0;
+	TBitArray<> ModifiedBlocks;
+	FTerraDyneChunkSnapshot PendingDelta;
+
+	// Collision LOD state (PendingCollisionLOD is INDEX_NONE when no async build is in flight)
+	int32 CollisionLOD = 0;
+	int32 PendingCollisionLOD = INDEX_NONE;
+	uint32 CollisionBuildSerial = 0;
+	FTerraDyneCancellationTokenPtr CollisionBuildToken;
+	bool bHasCollision = false;
+
+	// Topology of the last generated physics grid (lets pooled chunks skip the rebuild)
+	int32 BuiltMeshResolution = 0;
+	float BuiltMeshSize = 0.0f;
+
 	// Cached Material Instance to drive RT parameters
 	UPROPERTY(Transient)
 	TObjectPtr<UMaterialInstanceDynamic> TerrainMID;
 
+	// Cached paint brush MID
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> PaintMID;
+
+	// Cached visual MID (re-used when a pooled chunk is re-initialized)
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> VisualMID;
+
 	//--- Private Helpers ---//
 
 	void SyncPhysicsGeometry();
+
+	/** Uploads the full CPU caches to HeightRT/WeightRT. */
 	void UpdateVisualTexture();
 
-	UFUNCTION()
+	/** Snapshots the caches and hands them to an async saver task. */
+	void LaunchSave(const FString& SlotName);
+
+	/** Uploads a sub-rect (grid texels, exclusive max) of the CPU caches to HeightRT/WeightRT. */
+	void UpdateVisualRegion(const FIntRect& Region);
+
+	/** Worker-safe packing half of UpdateVisualRegion(). Region is clamped to the grid. */
+	static void PackVisualRegion(const TArray<float>& Heights, const TArray<FColor>& Weights, int32 Res, const FIntRect& Region, bool bPackHeights, bool bPackWeights, FTerraDynePackedRegion& Out);
+
+	/** Packs Width x Height texels of row-major grids with the given row stride; null skips that layer. Leaves Out.Region alone. */
+	static void PackVisualRows(const float* Heights, const FColor* Weights, int32 Stride, int32 Width, int32 Height, FTerraDynePackedRegion& Out);
+
+	/** Game Thread half of UpdateVisualRegion(): enqueues the render commands. */
+	void SubmitVisualRegion(FTerraDynePackedRegion&& Packed);
+
+	/**
+	 * Runs the derived products of the edits since the last flush as one task graph
+	 * (FTerraDyneEditGraph on the worker pool): collision mesh (from the LOD's height samples, cancelled
+	 * through CollisionBuildToken) and texture packing (from the dirty rows) in parallel, then mesh swap,
+	 * RT upload, nav and grass requests joined on the Game Thread.
+	 */
+	void FlushDerivedProducts();
+
+	/** Drops a compressed blob that is about to be overwritten by fresh caches. */
+	void DiscardCompressedCaches();
+
+	/** Points VisualMID's HeightMap/WeightMap at the current RTs. */
+	void BindVisualTextures();
+
+	/** Hands PendingGrassBounds to the grass system under the scheduler's grass budget. */
+	void QueueGrassRegen();
+
+	/** Grows PendingGPURegion and hands the chunk to the Manager's flush list. */
+	void MarkGPURegionDirty(const FIntRect& Region);
+
+	/** Tells the subsystem's change subscribers about an edited grid region (texels, exclusive max). */
+	void ReportTerrainChange(const FIntRect& Region, float MaxHeightDelta, bool bWeightsChanged) const;
+
 	void PerformDeferredCollisionUpdate();
 
+	/** Sizes and dequantizes the CPU caches from a resident tile (Game Thread). */
+	void DequantizeFromAsset(const UTerraDyneTileData* TileData);
+
+	/** Takes over a tile decoded elsewhere (see DequantizeTile()) as the caches and delta base. No upload yet. */
+	void AdoptDecodedTile(TArray<float>&& Heights, TArray<FColor>&& Weights, int32 TileResolution, float TileSize, uint64 TileHash);
+
+	/** Game Thread half of every init: RTs, GPU upload, material bindings and collision for the current caches. */
+	void CommitCaches();
+
+	/** Fills the caches from PlaceholderHeightMap and commits them. */
+	void ShowPlaceholder();
+
+	/** Streamable delegate: dequantizes the tile on a worker, then finishes on the Game Thread. */
+	void OnTileDataLoaded();
+
+	/** Game Thread completion of a tile decode: commits the caches (plus any PendingDelta) and releases the asset. */
+	void FinishTileData(TArray<float>&& Heights, TArray<FColor>&& Weights, int32 TileResolution, float TileSize, uint64 TileHash);
+
+	/** Dequantization of a tile's payloads. Returns the base hash of the result (see FChunkCodec::HashBase). Game Thread only. */
+	static uint64 DequantizeTile(const UTerraDyneTileData* TileData, float InZScale, TArray<float>& OutHeights, TArray<FColor>& OutWeights);
+
+	/** Thread-safe overload on payloads copied out of the tile; workers must never touch the UObject itself. */
+	static uint64 DequantizeTile(const TArray<uint16>& QuantizedHeights, const TArray<FColor>& TileWeights, float InZScale, TArray<float>& OutHeights, TArray<FColor>& OutWeights);
+
+	//--- Delta Saves ---//
+
+	/** The caches now hold the decoded tile identified by TileHash; nothing is edited yet. */
+	void SetDeltaBase(uint64 TileHash);
+
+	/** The caches no longer derive from the baked tile (imports, full snapshots, pool reuse). */
+	void ClearDeltaBase();
+
+	/** Flags the blocks overlapping a grid rect (exclusive max) as edited. */
+	void MarkBlocksModified(const FIntRect& Region);
+
+	/** Scatters PendingDelta's packed blocks over the caches if its base matches, then returns its buffers. */
+	void ApplyPendingDelta();
+
+	void ReleaseTileData();
+
+	ATerraDyneManager* FindManager() const;
+	mutable TWeakObjectPtr<ATerraDyneManager> CachedManager;
+
+	/** Game Thread completion of the startup init (expects the tile, if resident, to be in the caches already). */
+	void FinishStartupInit();
+
+	/** Next-tick fallback for chunks with no Manager to queue them. */
+	UFUNCTION()
+	void RunStartupInitIfOrphaned();
+
+	/** Launches the worker build for a collision LOD. */
+	void StartCollisionBuild(int32 NewLOD);
+
+	/** Cancels worker jobs that would write back into this chunk (collision builds, tile decodes). */
+	void CancelBackgroundJobs();
+
+	/** Asks the Manager whether collision should wait for demand (lazy streaming). */
+	bool ShouldDeferCollision() const;
+
+	/** Registers the current edit (if traced) as waiting on a stage of this chunk. */
+	static void TrackEdit(TArray<uint32>& Edits, ETerraDyneEditStage Stage);
+
+	/** Completes (bReached) or abandons every edit in the list and empties it. */
+	static void ResolveEdits(TArray<uint32>& Edits, ETerraDyneEditStage Stage, bool bReached);
+
+	/** Abandons every stage this chunk still owes (pooled or destroyed). */
+	void AbandonTrackedEdits();
+
+	/** Cooks the physics mesh (counted as one cooked section per call). */
+	void CookCollision();
+
+	/** Game Thread completion of an async collision rebuild. */
+	void FinishCollisionRebuild(UE::Geometry::FDynamicMesh3&& NewMesh, int32 LOD, bool bResyncHeights = true);
+
 	UTextureRenderTarget2D* CreateInternalRT(int32 Res, ETextureRenderTargetFormat Format, FLinearColor ClearColor);
+
+	/** Returns Existing if it matches the requested size/format (cleared), otherwise creates a new RT. */
+	UTextureRenderTarget2D* ReuseOrCreateRT(UTextureRenderTarget2D* Existing, int32 Res, ETextureRenderTargetFormat Format, FLinearColor ClearColor);
 };
\ No newline at end of file
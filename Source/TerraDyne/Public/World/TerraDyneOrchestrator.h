@@ -2,8 +2,158 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Math/RandomStream.h"
 #include "TerraDyneOrchestrator.generated.h"
 
+class ATerraDyneManager;
+
+UENUM(BlueprintType)
+enum class ETerraDyneOrchestratorMode : uint8
+{
+	/** Demo: one meteor every 0.05 s along a growing spiral. */
+	Spiral,
+	/** Seeded stress profile with a report at the end (see LoadProfile). */
+	LoadGenerator
+};
+
+/**
+ * FTerraDyneLoadProfile
+ *
+ * A reproducible bombardment: the same seed, profile and map produce the same edit sequence.
+ */
+USTRUCT(BlueprintType)
+struct FTerraDyneLoadProfile
+{
+	GENERATED_BODY()
+
+	/** Shows up in the log and the report file name. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load")
+	FString Name = TEXT("Default");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load")
+	int32 Seed = 1337;
+
+	/** Run length in seconds (0 = until StopLoadRun()). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0.0"))
+	float Duration = 60.0f;
+
+	/** Impacts (single edits or strokes) started per second. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0.0"))
+	float ImpactsPerSecond = 20.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "1.0"))
+	float MinRadius = 200.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "1.0"))
+	float MaxRadius = 1200.0f;
+
+	/** Radius = Lerp(Min, Max, U^Exponent): 1 is uniform, > 1 favours small craters. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0.1"))
+	float RadiusExponent = 2.0f;
+
+	/** Height change at the brush center (negative digs); picked uniformly between Min and Max. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load")
+	float MinStrength = -400.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load")
+	float MaxStrength = -50.0f;
+
+	/** Impacts land on a ChunkSpread x ChunkSpread block of chunks centered on the orchestrator. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "1"))
+	int32 ChunkSpread = 4;
+
+	/** Fraction of impacts that paint a weight layer instead of changing heights. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float PaintRatio = 0.25f;
+
+	/** Weight layer painted by paint impacts (0..3 = R..A). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0", ClampMax = "3"))
+	int32 PaintLayer = 1;
+
+	/** Fraction of impacts that are tool strokes: a run of brushes along a line, one per tick. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float StrokeRatio = 0.1f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "1"))
+	int32 StrokeSteps = 16;
+
+	/** Distance between stroke brushes, in radii. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0.01"))
+	float StrokeSpacing = 0.5f;
+
+	/** Spawn physics projectiles that edit on hit instead of editing directly (needs collision, so not deterministic). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load")
+	bool bUsePhysicsProjectiles = false;
+
+	/** Seconds between memory samples. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (ClampMin = "0.05"))
+	float MemorySampleInterval = 1.0f;
+};
+
+/** Results of one load run. */
+USTRUCT(BlueprintType)
+struct FTerraDyneLoadReport
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	float Seconds = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int32 Frames = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int32 Impacts = 0;
+
+	/** Brushes applied directly (stroke steps count individually); projectile edits are not included. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int32 BrushEdits = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int32 ProjectilesSpawned = 0;
+
+	/** Wall-clock frame times. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	float FrameP50Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	float FrameP95Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	float FrameP99Ms = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	float FrameMaxMs = 0.0f;
+
+	/** TerraDyne memory (active and pooled chunks + save buffers) at the start, peak and end of the run. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int64 StartMemoryBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int64 PeakMemoryBytes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int64 EndMemoryBytes = 0;
+
+	/** Process-wide used physical memory at its peak. */
+	UPROPERTY(BlueprintReadOnly, Category = "TerraDyne|Load")
+	int64 PeakProcessBytes = 0;
+};
+
+/**
+ * ATerraDyneOrchestrator
+ *
+ * Drives traffic into the terrain. In Spiral mode it is the original meteor demo. In LoadGenerator
+ * mode it replays a seeded FTerraDyneLoadProfile for capacity planning, and when the run ends it
+ * writes frame time, edit latency (FTerraDyneEditLatency) and memory to
+ * Saved/Profiling/TerraDyneLoad_<Name>.json.
+ *
+ * Headless: place one in the map and run with -nullrhi -TerraDyneLoadGen[=<Profile>]. The flag forces
+ * bAutoStart and bQuitWhenFinished; with a name, LoadProfile is overridden by the Game ini section
+ * [TerraDyne.LoadProfile.<Profile>], whose keys are the FTerraDyneLoadProfile property names
+ * (e.g. ImpactsPerSecond=40, bUsePhysicsProjectiles=True). Keys it leaves out keep the placed values.
+ * Console: terradyne.LoadGen start|stop
+ */
 UCLASS()
 class TERRADYNE_API ATerraDyneOrchestrator : public AActor
 {
@@ -12,6 +162,35 @@ class TERRADYNE_API ATerraDyneOrchestrator : public AActor
 public:	
 	ATerraDyneOrchestrator();
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Orchestrator")
+	ETerraDyneOrchestratorMode Mode = ETerraDyneOrchestratorMode::Spiral;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TerraDyne|Load", meta = (EditCondition = "Mode == ETerraDyneOrchestratorMode::LoadGenerator"))
+	FTerraDyneLoadProfile LoadProfile;
+
+	/** Starts the load run on BeginPlay. */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Load", meta = (EditCondition = "Mode == ETerraDyneOrchestratorMode::LoadGenerator"))
+	bool bAutoStart = false;
+
+	/** Requests engine exit once the report is written (headless capacity runs). */
+	UPROPERTY(EditAnywhere, Category = "TerraDyne|Load", meta = (EditCondition = "Mode == ETerraDyneOrchestratorMode::LoadGenerator"))
+	bool bQuitWhenFinished = false;
+
+	/** Resets the edit latency histograms and starts bombarding with LoadProfile. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Load")
+	void StartLoadRun();
+
+	/** Ends the run early and writes the report. */
+	UFUNCTION(BlueprintCallable, Category = "TerraDyne|Load")
+	void StopLoadRun();
+
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Load")
+	bool IsLoadRunActive() const { return bLoadRunActive; }
+
+	/** Report of the last finished run. */
+	UFUNCTION(BlueprintPure, Category = "TerraDyne|Load")
+	const FTerraDyneLoadReport& GetLastLoadReport() const { return LastReport; }
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void Tick(float DeltaTime) override;
@@ -19,4 +198,40 @@ protected:
 	float TimeElapsed;
 	float SpiralAngle;
 	float Radius;
-};
\ No newline at end of file
+
+private:
+	/** One brush sequence in progress: single impacts have one step, strokes several. */
+	struct FActiveStroke
+	{
+		FVector Position;
+		FVector Direction;
+		float Radius = 0.0f;
+		float Strength = 0.0f;
+		int32 PaintLayer = -1;
+		int32 StepsLeft = 0;
+	};
+
+	void TickSpiral(float DeltaTime);
+	void TickLoadRun(float DeltaTime);
+	void StartImpact(ATerraDyneManager* Manager);
+	void FinishLoadRun();
+
+	/** Same total as terradyne.MemReport: active and pooled chunks plus save buffers. */
+	int64 SampleTerrainMemory() const;
+
+	/** Overrides LoadProfile from [TerraDyne.LoadProfile.<ProfileName>] in the Game ini. False if there is no such section. */
+	bool LoadProfileFromConfig(const FString& ProfileName);
+
+	FString LoadReportToJson() const;
+
+	FRandomStream LoadRandom;
+	bool bLoadRunActive = false;
+	double LoadStartTime = 0.0;   // Wall clock
+	float LoadRunTime = 0.0f;     // Game time, drives Duration and the impact rate
+	double LastFrameTime = 0.0;
+	double LastMemorySample = 0.0;
+	float ImpactAccumulator = 0.0f;
+	TArray<float> FrameTimesMs;
+	TArray<FActiveStroke> ActiveStrokes;
+	FTerraDyneLoadReport LastReport;
+};
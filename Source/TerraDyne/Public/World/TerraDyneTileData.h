@@ -12,7 +12,8 @@
  * Workflow:
  * 1. Editor: Use UTerraDyneBaker to convert Landscape Components into these assets.
  * 2. Disk: Stored as compressed .uasset files.
- * 3. Runtime: Streamed in by ATerraDyneChunk::InitializeFromAsset().
+ * 3. Runtime: Soft-referenced by ATerraDyneChunk, streamed in asynchronously when the chunk
+ *    becomes relevant, converted to runtime caches and then released.
  */
 UCLASS(BlueprintType)
 class TERRADYNE_API UTerraDyneTileData : public UPrimaryDataAsset
@@ -26,7 +26,8 @@ public class TerraDyne : ModuleRules
 
 		// Private dependencies
 		PrivateDependencyModuleNames.AddRange(new string[] {
-			"GeometryScriptingCore"
+			"GeometryScriptingCore",
+			"TerraDyneCore"
 		});
 	}
 }
\ No newline at end of file
@@ -0,0 +1,332 @@
+#include "TerraDyneChunkCodec.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include "zlib.h"
+
+namespace TerraDyneCore
+{
+	// Payload: Version, GridX, GridY, Resolution, RealWorldSize, NumHeights ... NumWeights
+	static constexpr size_t PayloadFixedSize = 7 * sizeof(int32_t);
+
+	// Delta: Version, GridX, GridY, Resolution, RealWorldSize, BaseHash, BlockSize, NumBlocks
+	static constexpr size_t DeltaFixedSize = 7 * sizeof(int32_t) + sizeof(uint64_t);
+
+	/** Bytes of one delta block record for a W x H block. */
+	static size_t GetBlockRecordSize(const FGridRect& Rect)
+	{
+		const size_t Cells = (size_t)(Rect.MaxX - Rect.MinX) * (size_t)(Rect.MaxY - Rect.MinY);
+		return sizeof(int32_t) + Cells * (sizeof(float) + sizeof(FTexelBGRA));
+	}
+
+	/** Little-endian cursor over a byte buffer (every supported platform is little-endian, so these are plain copies). */
+	class FByteWriter
+	{
+	public:
+		explicit FByteWriter(uint8_t* InOut) : Out(InOut) {}
+
+		template <typename T>
+		void Write(const T& Value)
+		{
+			std::memcpy(Out + Offset, &Value, sizeof(T));
+			Offset += sizeof(T);
+		}
+
+		void WriteBytes(const void* Data, size_t Size)
+		{
+			if (Size > 0)
+			{
+				std::memcpy(Out + Offset, Data, Size);
+			}
+			Offset += Size;
+		}
+
+		size_t Tell() const { return Offset; }
+
+	private:
+		uint8_t* Out;
+		size_t Offset = 0;
+	};
+
+	class FByteReader
+	{
+	public:
+		FByteReader(const uint8_t* InData, size_t InSize) : Data(InData), Size(InSize) {}
+
+		template <typename T>
+		bool Read(T& Value)
+		{
+			if (Size - Offset < sizeof(T)) return false;
+			std::memcpy(&Value, Data + Offset, sizeof(T));
+			Offset += sizeof(T);
+			return true;
+		}
+
+		/** Returns a pointer to the next Bytes bytes and skips them, or null when truncated. */
+		const uint8_t* Skip(size_t Bytes)
+		{
+			if (Size - Offset < Bytes) return nullptr;
+			const uint8_t* Start = Data + Offset;
+			Offset += Bytes;
+			return Start;
+		}
+
+	private:
+		const uint8_t* Data;
+		size_t Size;
+		size_t Offset = 0;
+	};
+
+	size_t FChunkCodec::GetPayloadSize(int32_t NumHeights, int32_t NumWeights)
+	{
+		return PayloadFixedSize + (size_t)NumHeights * sizeof(float) + (size_t)NumWeights * sizeof(FTexelBGRA);
+	}
+
+	size_t FChunkCodec::WritePayload(const FChunkInfo& Info, const float* Heights, int32_t NumHeights, const FTexelBGRA* Weights, int32_t NumWeights, uint8_t* Out)
+	{
+		FByteWriter Writer(Out);
+		Writer.Write(Version);
+		Writer.Write(Info.GridX);
+		Writer.Write(Info.GridY);
+		Writer.Write(Info.Resolution);
+		Writer.Write(Info.RealWorldSize);
+		Writer.Write(NumHeights);
+		Writer.WriteBytes(Heights, (size_t)NumHeights * sizeof(float));
+		Writer.Write(NumWeights);
+		Writer.WriteBytes(Weights, (size_t)NumWeights * sizeof(FTexelBGRA));
+		return Writer.Tell();
+	}
+
+	bool FChunkCodec::ReadPayload(const uint8_t* Data, size_t Size, FChunkPayloadView& Out)
+	{
+		FByteReader Reader(Data, Size);
+		if (!Reader.Read(Out.Version) || (Out.Version != Version && Out.Version != DeltaVersion)) return false;
+
+		if (!Reader.Read(Out.Info.GridX) || !Reader.Read(Out.Info.GridY) ||
+			!Reader.Read(Out.Info.Resolution) || !Reader.Read(Out.Info.RealWorldSize))
+		{
+			return false;
+		}
+
+		// Callers allocate from these, so a corrupt header must not reach them
+		if (Out.Info.Resolution < 2 || Out.Info.Resolution > MaxResolution) return false;
+		const int64_t MaxCells = (int64_t)Out.Info.Resolution * Out.Info.Resolution;
+
+		if (Out.Version == DeltaVersion)
+		{
+			Out.NumBlockCells = 0;
+			if (!Reader.Read(Out.BaseHash) || !Reader.Read(Out.BlockSize) || !Reader.Read(Out.NumBlocks)) return false;
+			if (Out.BlockSize <= 0 || Out.BlockSize > MaxResolution) return false;
+
+			// Validate every record up front, so UnpackDeltaBlocks() can trust the view
+			const int32_t BlocksPerSide = GetBlocksPerSide(Out.Info.Resolution, Out.BlockSize);
+			const int64_t TotalBlocks = (int64_t)BlocksPerSide * BlocksPerSide;
+			if (Out.NumBlocks < 0 || Out.NumBlocks > TotalBlocks) return false;
+
+			Out.Blocks = Reader.Skip(0);
+			for (int32_t i = 0; i < Out.NumBlocks; i++)
+			{
+				int32_t BlockIndex = 0;
+				if (!Reader.Read(BlockIndex) || BlockIndex < 0 || BlockIndex >= TotalBlocks) return false;
+
+				const FGridRect Rect = GetBlockRect(Out.Info.Resolution, Out.BlockSize, BlockIndex);
+				if (!Reader.Skip(GetBlockRecordSize(Rect) - sizeof(int32_t))) return false;
+				Out.NumBlockCells += (int64_t)(Rect.MaxX - Rect.MinX) * (Rect.MaxY - Rect.MinY);
+			}
+			return Out.Blocks != nullptr;
+		}
+
+		if (!Reader.Read(Out.NumHeights) || Out.NumHeights < 0 || Out.NumHeights > MaxCells) return false;
+		Out.Heights = Reader.Skip((size_t)((int64_t)Out.NumHeights * (int64_t)sizeof(float)));
+		if (!Out.Heights) return false;
+
+		if (!Reader.Read(Out.NumWeights) || Out.NumWeights < 0 || Out.NumWeights > MaxCells) return false;
+		Out.Weights = Reader.Skip((size_t)((int64_t)Out.NumWeights * (int64_t)sizeof(FTexelBGRA)));
+		return Out.Weights != nullptr;
+	}
+
+	int32_t FChunkCodec::GetBlocksPerSide(int32_t Resolution, int32_t BlockSize)
+	{
+		return (Resolution + BlockSize - 1) / BlockSize;
+	}
+
+	FGridRect FChunkCodec::GetBlockRect(int32_t Resolution, int32_t BlockSize, int32_t BlockIndex)
+	{
+		const int32_t BlocksPerSide = GetBlocksPerSide(Resolution, BlockSize);
+
+		FGridRect Rect;
+		Rect.MinX = (BlockIndex % BlocksPerSide) * BlockSize;
+		Rect.MinY = (BlockIndex / BlocksPerSide) * BlockSize;
+		Rect.MaxX = std::min(Rect.MinX + BlockSize, Resolution);
+		Rect.MaxY = std::min(Rect.MinY + BlockSize, Resolution);
+		return Rect;
+	}
+
+	uint64_t FChunkCodec::HashBase(const float* Heights, const FTexelBGRA* Weights, size_t Num)
+	{
+		// FNV-1a over 64-bit words with a final avalanche; the data is little-endian on every platform we ship
+		constexpr uint64_t Prime = 0x100000001B3ull;
+		uint64_t Hash = 0xCBF29CE484222325ull ^ (uint64_t)Num;
+
+		auto HashBytes = [&Hash](const uint8_t* Bytes, size_t Size)
+		{
+			size_t Offset = 0;
+			for (; Offset + sizeof(uint64_t) <= Size; Offset += sizeof(uint64_t))
+			{
+				uint64_t Word;
+				std::memcpy(&Word, Bytes + Offset, sizeof(Word));
+				Hash = (Hash ^ Word) * Prime;
+			}
+			for (; Offset < Size; Offset++)
+			{
+				Hash = (Hash ^ Bytes[Offset]) * Prime;
+			}
+		};
+		HashBytes(reinterpret_cast<const uint8_t*>(Heights), Num * sizeof(float));
+		HashBytes(reinterpret_cast<const uint8_t*>(Weights), Num * sizeof(FTexelBGRA));
+
+		Hash ^= Hash >> 33;
+		Hash *= 0xFF51AFD7ED558CCDull;
+		Hash ^= Hash >> 33;
+		return Hash != 0 ? Hash : 1; // 0 means "no base"
+	}
+
+	size_t FChunkCodec::GetDeltaPayloadSize(int32_t Resolution, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks)
+	{
+		size_t Size = DeltaFixedSize;
+		for (int32_t i = 0; i < NumBlocks; i++)
+		{
+			Size += GetBlockRecordSize(GetBlockRect(Resolution, BlockSize, Blocks[i]));
+		}
+		return Size;
+	}
+
+	size_t FChunkCodec::WriteDeltaPayload(const FChunkInfo& Info, uint64_t BaseHash, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks,
+		const float* Heights, const FTexelBGRA* Weights, uint8_t* Out)
+	{
+		FByteWriter Writer(Out);
+		Writer.Write(DeltaVersion);
+		Writer.Write(Info.GridX);
+		Writer.Write(Info.GridY);
+		Writer.Write(Info.Resolution);
+		Writer.Write(Info.RealWorldSize);
+		Writer.Write(BaseHash);
+		Writer.Write(BlockSize);
+		Writer.Write(NumBlocks);
+
+		for (int32_t i = 0; i < NumBlocks; i++)
+		{
+			const FGridRect Rect = GetBlockRect(Info.Resolution, BlockSize, Blocks[i]);
+			const size_t Width = (size_t)(Rect.MaxX - Rect.MinX);
+
+			Writer.Write(Blocks[i]);
+			for (int32_t Y = Rect.MinY; Y < Rect.MaxY; Y++)
+			{
+				Writer.WriteBytes(Heights + (size_t)Y * Info.Resolution + Rect.MinX, Width * sizeof(float));
+			}
+			for (int32_t Y = Rect.MinY; Y < Rect.MaxY; Y++)
+			{
+				Writer.WriteBytes(Weights + (size_t)Y * Info.Resolution + Rect.MinX, Width * sizeof(FTexelBGRA));
+			}
+		}
+		return Writer.Tell();
+	}
+
+	int64_t FChunkCodec::GetBlockCellCount(int32_t Resolution, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks)
+	{
+		int64_t Cells = 0;
+		for (int32_t i = 0; i < NumBlocks; i++)
+		{
+			const FGridRect Rect = GetBlockRect(Resolution, BlockSize, Blocks[i]);
+			Cells += (int64_t)(Rect.MaxX - Rect.MinX) * (Rect.MaxY - Rect.MinY);
+		}
+		return Cells;
+	}
+
+	void FChunkCodec::UnpackDeltaBlocks(const FChunkPayloadView& Payload, float* PackedHeights, FTexelBGRA* PackedWeights, int32_t* OutBlocks)
+	{
+		const uint8_t* Cursor = Payload.Blocks;
+
+		for (int32_t i = 0; i < Payload.NumBlocks; i++)
+		{
+			int32_t BlockIndex;
+			std::memcpy(&BlockIndex, Cursor, sizeof(BlockIndex));
+			Cursor += sizeof(BlockIndex);
+			OutBlocks[i] = BlockIndex;
+
+			// A record is already the block's heights then its weights, row-major
+			const FGridRect Rect = GetBlockRect(Payload.Info.Resolution, Payload.BlockSize, BlockIndex);
+			const size_t Cells = (size_t)(Rect.MaxX - Rect.MinX) * (size_t)(Rect.MaxY - Rect.MinY);
+			std::memcpy(PackedHeights, Cursor, Cells * sizeof(float));
+			Cursor += Cells * sizeof(float);
+			std::memcpy(static_cast<void*>(PackedWeights), Cursor, Cells * sizeof(FTexelBGRA));
+			Cursor += Cells * sizeof(FTexelBGRA);
+
+			PackedHeights += Cells;
+			PackedWeights += Cells;
+		}
+	}
+
+	void FChunkCodec::ScatterPackedBlocks(int32_t Resolution, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks,
+		const float* PackedHeights, const FTexelBGRA* PackedWeights, float* Heights, FTexelBGRA* Weights)
+	{
+		for (int32_t i = 0; i < NumBlocks; i++)
+		{
+			const FGridRect Rect = GetBlockRect(Resolution, BlockSize, Blocks[i]);
+			const size_t Width = (size_t)(Rect.MaxX - Rect.MinX);
+			for (int32_t Y = Rect.MinY; Y < Rect.MaxY; Y++)
+			{
+				const size_t Row = (size_t)Y * Resolution + Rect.MinX;
+				std::memcpy(Heights + Row, PackedHeights, Width * sizeof(float));
+				std::memcpy(static_cast<void*>(Weights + Row), PackedWeights, Width * sizeof(FTexelBGRA));
+				PackedHeights += Width;
+				PackedWeights += Width;
+			}
+		}
+	}
+
+	size_t FChunkCodec::GetFrameBound(size_t PayloadSize)
+	{
+		return FrameHeaderSize + compressBound((uLong)PayloadSize);
+	}
+
+	bool FChunkCodec::CompressFrame(const uint8_t* Payload, size_t PayloadSize, uint8_t* Out, size_t OutCapacity, size_t& OutFrameSize, int32_t Level)
+	{
+		OutFrameSize = 0;
+		if (OutCapacity < FrameHeaderSize || PayloadSize > (size_t)std::numeric_limits<int32_t>::max()) return false;
+
+		uLongf CompressedSize = (uLongf)(OutCapacity - FrameHeaderSize);
+		if (compress2(Out + FrameHeaderSize, &CompressedSize, Payload, (uLong)PayloadSize, Level) != Z_OK) return false;
+		if (CompressedSize > (uLongf)std::numeric_limits<int32_t>::max()) return false;
+
+		FByteWriter Writer(Out);
+		Writer.Write(FileMagic);
+		Writer.Write((int32_t)PayloadSize);
+		Writer.Write((int32_t)CompressedSize);
+
+		OutFrameSize = FrameHeaderSize + CompressedSize;
+		return true;
+	}
+
+	bool FChunkCodec::ReadFrame(const uint8_t* File, size_t FileSize, FChunkFrameView& Out)
+	{
+		FByteReader Reader(File, FileSize);
+
+		int32_t Magic = 0;
+		if (!Reader.Read(Magic) || Magic != FileMagic) return false;
+		if (!Reader.Read(Out.UncompressedSize) || !Reader.Read(Out.CompressedSize)) return false;
+		if (Out.UncompressedSize <= 0 || Out.CompressedSize <= 0) return false;
+
+		Out.Compressed = Reader.Skip((size_t)Out.CompressedSize);
+		return Out.Compressed != nullptr;
+	}
+
+	bool FChunkCodec::DecompressFrame(const FChunkFrameView& Frame, uint8_t* Out, size_t OutSize)
+	{
+		if (!Frame.Compressed || OutSize != (size_t)Frame.UncompressedSize) return false;
+
+		uLongf DestSize = (uLongf)OutSize;
+		return uncompress(Out, &DestSize, Frame.Compressed, (uLong)Frame.CompressedSize) == Z_OK && DestSize == (uLongf)OutSize;
+	}
+}
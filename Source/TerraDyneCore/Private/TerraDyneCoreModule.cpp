@@ -0,0 +1,4 @@
+// The only engine-facing file of TerraDyneCore; Tools/TerraDyneCore/CMakeLists.txt leaves it out.
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, TerraDyneCore);
@@ -0,0 +1,149 @@
+#include "TerraDyneJournalCodec.h"
+
+#include <cstring>
+
+namespace TerraDyneCore
+{
+	namespace
+	{
+		uint32_t FloatBits(float Value)
+		{
+			uint32_t Bits;
+			std::memcpy(&Bits, &Value, sizeof(Bits));
+			return Bits;
+		}
+
+		float BitsFloat(uint32_t Bits)
+		{
+			float Value;
+			std::memcpy(&Value, &Bits, sizeof(Value));
+			return Value;
+		}
+
+		void PutUInt16(uint16_t Value, uint8_t* Out)
+		{
+			Out[0] = (uint8_t)(Value & 0xFF);
+			Out[1] = (uint8_t)(Value >> 8);
+		}
+
+		bool GetUInt16(const uint8_t* Data, size_t Size, size_t& Offset, uint16_t& OutValue)
+		{
+			if (Offset + 2 > Size) return false;
+			OutValue = (uint16_t)(Data[Offset] | (Data[Offset + 1] << 8));
+			Offset += 2;
+			return true;
+		}
+	}
+
+	size_t FJournalCodec::WriteVarUInt(uint32_t Value, uint8_t* Out)
+	{
+		size_t Written = 0;
+		while (Value >= 0x80)
+		{
+			Out[Written++] = (uint8_t)(Value | 0x80);
+			Value >>= 7;
+		}
+		Out[Written++] = (uint8_t)Value;
+		return Written;
+	}
+
+	bool FJournalCodec::ReadVarUInt(const uint8_t* Data, size_t Size, size_t& Offset, uint32_t& OutValue)
+	{
+		uint32_t Value = 0;
+		size_t Cursor = Offset;
+		for (int32_t Shift = 0; Shift < 35; Shift += 7)
+		{
+			if (Cursor >= Size) return false;
+			const uint8_t Byte = Data[Cursor++];
+
+			// The fifth byte only has room for the top 4 bits
+			if (Shift == 28 && (Byte & 0xF0) != 0) return false;
+
+			Value |= (uint32_t)(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				Offset = Cursor;
+				OutValue = Value;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	uint16_t FJournalCodec::FloatToHalf(float Value)
+	{
+		const uint32_t Bits = FloatBits(Value);
+		const uint16_t Sign = (uint16_t)((Bits >> 16) & 0x8000);
+		uint32_t Magnitude = Bits & 0x7FFFFFFF;
+
+		// Infinity and NaN (quiet, so a NaN never turns into infinity)
+		if (Magnitude >= 0x7F800000)
+		{
+			return Sign | (Magnitude > 0x7F800000 ? 0x7E00 : 0x7C00);
+		}
+
+		// At or past 65520 rounds to infinity
+		if (Magnitude >= 0x477FF000)
+		{
+			return Sign | 0x7C00;
+		}
+
+		// Below the smallest normal half (2^-14): let the FPU round the denormal for us
+		if (Magnitude < 0x38800000)
+		{
+			const float DenormMagic = BitsFloat(((127 - 15) + (23 - 10) + 1) << 23);
+			const float Shifted = BitsFloat(Magnitude) + DenormMagic;
+			return Sign | (uint16_t)(FloatBits(Shifted) - FloatBits(DenormMagic));
+		}
+
+		// Normal: rebias the exponent, round the 13 dropped mantissa bits to nearest even
+		const uint32_t MantissaOdd = (Magnitude >> 13) & 1;
+		Magnitude += ((uint32_t)(15 - 127) << 23) + 0xFFF + MantissaOdd;
+		return Sign | (uint16_t)(Magnitude >> 13);
+	}
+
+	float FJournalCodec::HalfToFloat(uint16_t Half)
+	{
+		const uint32_t Sign = (uint32_t)(Half & 0x8000) << 16;
+		const uint32_t Exponent = (Half >> 10) & 0x1F;
+		const uint32_t Mantissa = Half & 0x3FF;
+
+		if (Exponent == 0)
+		{
+			// Zero or denormal: Mantissa * 2^-24, exact in a float
+			const float Magnitude = (float)Mantissa * (1.0f / 16777216.0f);
+			return BitsFloat(Sign | FloatBits(Magnitude));
+		}
+		if (Exponent == 31)
+		{
+			return BitsFloat(Sign | 0x7F800000 | (Mantissa << 13));
+		}
+		return BitsFloat(Sign | ((Exponent + (127 - 15)) << 23) | (Mantissa << 13));
+	}
+
+	size_t FJournalCodec::WriteRecord(const FJournalRecord& Record, uint8_t* Out)
+	{
+		size_t Written = WriteVarUInt(Record.TickDelta, Out);
+		Out[Written++] = Record.Op;
+		Written += WriteVarUInt(ZigZag(Record.DX), Out + Written);
+		Written += WriteVarUInt(ZigZag(Record.DY), Out + Written);
+		PutUInt16(Record.Radius, Out + Written);
+		PutUInt16(Record.Strength, Out + Written + 2);
+		return Written + 4;
+	}
+
+	bool FJournalCodec::ReadRecord(const uint8_t* Data, size_t Size, size_t& Offset, FJournalRecord& Out)
+	{
+		size_t Cursor = Offset;
+		uint32_t DX, DY;
+		if (!ReadVarUInt(Data, Size, Cursor, Out.TickDelta) || Cursor >= Size) return false;
+		Out.Op = Data[Cursor++];
+		if (!ReadVarUInt(Data, Size, Cursor, DX) || !ReadVarUInt(Data, Size, Cursor, DY)) return false;
+		if (!GetUInt16(Data, Size, Cursor, Out.Radius) || !GetUInt16(Data, Size, Cursor, Out.Strength)) return false;
+
+		Out.DX = UnZigZag(DX);
+		Out.DY = UnZigZag(DY);
+		Offset = Cursor;
+		return true;
+	}
+}
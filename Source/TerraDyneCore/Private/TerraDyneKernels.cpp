@@ -0,0 +1,266 @@
+#include "TerraDyneKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TERRADYNECORE_SSE2 1
+#include <emmintrin.h>
+#else
+#define TERRADYNECORE_SSE2 0
+#endif
+
+namespace TerraDyneCore
+{
+	/** Halves round up, like FMath::RoundToInt, so results match the engine-side code bit for bit. */
+	static inline int32_t RoundToInt(float Value)
+	{
+		return (int32_t)std::floor(Value + 0.5f);
+	}
+
+	//--- Brushes ---//
+
+	FBrushFootprint MakeBrushFootprint(float LocalX, float LocalY, float WorldRadius, float ChunkSize, int32_t Resolution)
+	{
+		FBrushFootprint Brush;
+		if (Resolution < 1 || ChunkSize <= 0.0f) return Brush;
+
+		const float HalfSize = ChunkSize * 0.5f;
+		const float CellsPerUnit = (float)(Resolution - 1) / ChunkSize;
+		Brush.CenterX = (LocalX + HalfSize) * CellsPerUnit;
+		Brush.CenterY = (LocalY + HalfSize) * CellsPerUnit;
+		Brush.Radius = WorldRadius * CellsPerUnit;
+
+		const int32_t Last = Resolution - 1;
+		Brush.Rect.MinX = std::clamp((int32_t)std::floor(Brush.CenterX - Brush.Radius), 0, Last);
+		Brush.Rect.MinY = std::clamp((int32_t)std::floor(Brush.CenterY - Brush.Radius), 0, Last);
+		Brush.Rect.MaxX = std::clamp((int32_t)std::ceil(Brush.CenterX + Brush.Radius), 0, Last) + 1;
+		Brush.Rect.MaxY = std::clamp((int32_t)std::ceil(Brush.CenterY + Brush.Radius), 0, Last) + 1;
+		return Brush;
+	}
+
+	FBrushResult ApplyHeightBrush(TGridView<float> Heights, const FBrushFootprint& Brush, float Strength)
+	{
+		FBrushResult Result;
+		if (!Heights.IsValid() || Brush.Radius <= 0.0f) return Result;
+
+		const float RadiusSq = Brush.Radius * Brush.Radius;
+		const float InvRadius = 1.0f / Brush.Radius;
+
+		for (int32_t y = Brush.Rect.MinY; y < Brush.Rect.MaxY; y++)
+		{
+			const float Dy = (float)y - Brush.CenterY;
+			float* Row = &Heights(0, y);
+
+			for (int32_t x = Brush.Rect.MinX; x < Brush.Rect.MaxX; x++)
+			{
+				const float Dx = (float)x - Brush.CenterX;
+				const float DistSq = Dx * Dx + Dy * Dy;
+				if (DistSq > RadiusSq) continue;
+
+				const float Delta = Strength * (1.0f - std::sqrt(DistSq) * InvRadius);
+				Row[x] += Delta;
+				Result.MaxDelta = std::max(Result.MaxDelta, std::fabs(Delta));
+				Result.bModified = true;
+			}
+		}
+		return Result;
+	}
+
+	bool ApplyPaintBrush(TGridView<FTexelBGRA> Weights, const FBrushFootprint& Brush, float Strength, int32_t Layer)
+	{
+		if (!Weights.IsValid() || Layer < 0 || Layer > 3 || Brush.Radius <= 0.0f) return false;
+
+		const float RadiusSq = Brush.Radius * Brush.Radius;
+		const float InvRadius = 1.0f / Brush.Radius;
+
+		for (int32_t y = Brush.Rect.MinY; y < Brush.Rect.MaxY; y++)
+		{
+			const float Dy = (float)y - Brush.CenterY;
+			FTexelBGRA* Row = &Weights(0, y);
+
+			for (int32_t x = Brush.Rect.MinX; x < Brush.Rect.MaxX; x++)
+			{
+				const float Dx = (float)x - Brush.CenterX;
+				const float DistSq = Dx * Dx + Dy * Dy;
+				if (DistSq > RadiusSq) continue;
+
+				uint8_t& Channel = Row[x].Layer(Layer);
+				const int32_t Delta = RoundToInt(Strength * (1.0f - std::sqrt(DistSq) * InvRadius) * 255.0f);
+				Channel = (uint8_t)std::clamp((int32_t)Channel + Delta, 0, 255);
+			}
+		}
+		return true;
+	}
+
+	//--- Resampling ---//
+
+	/** Integer tap and fractional weight of every output column/row, padded to a multiple of 4. */
+	static void BuildTaps(int32_t SrcCount, int32_t DstRes, std::vector<int32_t>& OutIndex, std::vector<float>& OutFrac)
+	{
+		const size_t Padded = ((size_t)DstRes + 3) & ~(size_t)3;
+		OutIndex.assign(Padded, 0);
+		OutFrac.assign(Padded, 0.0f);
+
+		const float Scale = (DstRes > 1) ? (float)(SrcCount - 1) / (float)(DstRes - 1) : 0.0f;
+		const int32_t LastTap = std::max(SrcCount - 2, 0);
+
+		for (int32_t i = 0; i < DstRes; i++)
+		{
+			const float S = i * Scale;
+			const int32_t I0 = std::min((int32_t)std::floor(S), LastTap);
+			OutIndex[i] = I0;
+			OutFrac[i] = (SrcCount > 1) ? std::clamp(S - I0, 0.0f, 1.0f) : 0.0f;
+		}
+	}
+
+	static inline float Lerp(float A, float B, float Alpha)
+	{
+		return A + (B - A) * Alpha;
+	}
+
+	void ResampleBilinear(const float* Src, int32_t SrcWidth, int32_t SrcHeight, float* Dst, int32_t DstRes)
+	{
+		if (!Src || !Dst || SrcWidth <= 0 || SrcHeight <= 0 || DstRes <= 0) return;
+
+		std::vector<int32_t> XTap, YTap;
+		std::vector<float> XFrac, YFrac;
+		BuildTaps(SrcWidth, DstRes, XTap, XFrac);
+		BuildTaps(SrcHeight, DstRes, YTap, YFrac);
+
+		// Single-column sources have no right-hand neighbour
+		const int32_t XStep = SrcWidth > 1 ? 1 : 0;
+		const int32_t YStep = SrcHeight > 1 ? SrcWidth : 0;
+
+		for (int32_t Y = 0; Y < DstRes; Y++)
+		{
+			const float* Row0 = Src + (size_t)YTap[Y] * SrcWidth;
+			const float* Row1 = Row0 + YStep;
+			float* Out = Dst + (size_t)Y * DstRes;
+			const float Fy = YFrac[Y];
+
+			int32_t X = 0;
+#if TERRADYNECORE_SSE2
+			const int32_t VectorEnd = DstRes & ~3;
+			const __m128 VFy = _mm_set1_ps(Fy);
+			for (; X < VectorEnd; X += 4)
+			{
+				const int32_t* T = &XTap[X];
+
+				// Gather the 4 taps for 4 output samples (set_ps takes lanes high to low)
+				const __m128 A = _mm_set_ps(Row0[T[3]], Row0[T[2]], Row0[T[1]], Row0[T[0]]);
+				const __m128 B = _mm_set_ps(Row0[T[3] + XStep], Row0[T[2] + XStep], Row0[T[1] + XStep], Row0[T[0] + XStep]);
+				const __m128 C = _mm_set_ps(Row1[T[3]], Row1[T[2]], Row1[T[1]], Row1[T[0]]);
+				const __m128 D = _mm_set_ps(Row1[T[3] + XStep], Row1[T[2] + XStep], Row1[T[1] + XStep], Row1[T[0] + XStep]);
+
+				const __m128 Fx = _mm_loadu_ps(&XFrac[X]);
+				const __m128 Top = _mm_add_ps(A, _mm_mul_ps(_mm_sub_ps(B, A), Fx));
+				const __m128 Bottom = _mm_add_ps(C, _mm_mul_ps(_mm_sub_ps(D, C), Fx));
+				_mm_storeu_ps(Out + X, _mm_add_ps(Top, _mm_mul_ps(_mm_sub_ps(Bottom, Top), VFy)));
+			}
+#endif
+			// Scalar tail (or the whole row without SSE2)
+			for (; X < DstRes; X++)
+			{
+				const int32_t T = XTap[X];
+				const float Top = Lerp(Row0[T], Row0[T + XStep], XFrac[X]);
+				const float Bottom = Lerp(Row1[T], Row1[T + XStep], XFrac[X]);
+				Out[X] = Lerp(Top, Bottom, Fy);
+			}
+		}
+	}
+
+	void ResampleBilinear(const FTexelBGRA* Src, int32_t SrcWidth, int32_t SrcHeight, FTexelBGRA* Dst, int32_t DstRes)
+	{
+		if (!Src || !Dst || SrcWidth <= 0 || SrcHeight <= 0 || DstRes <= 0) return;
+
+		std::vector<int32_t> XTap, YTap;
+		std::vector<float> XFrac, YFrac;
+		BuildTaps(SrcWidth, DstRes, XTap, XFrac);
+		BuildTaps(SrcHeight, DstRes, YTap, YFrac);
+
+		const int32_t XStep = SrcWidth > 1 ? 1 : 0;
+		const int32_t YStep = SrcHeight > 1 ? SrcWidth : 0;
+
+		for (int32_t Y = 0; Y < DstRes; Y++)
+		{
+			const FTexelBGRA* Row0 = Src + (size_t)YTap[Y] * SrcWidth;
+			const FTexelBGRA* Row1 = Row0 + YStep;
+			FTexelBGRA* Out = Dst + (size_t)Y * DstRes;
+
+#if TERRADYNECORE_SSE2
+			const __m128 Fy = _mm_set1_ps(YFrac[Y]);
+			const __m128 Half = _mm_set1_ps(0.5f);
+			const __m128i Zero = _mm_setzero_si128();
+
+			// One texel = one register (B, G, R, A lanes keep their memory order)
+			auto Load = [Zero](const FTexelBGRA* Texel)
+			{
+				int32_t Bits;
+				std::memcpy(&Bits, Texel, sizeof(Bits));
+				const __m128i Bytes = _mm_cvtsi32_si128(Bits);
+				return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(Bytes, Zero), Zero));
+			};
+
+			for (int32_t X = 0; X < DstRes; X++)
+			{
+				const int32_t T = XTap[X];
+				const __m128 A = Load(&Row0[T]);
+				const __m128 B = Load(&Row0[T + XStep]);
+				const __m128 C = Load(&Row1[T]);
+				const __m128 D = Load(&Row1[T + XStep]);
+
+				const __m128 Fx = _mm_set1_ps(XFrac[X]);
+				const __m128 Top = _mm_add_ps(A, _mm_mul_ps(_mm_sub_ps(B, A), Fx));
+				const __m128 Bottom = _mm_add_ps(C, _mm_mul_ps(_mm_sub_ps(D, C), Fx));
+				const __m128 Result = _mm_add_ps(Top, _mm_mul_ps(_mm_sub_ps(Bottom, Top), Fy));
+
+				// Round to nearest before the truncating conversion, then narrow 32 -> 8 bits
+				const __m128i Ints = _mm_cvttps_epi32(_mm_add_ps(Result, Half));
+				const __m128i Packed = _mm_packus_epi16(_mm_packs_epi32(Ints, Zero), Zero);
+				const int32_t Bits = _mm_cvtsi128_si32(Packed);
+				std::memcpy(static_cast<void*>(&Out[X]), &Bits, sizeof(Bits));
+			}
+#else
+			const float Fy = YFrac[Y];
+			for (int32_t X = 0; X < DstRes; X++)
+			{
+				const int32_t T = XTap[X];
+				const uint8_t* A = &Row0[T].B;
+				const uint8_t* B = &Row0[T + XStep].B;
+				const uint8_t* C = &Row1[T].B;
+				const uint8_t* D = &Row1[T + XStep].B;
+				uint8_t* O = &Out[X].B;
+
+				for (int32_t Lane = 0; Lane < 4; Lane++)
+				{
+					const float Top = Lerp(A[Lane], B[Lane], XFrac[X]);
+					const float Bottom = Lerp(C[Lane], D[Lane], XFrac[X]);
+					O[Lane] = (uint8_t)std::clamp((int32_t)(Lerp(Top, Bottom, Fy) + 0.5f), 0, 255);
+				}
+			}
+#endif
+		}
+	}
+
+	//--- Quantization ---//
+
+	void DequantizeHeights(const uint16_t* Src, float* Dst, size_t Num, float Step)
+	{
+		for (size_t i = 0; i < Num; i++)
+		{
+			Dst[i] = (float)Src[i] * Step;
+		}
+	}
+
+	void QuantizeHeights(const float* Src, uint16_t* Dst, size_t Num, float Step)
+	{
+		const float InvStep = Step != 0.0f ? 1.0f / Step : 0.0f;
+		for (size_t i = 0; i < Num; i++)
+		{
+			Dst[i] = (uint16_t)std::clamp(RoundToInt(Src[i] * InvStep), 0, 65535);
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#include "TerraDyneRegionLayout.h"
+
+#include <cstring>
+
+namespace TerraDyneCore
+{
+	namespace
+	{
+		template <typename T>
+		void Put(uint8_t*& Out, const T& Value)
+		{
+			std::memcpy(Out, &Value, sizeof(T));
+			Out += sizeof(T);
+		}
+
+		template <typename T>
+		T Get(const uint8_t*& Data)
+		{
+			T Value;
+			std::memcpy(&Value, Data, sizeof(T));
+			Data += sizeof(T);
+			return Value;
+		}
+	}
+
+	FRegionHeader FRegionFileLayout::MakeEmptyHeader()
+	{
+		FRegionHeader Header;
+		Header.IndexOffset = (int64_t)HeaderSize;
+		Header.CommittedEnd = (int64_t)HeaderSize;
+		return Header;
+	}
+
+	void FRegionFileLayout::WriteHeader(const FRegionHeader& Header, uint8_t* Out)
+	{
+		Put(Out, FileMagic);
+		Put(Out, Version);
+		Put(Out, Header.NumEntries);
+		Put(Out, (int32_t)0);
+		Put(Out, Header.IndexOffset);
+		Put(Out, Header.CommittedEnd);
+	}
+
+	bool FRegionFileLayout::ReadHeader(const uint8_t* Data, size_t Size, int64_t FileSize, FRegionHeader& Out)
+	{
+		if (Size < HeaderSize) return false;
+		if (Get<int32_t>(Data) != FileMagic || Get<int32_t>(Data) != Version) return false;
+
+		Out.NumEntries = Get<int32_t>(Data);
+		Get<int32_t>(Data); // Reserved
+		Out.IndexOffset = Get<int64_t>(Data);
+		Out.CommittedEnd = Get<int64_t>(Data);
+
+		return Out.NumEntries >= 0 &&
+			Out.IndexOffset >= (int64_t)HeaderSize &&
+			Out.CommittedEnd == Out.IndexOffset + (int64_t)GetIndexSize(Out.NumEntries) &&
+			Out.CommittedEnd <= FileSize;
+	}
+
+	void FRegionFileLayout::WriteIndex(const FRegionEntry* Entries, int32_t NumEntries, uint8_t* Out)
+	{
+		for (int32_t i = 0; i < NumEntries; i++)
+		{
+			Put(Out, Entries[i].GridX);
+			Put(Out, Entries[i].GridY);
+			Put(Out, Entries[i].Offset);
+			Put(Out, Entries[i].Size);
+			Put(Out, (int32_t)0);
+		}
+	}
+
+	bool FRegionFileLayout::ReadIndex(const uint8_t* Data, size_t Size, const FRegionHeader& Header, FRegionEntry* Out)
+	{
+		if (Size < GetIndexSize(Header.NumEntries)) return false;
+
+		for (int32_t i = 0; i < Header.NumEntries; i++)
+		{
+			FRegionEntry& Entry = Out[i];
+			Entry.GridX = Get<int32_t>(Data);
+			Entry.GridY = Get<int32_t>(Data);
+			Entry.Offset = Get<int64_t>(Data);
+			Entry.Size = Get<int32_t>(Data);
+			Get<int32_t>(Data); // Reserved
+
+			// Frames live between the header and the index they are listed in
+			if (Entry.Size <= 0 || Entry.Offset < (int64_t)HeaderSize || Entry.Offset + Entry.Size > Header.IndexOffset) return false;
+		}
+		return true;
+	}
+}
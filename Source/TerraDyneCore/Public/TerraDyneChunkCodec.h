@@ -0,0 +1,135 @@
+#pragma once
+
+#include "TerraDyneCoreTypes.h"
+
+namespace TerraDyneCore
+{
+	/** Identity of a saved chunk. */
+	struct FChunkInfo
+	{
+		int32_t GridX = 0;
+		int32_t GridY = 0;
+		int32_t Resolution = 0;
+		float RealWorldSize = 0.0f;
+	};
+
+	/**
+	 * Zero-copy view of a decoded payload. The arrays point into the payload buffer and are
+	 * not necessarily aligned, so copy them out with memcpy.
+	 *
+	 * Version 1 fills Heights/Weights. Version 2 (delta) fills BaseHash/BlockSize/Blocks instead;
+	 * copy it out with FChunkCodec::UnpackDeltaBlocks().
+	 */
+	struct FChunkPayloadView
+	{
+		int32_t Version = 0;
+		FChunkInfo Info;
+		const uint8_t* Heights = nullptr; // NumHeights floats
+		int32_t NumHeights = 0;
+		const uint8_t* Weights = nullptr; // NumWeights FTexelBGRA
+		int32_t NumWeights = 0;
+
+		uint64_t BaseHash = 0;            // FChunkCodec::HashBase() of the state the blocks overlay
+		int32_t BlockSize = 0;
+		const uint8_t* Blocks = nullptr;  // NumBlocks records (see FChunkCodec)
+		int32_t NumBlocks = 0;
+		int64_t NumBlockCells = 0;        // Cells over all records: the packed size for UnpackDeltaBlocks()
+
+		bool IsDelta() const { return BlockSize > 0; }
+	};
+
+	/** The frame around a compressed payload, as found in a chunk file. */
+	struct FChunkFrameView
+	{
+		int32_t UncompressedSize = 0;
+		const uint8_t* Compressed = nullptr;
+		int32_t CompressedSize = 0;
+	};
+
+	/**
+	 * FChunkCodec
+	 *
+	 * The chunk file format, independent of FArchive:
+	 *
+	 *   Frame:   int32 Magic "TDYN", int32 UncompressedSize, int32 CompressedSize, zlib stream
+	 *   Payload: int32 Version (1), int32 GridX, int32 GridY, int32 Resolution, float RealWorldSize,
+	 *            int32 NumHeights, float[NumHeights], int32 NumWeights, BGRA8[NumWeights]
+	 *   Delta:   int32 Version (2), int32 GridX, int32 GridY, int32 Resolution, float RealWorldSize,
+	 *            uint64 BaseHash, int32 BlockSize, int32 NumBlocks,
+	 *            NumBlocks x { int32 BlockIndex, float[W*H], BGRA8[W*H] }
+	 *
+	 * A delta payload only holds the BlockSize^2 blocks (row-major, clipped at the far edges) that differ
+	 * from a known base state, e.g. the baked tile. The reader needs that base: it checks BaseHash and
+	 * copies the blocks over it. Without a base, chunks are written as version 1.
+	 *
+	 * Resolution is at most MaxResolution, and counts are checked against it before anything is sized from them.
+	 * All integers and floats are little-endian, byte-identical to what FArchive << writes for the same fields.
+	 * Every function works on caller-provided buffers, so the engine side can hand in pooled memory.
+	 */
+	class TERRADYNECORE_API FChunkCodec
+	{
+	public:
+		static constexpr int32_t FileMagic = 0x5444594E; // "TDYN"
+		static constexpr int32_t Version = 1;
+		static constexpr int32_t DeltaVersion = 2;
+		static constexpr int32_t DeltaBlockSize = 16;
+		static constexpr int32_t MaxResolution = 8193;
+		static constexpr size_t FrameHeaderSize = 3 * sizeof(int32_t);
+
+		/** Exact payload bytes for the given array sizes. */
+		static size_t GetPayloadSize(int32_t NumHeights, int32_t NumWeights);
+
+		/** Writes the payload into Out (GetPayloadSize() bytes) and returns the bytes written. */
+		static size_t WritePayload(const FChunkInfo& Info, const float* Heights, int32_t NumHeights, const FTexelBGRA* Weights, int32_t NumWeights, uint8_t* Out);
+
+		/**
+		 * Parses a version 1 or 2 payload without copying. False on truncation, an unknown version (Out.Version is
+		 * still set), a Resolution outside [2, MaxResolution], more than Resolution^2 cells or blocks, or a bad block.
+		 */
+		static bool ReadPayload(const uint8_t* Data, size_t Size, FChunkPayloadView& Out);
+
+		//--- Delta Payloads ---//
+
+		/** Blocks along one side of a Resolution^2 grid. */
+		static int32_t GetBlocksPerSide(int32_t Resolution, int32_t BlockSize);
+
+		/** Cells covered by a block (row-major index), clipped to the grid. */
+		static FGridRect GetBlockRect(int32_t Resolution, int32_t BlockSize, int32_t BlockIndex);
+
+		/** Identifies a base state; stable across runs and platforms for identical data. Never returns 0. */
+		static uint64_t HashBase(const float* Heights, const FTexelBGRA* Weights, size_t Num);
+
+		/** Exact delta payload bytes for the given blocks. */
+		static size_t GetDeltaPayloadSize(int32_t Resolution, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks);
+
+		/** Copies the listed blocks of full Resolution^2 grids into a delta payload in Out and returns the bytes written. */
+		static size_t WriteDeltaPayload(const FChunkInfo& Info, uint64_t BaseHash, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks,
+			const float* Heights, const FTexelBGRA* Weights, uint8_t* Out);
+
+		/** Cells covered by the listed blocks: the size of their packed form. */
+		static int64_t GetBlockCellCount(int32_t Resolution, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks);
+
+		/**
+		 * Copies the blocks of a delta payload out packed: block after block in payload order, each block's cells
+		 * row-major (GetBlockCellCount() entries per array). Writes the block indices to OutBlocks
+		 * (Payload.NumBlocks entries). Only the blocks are held, never a full grid.
+		 */
+		static void UnpackDeltaBlocks(const FChunkPayloadView& Payload, float* PackedHeights, FTexelBGRA* PackedWeights, int32_t* OutBlocks);
+
+		/** Copies packed blocks (as UnpackDeltaBlocks() lays them out) into full Resolution^2 grids; other cells are untouched. */
+		static void ScatterPackedBlocks(int32_t Resolution, int32_t BlockSize, const int32_t* Blocks, int32_t NumBlocks,
+			const float* PackedHeights, const FTexelBGRA* PackedWeights, float* Heights, FTexelBGRA* Weights);
+
+		/** Worst-case frame size (header + zlib bound) for a payload. */
+		static size_t GetFrameBound(size_t PayloadSize);
+
+		/** Compresses Payload into a complete frame in Out. Level is a zlib level (-1 = default). */
+		static bool CompressFrame(const uint8_t* Payload, size_t PayloadSize, uint8_t* Out, size_t OutCapacity, size_t& OutFrameSize, int32_t Level = -1);
+
+		/** Validates the magic and sizes of a frame and locates its compressed bytes. */
+		static bool ReadFrame(const uint8_t* File, size_t FileSize, FChunkFrameView& Out);
+
+		/** Inflates a frame into Out, which must hold exactly Frame.UncompressedSize bytes. */
+		static bool DecompressFrame(const FChunkFrameView& Frame, uint8_t* Out, size_t OutSize);
+	};
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// NOTE: Engine-independent. Nothing under Source/TerraDyneCore may include Unreal headers
+// (except TerraDyneCoreModule.cpp), so the library also builds standalone from Tools/TerraDyneCore.
+
+#ifndef TERRADYNECORE_API
+#define TERRADYNECORE_API
+#endif
+
+namespace TerraDyneCore
+{
+	/** One weight texel in FColor memory order (B, G, R, A). Layer 0..3 = R, G, B, A. */
+	struct FTexelBGRA
+	{
+		uint8_t B = 0;
+		uint8_t G = 0;
+		uint8_t R = 0;
+		uint8_t A = 0;
+
+		uint8_t& Layer(int32_t Index)
+		{
+			return Index == 0 ? R : Index == 1 ? G : Index == 2 ? B : A;
+		}
+
+		bool operator==(const FTexelBGRA& Other) const
+		{
+			return B == Other.B && G == Other.G && R == Other.R && A == Other.A;
+		}
+	};
+	static_assert(sizeof(FTexelBGRA) == 4, "FTexelBGRA must match FColor");
+
+	/** Half-open grid rectangle [Min, Max). */
+	struct FGridRect
+	{
+		int32_t MinX = 0;
+		int32_t MinY = 0;
+		int32_t MaxX = 0;
+		int32_t MaxY = 0;
+
+		bool IsEmpty() const { return MaxX <= MinX || MaxY <= MinY; }
+	};
+
+	/**
+	 * TGridView
+	 *
+	 * Non-owning row-major view of a Width x Height grid. Wraps TArray / std::vector storage
+	 * without copying; the caller keeps the memory alive.
+	 */
+	template <typename T>
+	struct TGridView
+	{
+		T* Data = nullptr;
+		int32_t Width = 0;
+		int32_t Height = 0;
+
+		TGridView() = default;
+		TGridView(T* InData, int32_t InWidth, int32_t InHeight) : Data(InData), Width(InWidth), Height(InHeight) {}
+
+		/** Square grid (chunk caches). */
+		TGridView(T* InData, int32_t InResolution) : Data(InData), Width(InResolution), Height(InResolution) {}
+
+		bool IsValid() const { return Data && Width > 0 && Height > 0; }
+		size_t Num() const { return (size_t)Width * (size_t)Height; }
+
+		T& operator()(int32_t X, int32_t Y) const { return Data[(size_t)Y * Width + X]; }
+	};
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "TerraDyneCoreTypes.h"
+
+namespace TerraDyneCore
+{
+	/** Op byte of a journal record: bits 0-1 op, bits 2-3 paint layer. */
+	enum EJournalOp : uint8_t
+	{
+		JournalOpHeight = 0,
+		JournalOpHole = 1,
+		JournalOpPaint = 2
+	};
+
+	/** One edit as stored in the stream, relative to the record before it. */
+	struct FJournalRecord
+	{
+		uint32_t TickDelta = 0;
+		uint8_t Op = 0;
+		int32_t DX = 0;       // Position delta, 1 world unit steps
+		int32_t DY = 0;
+		uint16_t Radius = 0;  // World units
+		uint16_t Strength = 0; // IEEE half (FJournalCodec::FloatToHalf)
+	};
+
+	/**
+	 * FJournalCodec
+	 *
+	 * The edit journal stream record, independent of FArchive:
+	 *
+	 *   varuint TickDelta, uint8 Op, varint DX, varint DY, uint16 Radius, uint16 Strength (half)
+	 *
+	 * varuint is LEB128 (7 bits per byte, low first), varint is zigzag + varuint, uint16s are
+	 * little-endian. Typical records take 8-12 bytes.
+	 */
+	class TERRADYNECORE_API FJournalCodec
+	{
+	public:
+		static constexpr size_t MaxVarUIntSize = 5;
+		static constexpr size_t MaxRecordSize = MaxVarUIntSize * 3 + 1 + 2 * sizeof(uint16_t);
+
+		static uint32_t ZigZag(int32_t Value) { return ((uint32_t)Value << 1) ^ (uint32_t)(Value >> 31); }
+		static int32_t UnZigZag(uint32_t Value) { return (int32_t)(Value >> 1) ^ -(int32_t)(Value & 1); }
+
+		/** Writes Value into Out (MaxVarUIntSize bytes) and returns the bytes written. */
+		static size_t WriteVarUInt(uint32_t Value, uint8_t* Out);
+
+		/** Reads at Offset and advances it. False on truncation or more than 32 bits. */
+		static bool ReadVarUInt(const uint8_t* Data, size_t Size, size_t& Offset, uint32_t& OutValue);
+
+		/** float -> IEEE 754 half, rounded to nearest even; overflow becomes infinity, NaN stays NaN. */
+		static uint16_t FloatToHalf(float Value);
+
+		/** IEEE 754 half -> float (exact). */
+		static float HalfToFloat(uint16_t Half);
+
+		/** Writes a record into Out (MaxRecordSize bytes) and returns the bytes written. */
+		static size_t WriteRecord(const FJournalRecord& Record, uint8_t* Out);
+
+		/** Reads the record at Offset and advances it past. False (Offset untouched) on a truncated record. */
+		static bool ReadRecord(const uint8_t* Data, size_t Size, size_t& Offset, FJournalRecord& Out);
+	};
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "TerraDyneCoreTypes.h"
+
+namespace TerraDyneCore
+{
+	//--- Brushes ---//
+
+	/** A circular brush mapped onto a chunk grid: center and radius in grid cells, plus the clamped cell rect to visit. */
+	struct FBrushFootprint
+	{
+		float CenterX = 0.0f;
+		float CenterY = 0.0f;
+		float Radius = 0.0f;
+		FGridRect Rect; // Every cell the circle may touch, clamped to the grid (half-open)
+	};
+
+	/** Outcome of a height brush. */
+	struct FBrushResult
+	{
+		bool bModified = false;
+		float MaxDelta = 0.0f; // Largest absolute height change of any cell
+	};
+
+	/**
+	 * Maps a brush in chunk-local space (origin at the chunk center) onto a Resolution^2 grid spanning ChunkSize.
+	 * Cell (0,0) sits at (-ChunkSize/2, -ChunkSize/2), cell (Res-1, Res-1) at the opposite corner.
+	 */
+	TERRADYNECORE_API FBrushFootprint MakeBrushFootprint(float LocalX, float LocalY, float WorldRadius, float ChunkSize, int32_t Resolution);
+
+	/** Adds Strength * (1 - d / r) to every cell within the footprint (linear cone falloff). */
+	TERRADYNECORE_API FBrushResult ApplyHeightBrush(TGridView<float> Heights, const FBrushFootprint& Brush, float Strength);
+
+	/**
+	 * Adds Strength * (1 - d / r) * 255 (rounded) to one weight layer within the footprint, saturating at 0..255.
+	 * Returns false for an invalid layer (outside 0..3; the pre-split inline loop sent those to A, but
+	 * ATerraDyneChunk::ApplyPaintBrush has always rejected them first) or a zero radius.
+	 */
+	TERRADYNECORE_API bool ApplyPaintBrush(TGridView<FTexelBGRA> Weights, const FBrushFootprint& Brush, float Strength, int32_t Layer);
+
+	//--- Resampling ---//
+
+	/**
+	 * Bilinear resample of a float grid onto a square DstRes^2 grid. Corners map to corners:
+	 * Src(0,0) -> Dst(0,0), Src(W-1,H-1) -> Dst(Res-1,Res-1). Uses SSE2 where available (4 outputs per step).
+	 * Pure and thread-safe.
+	 */
+	TERRADYNECORE_API void ResampleBilinear(const float* Src, int32_t SrcWidth, int32_t SrcHeight, float* Dst, int32_t DstRes);
+
+	/** Bilinear resample of an 8-bit BGRA grid; all four channels are filtered together and rounded to nearest. */
+	TERRADYNECORE_API void ResampleBilinear(const FTexelBGRA* Src, int32_t SrcWidth, int32_t SrcHeight, FTexelBGRA* Dst, int32_t DstRes);
+
+	//--- Quantization ---//
+
+	/** World units per uint16 step of a tile baked with ZScale (the full range spans ZScale * 512). */
+	inline float GetHeightQuantizationStep(float ZScale)
+	{
+		return (ZScale * 512.0f) / 65535.0f;
+	}
+
+	/** Dst[i] = Src[i] * Step */
+	TERRADYNECORE_API void DequantizeHeights(const uint16_t* Src, float* Dst, size_t Num, float Step);
+
+	/** Dst[i] = clamp(round(Src[i] / Step), 0, 65535) */
+	TERRADYNECORE_API void QuantizeHeights(const float* Src, uint16_t* Dst, size_t Num, float Step);
+}
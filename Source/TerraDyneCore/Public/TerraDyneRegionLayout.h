@@ -0,0 +1,61 @@
+#pragma once
+
+#include "TerraDyneCoreTypes.h"
+
+namespace TerraDyneCore
+{
+	/** Fixed header at offset 0 of a region file. */
+	struct FRegionHeader
+	{
+		int32_t NumEntries = 0;
+		int64_t IndexOffset = 0;   // Start of the committed index
+		int64_t CommittedEnd = 0;  // End of the committed index; anything past it was never committed
+	};
+
+	/** One chunk frame (FChunkCodec frame) inside a region file. */
+	struct FRegionEntry
+	{
+		int32_t GridX = 0;
+		int32_t GridY = 0;
+		int64_t Offset = 0;
+		int32_t Size = 0;
+	};
+
+	/**
+	 * FRegionFileLayout
+	 *
+	 * All chunk files of a save slot in one container:
+	 *
+	 *   Header:  int32 Magic "TDRG", int32 Version (1), int32 NumEntries, int32 Reserved,
+	 *            int64 IndexOffset, int64 CommittedEnd                                   (32 bytes)
+	 *   Data:    chunk frames, appended back to back
+	 *   Index:   NumEntries x { int32 GridX, int32 GridY, int64 Offset, int32 Size, int32 Reserved }
+	 *
+	 * Saves append frames after CommittedEnd and then append a fresh index; the header is rewritten
+	 * last, so a crash mid-save leaves the previous index intact. Superseded frames and old indices
+	 * are dead bytes until the file is compacted.
+	 */
+	class TERRADYNECORE_API FRegionFileLayout
+	{
+	public:
+		static constexpr int32_t FileMagic = 0x47524454; // "TDRG"
+		static constexpr int32_t Version = 1;
+		static constexpr size_t HeaderSize = 32;
+		static constexpr size_t EntrySize = 24;
+
+		/** Header of a file that holds no chunks yet. */
+		static FRegionHeader MakeEmptyHeader();
+
+		static void WriteHeader(const FRegionHeader& Header, uint8_t* Out);
+
+		/** False on a bad magic/version, truncation or offsets that don't fit FileSize. */
+		static bool ReadHeader(const uint8_t* Data, size_t Size, int64_t FileSize, FRegionHeader& Out);
+
+		static size_t GetIndexSize(int32_t NumEntries) { return (size_t)NumEntries * EntrySize; }
+
+		static void WriteIndex(const FRegionEntry* Entries, int32_t NumEntries, uint8_t* Out);
+
+		/** Reads Header.NumEntries entries; false if any of them points outside the data section. */
+		static bool ReadIndex(const uint8_t* Data, size_t Size, const FRegionHeader& Header, FRegionEntry* Out);
+	};
+}
@@ -0,0 +1,16 @@
+using UnrealBuildTool;
+
+public class TerraDyneCore : ModuleRules
+{
+	public TerraDyneCore(ReadOnlyTargetRules Target) : base(Target)
+	{
+		// Plain C++17: the same sources build outside the engine (Tools/TerraDyneCore/CMakeLists.txt)
+		PCHUsage = PCHUsageMode.NoPCHs;
+
+		PrivateDependencyModuleNames.AddRange(new string[] {
+			"Core"
+		});
+
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+	}
+}
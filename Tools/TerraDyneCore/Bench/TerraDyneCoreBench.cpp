@@ -0,0 +1,218 @@
+// Micro-benchmarks of the engine-independent TerraDyne core.
+//
+//   TerraDyneCoreBench               full run
+//   TerraDyneCoreBench --quick       a few iterations of everything (ctest smoke test)
+//   TerraDyneCoreBench --json <Path> also write the results as JSON
+#include "TerraDyneKernels.h"
+#include "TerraDyneChunkCodec.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace TerraDyneCore;
+
+namespace
+{
+	struct FResult
+	{
+		std::string Name;
+		double Value;
+		const char* Unit;
+	};
+
+	std::vector<FResult> GResults;
+	bool GQuick = false;
+
+	/** Mean milliseconds per call of Body over Iterations calls (after one warm-up call). */
+	template <typename FuncType>
+	double TimeMs(int Iterations, FuncType&& Body)
+	{
+		if (GQuick) Iterations = 1;
+		Body(0);
+
+		const auto Start = std::chrono::steady_clock::now();
+		for (int i = 0; i < Iterations; i++)
+		{
+			Body(i);
+		}
+		const std::chrono::duration<double, std::milli> Elapsed = std::chrono::steady_clock::now() - Start;
+		return Elapsed.count() / Iterations;
+	}
+
+	void Report(const std::string& Name, double Value, const char* Unit)
+	{
+		GResults.push_back({ Name, Value, Unit });
+		std::printf("%-44s %12.4f %s\n", Name.c_str(), Value, Unit);
+	}
+
+	void FillTerrain(int32_t Res, std::vector<float>& Heights, std::vector<FTexelBGRA>& Weights)
+	{
+		Heights.resize((size_t)Res * Res);
+		Weights.resize((size_t)Res * Res);
+		for (int32_t y = 0; y < Res; y++)
+		{
+			for (int32_t x = 0; x < Res; x++)
+			{
+				Heights[(size_t)y * Res + x] = std::sin(x * 0.05f) * std::cos(y * 0.07f) * 800.0f + std::sin(x * 0.31f + y * 0.17f) * 40.0f;
+				FTexelBGRA& Texel = Weights[(size_t)y * Res + x];
+				Texel.R = (uint8_t)(x * 255 / Res);
+				Texel.G = (uint8_t)(y * 255 / Res);
+				Texel.A = 255;
+			}
+		}
+	}
+}
+
+static void BenchBrushes()
+{
+	constexpr float ChunkSize = 10000.0f;
+	const int32_t Resolutions[] = { 129, 257, 513 };
+	const float RadiusFractions[] = { 0.02f, 0.1f, 0.4f };
+
+	for (int32_t Res : Resolutions)
+	{
+		std::vector<float> Heights((size_t)Res * Res, 0.0f);
+		std::vector<FTexelBGRA> Weights((size_t)Res * Res);
+		TGridView<float> HeightGrid(Heights.data(), Res);
+		TGridView<FTexelBGRA> WeightGrid(Weights.data(), Res);
+
+		for (float Fraction : RadiusFractions)
+		{
+			const FBrushFootprint Brush = MakeBrushFootprint(0.0f, 0.0f, ChunkSize * Fraction, ChunkSize, Res);
+			const double Cells = 3.14159265 * Brush.Radius * Brush.Radius;
+			const std::string Name = "Brush.Res" + std::to_string(Res) + ".R" + std::to_string((int)std::lround(Fraction * 100.0f));
+
+			const double HeightMs = TimeMs(500, [&](int i) { ApplyHeightBrush(HeightGrid, Brush, (i & 1) ? 5.0f : -5.0f); });
+			Report(Name + ".Height.MCellsPerSec", Cells / (HeightMs * 1000.0), "Mcell/s");
+
+			const double PaintMs = TimeMs(500, [&](int i) { ApplyPaintBrush(WeightGrid, Brush, (i & 1) ? 0.1f : -0.1f, i & 3); });
+			Report(Name + ".Paint.MCellsPerSec", Cells / (PaintMs * 1000.0), "Mcell/s");
+		}
+	}
+}
+
+static void BenchResample()
+{
+	// Landscape component (63 quads -> 64 verts) onto chunk grids, and a downsample for placeholders
+	const int32_t Cases[][2] = { { 64, 129 }, { 256, 257 }, { 505, 513 }, { 513, 33 } };
+
+	for (const auto& Case : Cases)
+	{
+		const int32_t SrcRes = Case[0], DstRes = Case[1];
+		std::vector<float> SrcHeights, DstHeights((size_t)DstRes * DstRes);
+		std::vector<FTexelBGRA> SrcWeights, DstWeights((size_t)DstRes * DstRes);
+		FillTerrain(SrcRes, SrcHeights, SrcWeights);
+
+		const double Outputs = (double)DstRes * DstRes;
+		const std::string Name = "Resample." + std::to_string(SrcRes) + "to" + std::to_string(DstRes);
+
+		const double FloatMs = TimeMs(50, [&](int) { ResampleBilinear(SrcHeights.data(), SrcRes, SrcRes, DstHeights.data(), DstRes); });
+		Report(Name + ".Float.MSamplesPerSec", Outputs / (FloatMs * 1000.0), "Msample/s");
+
+		const double ColorMs = TimeMs(50, [&](int) { ResampleBilinear(SrcWeights.data(), SrcRes, SrcRes, DstWeights.data(), DstRes); });
+		Report(Name + ".BGRA.MSamplesPerSec", Outputs / (ColorMs * 1000.0), "Msample/s");
+	}
+}
+
+static void BenchQuantization()
+{
+	const size_t Num = (size_t)513 * 513;
+	std::vector<float> Heights(Num), Restored(Num);
+	std::vector<uint16_t> Quantized(Num);
+	for (size_t i = 0; i < Num; i++) Heights[i] = (float)(i % 51200);
+	const float Step = GetHeightQuantizationStep(100.0f);
+
+	const double QuantizeMs = TimeMs(50, [&](int) { QuantizeHeights(Heights.data(), Quantized.data(), Num, Step); });
+	Report("Quantize.Res513.MSamplesPerSec", Num / (QuantizeMs * 1000.0), "Msample/s");
+
+	const double DequantizeMs = TimeMs(50, [&](int) { DequantizeHeights(Quantized.data(), Restored.data(), Num, Step); });
+	Report("Dequantize.Res513.MSamplesPerSec", Num / (DequantizeMs * 1000.0), "Msample/s");
+}
+
+static void BenchCodec()
+{
+	const int32_t Resolutions[] = { 129, 257, 513 };
+
+	for (int32_t Res : Resolutions)
+	{
+		std::vector<float> Heights;
+		std::vector<FTexelBGRA> Weights;
+		FillTerrain(Res, Heights, Weights);
+
+		FChunkInfo Info;
+		Info.Resolution = Res;
+		Info.RealWorldSize = 10000.0f;
+
+		const int32_t Num = Res * Res;
+		std::vector<uint8_t> Payload(FChunkCodec::GetPayloadSize(Num, Num));
+		std::vector<uint8_t> File(FChunkCodec::GetFrameBound(Payload.size()));
+		std::vector<uint8_t> Restored(Payload.size());
+		size_t FileSize = 0;
+
+		const double MB = Payload.size() / (1024.0 * 1024.0);
+		const std::string Name = "Codec.Res" + std::to_string(Res);
+
+		const double WriteMs = TimeMs(50, [&](int) { FChunkCodec::WritePayload(Info, Heights.data(), Num, Weights.data(), Num, Payload.data()); });
+		Report(Name + ".WritePayload.MBps", MB / (WriteMs / 1000.0), "MB/s");
+
+		const double CompressMs = TimeMs(10, [&](int) { FChunkCodec::CompressFrame(Payload.data(), Payload.size(), File.data(), File.size(), FileSize); });
+		Report(Name + ".Compress.MBps", MB / (CompressMs / 1000.0), "MB/s");
+		Report(Name + ".CompressionRatio", (double)Payload.size() / (double)FileSize, "x");
+
+		FChunkFrameView Frame;
+		FChunkCodec::ReadFrame(File.data(), FileSize, Frame);
+		const double DecompressMs = TimeMs(20, [&](int) { FChunkCodec::DecompressFrame(Frame, Restored.data(), Restored.size()); });
+		Report(Name + ".Decompress.MBps", MB / (DecompressMs / 1000.0), "MB/s");
+
+		FChunkPayloadView View;
+		const double ReadMs = TimeMs(200, [&](int) { FChunkCodec::ReadPayload(Restored.data(), Restored.size(), View); });
+		Report(Name + ".ReadPayload.Us", ReadMs * 1000.0, "us");
+	}
+}
+
+static bool WriteJson(const char* Path)
+{
+	FILE* File = std::fopen(Path, "w");
+	if (!File) return false;
+
+	std::fprintf(File, "{\n\t\"metrics\": [\n");
+	for (size_t i = 0; i < GResults.size(); i++)
+	{
+		std::fprintf(File, "\t\t{ \"name\": \"%s\", \"value\": %.6f, \"unit\": \"%s\" }%s\n",
+			GResults[i].Name.c_str(), GResults[i].Value, GResults[i].Unit, i + 1 < GResults.size() ? "," : "");
+	}
+	std::fprintf(File, "\t]\n}\n");
+	return std::fclose(File) == 0;
+}
+
+int main(int Argc, char** Argv)
+{
+	const char* JsonPath = nullptr;
+	for (int i = 1; i < Argc; i++)
+	{
+		if (std::strcmp(Argv[i], "--quick") == 0)
+		{
+			GQuick = true;
+		}
+		else if (std::strcmp(Argv[i], "--json") == 0 && i + 1 < Argc)
+		{
+			JsonPath = Argv[++i];
+		}
+	}
+
+	BenchBrushes();
+	BenchResample();
+	BenchQuantization();
+	BenchCodec();
+
+	if (JsonPath && !WriteJson(JsonPath))
+	{
+		std::fprintf(stderr, "Failed to write %s\n", JsonPath);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,637 @@
+// Unit tests of the engine-independent TerraDyne core. Run through ctest, or directly: exit code = failures.
+#include "TerraDyneKernels.h"
+#include "TerraDyneChunkCodec.h"
+#include "TerraDyneRegionLayout.h"
+#include "TerraDyneJournalCodec.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+using namespace TerraDyneCore;
+
+static int GFailures = 0;
+
+#define CHECK(Expr) \
+	do { if (!(Expr)) { std::printf("  FAILED %s:%d: %s\n", __FILE__, __LINE__, #Expr); GFailures++; } } while (0)
+
+#define CHECK_NEAR(A, B, Tolerance) CHECK(std::fabs((double)(A) - (double)(B)) <= (Tolerance))
+
+static void Run(const char* Name, const std::function<void()>& Test)
+{
+	const int Before = GFailures;
+	Test();
+	std::printf("%s %s\n", GFailures == Before ? "[ OK ]" : "[FAIL]", Name);
+}
+
+//--- Brushes ---//
+
+static void TestFootprint()
+{
+	// 5 cells across 100 units: cell 2 is the center
+	const FBrushFootprint Brush = MakeBrushFootprint(0.0f, 0.0f, 25.0f, 100.0f, 5);
+	CHECK_NEAR(Brush.CenterX, 2.0f, 1e-5);
+	CHECK_NEAR(Brush.CenterY, 2.0f, 1e-5);
+	CHECK_NEAR(Brush.Radius, 1.0f, 1e-5);
+	CHECK(Brush.Rect.MinX == 1 && Brush.Rect.MaxX == 4);
+	CHECK(Brush.Rect.MinY == 1 && Brush.Rect.MaxY == 4);
+
+	// Off the edge: clamped to the grid
+	const FBrushFootprint Edge = MakeBrushFootprint(-60.0f, 0.0f, 50.0f, 100.0f, 5);
+	CHECK(Edge.Rect.MinX == 0);
+	CHECK(Edge.Rect.MaxX <= 5);
+}
+
+static void TestHeightBrush()
+{
+	const int32_t Res = 33;
+	std::vector<float> Heights(Res * Res, 0.0f);
+	TGridView<float> Grid(Heights.data(), Res);
+
+	const FBrushFootprint Brush = MakeBrushFootprint(0.0f, 0.0f, 25.0f, 100.0f, Res);
+	const FBrushResult Result = ApplyHeightBrush(Grid, Brush, 10.0f);
+
+	CHECK(Result.bModified);
+	CHECK_NEAR(Result.MaxDelta, 10.0f, 1e-4);
+	CHECK_NEAR(Grid(16, 16), 10.0f, 1e-4);                 // Full strength at the center
+	CHECK_NEAR(Grid(20, 16), 10.0f * (1.0f - 4.0f / 8.0f), 1e-4); // Linear falloff (radius = 8 cells)
+	CHECK(Grid(0, 0) == 0.0f && Grid(16, 25) == 0.0f);      // Outside untouched
+
+	// Symmetric
+	CHECK_NEAR(Grid(12, 16), Grid(20, 16), 1e-5);
+	CHECK_NEAR(Grid(16, 12), Grid(16, 20), 1e-5);
+
+	// Zero radius changes nothing
+	const FBrushResult None = ApplyHeightBrush(Grid, MakeBrushFootprint(0.0f, 0.0f, 0.0f, 100.0f, Res), 10.0f);
+	CHECK(!None.bModified);
+}
+
+static void TestPaintBrush()
+{
+	const int32_t Res = 17;
+	std::vector<FTexelBGRA> Weights(Res * Res);
+	TGridView<FTexelBGRA> Grid(Weights.data(), Res);
+	const FBrushFootprint Brush = MakeBrushFootprint(0.0f, 0.0f, 50.0f, 100.0f, Res);
+
+	CHECK(ApplyPaintBrush(Grid, Brush, 1.0f, 0));
+	CHECK(Grid(8, 8).R == 255 && Grid(8, 8).G == 0 && Grid(8, 8).B == 0 && Grid(8, 8).A == 0);
+
+	// Saturates instead of wrapping
+	CHECK(ApplyPaintBrush(Grid, Brush, 1.0f, 0));
+	CHECK(Grid(8, 8).R == 255);
+	CHECK(ApplyPaintBrush(Grid, Brush, -2.0f, 0));
+	CHECK(Grid(8, 8).R == 0);
+
+	// Layer 3 = alpha; invalid layers are rejected
+	CHECK(ApplyPaintBrush(Grid, Brush, 0.5f, 3));
+	CHECK(Grid(8, 8).A == 128);
+	CHECK(!ApplyPaintBrush(Grid, Brush, 1.0f, 4));
+}
+
+//--- Resampling ---//
+
+static float ReferenceBilinear(const std::vector<float>& Src, int32_t W, int32_t H, int32_t Res, int32_t X, int32_t Y)
+{
+	const float Sx = Res > 1 ? X * (float)(W - 1) / (Res - 1) : 0.0f;
+	const float Sy = Res > 1 ? Y * (float)(H - 1) / (Res - 1) : 0.0f;
+	const int32_t X0 = std::min((int32_t)Sx, std::max(W - 2, 0)), Y0 = std::min((int32_t)Sy, std::max(H - 2, 0));
+	const int32_t X1 = std::min(X0 + 1, W - 1), Y1 = std::min(Y0 + 1, H - 1);
+	const float Fx = W > 1 ? Sx - X0 : 0.0f, Fy = H > 1 ? Sy - Y0 : 0.0f;
+	const float Top = Src[Y0 * W + X0] + (Src[Y0 * W + X1] - Src[Y0 * W + X0]) * Fx;
+	const float Bottom = Src[Y1 * W + X0] + (Src[Y1 * W + X1] - Src[Y1 * W + X0]) * Fx;
+	return Top + (Bottom - Top) * Fy;
+}
+
+static void TestResampleFloat()
+{
+	// Identity
+	const int32_t Res = 9;
+	std::vector<float> Src(Res * Res), Dst(Res * Res);
+	for (size_t i = 0; i < Src.size(); i++) Src[i] = (float)(i * 7 % 13);
+	ResampleBilinear(Src.data(), Res, Res, Dst.data(), Res);
+	CHECK(Src == Dst);
+
+	// A linear ramp stays exact under bilinear filtering; odd sizes exercise the SIMD tail
+	const int32_t W = 37, H = 23, Out = 70;
+	std::vector<float> Ramp(W * H), Resampled(Out * Out);
+	for (int32_t y = 0; y < H; y++)
+		for (int32_t x = 0; x < W; x++)
+			Ramp[y * W + x] = 2.0f * x + 3.0f * y;
+	ResampleBilinear(Ramp.data(), W, H, Resampled.data(), Out);
+
+	CHECK_NEAR(Resampled[0], 0.0f, 1e-4);
+	CHECK_NEAR(Resampled[Out * Out - 1], 2.0f * (W - 1) + 3.0f * (H - 1), 1e-3);
+	for (int32_t y = 0; y < Out; y += 7)
+		for (int32_t x = 0; x < Out; x++)
+			CHECK_NEAR(Resampled[y * Out + x], ReferenceBilinear(Ramp, W, H, Out, x, y), 1e-3);
+
+	// Single column source
+	std::vector<float> Column = { 1.0f, 3.0f };
+	std::vector<float> Wide(4 * 4);
+	ResampleBilinear(Column.data(), 1, 2, Wide.data(), 4);
+	CHECK_NEAR(Wide[0], 1.0f, 1e-5);
+	CHECK_NEAR(Wide[3], 1.0f, 1e-5);
+	CHECK_NEAR(Wide[15], 3.0f, 1e-5);
+}
+
+static void TestResampleColor()
+{
+	// 2x2 -> 3x3: the center is the average of the four corners, rounded to nearest
+	FTexelBGRA Src[4];
+	Src[0].R = 0;   Src[1].R = 255; Src[2].R = 0;   Src[3].R = 255;
+	Src[0].G = 10;  Src[1].G = 10;  Src[2].G = 11;  Src[3].G = 11;
+	Src[0].A = 200; Src[1].A = 200; Src[2].A = 200; Src[3].A = 200;
+
+	FTexelBGRA Dst[9];
+	ResampleBilinear(Src, 2, 2, Dst, 3);
+
+	CHECK(Dst[0] == Src[0]);
+	CHECK(Dst[8] == Src[3]);
+	CHECK(Dst[4].R == 128); // 127.5 rounds up
+	CHECK(Dst[4].G == 11);  // 10.5 rounds up
+	CHECK(Dst[4].A == 200);
+	CHECK(Dst[4].B == 0);
+}
+
+//--- Quantization ---//
+
+static void TestQuantization()
+{
+	const float Step = GetHeightQuantizationStep(100.0f);
+	CHECK_NEAR(Step * 65535.0f, 51200.0f, 1e-2);
+
+	std::vector<float> Heights = { -10.0f, 0.0f, 1234.5f, 51200.0f, 60000.0f };
+	std::vector<uint16_t> Quantized(Heights.size());
+	QuantizeHeights(Heights.data(), Quantized.data(), Heights.size(), Step);
+	CHECK(Quantized[0] == 0);
+	CHECK(Quantized[3] == 65535);
+	CHECK(Quantized[4] == 65535); // Clamped
+
+	std::vector<float> Restored(Heights.size());
+	DequantizeHeights(Quantized.data(), Restored.data(), Quantized.size(), Step);
+	CHECK_NEAR(Restored[1], 0.0f, 1e-6);
+	CHECK_NEAR(Restored[2], 1234.5f, Step * 0.5f + 1e-3);
+}
+
+//--- Codec ---//
+
+static void MakeChunk(int32_t Res, std::vector<float>& Heights, std::vector<FTexelBGRA>& Weights)
+{
+	Heights.resize(Res * Res);
+	Weights.resize(Res * Res);
+	for (int32_t i = 0; i < Res * Res; i++)
+	{
+		Heights[i] = std::sin(i * 0.01f) * 500.0f;
+		Weights[i].R = (uint8_t)(i & 0xFF);
+		Weights[i].A = 255;
+	}
+}
+
+static void TestCodecPayload()
+{
+	std::vector<float> Heights;
+	std::vector<FTexelBGRA> Weights;
+	MakeChunk(17, Heights, Weights);
+
+	FChunkInfo Info;
+	Info.GridX = -3;
+	Info.GridY = 12;
+	Info.Resolution = 17;
+	Info.RealWorldSize = 10000.0f;
+
+	std::vector<uint8_t> Payload(FChunkCodec::GetPayloadSize((int32_t)Heights.size(), (int32_t)Weights.size()));
+	const size_t Written = FChunkCodec::WritePayload(Info, Heights.data(), (int32_t)Heights.size(), Weights.data(), (int32_t)Weights.size(), Payload.data());
+	CHECK(Written == Payload.size());
+
+	// Same bytes FArchive << writes: Version, FIntPoint, Resolution, RealWorldSize, TArray count + data ...
+	int32_t Header[4];
+	std::memcpy(Header, Payload.data(), sizeof(Header));
+	CHECK(Header[0] == 1 && Header[1] == -3 && Header[2] == 12 && Header[3] == 17);
+
+	FChunkPayloadView View;
+	CHECK(FChunkCodec::ReadPayload(Payload.data(), Payload.size(), View));
+	CHECK(View.Info.GridX == -3 && View.Info.GridY == 12 && View.Info.Resolution == 17);
+	CHECK(View.Info.RealWorldSize == 10000.0f);
+	CHECK(View.NumHeights == 17 * 17 && View.NumWeights == 17 * 17);
+	CHECK(std::memcmp(View.Heights, Heights.data(), Heights.size() * sizeof(float)) == 0);
+	CHECK(std::memcmp(View.Weights, Weights.data(), Weights.size() * sizeof(FTexelBGRA)) == 0);
+
+	// Truncated and unknown versions are rejected
+	CHECK(!FChunkCodec::ReadPayload(Payload.data(), Payload.size() - 1, View));
+	Payload[0] = 99;
+	CHECK(!FChunkCodec::ReadPayload(Payload.data(), Payload.size(), View));
+	CHECK(View.Version == 99);
+}
+
+static void TestCodecFrame()
+{
+	std::vector<float> Heights;
+	std::vector<FTexelBGRA> Weights;
+	MakeChunk(65, Heights, Weights);
+
+	std::vector<uint8_t> Payload(FChunkCodec::GetPayloadSize((int32_t)Heights.size(), (int32_t)Weights.size()));
+	FChunkCodec::WritePayload(FChunkInfo(), Heights.data(), (int32_t)Heights.size(), Weights.data(), (int32_t)Weights.size(), Payload.data());
+
+	std::vector<uint8_t> File(FChunkCodec::GetFrameBound(Payload.size()));
+	size_t FileSize = 0;
+	CHECK(FChunkCodec::CompressFrame(Payload.data(), Payload.size(), File.data(), File.size(), FileSize));
+	CHECK(FileSize > FChunkCodec::FrameHeaderSize && FileSize < Payload.size());
+
+	FChunkFrameView Frame;
+	CHECK(FChunkCodec::ReadFrame(File.data(), FileSize, Frame));
+	CHECK(Frame.UncompressedSize == (int32_t)Payload.size());
+
+	std::vector<uint8_t> Restored(Frame.UncompressedSize);
+	CHECK(FChunkCodec::DecompressFrame(Frame, Restored.data(), Restored.size()));
+	CHECK(Restored == Payload);
+
+	// Bad magic, truncation, wrong output size
+	CHECK(!FChunkCodec::ReadFrame(File.data(), FileSize - 1, Frame));
+	CHECK(!FChunkCodec::DecompressFrame(Frame, Restored.data(), Restored.size() - 1));
+	File[0] ^= 0xFF;
+	CHECK(!FChunkCodec::ReadFrame(File.data(), FileSize, Frame));
+
+	// Too small an output buffer fails instead of overrunning
+	size_t Unused = 0;
+	std::vector<uint8_t> Tiny(FChunkCodec::FrameHeaderSize + 4);
+	CHECK(!FChunkCodec::CompressFrame(Payload.data(), Payload.size(), Tiny.data(), Tiny.size(), Unused));
+}
+
+static void TestCodecDelta()
+{
+	// 40 cells: 3 blocks per side, the last row/column of blocks clipped to 8 cells
+	const int32_t Res = 40;
+	std::vector<float> Base;
+	std::vector<FTexelBGRA> BaseWeights;
+	MakeChunk(Res, Base, BaseWeights);
+	const uint64_t BaseHash = FChunkCodec::HashBase(Base.data(), BaseWeights.data(), Base.size());
+	CHECK(BaseHash != 0);
+
+	CHECK(FChunkCodec::GetBlocksPerSide(Res, 16) == 3);
+	const FGridRect Corner = FChunkCodec::GetBlockRect(Res, 16, 8);
+	CHECK(Corner.MinX == 32 && Corner.MinY == 32 && Corner.MaxX == 40 && Corner.MaxY == 40);
+
+	// Edit one interior block and the clipped corner block
+	std::vector<float> Heights = Base;
+	std::vector<FTexelBGRA> Weights = BaseWeights;
+	Heights[20 * Res + 20] += 100.0f;
+	Weights[39 * Res + 39].G = 7;
+	CHECK(FChunkCodec::HashBase(Heights.data(), Weights.data(), Heights.size()) != BaseHash);
+
+	const int32_t Blocks[] = { 4, 8 };
+	FChunkInfo Info;
+	Info.GridX = 5;
+	Info.GridY = -1;
+	Info.Resolution = Res;
+	Info.RealWorldSize = 2500.0f;
+
+	std::vector<uint8_t> Payload(FChunkCodec::GetDeltaPayloadSize(Res, 16, Blocks, 2));
+	CHECK(Payload.size() < FChunkCodec::GetPayloadSize(Res * Res, Res * Res));
+	CHECK(FChunkCodec::WriteDeltaPayload(Info, BaseHash, 16, Blocks, 2, Heights.data(), Weights.data(), Payload.data()) == Payload.size());
+
+	FChunkPayloadView View;
+	CHECK(FChunkCodec::ReadPayload(Payload.data(), Payload.size(), View));
+	CHECK(View.IsDelta() && View.Version == FChunkCodec::DeltaVersion);
+	CHECK(View.BaseHash == BaseHash && View.BlockSize == 16 && View.NumBlocks == 2);
+	CHECK(View.Info.GridX == 5 && View.Info.Resolution == Res);
+
+	// Unpacked, the delta holds only its blocks (16x16 + 8x8 cells)
+	const int64_t Cells = FChunkCodec::GetBlockCellCount(Res, 16, Blocks, 2);
+	CHECK(Cells == 16 * 16 + 8 * 8 && View.NumBlockCells == Cells);
+	std::vector<float> PackedHeights(Cells);
+	std::vector<FTexelBGRA> PackedWeights(Cells);
+	int32_t ReadBlocks[2] = {};
+	FChunkCodec::UnpackDeltaBlocks(View, PackedHeights.data(), PackedWeights.data(), ReadBlocks);
+	CHECK(ReadBlocks[0] == 4 && ReadBlocks[1] == 8);
+	CHECK(PackedHeights[4 * 16 + 4] == Heights[20 * Res + 20]);
+	CHECK(PackedWeights[16 * 16 + 7 * 8 + 7].G == 7);
+
+	// Scattered over the base, the delta reproduces the edited state exactly
+	std::vector<float> Restored = Base;
+	std::vector<FTexelBGRA> RestoredWeights = BaseWeights;
+	FChunkCodec::ScatterPackedBlocks(Res, 16, ReadBlocks, 2, PackedHeights.data(), PackedWeights.data(), Restored.data(), RestoredWeights.data());
+	CHECK(Restored == Heights);
+	CHECK(RestoredWeights == Weights);
+
+	// Truncated records and out-of-range blocks are rejected
+	CHECK(!FChunkCodec::ReadPayload(Payload.data(), Payload.size() - 1, View));
+	const size_t BlocksOffset = 7 * sizeof(int32_t) + sizeof(uint64_t);
+	const int32_t BadBlock = 9;
+	std::vector<uint8_t> Corrupt = Payload;
+	std::memcpy(Corrupt.data() + BlocksOffset, &BadBlock, sizeof(BadBlock));
+	CHECK(!FChunkCodec::ReadPayload(Corrupt.data(), Corrupt.size(), View));
+
+	// Header fields that would size allocations are bounded: Resolution, BlockSize, NumBlocks
+	auto CorruptField = [&Payload, &View](size_t Offset, int32_t Value)
+	{
+		std::vector<uint8_t> Bytes = Payload;
+		std::memcpy(Bytes.data() + Offset, &Value, sizeof(Value));
+		return FChunkCodec::ReadPayload(Bytes.data(), Bytes.size(), View);
+	};
+	CHECK(!CorruptField(3 * sizeof(int32_t), FChunkCodec::MaxResolution + 1));
+	CHECK(!CorruptField(3 * sizeof(int32_t), -Res));
+	CHECK(!CorruptField(3 * sizeof(int32_t), 0x7FFFFFFF));
+	CHECK(!CorruptField(BlocksOffset - 2 * sizeof(int32_t), 0x7FFFFFFF));
+	CHECK(!CorruptField(BlocksOffset - sizeof(int32_t), 10));
+	CHECK(!CorruptField(BlocksOffset - sizeof(int32_t), -1));
+
+	// v1 counts beyond Resolution^2 never reach an allocation
+	std::vector<float> Full(Res * Res);
+	std::vector<FTexelBGRA> FullWeights(Res * Res);
+	std::vector<uint8_t> V1(FChunkCodec::GetPayloadSize(Res * Res, Res * Res));
+	FChunkCodec::WritePayload(Info, Full.data(), Res * Res, FullWeights.data(), Res * Res, V1.data());
+	CHECK(FChunkCodec::ReadPayload(V1.data(), V1.size(), View));
+	const int32_t HugeCount = Res * Res + 1;
+	std::memcpy(V1.data() + 5 * sizeof(int32_t), &HugeCount, sizeof(HugeCount));
+	CHECK(!FChunkCodec::ReadPayload(V1.data(), V1.size(), View));
+}
+
+//--- Region File ---//
+
+static void TestRegionLayout()
+{
+	// Two frames of 100 and 40 bytes, then the index
+	const FRegionEntry Entries[] = { { 0, 0, 32, 100 }, { -4, 9, 132, 40 } };
+
+	FRegionHeader Header;
+	Header.NumEntries = 2;
+	Header.IndexOffset = 172;
+	Header.CommittedEnd = Header.IndexOffset + (int64_t)FRegionFileLayout::GetIndexSize(2);
+
+	std::vector<uint8_t> File((size_t)Header.CommittedEnd);
+	FRegionFileLayout::WriteHeader(Header, File.data());
+	FRegionFileLayout::WriteIndex(Entries, 2, File.data() + Header.IndexOffset);
+
+	FRegionHeader ReadBack;
+	CHECK(FRegionFileLayout::ReadHeader(File.data(), File.size(), (int64_t)File.size(), ReadBack));
+	CHECK(ReadBack.NumEntries == 2 && ReadBack.IndexOffset == 172 && ReadBack.CommittedEnd == 172 + 48);
+
+	FRegionEntry ReadEntries[2];
+	CHECK(FRegionFileLayout::ReadIndex(File.data() + ReadBack.IndexOffset, File.size() - ReadBack.IndexOffset, ReadBack, ReadEntries));
+	CHECK(ReadEntries[1].GridX == -4 && ReadEntries[1].GridY == 9 && ReadEntries[1].Offset == 132 && ReadEntries[1].Size == 40);
+
+	// A fresh file is valid and empty
+	const FRegionHeader Empty = FRegionFileLayout::MakeEmptyHeader();
+	uint8_t EmptyFile[FRegionFileLayout::HeaderSize];
+	FRegionFileLayout::WriteHeader(Empty, EmptyFile);
+	CHECK(FRegionFileLayout::ReadHeader(EmptyFile, sizeof(EmptyFile), sizeof(EmptyFile), ReadBack) && ReadBack.NumEntries == 0);
+
+	// Truncated file, index past the end, frame overlapping the index
+	CHECK(!FRegionFileLayout::ReadHeader(File.data(), File.size(), (int64_t)File.size() - 1, ReadBack));
+	CHECK(!FRegionFileLayout::ReadHeader(File.data(), FRegionFileLayout::HeaderSize - 1, (int64_t)File.size(), ReadBack));
+	const FRegionEntry Overlapping[] = { { 0, 0, 32, 141 } };
+	Header.NumEntries = 1;
+	FRegionFileLayout::WriteIndex(Overlapping, 1, File.data() + Header.IndexOffset);
+	CHECK(!FRegionFileLayout::ReadIndex(File.data() + Header.IndexOffset, 24, Header, ReadEntries));
+
+	File[0] ^= 0xFF;
+	CHECK(!FRegionFileLayout::ReadHeader(File.data(), File.size(), (int64_t)File.size(), ReadBack));
+}
+
+//--- Edit Journal ---//
+
+static void TestJournalVarInt()
+{
+	struct FCase { uint32_t Value; size_t Size; };
+	const FCase Cases[] = { { 0, 1 }, { 1, 1 }, { 127, 1 }, { 128, 2 }, { 300, 2 }, { 16383, 2 }, { 16384, 3 },
+		{ 0x0FFFFFFFu, 4 }, { 0x10000000u, 5 }, { 0xFFFFFFFFu, 5 } };
+
+	for (const FCase& Case : Cases)
+	{
+		uint8_t Bytes[FJournalCodec::MaxVarUIntSize];
+		const size_t Size = FJournalCodec::WriteVarUInt(Case.Value, Bytes);
+		CHECK(Size == Case.Size);
+
+		size_t Offset = 0;
+		uint32_t Value = 0;
+		CHECK(FJournalCodec::ReadVarUInt(Bytes, Size, Offset, Value) && Value == Case.Value && Offset == Size);
+
+		// Truncated: fails without moving the offset
+		Offset = 0;
+		CHECK(!FJournalCodec::ReadVarUInt(Bytes, Size - 1, Offset, Value) && Offset == 0);
+	}
+
+	// More than 32 bits, or a sixth byte
+	const uint8_t Overflow[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x1F };
+	const uint8_t TooLong[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x00 };
+	size_t Offset = 0;
+	uint32_t Value = 0;
+	CHECK(!FJournalCodec::ReadVarUInt(Overflow, sizeof(Overflow), Offset, Value));
+	CHECK(!FJournalCodec::ReadVarUInt(TooLong, sizeof(TooLong), Offset, Value));
+
+	// Zigzag: small magnitudes stay small either way
+	CHECK(FJournalCodec::ZigZag(0) == 0 && FJournalCodec::ZigZag(-1) == 1 && FJournalCodec::ZigZag(1) == 2 && FJournalCodec::ZigZag(-2) == 3);
+	CHECK(FJournalCodec::ZigZag(std::numeric_limits<int32_t>::max()) == 0xFFFFFFFEu);
+	CHECK(FJournalCodec::ZigZag(std::numeric_limits<int32_t>::min()) == 0xFFFFFFFFu);
+	const int32_t Signed[] = { 0, 1, -1, 63, -64, 64, -65, 100000, -100000, std::numeric_limits<int32_t>::max(), std::numeric_limits<int32_t>::min() };
+	for (int32_t Case : Signed)
+	{
+		CHECK(FJournalCodec::UnZigZag(FJournalCodec::ZigZag(Case)) == Case);
+	}
+}
+
+static void TestJournalHalf()
+{
+	auto Bits = [](float Value) { uint32_t Out; std::memcpy(&Out, &Value, sizeof(Out)); return Out; };
+
+	// Exact values
+	struct FCase { float Value; uint16_t Half; };
+	const FCase Cases[] = { { 0.0f, 0x0000 }, { -0.0f, 0x8000 }, { 1.0f, 0x3C00 }, { -2.0f, 0xC000 }, { 0.5f, 0x3800 },
+		{ 65504.0f, 0x7BFF }, { std::ldexp(1.0f, -14), 0x0400 }, { std::ldexp(1.0f, -24), 0x0001 }, { 1.0f + std::ldexp(1.0f, -10), 0x3C01 } };
+	for (const FCase& Case : Cases)
+	{
+		CHECK(FJournalCodec::FloatToHalf(Case.Value) == Case.Half);
+		CHECK(Bits(FJournalCodec::HalfToFloat(Case.Half)) == Bits(Case.Value));
+	}
+
+	// Ties round to even, in normals and denormals
+	CHECK(FJournalCodec::FloatToHalf(1.0f + std::ldexp(1.0f, -11)) == 0x3C00);
+	CHECK(FJournalCodec::FloatToHalf(1.0f + 3.0f * std::ldexp(1.0f, -11)) == 0x3C02);
+	CHECK(FJournalCodec::FloatToHalf(std::ldexp(1.0f, -25)) == 0x0000);
+	CHECK(FJournalCodec::FloatToHalf(3.0f * std::ldexp(1.0f, -25)) == 0x0002);
+
+	// Overflow, infinity and NaN
+	CHECK(FJournalCodec::FloatToHalf(65519.0f) == 0x7BFF);
+	CHECK(FJournalCodec::FloatToHalf(65520.0f) == 0x7C00);
+	CHECK(FJournalCodec::FloatToHalf(-1.0e9f) == 0xFC00);
+	CHECK(FJournalCodec::FloatToHalf(std::numeric_limits<float>::infinity()) == 0x7C00);
+	const uint16_t NaN = FJournalCodec::FloatToHalf(std::numeric_limits<float>::quiet_NaN());
+	CHECK((NaN & 0x7C00) == 0x7C00 && (NaN & 0x03FF) != 0);
+
+	// Every half survives the trip through float
+	int32_t Mismatches = 0;
+	for (uint32_t Half = 0; Half <= 0xFFFF; Half++)
+	{
+		const bool bNaN = (Half & 0x7C00) == 0x7C00 && (Half & 0x03FF) != 0;
+		if (!bNaN && FJournalCodec::FloatToHalf(FJournalCodec::HalfToFloat((uint16_t)Half)) != Half)
+		{
+			Mismatches++;
+		}
+	}
+	CHECK(Mismatches == 0);
+}
+
+static void TestJournalRecord()
+{
+	FJournalRecord Record;
+	Record.TickDelta = 3;
+	Record.Op = JournalOpPaint | (2 << 2);
+	Record.DX = -250;
+	Record.DY = 70000;
+	Record.Radius = 512;
+	Record.Strength = FJournalCodec::FloatToHalf(-0.75f);
+
+	uint8_t Bytes[FJournalCodec::MaxRecordSize * 2];
+	const size_t Size = FJournalCodec::WriteRecord(Record, Bytes);
+	CHECK(Size == 1 + 1 + 2 + 3 + 4);
+
+	size_t Offset = 0;
+	FJournalRecord Read;
+	CHECK(FJournalCodec::ReadRecord(Bytes, Size, Offset, Read) && Offset == Size);
+	CHECK(Read.TickDelta == 3 && Read.Op == Record.Op && Read.DX == -250 && Read.DY == 70000 && Read.Radius == 512);
+	CHECK(FJournalCodec::HalfToFloat(Read.Strength) == -0.75f);
+
+	// Every truncation fails and leaves the offset alone
+	for (size_t Cut = 0; Cut < Size; Cut++)
+	{
+		Offset = 0;
+		CHECK(!FJournalCodec::ReadRecord(Bytes, Cut, Offset, Read) && Offset == 0);
+	}
+}
+
+/** Terrain of one chunk under a journal, replayed with the same kernels the chunks use. */
+struct FJournalTerrain
+{
+	static constexpr int32_t Res = 65;
+	static constexpr float ChunkSize = 1000.0f;
+
+	std::vector<float> Heights = std::vector<float>(Res * Res, 0.0f);
+	std::vector<FTexelBGRA> Weights = std::vector<FTexelBGRA>(Res * Res);
+
+	void Apply(const FJournalRecord& Record, int32_t X, int32_t Y)
+	{
+		const FBrushFootprint Brush = MakeBrushFootprint((float)X, (float)Y, (float)Record.Radius, ChunkSize, Res);
+		const float Strength = FJournalCodec::HalfToFloat(Record.Strength);
+		if ((Record.Op & 3) == JournalOpPaint)
+		{
+			ApplyPaintBrush(TGridView<FTexelBGRA>(Weights.data(), Res), Brush, Strength, (Record.Op >> 2) & 3);
+		}
+		else
+		{
+			ApplyHeightBrush(TGridView<float>(Heights.data(), Res), Brush, (Record.Op & 3) == JournalOpHole ? -Strength : Strength);
+		}
+	}
+
+	bool operator==(const FJournalTerrain& Other) const
+	{
+		return std::memcmp(Heights.data(), Other.Heights.data(), Heights.size() * sizeof(float)) == 0 &&
+			std::memcmp(Weights.data(), Other.Weights.data(), Weights.size() * sizeof(FTexelBGRA)) == 0;
+	}
+};
+
+/** Decoder position, as FTerraDyneEditJournal::FCursor. */
+struct FJournalCursor
+{
+	size_t Offset = 0;
+	int32_t X = 0;
+	int32_t Y = 0;
+};
+
+static void ReplayJournal(const std::vector<uint8_t>& Stream, FJournalCursor Cursor, size_t EndOffset, FJournalTerrain& Terrain)
+{
+	FJournalRecord Record;
+	while (Cursor.Offset < EndOffset && FJournalCodec::ReadRecord(Stream.data(), Stream.size(), Cursor.Offset, Record))
+	{
+		Cursor.X += Record.DX;
+		Cursor.Y += Record.DY;
+		Terrain.Apply(Record, Cursor.X, Cursor.Y);
+	}
+}
+
+static void TestJournalSeekReplay()
+{
+	constexpr int32_t NumEdits = 400;
+	constexpr int32_t KeyframeEvery = 37;
+
+	// Record: apply every edit as it was stored (the Manager quantizes before applying), keyframing along the way
+	std::vector<uint8_t> Stream;
+	std::vector<std::pair<FJournalCursor, FJournalTerrain>> Keyframes;
+	FJournalTerrain Live;
+	FJournalCursor Tail;
+	uint32_t Seed = 12345;
+	auto Random = [&Seed](int32_t Range) { Seed = Seed * 1664525u + 1013904223u; return (int32_t)((Seed >> 8) % (uint32_t)Range); };
+
+	for (int32_t Edit = 0; Edit < NumEdits; Edit++)
+	{
+		if (Edit > 0 && Edit % KeyframeEvery == 0)
+		{
+			Keyframes.emplace_back(Tail, Live);
+		}
+
+		const int32_t X = Random(1200) - 600;
+		const int32_t Y = Random(1200) - 600;
+		FJournalRecord Record;
+		Record.TickDelta = (uint32_t)Random(20);
+		Record.Op = Random(4) == 0 ? (uint8_t)(JournalOpPaint | (Random(4) << 2)) : (uint8_t)Random(2);
+		Record.DX = X - Tail.X;
+		Record.DY = Y - Tail.Y;
+		Record.Radius = (uint16_t)(20 + Random(200));
+		Record.Strength = FJournalCodec::FloatToHalf((Random(20000) - 10000) / 997.0f);
+
+		uint8_t Bytes[FJournalCodec::MaxRecordSize];
+		Stream.insert(Stream.end(), Bytes, Bytes + FJournalCodec::WriteRecord(Record, Bytes));
+		Tail.Offset = Stream.size();
+		Tail.X = X;
+		Tail.Y = Y;
+		Live.Apply(Record, X, Y);
+	}
+
+	// Straight replay from the base state
+	FJournalTerrain Replayed;
+	ReplayJournal(Stream, FJournalCursor(), Stream.size(), Replayed);
+	CHECK(Replayed == Live);
+
+	// Seeking: any keyframe plus the edits after it lands on the recorded terrain, bit for bit,
+	// both at the next keyframe and at the end
+	for (size_t Index = 0; Index < Keyframes.size(); Index++)
+	{
+		const FJournalCursor& Cursor = Keyframes[Index].first;
+		if (Index + 1 < Keyframes.size())
+		{
+			FJournalTerrain ToNext = Keyframes[Index].second;
+			ReplayJournal(Stream, Cursor, Keyframes[Index + 1].first.Offset, ToNext);
+			CHECK(ToNext == Keyframes[Index + 1].second);
+		}
+
+		FJournalTerrain ToEnd = Keyframes[Index].second;
+		ReplayJournal(Stream, Cursor, Stream.size(), ToEnd);
+		CHECK(ToEnd == Live);
+	}
+	CHECK(Keyframes.size() == (NumEdits - 1) / KeyframeEvery);
+}
+
+int main()
+{
+	Run("Footprint", TestFootprint);
+	Run("HeightBrush", TestHeightBrush);
+	Run("PaintBrush", TestPaintBrush);
+	Run("ResampleFloat", TestResampleFloat);
+	Run("ResampleColor", TestResampleColor);
+	Run("Quantization", TestQuantization);
+	Run("CodecPayload", TestCodecPayload);
+	Run("CodecFrame", TestCodecFrame);
+	Run("CodecDelta", TestCodecDelta);
+	Run("RegionLayout", TestRegionLayout);
+	Run("JournalVarInt", TestJournalVarInt);
+	Run("JournalHalf", TestJournalHalf);
+	Run("JournalRecord", TestJournalRecord);
+	Run("JournalSeekReplay", TestJournalSeekReplay);
+
+	std::printf("%d failure(s)\n", GFailures);
+	return GFailures == 0 ? 0 : 1;
+}